@@ -0,0 +1,184 @@
+#include <stdlib.h>
+#include "accountDirectory.h"
+
+#define INITIAL_CAPACITY 64
+
+typedef struct {
+	Email email;
+	AccountRole role;
+	void* record;
+} Account;
+
+struct accountDirectory_t {
+	Account* accounts;
+	int capacity;
+	int size;
+};
+
+static Account* findAccount(AccountDirectory directory, Email email);
+static bool growAccounts(AccountDirectory directory, int id);
+
+/**
+* Allocates a new, empty AccountDirectory.
+*
+* @return
+* 	NULL - if allocations failed.
+* 	A new AccountDirectory in case of success.
+*/
+AccountDirectory accountDirectoryCreate() {
+	AccountDirectory directory = malloc(sizeof(*directory));
+	if (directory == NULL) return NULL;
+	directory->accounts = NULL;
+	directory->capacity = 0;
+	directory->size = 0;
+	return directory;
+}
+
+/**
+* accountDirectoryDestroy: Deallocates an existing directory. the records
+* are not deallocated.
+*
+* @param directory Target directory to be deallocated.
+* If directory is NULL nothing will be done
+*/
+void accountDirectoryDestroy(AccountDirectory directory) {
+	if (directory == NULL) return;
+	for (int i = 0; i < directory->capacity; i++) {
+		emailDestroy(directory->accounts[i].email);
+	}
+	free(directory->accounts);
+	free(directory);
+}
+
+/**
+* accountDirectoryAdd: registers the account of an email.
+*
+* @param directory the directory.
+* @param email the account email. the directory keeps a copy of it.
+* @param role the account role, ACCOUNT_CLIENT or ACCOUNT_AGENT.
+* @param record the record of the account in its manager.
+*
+* @return
+*
+* 	ACCOUNT_DIRECTORY_NULL_PARAMETERS - if directory, email or record are
+* 		NULL, or role is ACCOUNT_NONE.
+*
+* 	ACCOUNT_DIRECTORY_ALREADY_EXISTS - if the email already has an account.
+*
+* 	ACCOUNT_DIRECTORY_OUT_OF_MEMORY - if allocations failed.
+*
+* 	ACCOUNT_DIRECTORY_SUCCESS - in case of success.
+*/
+AccountDirectoryResult accountDirectoryAdd(AccountDirectory directory,
+		Email email, AccountRole role, void* record) {
+	if ((directory == NULL) || (email == NULL) || (record == NULL) ||
+		((role != ACCOUNT_CLIENT) && (role != ACCOUNT_AGENT)))
+		return ACCOUNT_DIRECTORY_NULL_PARAMETERS;
+	if (findAccount(directory, email) != NULL)
+		return ACCOUNT_DIRECTORY_ALREADY_EXISTS;
+	int id = emailGetId(email);
+	if (!growAccounts(directory, id)) return ACCOUNT_DIRECTORY_OUT_OF_MEMORY;
+	Account* account = &directory->accounts[id];
+	if (emailCopy(email, &account->email) != EMAIL_SUCCESS)
+		return ACCOUNT_DIRECTORY_OUT_OF_MEMORY;
+	account->role = role;
+	account->record = record;
+	directory->size++;
+	return ACCOUNT_DIRECTORY_SUCCESS;
+}
+
+/**
+* accountDirectoryRemove: removes the account of an email.
+*
+* @param directory the directory.
+* @param email the account email.
+*
+* @return
+*
+* 	ACCOUNT_DIRECTORY_NULL_PARAMETERS - if directory or email are NULL.
+*
+* 	ACCOUNT_DIRECTORY_NOT_EXISTS - if the email has no account.
+*
+* 	ACCOUNT_DIRECTORY_SUCCESS - in case of success.
+*/
+AccountDirectoryResult accountDirectoryRemove(AccountDirectory directory,
+		Email email) {
+	if ((directory == NULL) || (email == NULL))
+		return ACCOUNT_DIRECTORY_NULL_PARAMETERS;
+	Account* account = findAccount(directory, email);
+	if (account == NULL) return ACCOUNT_DIRECTORY_NOT_EXISTS;
+	Email stored = account->email;
+	account->email = NULL;
+	account->role = ACCOUNT_NONE;
+	account->record = NULL;
+	directory->size--;
+	emailDestroy(stored);
+	return ACCOUNT_DIRECTORY_SUCCESS;
+}
+
+/**
+* accountDirectoryFind: finds the account of an email.
+*
+* @param directory the directory.
+* @param email the email to find.
+* @param record pointer to save the account record in, or NULL. NULL is
+* 	saved if the email has no account.
+*
+* @return
+* 	ACCOUNT_NONE if directory or email are NULL or the email has no
+* 	account; else returns the account role.
+*/
+AccountRole accountDirectoryFind(AccountDirectory directory, Email email,
+		void** record) {
+	Account* account = findAccount(directory, email);
+	if (record != NULL) *record = (account == NULL) ? NULL : account->record;
+	return (account == NULL) ? ACCOUNT_NONE : account->role;
+}
+
+/**
+* accountDirectoryGetSize: returns the amount of accounts in the directory.
+*
+* @param directory the directory.
+*
+* @return
+* 	0 if directory is NULL; else returns the amount of accounts.
+*/
+int accountDirectoryGetSize(AccountDirectory directory) {
+	return (directory == NULL) ? 0 : directory->size;
+}
+
+/*
+ * findAccount: returns the account of an email, or NULL if the email has no
+ * account. an email id may be reused once its email is freed, but the
+ * directory keeps its emails alive, so an account found by the id is the
+ * account of the email.
+ */
+static Account* findAccount(AccountDirectory directory, Email email) {
+	if ((directory == NULL) || (email == NULL)) return NULL;
+	int id = emailGetId(email);
+	if ((id < 0) || (id >= directory->capacity)) return NULL;
+	Account* account = &directory->accounts[id];
+	return (account->role == ACCOUNT_NONE) ? NULL : account;
+}
+
+/*
+ * growAccounts: makes room in the table for the given email id, doubling
+ * the table until it fits.
+ */
+static bool growAccounts(AccountDirectory directory, int id) {
+	if (id < directory->capacity) return true;
+	int capacity = (directory->capacity == 0) ? INITIAL_CAPACITY :
+		directory->capacity;
+	while (capacity <= id) capacity *= 2;
+	Account* accounts = realloc(directory->accounts,
+		capacity * sizeof(*accounts));
+	if (accounts == NULL) return false;
+	for (int i = directory->capacity; i < capacity; i++) {
+		accounts[i].email = NULL;
+		accounts[i].role = ACCOUNT_NONE;
+		accounts[i].record = NULL;
+	}
+	directory->accounts = accounts;
+	directory->capacity = capacity;
+	return true;
+}
@@ -0,0 +1,119 @@
+#ifndef SRC_ACCOUNTDIRECTORY_H_
+#define SRC_ACCOUNTDIRECTORY_H_
+
+#include "email.h"
+
+/**
+* A directory of the accounts of the service: for every registered email,
+* the role of its account and the record the account manager keeps for it.
+*
+* Entries are kept in a table by the email id (emailGetId), so finding an
+* account is a single probe once the email is created. The managers keep the
+* directory up to date as they add and remove their records, and a record
+* stays valid as long as it is not removed from its manager.
+*/
+typedef struct accountDirectory_t *AccountDirectory;
+
+/**
+* The role of an account.
+*/
+typedef enum {
+	ACCOUNT_NONE = 0,
+	ACCOUNT_CLIENT = 1,
+	ACCOUNT_AGENT = 2
+} AccountRole;
+
+/**
+* This type defines end codes for the methods.
+*/
+typedef enum {
+	ACCOUNT_DIRECTORY_NULL_PARAMETERS = 0,
+	ACCOUNT_DIRECTORY_OUT_OF_MEMORY = 1,
+	ACCOUNT_DIRECTORY_ALREADY_EXISTS = 2,
+	ACCOUNT_DIRECTORY_NOT_EXISTS = 3,
+	ACCOUNT_DIRECTORY_SUCCESS = 4
+} AccountDirectoryResult;
+
+/**
+* Allocates a new, empty AccountDirectory.
+*
+* @return
+* 	NULL - if allocations failed.
+* 	A new AccountDirectory in case of success.
+*/
+AccountDirectory accountDirectoryCreate();
+
+/**
+* accountDirectoryDestroy: Deallocates an existing directory. the records
+* are not deallocated.
+*
+* @param directory Target directory to be deallocated.
+* If directory is NULL nothing will be done
+*/
+void accountDirectoryDestroy(AccountDirectory directory);
+
+/**
+* accountDirectoryAdd: registers the account of an email.
+*
+* @param directory the directory.
+* @param email the account email. the directory keeps a copy of it.
+* @param role the account role, ACCOUNT_CLIENT or ACCOUNT_AGENT.
+* @param record the record of the account in its manager.
+*
+* @return
+*
+* 	ACCOUNT_DIRECTORY_NULL_PARAMETERS - if directory, email or record are
+* 		NULL, or role is ACCOUNT_NONE.
+*
+* 	ACCOUNT_DIRECTORY_ALREADY_EXISTS - if the email already has an account.
+*
+* 	ACCOUNT_DIRECTORY_OUT_OF_MEMORY - if allocations failed.
+*
+* 	ACCOUNT_DIRECTORY_SUCCESS - in case of success.
+*/
+AccountDirectoryResult accountDirectoryAdd(AccountDirectory directory,
+	Email email, AccountRole role, void* record);
+
+/**
+* accountDirectoryRemove: removes the account of an email.
+*
+* @param directory the directory.
+* @param email the account email.
+*
+* @return
+*
+* 	ACCOUNT_DIRECTORY_NULL_PARAMETERS - if directory or email are NULL.
+*
+* 	ACCOUNT_DIRECTORY_NOT_EXISTS - if the email has no account.
+*
+* 	ACCOUNT_DIRECTORY_SUCCESS - in case of success.
+*/
+AccountDirectoryResult accountDirectoryRemove(AccountDirectory directory,
+	Email email);
+
+/**
+* accountDirectoryFind: finds the account of an email.
+*
+* @param directory the directory.
+* @param email the email to find.
+* @param record pointer to save the account record in, or NULL. NULL is
+* 	saved if the email has no account.
+*
+* @return
+* 	ACCOUNT_NONE if directory or email are NULL or the email has no
+* 	account; else returns the account role.
+*/
+AccountRole accountDirectoryFind(AccountDirectory directory, Email email,
+	void** record);
+
+/**
+* accountDirectoryGetSize: returns the amount of accounts in the directory.
+*
+* @param directory the directory.
+*
+* @return
+* 	0 if directory is NULL; else returns the amount of accounts.
+*/
+int accountDirectoryGetSize(AccountDirectory directory);
+
+#endif /* SRC_ACCOUNTDIRECTORY_H_ */
@@ -0,0 +1,148 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "accountDirectory.h"
+#include "clientsManager.h"
+#include "agentsManager.h"
+#include "email.h"
+#include "test_utilities.h"
+
+static bool testAccountDirectoryCreate();
+static bool testAccountDirectoryAddFindRemove();
+static bool testAccountDirectoryManagers();
+int RunAccountDirectoryTest();
+
+//int main() {
+int RunAccountDirectoryTest() {
+	RUN_TEST(testAccountDirectoryCreate);
+	RUN_TEST(testAccountDirectoryAddFindRemove);
+	RUN_TEST(testAccountDirectoryManagers);
+	return 0;
+}
+
+/**
+ * Test create method
+ */
+static bool testAccountDirectoryCreate() {
+	AccountDirectory directory = accountDirectoryCreate();
+	ASSERT_TEST(directory != NULL);
+	ASSERT_TEST(accountDirectoryGetSize(directory) == 0);
+	ASSERT_TEST(accountDirectoryGetSize(NULL) == 0);
+	ASSERT_TEST(accountDirectoryFind(NULL, NULL, NULL) == ACCOUNT_NONE);
+	accountDirectoryDestroy(directory);
+	accountDirectoryDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test add, find and remove methods
+ */
+static bool testAccountDirectoryAddFindRemove() {
+	AccountDirectory directory = accountDirectoryCreate();
+	Email client = NULL, agent = NULL, other = NULL;
+	emailCreate("client@mail", &client);
+	emailCreate("agent@mail", &agent);
+	emailCreate("other@mail", &other);
+	int client_record = 1, agent_record = 2;
+	void* record = NULL;
+
+	ASSERT_TEST(accountDirectoryAdd(NULL, client, ACCOUNT_CLIENT,
+		&client_record) == ACCOUNT_DIRECTORY_NULL_PARAMETERS);
+	ASSERT_TEST(accountDirectoryAdd(directory, client, ACCOUNT_NONE,
+		&client_record) == ACCOUNT_DIRECTORY_NULL_PARAMETERS);
+	ASSERT_TEST(accountDirectoryAdd(directory, client, ACCOUNT_CLIENT,
+		NULL) == ACCOUNT_DIRECTORY_NULL_PARAMETERS);
+	ASSERT_TEST(accountDirectoryAdd(directory, client, ACCOUNT_CLIENT,
+		&client_record) == ACCOUNT_DIRECTORY_SUCCESS);
+	ASSERT_TEST(accountDirectoryAdd(directory, agent, ACCOUNT_AGENT,
+		&agent_record) == ACCOUNT_DIRECTORY_SUCCESS);
+	ASSERT_TEST(accountDirectoryAdd(directory, client, ACCOUNT_AGENT,
+		&agent_record) == ACCOUNT_DIRECTORY_ALREADY_EXISTS);
+	ASSERT_TEST(accountDirectoryGetSize(directory) == 2);
+
+	ASSERT_TEST(accountDirectoryFind(directory, client, &record) ==
+		ACCOUNT_CLIENT);
+	ASSERT_TEST(record == &client_record);
+	ASSERT_TEST(accountDirectoryFind(directory, agent, &record) ==
+		ACCOUNT_AGENT);
+	ASSERT_TEST(record == &agent_record);
+	ASSERT_TEST(accountDirectoryFind(directory, other, &record) ==
+		ACCOUNT_NONE);
+	ASSERT_TEST(record == NULL);
+
+	ASSERT_TEST(accountDirectoryRemove(directory, NULL) ==
+		ACCOUNT_DIRECTORY_NULL_PARAMETERS);
+	ASSERT_TEST(accountDirectoryRemove(directory, other) ==
+		ACCOUNT_DIRECTORY_NOT_EXISTS);
+	ASSERT_TEST(accountDirectoryRemove(directory, client) ==
+		ACCOUNT_DIRECTORY_SUCCESS);
+	ASSERT_TEST(accountDirectoryRemove(directory, client) ==
+		ACCOUNT_DIRECTORY_NOT_EXISTS);
+	ASSERT_TEST(accountDirectoryFind(directory, client, NULL) ==
+		ACCOUNT_NONE);
+	ASSERT_TEST(accountDirectoryGetSize(directory) == 1);
+
+	/* the directory keeps its emails alive after their owners let go */
+	emailDestroy(agent);
+	Email same = NULL;
+	emailCreate("agent@mail", &same);
+	ASSERT_TEST(accountDirectoryFind(directory, same, &record) ==
+		ACCOUNT_AGENT);
+	ASSERT_TEST(record == &agent_record);
+
+	emailDestroy(same);
+	emailDestroy(client);
+	emailDestroy(other);
+	accountDirectoryDestroy(directory);
+	return true;
+}
+
+/**
+ * Test the managers keep the directory up to date
+ */
+static bool testAccountDirectoryManagers() {
+	AccountDirectory directory = accountDirectoryCreate();
+	ClientsManager clients = clientsManagerCreate();
+	AgentsManager agents = agentsManagerCreate();
+	clientsManagerSetDirectory(clients, directory);
+	agentsManagerSetDirectory(agents, directory);
+	Email client = NULL, agent = NULL;
+	emailCreate("client@mail", &client);
+	emailCreate("agent@mail", &agent);
+	void* record = NULL;
+
+	ASSERT_TEST(clientsManagerAdd(clients, client, 1, 1, 100) ==
+		CLIENT_MANAGER_SUCCESS);
+	ASSERT_TEST(agentsManagerAdd(agents, agent, "company", 10) ==
+		AGENT_MANAGER_SUCCESS);
+	ASSERT_TEST(accountDirectoryFind(directory, client, &record) ==
+		ACCOUNT_CLIENT);
+	ASSERT_TEST(clientGetTotalPayments((Client)record) == 0);
+	ASSERT_TEST(accountDirectoryFind(directory, agent, &record) ==
+		ACCOUNT_AGENT);
+	ASSERT_TEST(agentGetTax((Agent)record) == 10);
+
+	/* an email has a single account, whichever manager adds it */
+	ASSERT_TEST(agentsManagerAdd(agents, client, "company", 10) ==
+		AGENT_MANAGER_ALREADY_EXISTS);
+	ASSERT_TEST(!agentsManagerAgentExists(agents, client));
+	ASSERT_TEST(accountDirectoryGetSize(directory) == 2);
+
+	ASSERT_TEST(clientsManagerRemove(clients, client) ==
+		CLIENT_MANAGER_SUCCESS);
+	ASSERT_TEST(accountDirectoryFind(directory, client, NULL) ==
+		ACCOUNT_NONE);
+	ASSERT_TEST(agentsManagerAdd(agents, client, "company", 20) ==
+		AGENT_MANAGER_SUCCESS);
+	ASSERT_TEST(accountDirectoryFind(directory, client, NULL) ==
+		ACCOUNT_AGENT);
+
+	agentsManagerDestroy(agents);
+	ASSERT_TEST(accountDirectoryGetSize(directory) == 0);
+	emailDestroy(client);
+	emailDestroy(agent);
+	clientsManagerDestroy(clients);
+	accountDirectoryDestroy(directory);
+	return true;
+}
@@ -8,16 +8,40 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
+#include <limits.h>
 #include "agent.h"
 #include "apartment_service.h"
 #include "utilities.h"
 #include "map.h"
+#include "snapshot.h"
 
+/*
+ * The medians of an apartment service, cached for the rank of its agent.
+ * is_empty is set for a service with no apartments, which has no medians.
+ */
+typedef struct ServiceMedians_t {
+	bool is_empty;
+	int area;
+	int price;
+} *ServiceMedians;
+
+/*
+ * serviceMedians caches the medians of the apartment services by their
+ * names, and the rank components below are summed from it. a service is
+ * dropped from the cache, and the rank components marked invalid, only when
+ * its apartments or the services themselves change, so the medians of the
+ * other services are not computed again.
+ */
 struct Agent_t {
 	Email email;
 	char* companyName;
 	int taxPercentge;
 	Map apartmentServices;
+	Map serviceMedians;
+	bool is_rank_valid;
+	int ranked_services_count;
+	int median_area_sum;
+	int median_price_sum;
 };
 
 static MapDataElement GetDataCopy(constMapDataElement data);
@@ -25,13 +49,26 @@ static MapKeyElement GetKeyCopy(constMapKeyElement key);
 static void FreeData(MapDataElement data);
 static void FreeKey(MapKeyElement key);
 static int CompareKeys(constMapKeyElement first, constMapKeyElement second);
+static unsigned int HashKey(constMapKeyElement key);
+static MapDataElement GetMediansCopy(constMapDataElement data);
+static void FreeMedians(MapDataElement data);
 
-static AgentResult squresCreate(int width, int height, char* matrix,
-		SquareType*** result);
 static void squresDestroy(SquareType** squres, int length);
 static AgentResult ConvertServiceResult(ApartmentServiceResult result);
 static bool isTaxValid( int taxPercentage );
 static bool isPriceValid( int price );
+static SnapshotResult saveService(char* name, ApartmentService service,
+		SnapshotWriter writer);
+static SnapshotResult saveApartment(Apartment apartment, int id,
+		SnapshotWriter writer);
+static SnapshotResult loadApartment(ApartmentService service,
+		SnapshotReader reader);
+static SnapshotResult unpackSquares(const unsigned char* bits, int length,
+		int width, SquareType*** result);
+static void invalidateRank(Agent agent, char* service_name);
+static bool getServiceMedians(Agent agent, char* service_name,
+		ApartmentService service, struct ServiceMedians_t* medians);
+static void updateRankComponents(Agent agent);
 
 /* isValid: The function checks whether the given apartment numerical
  * 					param is valid
@@ -113,14 +150,20 @@ int agentGetTax( Agent agent ){
  		free(agent);
  		return AGENT_OUT_OF_MEMORY;
  	}
+ 	agent->apartmentServices = NULL;
+	agent->serviceMedians = NULL;
+	agent->is_rank_valid = false;
  	agent->companyName = duplicateString(companyName);
  	if ( agent->companyName == NULL ) {
  		agentDestroy(agent);
  		return AGENT_OUT_OF_MEMORY;
  	}
- 	agent->apartmentServices = mapCreate(GetDataCopy, GetKeyCopy,
- 			FreeData, FreeKey, CompareKeys);
- 	if( agent->apartmentServices == NULL){
+ 	agent->apartmentServices = mapCreateHashed(GetDataCopy, GetKeyCopy,
+ 			FreeData, FreeKey, CompareKeys, HashKey);
+ 	agent->serviceMedians = mapCreateHashed(GetMediansCopy, GetKeyCopy,
+ 			FreeMedians, FreeKey, CompareKeys, HashKey);
+ 	if( (agent->apartmentServices == NULL) ||
+ 			(agent->serviceMedians == NULL) ){
  		agentDestroy(agent);
  		return AGENT_OUT_OF_MEMORY;
  	}
@@ -144,6 +187,7 @@ int agentGetTax( Agent agent ){
  			mapDestroy( agent->apartmentServices );
  			agent->apartmentServices = NULL;
  		}
+ 		mapDestroy( agent->serviceMedians );
  		free(agent);
  	}
  }
@@ -185,10 +229,13 @@ AgentResult agentAddService(Agent agent, char* serviceName,
 		(max_apartments > 100)) return AGENT_INVALID_PARAMETERS;
 	ApartmentService service = serviceCreate(max_apartments);
 	if (service == NULL) return AGENT_OUT_OF_MEMORY;
-	MapResult result = mapPut(agent->apartmentServices,
-			(constMapKeyElement)serviceName, (constMapDataElement)service);
-	serviceDestroy(service);
-	if (result != MAP_SUCCESS) return AGENT_OUT_OF_MEMORY;
+	MapResult result = mapPutTake(agent->apartmentServices,
+			(constMapKeyElement)serviceName, (MapDataElement)service);
+	if (result != MAP_SUCCESS) {
+		serviceDestroy(service);
+		return AGENT_OUT_OF_MEMORY;
+	}
+	invalidateRank(agent, serviceName);
 	return AGENT_SUCCESS;
 }
 
@@ -213,6 +260,7 @@ AgentResult agentRemoveService( Agent agent, char* service_name ){
 		return AGENT_INVALID_PARAMETERS;
 	if ( result == MAP_ITEM_DOES_NOT_EXIST )
 		return AGENT_APARTMENT_SERVICE_NOT_EXISTS;
+	invalidateRank(agent, service_name);
 	return AGENT_SUCCESS;
 }
 
@@ -239,66 +287,19 @@ AgentResult agentAddApartmentToService(Agent agent, char* service_name, int id,
 		(strlen(matrix) != (width * height))) return AGENT_INVALID_PARAMETERS;
 	ApartmentService service = agentGetService(agent, service_name);
 	if (service == NULL) return AGENT_APARTMENT_SERVICE_NOT_EXISTS;
-	SquareType** squares = NULL;
-	AgentResult squre_result = squresCreate(width, height, matrix, &squares);
-	if (squre_result != AGENT_SUCCESS) return squre_result;
-	Apartment apartment = apartmentCreate(squares, height, width, price);
-	if (apartment == NULL) {
-		squresDestroy(squares, height);
-		return AGENT_OUT_OF_MEMORY;
-	}
+	char squares_chars[] = {WALL_CHAR, EMPTY_CHAR, '\0'};
+	if (strspn(matrix, squares_chars) != strlen(matrix))
+		return AGENT_INVALID_PARAMETERS;
+	Apartment apartment = apartmentCreateFromString(matrix, height, width,
+		price, WALL_CHAR, EMPTY_CHAR);
+	if (apartment == NULL) return AGENT_OUT_OF_MEMORY;
 	ApartmentServiceResult result = serviceAddApartment(service, apartment, id);
 	apartmentDestroy(apartment);
-	squresDestroy(squares, height);
+	if (result == APARTMENT_SERVICE_SUCCESS)
+		invalidateRank(agent, service_name);
 	return ConvertServiceResult(result);
 }
 
-/**
-* squresCreate: creates a SquareType metrix in the given width and hight,
-* 	according to a given string built from 'e's and 'w's, e stands for empty
-* 	and w stands from wall
-*
-* @param width   	the matrix width
-* @param height  	the matrix height
-* @param matrix		matrix string
-* @param result 	pointer to result
-*
-* @return
-*	AGENT_INVALID_PARAMETERS   if any of parameters are NULL
-*	AGENT_APARTMENT_NOT_EXISTS if apartment not found in the service
-* 	AGENT_APARTMENT_SERVICE_NOT_EXISTS service with the given name doesn't exist
-*	AGENT_OUT_OF_MEMORY      if allocation failed
-*	AGENT_SUCCESS            if apartment successfully added
-*/
-static AgentResult squresCreate(int width, int height, char* matrix,
-	SquareType*** result) {
-	SquareType** squre = malloc (sizeof(*squre) * height);
-	if (squre == NULL) return AGENT_OUT_OF_MEMORY;
-	for (int row = 0; row < height; row++) {
-		squre[row] = NULL;
-	}
-	for (int row = 0; row < height; row++) {
-		squre[row] = malloc (sizeof(squre) * width);
-		if (squre[row] == NULL) {
-			squresDestroy(squre, height);
-			return AGENT_OUT_OF_MEMORY;
-		} else {
-			for (int col = 0; col < width; col++) {
-				if (matrix[(row * width) + col] == WALL_CHAR) {
-					squre[row][col] = WALL;
-				} else if (matrix[(row * width) + col] == EMPTY_CHAR) {
-					squre[row][col] = EMPTY;
-				} else {
-					squresDestroy(squre, height);
-					return AGENT_INVALID_PARAMETERS;
-				}
-			}
-		}
-	}
-	*result = squre;
-	return AGENT_SUCCESS;
-}
-
 /*
  * Destroys the given squre
  */
@@ -369,27 +370,17 @@ AgentResult agentRemoveApartmentFromService( Agent agent, int apartmentId,
 	ApartmentService service = agentGetService(agent, serviceName);
 	if (service == NULL)
 		return AGENT_APARTMENT_SERVICE_NOT_EXISTS;
-	Apartment apartment = NULL;
-	ApartmentServiceResult getResult = serviceGetById(service,
-			apartmentId, &apartment);
-	if( getResult == APARTMENT_SERVICE_NULL_ARG ) {
-		apartmentDestroy(apartment);
-		return AGENT_INVALID_PARAMETERS;
-	}
-	if( getResult != APARTMENT_SERVICE_SUCCESS ) {
-		apartmentDestroy(apartment);
-		return AGENT_APARTMENT_NOT_EXISTS;
-	}
-	ApartmentServiceResult deleteResult = serviceDeleteApartment(service,
-		apartment);
-	apartmentDestroy(apartment);
+	ApartmentServiceResult deleteResult = serviceDeleteById(service,
+		apartmentId);
+	if (deleteResult == APARTMENT_SERVICE_SUCCESS)
+		invalidateRank(agent, serviceName);
 	return ConvertServiceResult(deleteResult);
 }
 
 static AgentResult findMatch(ApartmentService service, int rooms, int area,
 							int price, Agent agent, AgentDetails* details) {
 	ApartmentServiceResult result;
-	Apartment apartment;
+	Apartment apartment = NULL;
 	result = serviceSearch(service, area, rooms, price, &apartment);
 	apartmentDestroy(apartment);
 	if(result == APARTMENT_SERVICE_SUCCESS) {
@@ -438,7 +429,10 @@ AgentResult agentFindMatch(Agent agent, int rooms, int area,
 }
 
 /**
-* agentGetRank: calculates the rank of the agent according to a formula
+* agentGetRank: calculates the rank of the agent according to a formula.
+* the rank components are cached, and summed again only after the apartments
+* or services of the agent changed, from the cached medians of the services
+* which did not.
 *
 * @param agent 	the requested agent
 *
@@ -448,31 +442,68 @@ AgentResult agentFindMatch(Agent agent, int rooms, int area,
 */
 double agentGetRank(Agent agent) {
 	if( agent == NULL ) return AGENT_INVALID_PARAMETERS;
-	int apartments_count = 0, median_price = 0, median_area = 0,
-		area = 0, price;
-	char* name = mapGetFirst(agent->apartmentServices);
-	ApartmentService current = NULL;
-	if(name != NULL) current = mapGet(agent->apartmentServices, name);
-	while(current != NULL) {
-		if ((serviceAreaMedian(current, &area) == APARTMENT_SERVICE_SUCCESS) &&
-			(servicePriceMedian(current, &price) == APARTMENT_SERVICE_SUCCESS))
-		{
-			median_area += area;
-			median_price += price;
-			apartments_count++;
-		}
-		name = mapGetNext(agent->apartmentServices);
-		current = ((name != NULL) ?
-					mapGet(agent->apartmentServices, name) :
-					NULL);
+	if (!agent->is_rank_valid) updateRankComponents(agent);
+	int apartments_count = agent->ranked_services_count;
+	if (apartments_count == 0) return RANK_EMPTY;
+	int median_price = agent->median_price_sum / apartments_count;
+	int median_area = agent->median_area_sum / apartments_count;
+	return 1000000 * apartments_count + median_price + 100000 * median_area;
+}
+
+/*
+ * invalidateRank: drops the cached medians of a service whose apartments
+ * changed, or which was added or removed, and marks the rank components
+ * invalid.
+ */
+static void invalidateRank(Agent agent, char* service_name) {
+	mapRemove(agent->serviceMedians, service_name);
+	agent->is_rank_valid = false;
+}
+
+/*
+ * getServiceMedians: gets the medians of a service from the cache, or
+ * computes and caches them if they are not in it. returns false if they
+ * could not be cached.
+ */
+static bool getServiceMedians(Agent agent, char* service_name,
+		ApartmentService service, struct ServiceMedians_t* medians) {
+	ServiceMedians cached = mapGet(agent->serviceMedians, service_name);
+	if (cached != NULL) {
+		*medians = *cached;
+		return true;
 	}
-	if (apartments_count != 0) {
-		median_price /= apartments_count;
-		median_area /= apartments_count;
+	medians->area = 0;
+	medians->price = 0;
+	medians->is_empty =
+		(serviceAreaMedian(service, &medians->area) !=
+			APARTMENT_SERVICE_SUCCESS) ||
+		(servicePriceMedian(service, &medians->price) !=
+			APARTMENT_SERVICE_SUCCESS);
+	return mapPut(agent->serviceMedians, service_name, medians) ==
+		MAP_SUCCESS;
+}
+
+/*
+ * updateRankComponents: sums the medians of the services with apartments
+ * and counts them. the components stay invalid if medians could not be
+ * cached, so they are summed again next time.
+ */
+static void updateRankComponents(Agent agent) {
+	agent->is_rank_valid = true;
+	agent->ranked_services_count = 0;
+	agent->median_area_sum = 0;
+	agent->median_price_sum = 0;
+	MAP_FOREACH(char*, name, agent->apartmentServices) {
+		struct ServiceMedians_t medians;
+		if (!getServiceMedians(agent, name,
+				mapGet(agent->apartmentServices, name), &medians))
+			agent->is_rank_valid = false;
+		if (!medians.is_empty) {
+			agent->median_area_sum += medians.area;
+			agent->median_price_sum += medians.price;
+			agent->ranked_services_count++;
+		}
 	}
-	return apartments_count ?
-		(1000000 * apartments_count + median_price + 100000 * median_area)
-		: RANK_EMPTY;
 }
 
 /* isTaxValid: The function checks whether the tax is between 1 and 100
@@ -562,6 +593,82 @@ AgentResult agentGetApartmentDetails(Agent agent, char* service_name,
 	return AGENT_SUCCESS;
 }
 
+/**
+* agentSaveSnapshot: writes the apartment services of the agent to a
+* snapshot: the amount of services, then for each service its name,
+* capacity, the amount of apartments and the apartments in their order.
+* each apartment is its id, price, length, width and its squares, a bit
+* each row by row, set for a wall.
+*
+* @param agent	the agent
+* @param writer	the snapshot writer
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS if agent or writer are NULL.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocations failure.
+*
+* 	SNAPSHOT_WRITE_FAILED if writing failed.
+*
+*	SNAPSHOT_SUCCESS services written.
+*/
+SnapshotResult agentSaveSnapshot(Agent agent, SnapshotWriter writer) {
+	if ((agent == NULL) || (writer == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	if (!snapshotWriteInt(writer, mapGetSize(agent->apartmentServices)))
+		return SNAPSHOT_WRITE_FAILED;
+	MAP_FOREACH(char*, name, agent->apartmentServices) {
+		SnapshotResult result = saveService(name,
+			mapGet(agent->apartmentServices, name), writer);
+		if (result != SNAPSHOT_SUCCESS) return result;
+	}
+	return SNAPSHOT_SUCCESS;
+}
+
+/**
+* agentLoadSnapshot: reads apartment services written by agentSaveSnapshot
+* into the agent. the apartments are added as they are, without parsing
+* them from the command matrix format.
+*
+* @param agent	the agent, with no services
+* @param reader	the snapshot reader
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS if agent or reader are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT if the snapshot is truncated or not valid.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocations failure.
+*
+*	SNAPSHOT_SUCCESS services read.
+*/
+SnapshotResult agentLoadSnapshot(Agent agent, SnapshotReader reader) {
+	if ((agent == NULL) || (reader == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	int services_count = 0;
+	if (!snapshotReadInt(reader, &services_count) || (services_count < 0))
+		return SNAPSHOT_BAD_FORMAT;
+	for (int i = 0; i < services_count; i++) {
+		const char* name = NULL;
+		int capacity = 0, apartments_count = 0;
+		if (!snapshotReadString(reader, &name) ||
+			!snapshotReadInt(reader, &capacity) ||
+			!snapshotReadInt(reader, &apartments_count) ||
+			(apartments_count < 0)) return SNAPSHOT_BAD_FORMAT;
+		AgentResult result = agentAddService(agent, (char*)name, capacity);
+		if (result != AGENT_SUCCESS) {
+			return (result == AGENT_OUT_OF_MEMORY) ?
+				SNAPSHOT_OUT_OF_MEMORY : SNAPSHOT_BAD_FORMAT;
+		}
+		/* agentAddService dropped the cached medians of the service, so
+		 * its apartments can be loaded into it directly */
+		ApartmentService service = agentGetService(agent, (char*)name);
+		for (int j = 0; j < apartments_count; j++) {
+			SnapshotResult loaded = loadApartment(service, reader);
+			if (loaded != SNAPSHOT_SUCCESS) return loaded;
+		}
+	}
+	return SNAPSHOT_SUCCESS;
+}
+
 /** Function to be used for copying data elements into the map */
 static MapDataElement GetDataCopy(constMapDataElement data) {
 	ApartmentService new_service = NULL;
@@ -591,6 +698,23 @@ static int CompareKeys(constMapKeyElement first, constMapKeyElement second) {
 	return strcmp( first, second);
 }
 
+/** Function to be used for hashing key elements in the map */
+static unsigned int HashKey(constMapKeyElement key) {
+	return hashString(key);
+}
+
+/** Function to be used for copying medians into the medians map */
+static MapDataElement GetMediansCopy(constMapDataElement data) {
+	ServiceMedians copy = malloc(sizeof(*copy));
+	if (copy != NULL) *copy = *(const struct ServiceMedians_t*)data;
+	return copy;
+}
+
+/** Function to be used for freeing medians of the medians map */
+static void FreeMedians(MapDataElement data) {
+	free(data);
+}
+
 /* priceisValid: The function checks whether the price can be divided by 100
  *
  * @price  The price to check.
@@ -602,3 +726,100 @@ static bool isPriceValid( int price ){
 	return !(price%100);
 }
 
+/*
+ * saveService: writes an apartment service and its apartments.
+ */
+static SnapshotResult saveService(char* name, ApartmentService service,
+		SnapshotWriter writer) {
+	int count = serviceNumberOfApatments(service);
+	if (!snapshotWriteString(writer, name) ||
+		!snapshotWriteInt(writer, serviceGetCapacity(service)) ||
+		!snapshotWriteInt(writer, count)) return SNAPSHOT_WRITE_FAILED;
+	for (int i = 0; i < count; i++) {
+		Apartment apartment = NULL;
+		int id = 0;
+		if (serviceGetByIndex(service, i, &apartment, &id) !=
+			APARTMENT_SERVICE_SUCCESS) return SNAPSHOT_OUT_OF_MEMORY;
+		SnapshotResult result = saveApartment(apartment, id, writer);
+		apartmentDestroy(apartment);
+		if (result != SNAPSHOT_SUCCESS) return result;
+	}
+	return SNAPSHOT_SUCCESS;
+}
+
+/*
+ * saveApartment: writes an apartment, with its squares packed to bits.
+ */
+static SnapshotResult saveApartment(Apartment apartment, int id,
+		SnapshotWriter writer) {
+	int length = apartmentGetLength(apartment);
+	int width = apartmentGetWidth(apartment);
+	size_t size = ((size_t)length * width + 7) / 8;
+	unsigned char* bits = calloc(size > 0 ? size : 1, 1);
+	if (bits == NULL) return SNAPSHOT_OUT_OF_MEMORY;
+	for (int row = 0; row < length; row++) {
+		for (int col = 0; col < width; col++) {
+			SquareType square = EMPTY;
+			apartmentGetSquare(apartment, row, col, &square);
+			size_t bit = (size_t)row * width + col;
+			if (square == WALL) {
+				bits[bit / 8] |= (unsigned char)(1 << (bit % 8));
+			}
+		}
+	}
+	bool written = snapshotWriteInt(writer, id) &&
+		snapshotWriteInt(writer, apartmentGetPrice(apartment)) &&
+		snapshotWriteInt(writer, length) && snapshotWriteInt(writer, width) &&
+		snapshotWriteBytes(writer, bits, size);
+	free(bits);
+	return written ? SNAPSHOT_SUCCESS : SNAPSHOT_WRITE_FAILED;
+}
+
+/*
+ * loadApartment: reads an apartment written by saveApartment into a service.
+ */
+static SnapshotResult loadApartment(ApartmentService service,
+		SnapshotReader reader) {
+	int id = 0, price = 0, length = 0, width = 0;
+	if (!snapshotReadInt(reader, &id) || !snapshotReadInt(reader, &price) ||
+		!snapshotReadInt(reader, &length) || !snapshotReadInt(reader, &width)
+		|| (length <= 0) || (width <= 0) || (width > INT_MAX / length))
+		return SNAPSHOT_BAD_FORMAT;
+	const unsigned char* bits = NULL;
+	if (!snapshotReadBytes(reader, &bits, ((size_t)length * width + 7) / 8))
+		return SNAPSHOT_BAD_FORMAT;
+	SquareType** squares = NULL;
+	SnapshotResult result = unpackSquares(bits, length, width, &squares);
+	if (result != SNAPSHOT_SUCCESS) return result;
+	Apartment apartment = apartmentCreate(squares, length, width, price);
+	squresDestroy(squares, length);
+	if (apartment == NULL) return SNAPSHOT_BAD_FORMAT;
+	ApartmentServiceResult added = serviceAddApartment(service, apartment, id);
+	apartmentDestroy(apartment);
+	if (added == APARTMENT_SERVICE_OUT_OF_MEM) return SNAPSHOT_OUT_OF_MEMORY;
+	return (added == APARTMENT_SERVICE_SUCCESS) ? SNAPSHOT_SUCCESS :
+		SNAPSHOT_BAD_FORMAT;
+}
+
+/*
+ * unpackSquares: creates a SquareType matrix from squares packed to bits.
+ */
+static SnapshotResult unpackSquares(const unsigned char* bits, int length,
+		int width, SquareType*** result) {
+	SquareType** squares = malloc(sizeof(*squares) * length);
+	if (squares == NULL) return SNAPSHOT_OUT_OF_MEMORY;
+	for (int row = 0; row < length; row++) {
+		squares[row] = malloc(sizeof(**squares) * width);
+		if (squares[row] == NULL) {
+			squresDestroy(squares, row);
+			return SNAPSHOT_OUT_OF_MEMORY;
+		}
+		for (int col = 0; col < width; col++) {
+			size_t bit = (size_t)row * width + col;
+			squares[row][col] = (bits[bit / 8] & (1 << (bit % 8))) ? WALL :
+				EMPTY;
+		}
+	}
+	*result = squares;
+	return SNAPSHOT_SUCCESS;
+}
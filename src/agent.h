@@ -7,6 +7,7 @@
 #include "apartment_service.h"
 #include "agentDetails.h"
 #include "email.h"
+#include "snapshot.h"
 
 #define AT_SIGN '@'
 #define RANK_EMPTY -1
@@ -206,7 +207,10 @@ AgentResult agentFindMatch(Agent agent, int rooms, int area,
 							int price, AgentDetails* details);
 
 /**
-* agentGetRank: calculates the rank of the agent according to a formula
+* agentGetRank: calculates the rank of the agent according to a formula.
+* the rank components are cached, and summed again only after the apartments
+* or services of the agent changed, from the cached medians of the services
+* which did not.
 *
 * @param agent 	the requested agent
 *
@@ -240,4 +244,44 @@ double agentGetRank( Agent agent );
 AgentResult agentGetApartmentDetails(Agent agent, char* service_name,
 	int id, int *apartment_area, int *apartment_rooms, int *apartment_price);
 
+/**
+* agentSaveSnapshot: writes the apartment services of the agent to a
+* snapshot: the amount of services, then for each service its name,
+* capacity, the amount of apartments and the apartments in their order.
+* each apartment is its id, price, length, width and its squares, a bit
+* each row by row, set for a wall.
+*
+* @param agent	the agent
+* @param writer	the snapshot writer
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS if agent or writer are NULL.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocations failure.
+*
+* 	SNAPSHOT_WRITE_FAILED if writing failed.
+*
+*	SNAPSHOT_SUCCESS services written.
+*/
+SnapshotResult agentSaveSnapshot(Agent agent, SnapshotWriter writer);
+
+/**
+* agentLoadSnapshot: reads apartment services written by agentSaveSnapshot
+* into the agent. the apartments are added as they are, without parsing
+* them from the command matrix format.
+*
+* @param agent	the agent, with no services
+* @param reader	the snapshot reader
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS if agent or reader are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT if the snapshot is truncated or not valid.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocations failure.
+*
+*	SNAPSHOT_SUCCESS services read.
+*/
+SnapshotResult agentLoadSnapshot(Agent agent, SnapshotReader reader);
+
 #endif /* SRC_AGENT_H_ */
@@ -18,6 +18,7 @@ struct agentDetails_t {
 	Email email;
 	char* companyName;
 	double rank;
+	SlabAllocator allocator;
 };
 
 /**
@@ -35,21 +36,47 @@ struct agentDetails_t {
 * 	or if allocation failed.
 */
 AgentDetails agentDetailsCreate(Email email, char* company_name, double rank) {
+	return agentDetailsCreateWithAllocator(NULL, email, company_name, rank);
+}
+
+/**
+* agentDetailsCreateWithAllocator: creates a new AgentDetails instance from
+* an allocator.
+*
+* Creates a new AgentDetails like agentDetailsCreate, with the details and
+* the company name in blocks of the given allocator. The details and their
+* copies are freed back to the allocator when destroyed.
+*
+* @param allocator the allocator, or NULL to allocate with malloc.
+* @param email agents email.
+* @param companyName the name of the agents company
+*
+* @return
+* 	A new AgentDetails element or NULL if :email is NULL, companyName is null,
+* 	or if allocation failed.
+*/
+AgentDetails agentDetailsCreateWithAllocator(SlabAllocator allocator,
+		Email email, char* company_name, double rank) {
 	if (email == NULL || company_name == NULL)
 		return NULL;
-	AgentDetails agent_details = malloc(sizeof(*agent_details));
+	AgentDetails agent_details = slabAllocatorAllocate(allocator,
+		SLAB_AGENT_DETAILS, sizeof(*agent_details));
 	if (agent_details == NULL)
 		return NULL;
+	agent_details->allocator = allocator;
 	agent_details->rank = rank;
 	agent_details->email = NULL;
 	if (emailCopy(email, &agent_details->email) == EMAIL_OUT_OF_MEMORY) {
-		free(agent_details);
+		slabAllocatorFree(allocator, SLAB_AGENT_DETAILS, agent_details,
+			sizeof(*agent_details));
 		return NULL;
 	}
-	agent_details->companyName = duplicateString(company_name);
+	agent_details->companyName = slabAllocatorDuplicateString(allocator,
+		company_name);
 	if (agent_details->companyName == NULL) {
 		emailDestroy(agent_details->email);
-		free(agent_details);
+		slabAllocatorFree(allocator, SLAB_AGENT_DETAILS, agent_details,
+			sizeof(*agent_details));
 		return NULL;
 	}
 	return agent_details;
@@ -70,7 +97,8 @@ AgentDetails agentDetailsCreate(Email email, char* company_name, double rank) {
 */
 AgentDetails agentDetailsCopy(AgentDetails agent_details) {
 	if (agent_details == NULL) return NULL;
-		return agentDetailsCreate(agent_details->email,
+		return agentDetailsCreateWithAllocator(agent_details->allocator,
+								  agent_details->email,
 								  agent_details->companyName,
 								  agent_details->rank);
 }
@@ -86,8 +114,10 @@ AgentDetails agentDetailsCopy(AgentDetails agent_details) {
 void agentDetailsDestroy(AgentDetails agent_details) {
 	if (agent_details != NULL) {
 		emailDestroy(agent_details->email);
-		free(agent_details->companyName);
-		free(agent_details);
+		slabAllocatorFreeString(agent_details->allocator,
+			agent_details->companyName);
+		slabAllocatorFree(agent_details->allocator, SLAB_AGENT_DETAILS,
+			agent_details, sizeof(*agent_details));
 	}
 }
 
@@ -9,6 +9,7 @@
 #define SRC_AGENTDETAILS_H_
 
 #include "email.h"
+#include "slabAllocator.h"
 
 typedef struct agentDetails_t *AgentDetails;
 
@@ -28,6 +29,25 @@ typedef struct agentDetails_t *AgentDetails;
 */
 AgentDetails agentDetailsCreate(Email email, char* companyName, double rank );
 
+/**
+* agentDetailsCreateWithAllocator: creates a new AgentDetails instance from
+* an allocator.
+*
+* Creates a new AgentDetails like agentDetailsCreate, with the details and
+* the company name in blocks of the given allocator. The details and their
+* copies are freed back to the allocator when destroyed.
+*
+* @param allocator the allocator, or NULL to allocate with malloc.
+* @param email agents email.
+* @param companyName the name of the agents company
+*
+* @return
+* 	A new AgentDetails element or NULL if :email is NULL, companyName is null,
+* 	or if allocation failed.
+*/
+AgentDetails agentDetailsCreateWithAllocator(SlabAllocator allocator,
+		Email email, char* companyName, double rank);
+
 /**
 * agentDetailsCopy: Allocates a new AgentDetails instance,
 * identical to the old AgentDetails instance
@@ -18,6 +18,7 @@ static bool testAgentRemoveApartmentFromService();
 static bool testAgentFindMatch();
 static bool testAgentGetApartmentDetails();
 static bool testAgentCopy();
+static bool testAgentGetRank();
 
 int RunAgentTest() {
 	RUN_TEST(testAgentCreate);
@@ -29,9 +30,41 @@ int RunAgentTest() {
 	RUN_TEST(testAgentFindMatch);
 	RUN_TEST(testAgentGetApartmentDetails);
 	RUN_TEST(testAgentCopy);
+	RUN_TEST(testAgentGetRank);
 	return 0;
 }
 
+static bool testAgentGetRank(){
+	Email email = NULL;
+	emailCreate("baba@ganosh", &email);
+	Agent agent = NULL;
+	agentCreate(email,"tania", 5, &agent);
+	agentAddService(agent,"serveMe", 3);
+	ASSERT_TEST(agentGetRank(agent) == RANK_EMPTY);
+	agentAddApartmentToService(agent, "serveMe", 1, 100, 1, 2, "we");
+	ASSERT_TEST(agentGetRank(agent) == 1100100);
+	ASSERT_TEST(agentGetRank(agent) == 1100100);
+	agentAddApartmentToService(agent, "serveMe", 2, 300, 2, 2, "eeee");
+	agentAddApartmentToService(agent, "serveMe", 3, 300, 2, 2, "eeee");
+	ASSERT_TEST(agentGetRank(agent) == 1000000 + 300 + 100000 * 4);
+	agentAddService(agent,"serve2", 1);
+	agentAddApartmentToService(agent, "serve2", 1, 500, 1, 1, "e");
+	ASSERT_TEST(agentGetRank(agent) == 2000000 + 400 + 100000 * 2);
+	ASSERT_TEST(agentAddApartmentToService(agent, "serve2", 2, 500, 1, 1,
+		"e") == AGENT_APARTMENT_SERVICE_FULL);
+	ASSERT_TEST(agentGetRank(agent) == 2000000 + 400 + 100000 * 2);
+	agentRemoveApartmentFromService(agent, 2, "serveMe");
+	agentRemoveApartmentFromService(agent, 3, "serveMe");
+	ASSERT_TEST(agentGetRank(agent) == 2000000 + 300 + 100000 * 1);
+	agentRemoveService(agent, "serve2");
+	ASSERT_TEST(agentGetRank(agent) == 1100100);
+	agentRemoveApartmentFromService(agent, 1, "serveMe");
+	ASSERT_TEST(agentGetRank(agent) == RANK_EMPTY);
+	agentDestroy(agent);
+	emailDestroy(email);
+	return true;
+}
+
 static bool testAgentCreate(){
 	Email email = NULL;
 	emailCreate("baba@ganosh", &email);
@@ -13,10 +13,20 @@
 #include "agentDetails.h"
 #include "map.h"
 #include "list.h"
+#include "set.h"
 
+/*
+ * rankedAgents holds the agents of agentsMap who have a rank, ordered by
+ * their rank from the highest, then by their emails. it does not own them,
+ * and an agent is taken out of it before its apartments change, as its rank
+ * is its key.
+ */
 struct agentsManager_t {
 
 	Map agentsMap;
+	Set rankedAgents;
+	AccountDirectory directory;
+	SlabAllocator allocator;
 };
 
 static Agent agentsManagerGetAgent(AgentsManager manager, Email email);
@@ -25,13 +35,22 @@ static MapKeyElement GetKeyCopy(constMapKeyElement key);
 static void FreeData(MapDataElement data);
 static void FreeKey(MapKeyElement key);
 static int CompareKeys(constMapKeyElement first, constMapKeyElement second);
+static unsigned int HashKey(constMapKeyElement key);
 static void freeListElement(ListElement element);
 static ListElement copyListElement(ListElement element);
-static int compareListElements(ListElement first, ListElement second);
+static SetElement copyRankedAgent(SetElement element);
+static void freeRankedAgent(SetElement element);
+static int compareRankedAgents(SetElement first, SetElement second);
+static void unrankAgent(AgentsManager manager, Agent agent);
+static AgentsManagerResult rankAgent(AgentsManager manager, Agent agent,
+	AgentsManagerResult result);
+static Email getRankedAgent(Agent agent, char** company_name);
 static AgentsManagerResult convertAgentResult(AgentResult value);
 static bool isPriceValid( int price );
 static bool isValid( int param );
-static void reduceListToCount( List list, int count );
+static SnapshotResult loadAgent(AgentsManager manager,
+	SnapshotReader reader);
+static AgentsManagerResult registerAgent(AgentsManager manager, Email email);
 
 /**
 * Allocates a new AgentsManager.
@@ -41,15 +60,25 @@ static void reduceListToCount( List list, int count );
 * 	A new AgentsManager in case of success.
 */
 AgentsManager agentsManagerCreate(){
-	Map agents = mapCreate(GetDataCopy, GetKeyCopy, FreeData, FreeKey,
-		CompareKeys);
+	Map agents = mapCreateHashed(GetDataCopy, GetKeyCopy, FreeData, FreeKey,
+		CompareKeys, HashKey);
 	if (agents == NULL) return NULL;
+	Set ranked_agents = setCreate(copyRankedAgent, freeRankedAgent,
+		compareRankedAgents);
+	if (ranked_agents == NULL) {
+		mapDestroy(agents);
+		return NULL;
+	}
 	AgentsManager manager = malloc(sizeof(*manager));
 	if (manager == NULL) {
-		free(agents);
+		setDestroy(ranked_agents);
+		mapDestroy(agents);
 		return NULL;
 	} else {
 		manager->agentsMap = agents;
+		manager->rankedAgents = ranked_agents;
+		manager->directory = NULL;
+		manager->allocator = NULL;
 		return manager;
 	}
 }
@@ -64,11 +93,44 @@ AgentsManager agentsManagerCreate(){
 void agentsManagerDestroy(AgentsManager manager){
 
 	if (manager != NULL) {
+		if (manager->directory != NULL) {
+			MAP_FOREACH(Email, email, manager->agentsMap) {
+				accountDirectoryRemove(manager->directory, email);
+			}
+		}
+		setDestroy(manager->rankedAgents);
 		mapDestroy(manager->agentsMap);
 		free(manager);
 	}
 }
 
+/**
+* agentsManagerSetDirectory: sets the account directory the manager keeps
+* its agents in. agents are added to and removed from the directory with
+* the manager, so it is set while the manager is empty.
+*
+* @param manager Target Agents Manager.
+* @param directory the directory, or NULL for none. it must outlive the
+* 	manager.
+*/
+void agentsManagerSetDirectory(AgentsManager manager,
+	AccountDirectory directory) {
+	if (manager != NULL) manager->directory = directory;
+}
+
+/**
+* agentsManagerSetAllocator: sets the allocator the manager creates the
+* details of the significant agents lists from.
+*
+* @param manager Target Agents Manager.
+* @param allocator the allocator, or NULL to use malloc. it must outlive the
+* 	manager and the lists it returns.
+*/
+void agentsManagerSetAllocator(AgentsManager manager,
+	SlabAllocator allocator) {
+	if (manager != NULL) manager->allocator = allocator;
+}
+
 /**
 * agentsManagerAddAgent: adds the new Agent to the collection.
 *
@@ -102,10 +164,12 @@ AgentsManagerResult agentsManagerAdd(AgentsManager manager, Email email,
 		agentDestroy(agent);
 		return AGENT_MANAGER_ALREADY_EXISTS;
 	}
-	MapResult map_result = mapPut(manager->agentsMap, email, agent);
-	agentDestroy(agent);
-	if (map_result != MAP_SUCCESS) return AGENT_MANAGER_OUT_OF_MEMORY;
-	return AGENT_MANAGER_SUCCESS;
+	MapResult map_result = mapPutTake(manager->agentsMap, email, agent);
+	if (map_result != MAP_SUCCESS) {
+		agentDestroy(agent);
+		return AGENT_MANAGER_OUT_OF_MEMORY;
+	}
+	return registerAgent(manager, email);
 }
 
 /**
@@ -124,8 +188,11 @@ AgentsManagerResult agentsManagerRemove(AgentsManager manager, Email email){
 
 	if( manager == NULL || email == NULL )
 		return AGENT_MANAGER_INVALID_PARAMETERS;
-	if( agentsManagerGetAgent( manager, email) == NULL )
+	Agent agent = agentsManagerGetAgent(manager, email);
+	if( agent == NULL )
 		return AGENT_MANAGER_AGENT_NOT_EXISTS;
+	unrankAgent(manager, agent);
+	accountDirectoryRemove(manager->directory, email);
 	mapRemove( manager->agentsMap, (constMapKeyElement)email);
 	return AGENT_MANAGER_SUCCESS;
 }
@@ -183,10 +250,10 @@ AgentsManagerResult agentsManagerAddApartmentService(AgentsManager manager,
 		return AGENT_MANAGER_AGENT_NOT_EXISTS;
 	if(agentGetService(agent, serviceName))
 		return AGENT_MANAGER_ALREADY_EXISTS;
-	if (agentAddService(agent, serviceName, max_apartments) != AGENT_SUCCESS)
-		return AGENT_MANAGER_OUT_OF_MEMORY;
-	else
-		return AGENT_MANAGER_SUCCESS;
+	unrankAgent(manager, agent);
+	AgentResult result = agentAddService(agent, serviceName, max_apartments);
+	return rankAgent(manager, agent, (result != AGENT_SUCCESS) ?
+		AGENT_MANAGER_OUT_OF_MEMORY : AGENT_MANAGER_SUCCESS);
 }
 
 /**
@@ -211,15 +278,16 @@ AgentsManagerResult agentsManagerRemoveApartmentService(AgentsManager manager,
 		if( agent == NULL )
 			return AGENT_MANAGER_AGENT_NOT_EXISTS;
 
+	unrankAgent(manager, agent);
 	AgentResult result = agentRemoveService( agent, serviceName);
 
 	if( result == AGENT_INVALID_PARAMETERS )
-		return AGENT_MANAGER_INVALID_PARAMETERS;
+		return rankAgent(manager, agent, AGENT_MANAGER_INVALID_PARAMETERS);
 
 	if( result == AGENT_APARTMENT_SERVICE_NOT_EXISTS )
-		return AGENT_MANAGER_SERVICE_NOT_EXISTS;
+		return rankAgent(manager, agent, AGENT_MANAGER_SERVICE_NOT_EXISTS);
 
-	return AGENT_MANAGER_SUCCESS;
+	return rankAgent(manager, agent, AGENT_MANAGER_SUCCESS);
 }
 
 
@@ -252,11 +320,12 @@ AgentsManagerResult agentsManagerAddApartmentToService(AgentsManager manager,
 		(id < 0)) return AGENT_MANAGER_INVALID_PARAMETERS;
 	Agent agent = agentsManagerGetAgent(manager, email);
 	if(agent == NULL) return AGENT_MANAGER_AGENT_NOT_EXISTS;
+	unrankAgent(manager, agent);
 	AgentResult result = agentAddApartmentToService(agent, service_name, id,
 			price, width, height, matrix);
-	return convertAgentResult(result);
+	return rankAgent(manager, agent, convertAgentResult(result));
 }
-
+
 static AgentsManagerResult convertAgentResult(AgentResult value) {
 	AgentsManagerResult result;
 	switch(value) {
@@ -265,7 +334,7 @@ static AgentsManagerResult convertAgentResult(AgentResult value) {
 			break;
 		}
 		case AGENT_APARTMENT_SERVICE_NOT_EXISTS : {
-			result = AGENT_MANAGER_SERVICE_NOT_EXISTS;
+			result = AGENT_MANAGER_SERVICE_NOT_EXISTS;
 			break;
 		}
 		case AGENT_OUT_OF_MEMORY : {
@@ -317,9 +386,10 @@ AgentsManagerResult agentsManagerRemoveApartmentFromService(
 	if( agent == NULL )
 		return AGENT_MANAGER_AGENT_NOT_EXISTS;
 
+	unrankAgent(manager, agent);
 	AgentResult result = agentRemoveApartmentFromService(
 											agent, apartmentId, serviceName );
-	return convertAgentResult( result );
+	return rankAgent(manager, agent, convertAgentResult( result ));
 }
 
 static bool findMatch(Agent agent, int area, int rooms, int price,
@@ -332,14 +402,13 @@ static bool findMatch(Agent agent, int area, int rooms, int price,
 		listDestroy(agents_list);
 		return false;
 	} else if(result == AGENT_SUCCESS) {
-		ListResult lr =  listInsertLast(agents_list,
+		ListResult lr =  listInsertLastTake(agents_list,
 				(ListElement)(curr_details));
 		if( lr == LIST_OUT_OF_MEMORY) {
 			agentDetailsDestroy(curr_details);
 			listDestroy(agents_list);
 			return false;
 		}
-		agentDetailsDestroy(curr_details);
 	}
 	return true;
 }
@@ -402,29 +471,35 @@ AgentsManagerResult agentManagerFindMatch(AgentsManager manager, int min_rooms,
 bool agentsManagerAgentExists(AgentsManager manager, Email email){
 	if ((manager == NULL) || (email == NULL)) return false;
 	return mapContains(manager->agentsMap, email);
-}
+}
 
+/* agentsManagerIsEmpty: The function checks whether no agent is registered
+ *
+ * @param manager Target agent Manager to check.
+ *
+ * * @return
+ * true if manager is NULL or has no agents; else returns false.
+ */
+bool agentsManagerIsEmpty(AgentsManager manager){
+	return (manager == NULL) || (mapGetSize(manager->agentsMap) == 0);
+}
 
-static bool addRankedAgentToList(Agent curr_agent, Email curr_email,
-		List agents_list ){
 
-	double rank = agentGetRank(curr_agent);
-	AgentDetails curr_details;
+static bool addRankedAgentToList(Agent curr_agent, List agents_list,
+		SlabAllocator allocator){
 
-	if(rank != RANK_EMPTY) {
-		curr_details = agentDetailsCreate(curr_email,
-				agentGetCompany(curr_agent), rank);
-		if(curr_details == NULL) {
-			listDestroy(agents_list);
-			return false;
-		}
-		if (listInsertLast(agents_list, curr_details) ==
-				LIST_OUT_OF_MEMORY) {
-			listDestroy(agents_list);
-			agentDetailsDestroy(curr_details);
-			return false;
-		}
+	AgentDetails curr_details = agentDetailsCreateWithAllocator(allocator,
+			agentGetMail(curr_agent), agentGetCompany(curr_agent),
+			agentGetRank(curr_agent));
+	if(curr_details == NULL) {
+		listDestroy(agents_list);
+		return false;
+	}
+	if (listInsertLastTake(agents_list, curr_details) ==
+			LIST_OUT_OF_MEMORY) {
+		listDestroy(agents_list);
 		agentDetailsDestroy(curr_details);
+		return false;
 	}
 	return true;
 }
@@ -446,34 +521,63 @@ static bool addRankedAgentToList(Agent curr_agent, Email curr_email,
 AgentsManagerResult agentManagerGetSignificantAgents(AgentsManager manager,
 		int count, List* significant_list) {
 	if (!isValid(count)) return AGENT_MANAGER_INVALID_PARAMETERS;
-
-	Email curr_email = mapGetFirst(manager->agentsMap);
-	Agent curr_agent = (curr_email != NULL) ?
-			agentsManagerGetAgent(manager, curr_email) : NULL;
-	if(curr_agent == NULL)
+	if(agentsManagerIsEmpty(manager))
 			return AGENT_MANAGER_AGENT_NOT_EXISTS;
 
 	List agents_list = listCreate(copyListElement, freeListElement);
 	if(agents_list == NULL)
 		return AGENT_MANAGER_OUT_OF_MEMORY;
 
-	while(curr_agent != NULL) {
+	Agent curr_agent = setGetFirst(manager->rankedAgents);
+	for (; (curr_agent != NULL) && (count > 0); count--) {
 
-		if ( !addRankedAgentToList( curr_agent, curr_email, agents_list ))
+		if ( !addRankedAgentToList( curr_agent, agents_list,
+				manager->allocator ))
 			return AGENT_MANAGER_OUT_OF_MEMORY;
 
-		curr_email = mapGetNext(manager->agentsMap);
-		curr_agent = (curr_email != NULL ) ?
-				agentsManagerGetAgent( manager, curr_email) : NULL;
+		curr_agent = setGetNext(manager->rankedAgents);
 	}
-
-	listSort(agents_list, compareListElements);
-	reduceListToCount(agents_list, count);
 	*significant_list = agents_list;
 
 	return AGENT_MANAGER_SUCCESS;
 }
 
+/**
+* agentsManagerGetFirstSignificant: starts a walk over the agents who have
+* apartments, in the order of agentManagerGetSignificantAgents, and returns
+* the first of them. the walk allocates nothing.
+*
+* @param manager Target agent Manager to use.
+* @param company_name pointer to save the company name of the agent in.
+*
+* @return
+* 	NULL if manager or company_name are NULL, or no agent has apartments.
+* 	else the email of the agent, which belongs to the manager.
+*/
+Email agentsManagerGetFirstSignificant(AgentsManager manager,
+		char** company_name) {
+	if ((manager == NULL) || (company_name == NULL)) return NULL;
+	return getRankedAgent(setGetFirst(manager->rankedAgents), company_name);
+}
+
+/**
+* agentsManagerGetNextSignificant: advances the walk started by
+* agentsManagerGetFirstSignificant to the next agent. the walk is invalid
+* after agents are added or removed, or their apartments change.
+*
+* @param manager Target agent Manager to use.
+* @param company_name pointer to save the company name of the agent in.
+*
+* @return
+* 	NULL if manager or company_name are NULL, or the walk reached its end.
+* 	else the email of the agent, which belongs to the manager.
+*/
+Email agentsManagerGetNextSignificant(AgentsManager manager,
+		char** company_name) {
+	if ((manager == NULL) || (company_name == NULL)) return NULL;
+	return getRankedAgent(setGetNext(manager->rankedAgents), company_name);
+}
+
 /**
 * agentsManagerGetApartmentDetails: finds the apartment and retrieves its
 * 	details
@@ -518,8 +622,124 @@ AgentsManagerResult agentsManagerGetApartmentDetails(AgentsManager manager,
 	if (result != AGENT_SUCCESS) return convertAgentResult(result);
 	*apartment_commission = agentGetTax(agent);
 	return AGENT_MANAGER_SUCCESS;
-}
-
+}
+
+/**
+* agentsManagerSaveSnapshot: writes all the agents to a snapshot: their
+* amount, then for each agent its email, company name, tax percentage and
+* apartment services.
+*
+* @param manager Target Agents Manager.
+* @param writer the snapshot writer.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS - if manager or writer are NULL.
+* 	SNAPSHOT_OUT_OF_MEMORY - in case of memory allocations failure.
+* 	SNAPSHOT_WRITE_FAILED - if writing failed.
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult agentsManagerSaveSnapshot(AgentsManager manager,
+	SnapshotWriter writer) {
+	if ((manager == NULL) || (writer == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	if (!snapshotWriteInt(writer, mapGetSize(manager->agentsMap)))
+		return SNAPSHOT_WRITE_FAILED;
+	MAP_FOREACH(Email, email, manager->agentsMap) {
+		Agent agent = mapGet(manager->agentsMap, email);
+		SnapshotResult result = emailSaveSnapshot(email, writer);
+		if (result != SNAPSHOT_SUCCESS) return result;
+		if (!snapshotWriteString(writer, agentGetCompany(agent)) ||
+			!snapshotWriteInt(writer, agentGetTax(agent)))
+			return SNAPSHOT_WRITE_FAILED;
+		result = agentSaveSnapshot(agent, writer);
+		if (result != SNAPSHOT_SUCCESS) return result;
+	}
+	return SNAPSHOT_SUCCESS;
+}
+
+/**
+* agentsManagerLoadSnapshot: reads agents written by agentsManagerSaveSnapshot
+* into an empty manager. the snapshot is trusted to hold each email once, so
+* agents are not searched for before adding, and their services are read
+* straight into the agent held by the manager instead of being copied in.
+*
+* @param manager Target Agents Manager, with no agents.
+* @param reader the snapshot reader.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS - if manager or reader are NULL.
+* 	SNAPSHOT_BAD_FORMAT - if the snapshot is truncated or not valid.
+* 	SNAPSHOT_OUT_OF_MEMORY - in case of memory allocations failure.
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult agentsManagerLoadSnapshot(AgentsManager manager,
+	SnapshotReader reader) {
+	if ((manager == NULL) || (reader == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	int count = 0;
+	if (!snapshotReadInt(reader, &count) || (count < 0))
+		return SNAPSHOT_BAD_FORMAT;
+	for (int i = 0; i < count; i++) {
+		SnapshotResult result = loadAgent(manager, reader);
+		if (result != SNAPSHOT_SUCCESS) return result;
+	}
+	return SNAPSHOT_SUCCESS;
+}
+
+/*
+ * loadAgent: reads a single agent written by agentsManagerSaveSnapshot. the
+ * agent is put in the manager with no services, which are then read into
+ * the copy the manager holds.
+ */
+static SnapshotResult loadAgent(AgentsManager manager,
+	SnapshotReader reader) {
+	Email email = NULL;
+	SnapshotResult result = emailLoadSnapshot(reader, &email);
+	if (result != SNAPSHOT_SUCCESS) return result;
+	const char* company = NULL;
+	int tax = 0;
+	Agent agent = NULL;
+	if (!snapshotReadString(reader, &company) ||
+		!snapshotReadInt(reader, &tax)) {
+		emailDestroy(email);
+		return SNAPSHOT_BAD_FORMAT;
+	}
+	AgentResult created = agentCreate(email, (char*)company, tax, &agent);
+	if (created != AGENT_SUCCESS) {
+		emailDestroy(email);
+		return (created == AGENT_OUT_OF_MEMORY) ? SNAPSHOT_OUT_OF_MEMORY :
+			SNAPSHOT_BAD_FORMAT;
+	}
+	MapResult put = mapPutTake(manager->agentsMap, email, agent);
+	if (put != MAP_SUCCESS) agentDestroy(agent);
+	AgentsManagerResult registered = (put == MAP_SUCCESS) ?
+		registerAgent(manager, email) : AGENT_MANAGER_OUT_OF_MEMORY;
+	agent = mapGet(manager->agentsMap, email);
+	emailDestroy(email);
+	if (registered == AGENT_MANAGER_ALREADY_EXISTS) return SNAPSHOT_BAD_FORMAT;
+	if ((registered != AGENT_MANAGER_SUCCESS) || (agent == NULL))
+		return SNAPSHOT_OUT_OF_MEMORY;
+	result = agentLoadSnapshot(agent, reader);
+	if ((result == SNAPSHOT_SUCCESS) && (rankAgent(manager, agent,
+		AGENT_MANAGER_SUCCESS) != AGENT_MANAGER_SUCCESS))
+		return SNAPSHOT_OUT_OF_MEMORY;
+	return result;
+}
+
+/*
+ * registerAgent: adds an agent just put in the manager to the account
+ * directory, with the agent the manager holds as its record. the agent is
+ * taken out of the manager again if that fails.
+ */
+static AgentsManagerResult registerAgent(AgentsManager manager, Email email) {
+	if (manager->directory == NULL) return AGENT_MANAGER_SUCCESS;
+	Agent agent = mapGet(manager->agentsMap, email);
+	AccountDirectoryResult result = accountDirectoryAdd(manager->directory,
+		email, ACCOUNT_AGENT, agent);
+	if (result == ACCOUNT_DIRECTORY_SUCCESS) return AGENT_MANAGER_SUCCESS;
+	mapRemove(manager->agentsMap, email);
+	return (result == ACCOUNT_DIRECTORY_ALREADY_EXISTS) ?
+		AGENT_MANAGER_ALREADY_EXISTS : AGENT_MANAGER_OUT_OF_MEMORY;
+}
+
 /* isValid: The function checks whether the given apartment numerical
  * 					param is valid
  *
@@ -527,7 +747,7 @@ AgentsManagerResult agentsManagerGetApartmentDetails(AgentsManager manager,
  *
  * * @return
  * false if invalid; else returns true.
- */
+ */
 static bool isValid( int param ){
 	return param > 0;
 }
@@ -542,19 +762,6 @@ static bool isValid( int param ){
  */
 static bool isPriceValid(int price) {
 	return !(price%100) && price > 0;
-}
-
-
-static void reduceListToCount(List list, int count) {
-	ListElement current = listGetFirst( list );
-	while( current ) {
-		if( count == 0 ) {
-			listRemoveCurrent(list);
-		} else {
-			count--;
-		}
-		current = listGetNext( list );
-	}
 }
 
 /** Function to be used for copying data elements into the map */
@@ -588,6 +795,12 @@ static int CompareKeys(constMapKeyElement first, constMapKeyElement second) {
 	return emailComapre((Email)first, (Email)second);
 }
 
+/** Function to be used for hashing key elements in the map, by the email
+ * id, which equal emails share */
+static unsigned int HashKey(constMapKeyElement key) {
+	return (unsigned int)emailGetId((Email)key);
+}
+
 
 /** Function to be used for freeing data elements from list */
 void freeListElement(ListElement element) {
@@ -600,8 +813,57 @@ ListElement copyListElement(ListElement element) {
 	return agentDetailsCopy((AgentDetails)element);
 }
 
-/** Function to be used for comparing data elements in list */
-static int compareListElements(ListElement first, ListElement second){
+/** Function to be used for adding agents to the ranked agents set, which
+ * does not copy them */
+static SetElement copyRankedAgent(SetElement element) {
+	return element;
+}
+
+/** Function to be used for removing agents from the ranked agents set,
+ * which does not free them */
+static void freeRankedAgent(SetElement element) {
+	(void)element;
+}
+
+/** Function to be used for ordering the ranked agents set, from the highest
+ * rank, and by the email for equal ranks */
+static int compareRankedAgents(SetElement first, SetElement second) {
+	double first_rank = agentGetRank((Agent)first);
+	double second_rank = agentGetRank((Agent)second);
+	if (first_rank != second_rank)
+		return (first_rank < second_rank) ? 1 : -1;
+	return emailComapre(agentGetMail((Agent)first),
+			agentGetMail((Agent)second));
+}
+
+/*
+ * unrankAgent: takes an agent out of the ranked agents, before its
+ * apartments change. the rank it was added with is still cached then.
+ */
+static void unrankAgent(AgentsManager manager, Agent agent) {
+	if (agentGetRank(agent) != RANK_EMPTY)
+		setRemove(manager->rankedAgents, agent);
+}
 
-	return agentDetailsRankCompare((AgentDetails)first, (AgentDetails)second);
+/*
+ * rankAgent: adds an agent back to the ranked agents after its apartments
+ * changed, if it has a rank, and returns result, or
+ * AGENT_MANAGER_OUT_OF_MEMORY if adding it failed.
+ */
+static AgentsManagerResult rankAgent(AgentsManager manager, Agent agent,
+	AgentsManagerResult result) {
+	if ((agentGetRank(agent) != RANK_EMPTY) &&
+		(setAdd(manager->rankedAgents, agent) == SET_OUT_OF_MEMORY))
+		return AGENT_MANAGER_OUT_OF_MEMORY;
+	return result;
+}
+
+/*
+ * getRankedAgent: returns the email of a ranked agent and saves its company
+ * name, or returns NULL if agent is NULL.
+ */
+static Email getRankedAgent(Agent agent, char** company_name) {
+	if (agent == NULL) return NULL;
+	*company_name = agentGetCompany(agent);
+	return agentGetMail(agent);
 }
@@ -11,6 +11,9 @@
 #include "agent.h"
 #include "email.h"
 #include "list.h"
+#include "snapshot.h"
+#include "accountDirectory.h"
+#include "slabAllocator.h"
 
 /**
 * This type defines end codes for the methods.
@@ -48,6 +51,29 @@ AgentsManager agentsManagerCreate();
 */
 void agentsManagerDestroy(AgentsManager manager);
 
+/**
+* agentsManagerSetDirectory: sets the account directory the manager keeps
+* its agents in. agents are added to and removed from the directory with
+* the manager, so it is set while the manager is empty.
+*
+* @param manager Target Agents Manager.
+* @param directory the directory, or NULL for none. it must outlive the
+* 	manager.
+*/
+void agentsManagerSetDirectory(AgentsManager manager,
+	AccountDirectory directory);
+
+/**
+* agentsManagerSetAllocator: sets the allocator the manager creates the
+* details of the significant agents lists from.
+*
+* @param manager Target Agents Manager.
+* @param allocator the allocator, or NULL to use malloc. it must outlive the
+* 	manager and the lists it returns.
+*/
+void agentsManagerSetAllocator(AgentsManager manager,
+	SlabAllocator allocator);
+
 /**
 * agentsManagerAddAgent: adds the new Agent to the collection.
 *
@@ -181,6 +207,15 @@ AgentsManagerResult agentsManagerRemoveApartmentFromService(
  */
 bool agentsManagerAgentExists(AgentsManager manager, Email email);
 
+/* agentsManagerIsEmpty: The function checks whether no agent is registered
+ *
+ * @param manager Target agent Manager to check.
+ *
+ * * @return
+ * true if manager is NULL or has no agents; else returns false.
+ */
+bool agentsManagerIsEmpty(AgentsManager manager);
+
 /**
 * agentFindMatch: finds a matching apartment in each of the agent's services
 *
@@ -208,12 +243,43 @@ AgentsManagerResult agentManagerFindMatch(AgentsManager manager, int min_rooms,
  * 							the significant agents
  *
  * * @return
+ * AGENT_MANAGER_AGENT_NOT_EXISTS   if no agents found
  * AGENT_MANAGER_OUT_OF_MEMORY 		if an allocation problem occurred
  * AGENT_MANAGER_SUCCESS			otherwise
  */
 AgentsManagerResult agentManagerGetSignificantAgents( AgentsManager manager,
 		int count, List* significal_list );
 
+/**
+* agentsManagerGetFirstSignificant: starts a walk over the agents who have
+* apartments, in the order of agentManagerGetSignificantAgents, and returns
+* the first of them. the walk allocates nothing.
+*
+* @param manager Target agent Manager to use.
+* @param company_name pointer to save the company name of the agent in.
+*
+* @return
+* 	NULL if manager or company_name are NULL, or no agent has apartments.
+* 	else the email of the agent, which belongs to the manager.
+*/
+Email agentsManagerGetFirstSignificant(AgentsManager manager,
+		char** company_name);
+
+/**
+* agentsManagerGetNextSignificant: advances the walk started by
+* agentsManagerGetFirstSignificant to the next agent. the walk is invalid
+* after agents are added or removed, or their apartments change.
+*
+* @param manager Target agent Manager to use.
+* @param company_name pointer to save the company name of the agent in.
+*
+* @return
+* 	NULL if manager or company_name are NULL, or the walk reached its end.
+* 	else the email of the agent, which belongs to the manager.
+*/
+Email agentsManagerGetNextSignificant(AgentsManager manager,
+		char** company_name);
+
 /**
 * agentsManagerGetApartmentDetails: finds the apartment and retrieves its
 * 	details
@@ -249,4 +315,39 @@ AgentsManagerResult agentsManagerGetApartmentDetails(AgentsManager manager,
 	Email agent_email, char* service_name, int id, int *apartment_area,
 	int *apartment_rooms, int *apartment_price, int *apartment_commission);
 
+/**
+* agentsManagerSaveSnapshot: writes all the agents to a snapshot: their
+* amount, then for each agent its email, company name, tax percentage and
+* apartment services.
+*
+* @param manager Target Agents Manager.
+* @param writer the snapshot writer.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS - if manager or writer are NULL.
+* 	SNAPSHOT_OUT_OF_MEMORY - in case of memory allocations failure.
+* 	SNAPSHOT_WRITE_FAILED - if writing failed.
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult agentsManagerSaveSnapshot(AgentsManager manager,
+	SnapshotWriter writer);
+
+/**
+* agentsManagerLoadSnapshot: reads agents written by agentsManagerSaveSnapshot
+* into an empty manager. the snapshot is trusted to hold each email once, so
+* agents are not searched for before adding, and their services are read
+* straight into the agent held by the manager instead of being copied in.
+*
+* @param manager Target Agents Manager, with no agents.
+* @param reader the snapshot reader.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS - if manager or reader are NULL.
+* 	SNAPSHOT_BAD_FORMAT - if the snapshot is truncated or not valid.
+* 	SNAPSHOT_OUT_OF_MEMORY - in case of memory allocations failure.
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult agentsManagerLoadSnapshot(AgentsManager manager,
+	SnapshotReader reader);
+
 #endif /* SRC_AGENTSMANAGER_H_ */
@@ -26,6 +26,7 @@ static bool testAgentsManagerAddApartmentToService();
 static bool testAgentsManagerRemoveApartmentFromService();
 static bool testAgentManagerFindMatch();
 static bool testAgentManagerGetSignificantAgents();
+static bool testAgentsManagerSignificantWalk();
 static bool testAgentsManagerGetApartmentDetails();
 
 int RunAgentManagerTest() {
@@ -38,6 +39,7 @@ int RunAgentManagerTest() {
 	RUN_TEST(testAgentsManagerRemoveApartmentFromService);
 	RUN_TEST(testAgentManagerFindMatch);
 	RUN_TEST(testAgentManagerGetSignificantAgents);
+	RUN_TEST(testAgentsManagerSignificantWalk);
 	RUN_TEST(testAgentsManagerGetApartmentDetails);
 	return 0;
 }
@@ -276,7 +278,7 @@ static bool testAgentManagerGetSignificantAgents() {
 	ASSERT_TEST(result == AGENT_MANAGER_SUCCESS);
 
 	ASSERT_TEST(strcmp(agentDetailsGetCompanyName(
-		(AgentDetails)(listGetFirst(agents_list))), "tania"));
+		(AgentDetails)(listGetFirst(agents_list))), "tania") == 0);
 
 	agentsManagerDestroy(manager);
 	listDestroy(agents_list);
@@ -285,6 +287,69 @@ static bool testAgentManagerGetSignificantAgents() {
 	return true;
 }
 
+/**
+ * Test the walk over the significant agents follows their apartments
+ */
+static bool testAgentsManagerSignificantWalk() {
+	Email email = NULL;
+	emailCreate("baba@ganosh", &email);
+	Email mail = NULL;
+	emailCreate("baba@gansh", &mail);
+	char* company = NULL;
+	AgentsManager manager = agentsManagerCreate();
+	ASSERT_TEST(agentsManagerIsEmpty(manager));
+	ASSERT_TEST(agentsManagerIsEmpty(NULL));
+	List agents_list = NULL;
+	ASSERT_TEST(agentManagerGetSignificantAgents(manager, 1, &agents_list)
+		== AGENT_MANAGER_AGENT_NOT_EXISTS);
+	agentsManagerAdd(manager, email, "tania" , TAX_PERCENT);
+	agentsManagerAdd(manager, mail, "alon" , TAX_PERCENT);
+	ASSERT_TEST(!agentsManagerIsEmpty(manager));
+	ASSERT_TEST(agentsManagerGetFirstSignificant(manager, &company) == NULL);
+	ASSERT_TEST(agentsManagerGetFirstSignificant(manager, NULL) == NULL);
+	ASSERT_TEST(agentsManagerGetNextSignificant(NULL, &company) == NULL);
+
+	agentsManagerAddApartmentService(manager, email, "serveMee", 2);
+	agentsManagerAddApartmentService(manager, mail, "serveMe", 2);
+	agentsManagerAddApartmentService(manager, mail, "serveMeToo", 2);
+	agentsManagerAddApartmentToService(manager, email, "serveMee", AP_ID, 200,
+		2, 2, "weee");
+	agentsManagerAddApartmentToService(manager, mail, "serveMe", AP_ID, 200,
+		1, 2, "we");
+	ASSERT_TEST(emailAreEqual(agentsManagerGetFirstSignificant(manager,
+		&company), email));
+	ASSERT_TEST(strcmp(company, "tania") == 0);
+	ASSERT_TEST(emailAreEqual(agentsManagerGetNextSignificant(manager,
+		&company), mail));
+	ASSERT_TEST(strcmp(company, "alon") == 0);
+	ASSERT_TEST(agentsManagerGetNextSignificant(manager, &company) == NULL);
+
+	agentsManagerAddApartmentToService(manager, mail, "serveMeToo", AP_ID,
+		100, 1, 1, "e");
+	ASSERT_TEST(emailAreEqual(agentsManagerGetFirstSignificant(manager,
+		&company), mail));
+	ASSERT_TEST(agentManagerGetSignificantAgents(manager, 1, &agents_list)
+		== AGENT_MANAGER_SUCCESS);
+	ASSERT_TEST(listGetSize(agents_list) == 1);
+	ASSERT_TEST(strcmp(agentDetailsGetCompanyName(
+		(AgentDetails)(listGetFirst(agents_list))), "alon") == 0);
+	listDestroy(agents_list);
+
+	agentsManagerRemoveApartmentService(manager, mail, "serveMeToo");
+	agentsManagerRemoveApartmentFromService(manager, email, "serveMee",
+		AP_ID);
+	ASSERT_TEST(emailAreEqual(agentsManagerGetFirstSignificant(manager,
+		&company), mail));
+	ASSERT_TEST(agentsManagerGetNextSignificant(manager, &company) == NULL);
+	agentsManagerRemove(manager, mail);
+	ASSERT_TEST(agentsManagerGetFirstSignificant(manager, &company) == NULL);
+
+	agentsManagerDestroy(manager);
+	emailDestroy(email);
+	emailDestroy(mail);
+	return true;
+}
+
 static bool testAgentsManagerGetApartmentDetails(){
 	Email email = NULL;
 	emailCreate("baba@ganosh", &email);
@@ -0,0 +1,584 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include "apartment.h"
+
+#define BITS_PER_BYTE 8
+#define MIN_PERCENT -100
+#define FULL_PERCENT 100
+#define DIRECTIONS 4
+
+/*
+ * The squares of an apartment are kept row by row in one bitset, a bit per
+ * square which is set for a WALL, allocated with the apartment after its
+ * rooms. the bits past the last square are always clear, so apartments are
+ * compared a byte at a time.
+ *
+ * the rooms are labelled once in a union-find over the EMPTY squares: rooms
+ * holds for every EMPTY square the square it was joined under, or for the
+ * square a room is kept by, the negated area of the room. an EMPTY square
+ * set is joined with its neighbours, and a square walled clears is_labelled
+ * unless it was a room of its own, so the rooms are labelled again on the
+ * next room query.
+ */
+struct apartment_t {
+	int length;
+	int width;
+	int price;
+	int room_count;
+	bool is_labelled;
+	int rooms[];
+};
+
+static size_t getWallsSize(int length, int width);
+static unsigned char* getWalls(Apartment apartment);
+static Apartment allocateApartment(int length, int width, int price);
+static bool isInside(Apartment apartment, int row, int col);
+static bool isWall(Apartment apartment, int square);
+static void setWall(Apartment apartment, int square, bool is_wall);
+static bool isWallLine(Apartment apartment, bool is_row, int index);
+static Apartment createPart(Apartment apartment, int row, int col,
+	int length, int width, int price);
+static int getNeighbours(Apartment apartment, int square,
+	int neighbours[DIRECTIONS]);
+static void labelRooms(Apartment apartment);
+static int findRoom(Apartment apartment, int square);
+static bool joinRooms(Apartment apartment, int first, int second);
+
+/**
+* apartmentCreate: Allocates a new apartment.
+*
+* @param squares the squares of the apartment, length rows of width each.
+* @param length  the amount of rows.
+* @param width   the amount of columns.
+* @param price   the price of the apartment.
+*
+* @return
+* 	NULL if squares is NULL, length or width are not positive, price is
+* 	negative or allocations failed.
+* 	A new apartment in case of success.
+*/
+Apartment apartmentCreate(SquareType** squares, int length, int width,
+		int price) {
+	if (squares == NULL) return NULL;
+	Apartment apartment = allocateApartment(length, width, price);
+	if (apartment == NULL) return NULL;
+	for (int row = 0; row < length; row++) {
+		for (int col = 0; col < width; col++) {
+			if (squares[row][col] == WALL)
+				setWall(apartment, row * width + col, true);
+		}
+	}
+	labelRooms(apartment);
+	return apartment;
+}
+
+/**
+* apartmentCreateFromString: Allocates a new apartment from a string of its
+* squares, straight into its bitset.
+*
+* @param squares the squares of the apartment, length * width characters
+* 				 row by row.
+* @param length  the amount of rows.
+* @param width   the amount of columns.
+* @param price   the price of the apartment.
+* @param wall    the character of a WALL square.
+* @param empty   the character of an EMPTY square.
+*
+* @return
+* 	NULL if squares is NULL, length or width are not positive, price is
+* 	negative, a character is neither wall nor empty or allocations failed.
+* 	A new apartment in case of success.
+*/
+Apartment apartmentCreateFromString(const char* squares, int length,
+		int width, int price, char wall, char empty) {
+	if (squares == NULL) return NULL;
+	Apartment apartment = allocateApartment(length, width, price);
+	if (apartment == NULL) return NULL;
+	int count = length * width;
+	for (int square = 0; square < count; square++) {
+		if (squares[square] == wall) {
+			setWall(apartment, square, true);
+		} else if (squares[square] != empty) {
+			apartmentDestroy(apartment);
+			return NULL;
+		}
+	}
+	labelRooms(apartment);
+	return apartment;
+}
+
+/**
+* apartmentDestroy: Deallocates an apartment.
+*
+* @param apartment the apartment to deallocate, may be NULL.
+*/
+void apartmentDestroy(Apartment apartment) {
+	free(apartment);
+}
+
+/**
+* apartmentCopy: Creates a copy of an apartment.
+*
+* @param apartment the apartment to copy.
+*
+* @return
+* 	NULL if apartment is NULL or allocations failed.
+* 	A new apartment in case of success.
+*/
+Apartment apartmentCopy(Apartment apartment) {
+	if (apartment == NULL) return NULL;
+	size_t size = (size_t)(getWalls(apartment) +
+		getWallsSize(apartment->length, apartment->width) -
+		(unsigned char*)apartment);
+	Apartment copy = malloc(size);
+	if (copy == NULL) return NULL;
+	memcpy(copy, apartment, size);
+	return copy;
+}
+
+/**
+* apartmentIsSameRoom: Checks if two squares are in the same room.
+*
+* @param apartment the apartment.
+* @param row1      the row of the first square.
+* @param col1      the column of the first square.
+* @param row2      the row of the second square.
+* @param col2      the column of the second square.
+* @param outResult pointer to save the result in.
+*
+* @return
+* 	APARTMENT_NULL_ARG if apartment or outResult are NULL.
+* 	APARTMENT_OUT_OF_BOUNDS if a square is not in the apartment.
+* 	APARTMENT_NO_ROOM if a square is a wall.
+* 	APARTMENT_SUCCESS in case of success.
+*/
+ApartmentResult apartmentIsSameRoom(Apartment apartment, int row1, int col1,
+		int row2, int col2, bool* outResult) {
+	if ((apartment == NULL) || (outResult == NULL)) return APARTMENT_NULL_ARG;
+	if (!isInside(apartment, row1, col1) || !isInside(apartment, row2, col2))
+		return APARTMENT_OUT_OF_BOUNDS;
+	int first = row1 * apartment->width + col1;
+	int second = row2 * apartment->width + col2;
+	if (isWall(apartment, first) || isWall(apartment, second))
+		return APARTMENT_NO_ROOM;
+	labelRooms(apartment);
+	*outResult = findRoom(apartment, first) == findRoom(apartment, second);
+	return APARTMENT_SUCCESS;
+}
+
+/**
+* apartmentTotalArea: Counts the EMPTY squares of an apartment.
+*
+* @param apartment the apartment, asserted not to be NULL.
+*
+* @return
+* 	the amount of EMPTY squares.
+*/
+int apartmentTotalArea(Apartment apartment) {
+	assert(apartment != NULL);
+	int walls = 0;
+	unsigned char* bytes = getWalls(apartment);
+	size_t size = getWallsSize(apartment->length, apartment->width);
+	for (size_t i = 0; i < size; i++) {
+		for (unsigned int bits = bytes[i]; bits != 0;
+			bits &= bits - 1) walls++;
+	}
+	return apartment->length * apartment->width - walls;
+}
+
+/**
+* apartmentRoomArea: Counts the squares of the room of a square.
+*
+* @param apartment the apartment.
+* @param row       the row of the square.
+* @param col       the column of the square.
+* @param outArea   pointer to save the result in.
+*
+* @return
+* 	APARTMENT_NULL_ARG if apartment or outArea are NULL.
+* 	APARTMENT_OUT_OF_BOUNDS if the square is not in the apartment.
+* 	APARTMENT_NO_ROOM if the square is a wall.
+* 	APARTMENT_SUCCESS in case of success.
+*/
+ApartmentResult apartmentRoomArea(Apartment apartment, int row, int col,
+		int* outArea) {
+	if ((apartment == NULL) || (outArea == NULL)) return APARTMENT_NULL_ARG;
+	if (!isInside(apartment, row, col)) return APARTMENT_OUT_OF_BOUNDS;
+	int square = row * apartment->width + col;
+	if (isWall(apartment, square)) return APARTMENT_NO_ROOM;
+	labelRooms(apartment);
+	*outArea = -apartment->rooms[findRoom(apartment, square)];
+	return APARTMENT_SUCCESS;
+}
+
+/**
+* apartmentSplit: Splits an apartment in two along a row or a column of
+* walls.
+*
+* @param apartment  the apartment to split.
+* @param splitByRow true to split along a row, false along a column.
+* @param index      the index of the row or column.
+* @param first      pointer to save the part of the lower indices in.
+* @param second     pointer to save the part of the greater indices in.
+*
+* @return
+* 	APARTMENT_NULL_ARG if apartment, first or second are NULL.
+* 	APARTMENT_OUT_OF_BOUNDS if index is not in the apartment.
+* 	APARTMENT_BAD_SPLIT if a part would be empty or the row or column has an
+* 	EMPTY square.
+* 	APARTMENT_OUT_OF_MEM if allocations failed.
+* 	APARTMENT_SUCCESS in case of success.
+*/
+ApartmentResult apartmentSplit(Apartment apartment, bool splitByRow,
+		int index, Apartment* first, Apartment* second) {
+	if ((apartment == NULL) || (first == NULL) || (second == NULL))
+		return APARTMENT_NULL_ARG;
+	int size = splitByRow ? apartment->length : apartment->width;
+	if ((index < 0) || (index >= size)) return APARTMENT_OUT_OF_BOUNDS;
+	if ((index == 0) || (index == size - 1) ||
+		!isWallLine(apartment, splitByRow, index)) return APARTMENT_BAD_SPLIT;
+	int first_price = (index + 1) * apartment->price / size;
+	int second_price = (size - index) * apartment->price / size;
+	if (splitByRow) {
+		*first = createPart(apartment, 0, 0, index, apartment->width,
+			first_price);
+		*second = createPart(apartment, index + 1, 0, size - index - 1,
+			apartment->width, second_price);
+	} else {
+		*first = createPart(apartment, 0, 0, apartment->length, index,
+			first_price);
+		*second = createPart(apartment, 0, index + 1, apartment->length,
+			size - index - 1, second_price);
+	}
+	if ((*first == NULL) || (*second == NULL)) {
+		apartmentDestroy(*first);
+		apartmentDestroy(*second);
+		*first = NULL;
+		*second = NULL;
+		return APARTMENT_OUT_OF_MEM;
+	}
+	return APARTMENT_SUCCESS;
+}
+
+/**
+* apartmentNumOfRooms: Counts the rooms of an apartment.
+*
+* @param apartment the apartment, asserted not to be NULL.
+*
+* @return
+* 	the amount of rooms.
+*/
+int apartmentNumOfRooms(Apartment apartment) {
+	assert(apartment != NULL);
+	labelRooms(apartment);
+	return apartment->room_count;
+}
+
+/**
+* apartmentSetSquare: Sets the type of a square. an EMPTY square is joined
+* with the rooms of its neighbours, and a walled square leaves the rooms to
+* be labelled again unless it was a room of its own.
+*
+* @param apartment the apartment.
+* @param row       the row of the square.
+* @param col       the column of the square.
+* @param value     the type to set.
+*
+* @return
+* 	APARTMENT_NULL_ARG if apartment is NULL.
+* 	APARTMENT_OUT_OF_BOUNDS if the square is not in the apartment.
+* 	APARTMENT_OLD_VALUE if the square already is of the type.
+* 	APARTMENT_SUCCESS in case of success.
+*/
+ApartmentResult apartmentSetSquare(Apartment apartment, int row, int col,
+		SquareType value) {
+	if (apartment == NULL) return APARTMENT_NULL_ARG;
+	if (!isInside(apartment, row, col)) return APARTMENT_OUT_OF_BOUNDS;
+	int square = row * apartment->width + col;
+	if (isWall(apartment, square) == (value == WALL))
+		return APARTMENT_OLD_VALUE;
+	setWall(apartment, square, value == WALL);
+	if (!apartment->is_labelled) return APARTMENT_SUCCESS;
+	int neighbours[DIRECTIONS];
+	int count = getNeighbours(apartment, square, neighbours);
+	if (value == WALL) {
+		if (count > 0) {
+			apartment->is_labelled = false;
+		} else {
+			apartment->room_count--;
+		}
+		return APARTMENT_SUCCESS;
+	}
+	apartment->rooms[square] = -1;
+	apartment->room_count++;
+	for (int i = 0; i < count; i++) {
+		if (joinRooms(apartment, square, neighbours[i]))
+			apartment->room_count--;
+	}
+	return APARTMENT_SUCCESS;
+}
+
+/**
+* apartmentGetSquare: Gets the type of a square.
+*
+* @param apartment the apartment.
+* @param row       the row of the square.
+* @param col       the column of the square.
+* @param outValue  pointer to save the type in.
+*
+* @return
+* 	APARTMENT_NULL_ARG if apartment or outValue are NULL.
+* 	APARTMENT_OUT_OF_BOUNDS if the square is not in the apartment.
+* 	APARTMENT_SUCCESS in case of success.
+*/
+ApartmentResult apartmentGetSquare(Apartment apartment, int row, int col,
+		SquareType* outValue) {
+	if ((apartment == NULL) || (outValue == NULL)) return APARTMENT_NULL_ARG;
+	if (!isInside(apartment, row, col)) return APARTMENT_OUT_OF_BOUNDS;
+	*outValue = isWall(apartment, row * apartment->width + col) ? WALL :
+		EMPTY;
+	return APARTMENT_SUCCESS;
+}
+
+/**
+* apartmentChangePrice: Changes the price of an apartment by a percentage.
+*
+* @param apartment the apartment.
+* @param percent   the percentage to add to the price, at least -100.
+*
+* @return
+* 	APARTMENT_NULL_ARG if apartment is NULL.
+* 	APARTMENT_PRICE_NOT_IN_RANGE if percent is lower than -100.
+* 	APARTMENT_SUCCESS in case of success.
+*/
+ApartmentResult apartmentChangePrice(Apartment apartment, int percent) {
+	if (apartment == NULL) return APARTMENT_NULL_ARG;
+	if (percent < MIN_PERCENT) return APARTMENT_PRICE_NOT_IN_RANGE;
+	apartment->price += apartment->price * percent / FULL_PERCENT;
+	return APARTMENT_SUCCESS;
+}
+
+/**
+* apartmentGetPrice: Gets the price of an apartment.
+*
+* @param apartment the apartment, asserted not to be NULL.
+*/
+int apartmentGetPrice(Apartment apartment) {
+	assert(apartment != NULL);
+	return apartment->price;
+}
+
+/**
+* apartmentGetLength: Gets the amount of rows of an apartment.
+*
+* @param apartment the apartment, asserted not to be NULL.
+*/
+int apartmentGetLength(Apartment apartment) {
+	assert(apartment != NULL);
+	return apartment->length;
+}
+
+/**
+* apartmentGetWidth: Gets the amount of columns of an apartment.
+*
+* @param apartment the apartment, asserted not to be NULL.
+*/
+int apartmentGetWidth(Apartment apartment) {
+	assert(apartment != NULL);
+	return apartment->width;
+}
+
+/**
+* apartmentIsIdentical: Checks if two apartments have the same dimensions,
+* price and squares.
+*
+* @param apartment1 the first apartment, may be NULL.
+* @param apartment2 the second apartment, may be NULL.
+*
+* @return
+* 	true if both are NULL or both are identical, false otherwise.
+*/
+bool apartmentIsIdentical(Apartment apartment1, Apartment apartment2) {
+	if ((apartment1 == NULL) || (apartment2 == NULL))
+		return apartment1 == apartment2;
+	return (apartment1->length == apartment2->length) &&
+		(apartment1->width == apartment2->width) &&
+		(apartment1->price == apartment2->price) &&
+		(memcmp(getWalls(apartment1), getWalls(apartment2),
+		getWallsSize(apartment1->length, apartment1->width)) == 0);
+}
+
+/*
+ * getWallsSize: returns the bytes of the bitset of an apartment.
+ */
+static size_t getWallsSize(int length, int width) {
+	return ((size_t)length * width + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+}
+
+/*
+ * getWalls: returns the bitset of an apartment, after its rooms.
+ */
+static unsigned char* getWalls(Apartment apartment) {
+	return (unsigned char*)(apartment->rooms +
+		apartment->length * apartment->width);
+}
+
+/*
+ * allocateApartment: allocates an apartment of EMPTY squares whose rooms
+ * are not labelled, or returns NULL if the dimensions or the price are
+ * invalid or allocations failed.
+ */
+static Apartment allocateApartment(int length, int width, int price) {
+	if ((length <= 0) || (width <= 0) || (price < 0) ||
+		(width > INT_MAX / length)) return NULL;
+	size_t count = (size_t)length * width;
+	if (count > (SIZE_MAX - sizeof(struct apartment_t)) /
+		(sizeof(int) + 1)) return NULL;
+	Apartment apartment = calloc(1, sizeof(*apartment) +
+		count * sizeof(int) + getWallsSize(length, width));
+	if (apartment == NULL) return NULL;
+	apartment->length = length;
+	apartment->width = width;
+	apartment->price = price;
+	apartment->room_count = 0;
+	apartment->is_labelled = false;
+	return apartment;
+}
+
+/*
+ * isInside: checks if a row and a column are of a square of an apartment.
+ */
+static bool isInside(Apartment apartment, int row, int col) {
+	return (row >= 0) && (row < apartment->length) && (col >= 0) &&
+		(col < apartment->width);
+}
+
+/*
+ * isWall: checks if the square of an index, row by row, is a wall.
+ */
+static bool isWall(Apartment apartment, int square) {
+	return (getWalls(apartment)[square / BITS_PER_BYTE] &
+		(1 << (square % BITS_PER_BYTE))) != 0;
+}
+
+/*
+ * setWall: sets the square of an index, row by row, to a wall or empty.
+ */
+static void setWall(Apartment apartment, int square, bool is_wall) {
+	unsigned char* walls = getWalls(apartment);
+	unsigned char bit = (unsigned char)(1 << (square % BITS_PER_BYTE));
+	if (is_wall) {
+		walls[square / BITS_PER_BYTE] |= bit;
+	} else {
+		walls[square / BITS_PER_BYTE] &= (unsigned char)~bit;
+	}
+}
+
+/*
+ * isWallLine: checks if every square of a row or a column is a wall.
+ */
+static bool isWallLine(Apartment apartment, bool is_row, int index) {
+	int count = is_row ? apartment->width : apartment->length;
+	for (int i = 0; i < count; i++) {
+		int square = is_row ? (index * apartment->width + i) :
+			(i * apartment->width + index);
+		if (!isWall(apartment, square)) return false;
+	}
+	return true;
+}
+
+/*
+ * createPart: creates an apartment of the squares of another from a row and
+ * a column, in the given dimensions and price.
+ */
+static Apartment createPart(Apartment apartment, int row, int col,
+		int length, int width, int price) {
+	Apartment part = allocateApartment(length, width, price);
+	if (part == NULL) return NULL;
+	for (int i = 0; i < length; i++) {
+		for (int j = 0; j < width; j++) {
+			if (isWall(apartment, (row + i) * apartment->width + col + j))
+				setWall(part, i * width + j, true);
+		}
+	}
+	labelRooms(part);
+	return part;
+}
+
+/*
+ * getNeighbours: saves the EMPTY squares next to a square, and returns
+ * their amount.
+ */
+static int getNeighbours(Apartment apartment, int square,
+		int neighbours[DIRECTIONS]) {
+	static const int row_steps[DIRECTIONS] = {-1, 1, 0, 0};
+	static const int col_steps[DIRECTIONS] = {0, 0, -1, 1};
+	int row = square / apartment->width, col = square % apartment->width;
+	int count = 0;
+	for (int i = 0; i < DIRECTIONS; i++) {
+		int next_row = row + row_steps[i], next_col = col + col_steps[i];
+		if (!isInside(apartment, next_row, next_col)) continue;
+		int next = next_row * apartment->width + next_col;
+		if (!isWall(apartment, next)) neighbours[count++] = next;
+	}
+	return count;
+}
+
+/*
+ * labelRooms: labels the rooms of an apartment again if a square walled
+ * may have split one, joining every EMPTY square with the EMPTY squares
+ * above and left of it.
+ */
+static void labelRooms(Apartment apartment) {
+	if (apartment->is_labelled) return;
+	int width = apartment->width;
+	int count = apartment->length * width;
+	apartment->room_count = 0;
+	for (int square = 0; square < count; square++) {
+		if (isWall(apartment, square)) continue;
+		apartment->rooms[square] = -1;
+		apartment->room_count++;
+		if ((square >= width) && !isWall(apartment, square - width) &&
+			joinRooms(apartment, square, square - width))
+			apartment->room_count--;
+		if ((square % width > 0) && !isWall(apartment, square - 1) &&
+			joinRooms(apartment, square, square - 1))
+			apartment->room_count--;
+	}
+	apartment->is_labelled = true;
+}
+
+/*
+ * findRoom: returns the square the room of an EMPTY square is kept by,
+ * halving the path to it.
+ */
+static int findRoom(Apartment apartment, int square) {
+	int* rooms = apartment->rooms;
+	while (rooms[square] >= 0) {
+		if (rooms[rooms[square]] >= 0) rooms[square] = rooms[rooms[square]];
+		square = rooms[square];
+	}
+	return square;
+}
+
+/*
+ * joinRooms: joins the rooms of two EMPTY squares under the larger of
+ * them. returns false if they already are the same room.
+ */
+static bool joinRooms(Apartment apartment, int first, int second) {
+	first = findRoom(apartment, first);
+	second = findRoom(apartment, second);
+	if (first == second) return false;
+	if (apartment->rooms[first] > apartment->rooms[second]) {
+		int larger = second;
+		second = first;
+		first = larger;
+	}
+	apartment->rooms[first] += apartment->rooms[second];
+	apartment->rooms[second] = first;
+	return true;
+}
@@ -26,6 +26,22 @@ typedef enum {
 **/
 Apartment apartmentCreate(SquareType** squares, int length, int width, 
 						  int price);
+
+/**
+* Creates a new apartment whose structure is given row by row in a string of
+* length * width characters, where wall stands for a WALL square and empty
+* for an EMPTY square.
+* The price of the apartment is given by price.
+*
+* @return
+* 	A new allocated apartment.
+* 	if width or height are not positive, price is negative, squares is NULL,
+* 	a character of squares is neither wall nor empty or in case of a memory
+* 	allocation failure - return NULL.
+**/
+Apartment apartmentCreateFromString(const char* squares, int length,
+									int width, int price, char wall,
+									char empty);
 /**
 * Frees all memory allocated for the given apartment.
 * This function can receive NULL.
@@ -0,0 +1,1171 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include "apartment_service.h"
+#include "map.h"
+
+#define NULL_SERVICE_SIZE -1
+#define INITIAL_SEED 2463534242u
+
+typedef struct ServiceEntry_t *ServiceEntry;
+typedef struct ServiceShape_t *ServiceShape;
+typedef struct RankNode_t *RankNode;
+
+/*
+ * An apartment of the service, with its price, area and rooms read once
+ * when it is added, as searches compare them. every entry is in two treaps
+ * sharing its priority: the treap of all the entries in the order they were
+ * added in, by left and right, where it keeps the size of its subtree, and
+ * the treap of the entries of its shape in the order of their prices, by
+ * cheaper and pricier, where it keeps the last added and the cheapest entries
+ * of its subtree.
+ */
+struct ServiceEntry_t {
+	Apartment apartment;
+	int id;
+	int price;
+	int area;
+	int rooms;
+	long long sequence;
+	unsigned int priority;
+	int size;
+	ServiceEntry left;
+	ServiceEntry right;
+	ServiceEntry latest;
+	ServiceEntry cheapest;
+	ServiceEntry cheaper;
+	ServiceEntry pricier;
+};
+
+/*
+ * The entries of the service of an area and an amount of rooms, in a treap
+ * by their prices and then by the order they were added in. the shapes are
+ * kept in a treap by area and then by rooms, where each shape also keeps the
+ * most rooms, the cheapest price and the last added entry of its subtree.
+ */
+struct ServiceShape_t {
+	int area;
+	int rooms;
+	ServiceEntry entries;
+	unsigned int priority;
+	int max_rooms;
+	int min_price;
+	ServiceEntry latest;
+	ServiceShape left;
+	ServiceShape right;
+};
+
+/*
+ * A price or an area, and how many apartments of the service have it. the
+ * nodes are kept in a treap in the order of their values, where each node
+ * also keeps the amount of apartments in its subtree.
+ */
+struct RankNode_t {
+	int value;
+	int count;
+	int size;
+	unsigned int priority;
+	RankNode left;
+	RankNode right;
+};
+
+/*
+ * entries holds the apartments in the order they were added in, so they
+ * are got by index in logarithmic expected time. shapes holds the shapes of
+ * the apartments by area and then by rooms, so a search skips the subtrees
+ * of too small an area in logarithmic expected time, and the subtrees with
+ * too few rooms, too high prices or no entry later than the one found by
+ * their summaries. it finds the last added apartment of each shape it
+ * visits with at most its price in logarithmic expected time. ids finds the
+ * entry of an id in constant expected time, and prices and areas find the
+ * medians in logarithmic expected time.
+ *
+ * the priorities of the treaps are drawn from a generator seeded the same
+ * for every service, so runs over the same apartments build the same trees.
+ */
+struct apartment_service_t {
+	int capacity;
+	ServiceEntry entries;
+	ServiceShape shapes;
+	Map ids;
+	RankNode prices;
+	RankNode areas;
+	long long next_sequence;
+	unsigned int seed;
+};
+
+static MapDataElement copyEntry(constMapDataElement data);
+static MapKeyElement copyId(constMapKeyElement key);
+static void freeEntry(MapDataElement data);
+static void freeId(MapKeyElement key);
+static int compareIds(constMapKeyElement first, constMapKeyElement second);
+static unsigned int hashId(constMapKeyElement key);
+static unsigned int nextPriority(ApartmentService service);
+static int getSize(ApartmentService service);
+static ApartmentServiceResult addEntry(ApartmentService service,
+	Apartment apartment, int id);
+static void removeEntry(ApartmentService service, ServiceEntry entry);
+static bool copyEntries(ApartmentService copy, ServiceEntry entry);
+static void destroyEntries(ServiceEntry entry);
+static void updateEntry(ServiceEntry entry);
+static ServiceEntry mergeEntries(ServiceEntry first, ServiceEntry second);
+static ServiceEntry unlinkEntry(ServiceEntry entry, long long sequence);
+static ServiceEntry selectEntry(ServiceEntry entry, int index);
+static ServiceShape findShape(ServiceShape shape, int area, int rooms);
+static bool addToShape(ApartmentService service, ServiceEntry entry);
+static void removeFromShape(ApartmentService service, ServiceEntry entry);
+static void destroyShapes(ServiceShape shape);
+static bool isShapeBefore(int area, int rooms, ServiceShape shape);
+static void updateShape(ServiceShape shape);
+static void refreshShapes(ServiceShape node, ServiceShape shape);
+static ServiceShape insertShape(ServiceShape node, ServiceShape shape);
+static void splitShapes(ServiceShape node, ServiceShape shape,
+	ServiceShape* less, ServiceShape* greater);
+static ServiceShape mergeShapes(ServiceShape first, ServiceShape second);
+static ServiceShape unlinkShape(ServiceShape node, ServiceShape shape);
+static void searchShapes(ServiceShape shape, int area, int rooms, int price,
+	ServiceEntry* found);
+static ServiceEntry searchIdentical(ApartmentService service,
+	Apartment apartment);
+static bool isCheaper(ServiceEntry first, ServiceEntry second);
+static ServiceEntry laterOf(ServiceEntry first, ServiceEntry second);
+static void updatePriced(ServiceEntry entry);
+static ServiceEntry insertPriced(ServiceEntry node, ServiceEntry entry);
+static void splitPriced(ServiceEntry node, ServiceEntry entry,
+	ServiceEntry* less, ServiceEntry* greater);
+static ServiceEntry mergePriced(ServiceEntry first, ServiceEntry second);
+static ServiceEntry unlinkPriced(ServiceEntry node, ServiceEntry entry);
+static ServiceEntry findCheapLatest(ServiceEntry entry, int price);
+static ServiceEntry findIdentical(ServiceEntry entry, Apartment apartment,
+	int price);
+static bool addRank(ApartmentService service, RankNode* root, int value);
+static void removeRank(RankNode* root, int value);
+static void changeRankCount(RankNode node, int value, int change);
+static void destroyRanks(RankNode node);
+static void updateRank(RankNode node);
+static RankNode insertRank(RankNode node, RankNode leaf);
+static void splitRanks(RankNode node, int value, RankNode* less,
+	RankNode* greater);
+static RankNode mergeRanks(RankNode first, RankNode second);
+static int selectRank(RankNode node, int index);
+static ApartmentServiceResult getMedian(ApartmentService service,
+	RankNode root, int* outResult);
+
+/**
+* serviceCreate: Allocates a new empty apartment service.
+*
+* @param maxNumOfApartments the most apartments the service holds.
+*
+* @return
+* 	NULL if maxNumOfApartments is not positive or allocations failed.
+* 	A new service in case of success.
+*/
+ApartmentService serviceCreate(int maxNumOfApartments) {
+	if (maxNumOfApartments <= 0) return NULL;
+	ApartmentService service = malloc(sizeof(*service));
+	if (service == NULL) return NULL;
+	service->ids = mapCreateHashed(copyEntry, copyId, freeEntry, freeId,
+		compareIds, hashId);
+	if (service->ids == NULL) {
+		free(service);
+		return NULL;
+	}
+	service->capacity = maxNumOfApartments;
+	service->entries = NULL;
+	service->shapes = NULL;
+	service->prices = NULL;
+	service->areas = NULL;
+	service->next_sequence = 0;
+	service->seed = INITIAL_SEED;
+	return service;
+}
+
+/**
+* serviceCopy: Creates a copy of an apartment service, with copies of its
+* apartments in the same order.
+*
+* @param service the service to copy.
+*
+* @return
+* 	NULL if service is NULL or allocations failed.
+* 	A new service in case of success.
+*/
+ApartmentService serviceCopy(ApartmentService service) {
+	if (service == NULL) return NULL;
+	ApartmentService copy = serviceCreate(service->capacity);
+	if (copy == NULL) return NULL;
+	if (!copyEntries(copy, service->entries)) {
+		serviceDestroy(copy);
+		return NULL;
+	}
+	return copy;
+}
+
+/**
+* serviceDestroy: Deallocates an apartment service and its apartments.
+*
+* @param service the service to deallocate. If service is NULL nothing will
+* 	be done
+*/
+void serviceDestroy(ApartmentService service) {
+	if (service == NULL) return;
+	mapDestroy(service->ids);
+	destroyEntries(service->entries);
+	destroyShapes(service->shapes);
+	destroyRanks(service->prices);
+	destroyRanks(service->areas);
+	free(service);
+}
+
+/**
+* serviceNumberOfApatments: returns the amount of apartments in a service.
+*
+* @param service the service.
+*
+* @return
+* 	-1 if service is NULL; else the amount of apartments.
+*/
+int serviceNumberOfApatments(ApartmentService service) {
+	if (service == NULL) return NULL_SERVICE_SIZE;
+	return getSize(service);
+}
+
+/**
+* serviceAddApartment: adds a copy of an apartment to a service, after the
+* apartments added before it.
+*
+* @param service the service.
+* @param apartment the apartment to add.
+* @param id the id of the apartment.
+*
+* @return
+* 	APARTMENT_SERVICE_NULL_ARG if service or apartment are NULL.
+* 	APARTMENT_SERVICE_OUT_OF_BOUNDS if id is negative.
+* 	APARTMENT_SERVICE_FULL if the service holds its most apartments.
+* 	APARTMENT_SERVICE_ALREADY_EXISTS if an apartment with id is in service.
+* 	APARTMENT_SERVICE_OUT_OF_MEM if allocations failed.
+* 	APARTMENT_SERVICE_SUCCESS in case of success.
+*/
+ApartmentServiceResult serviceAddApartment(ApartmentService service,
+		Apartment apartment, int id) {
+	if ((service == NULL) || (apartment == NULL))
+		return APARTMENT_SERVICE_NULL_ARG;
+	if (id < 0) return APARTMENT_SERVICE_OUT_OF_BOUNDS;
+	if (getSize(service) == service->capacity) return APARTMENT_SERVICE_FULL;
+	if (mapContains(service->ids, &id)) return APARTMENT_SERVICE_ALREADY_EXISTS;
+	return addEntry(service, apartment, id);
+}
+
+/**
+* servicePriceMedian: finds the median of the prices of the apartments of a
+* service. for an even amount of apartments, it is the average of the two
+* middle prices.
+*
+* @param service the service.
+* @param outResult pointer to save the median in.
+*
+* @return
+* 	APARTMENT_SERVICE_NULL_ARG if service or outResult are NULL.
+* 	APARTMENT_SERVICE_EMPTY if the service has no apartments.
+* 	APARTMENT_SERVICE_SUCCESS in case of success.
+*/
+ApartmentServiceResult servicePriceMedian(ApartmentService service,
+		int* outResult) {
+	if (service == NULL) return APARTMENT_SERVICE_NULL_ARG;
+	return getMedian(service, service->prices, outResult);
+}
+
+/**
+* serviceAreaMedian: finds the median of the areas of the apartments of a
+* service. for an even amount of apartments, it is the average of the two
+* middle areas.
+*
+* @param service the service.
+* @param outResult pointer to save the median in.
+*
+* @return
+* 	APARTMENT_SERVICE_NULL_ARG if service or outResult are NULL.
+* 	APARTMENT_SERVICE_EMPTY if the service has no apartments.
+* 	APARTMENT_SERVICE_SUCCESS in case of success.
+*/
+ApartmentServiceResult serviceAreaMedian(ApartmentService service,
+		int* outResult) {
+	if (service == NULL) return APARTMENT_SERVICE_NULL_ARG;
+	return getMedian(service, service->areas, outResult);
+}
+
+/**
+* serviceDeleteApartment: removes the last added apartment of a service
+* which is identical to a given apartment.
+*
+* @param service the service.
+* @param apartment the apartment to remove the identical of.
+*
+* @return
+* 	APARTMENT_SERVICE_NULL_ARG if service or apartment are NULL.
+* 	APARTMENT_SERVICE_EMPTY if the service has no apartments.
+* 	APARTMENT_SERVICE_NO_FIT if no apartment is identical to apartment.
+* 	APARTMENT_SERVICE_SUCCESS in case of success.
+*/
+ApartmentServiceResult serviceDeleteApartment(ApartmentService service,
+		Apartment apartment) {
+	if ((service == NULL) || (apartment == NULL))
+		return APARTMENT_SERVICE_NULL_ARG;
+	if (service->entries == NULL) return APARTMENT_SERVICE_EMPTY;
+	ServiceEntry entry = searchIdentical(service, apartment);
+	if (entry == NULL) return APARTMENT_SERVICE_NO_FIT;
+	removeEntry(service, entry);
+	return APARTMENT_SERVICE_SUCCESS;
+}
+
+/**
+* serviceDeleteById: removes the apartment of an id from a service.
+*
+* @param service the service.
+* @param id the id of the apartment.
+*
+* @return
+* 	APARTMENT_SERVICE_NULL_ARG if service is NULL.
+* 	APARTMENT_SERVICE_OUT_OF_BOUNDS if id is negative.
+* 	APARTMENT_SERVICE_EMPTY if the service has no apartments.
+* 	APARTMENT_SERVICE_NO_FIT if no apartment has id.
+* 	APARTMENT_SERVICE_SUCCESS in case of success.
+*/
+ApartmentServiceResult serviceDeleteById(ApartmentService service, int id) {
+	if (service == NULL) return APARTMENT_SERVICE_NULL_ARG;
+	if (id < 0) return APARTMENT_SERVICE_OUT_OF_BOUNDS;
+	if (service->entries == NULL) return APARTMENT_SERVICE_EMPTY;
+	ServiceEntry entry = mapGet(service->ids, &id);
+	if (entry == NULL) return APARTMENT_SERVICE_NO_FIT;
+	removeEntry(service, entry);
+	return APARTMENT_SERVICE_SUCCESS;
+}
+
+/**
+* serviceGetById: gets a copy of the apartment of an id.
+*
+* @param service the service.
+* @param id the id of the apartment.
+* @param outApartment pointer to save the copy in, or NULL if it fails.
+*
+* @return
+* 	APARTMENT_SERVICE_NULL_ARG if service or outApartment are NULL.
+* 	APARTMENT_SERVICE_OUT_OF_BOUNDS if id is negative.
+* 	APARTMENT_SERVICE_EMPTY if the service has no apartments.
+* 	APARTMENT_SERVICE_NO_FIT if no apartment has id.
+* 	APARTMENT_SERVICE_OUT_OF_MEM if allocations failed.
+* 	APARTMENT_SERVICE_SUCCESS in case of success.
+*/
+ApartmentServiceResult serviceGetById(ApartmentService service, int id,
+		Apartment* outApartment) {
+	if ((service == NULL) || (outApartment == NULL))
+		return APARTMENT_SERVICE_NULL_ARG;
+	*outApartment = NULL;
+	if (id < 0) return APARTMENT_SERVICE_OUT_OF_BOUNDS;
+	if (service->entries == NULL) return APARTMENT_SERVICE_EMPTY;
+	ServiceEntry entry = mapGet(service->ids, &id);
+	if (entry == NULL) return APARTMENT_SERVICE_NO_FIT;
+	*outApartment = apartmentCopy(entry->apartment);
+	return (*outApartment == NULL) ? APARTMENT_SERVICE_OUT_OF_MEM :
+		APARTMENT_SERVICE_SUCCESS;
+}
+
+/**
+* serviceSearch: gets a copy of the last added apartment of a service which
+* has at least a given area and amount of rooms, and at most a given price.
+*
+* @param service the service.
+* @param area the least area.
+* @param rooms the least amount of rooms.
+* @param price the highest price.
+* @param outApartment pointer to save the copy in, or NULL if it fails.
+*
+* @return
+* 	APARTMENT_SERVICE_NULL_ARG if service or outApartment are NULL.
+* 	APARTMENT_SERVICE_OUT_OF_BOUNDS if area, rooms or price are negative.
+* 	APARTMENT_SERVICE_EMPTY if the service has no apartments.
+* 	APARTMENT_SERVICE_NO_FIT if no apartment fits.
+* 	APARTMENT_SERVICE_OUT_OF_MEM if allocations failed.
+* 	APARTMENT_SERVICE_SUCCESS in case of success.
+*/
+ApartmentServiceResult serviceSearch(ApartmentService service, int area,
+		int rooms, int price, Apartment* outApartment) {
+	if ((service == NULL) || (outApartment == NULL))
+		return APARTMENT_SERVICE_NULL_ARG;
+	*outApartment = NULL;
+	if ((area < 0) || (rooms < 0) || (price < 0))
+		return APARTMENT_SERVICE_OUT_OF_BOUNDS;
+	if (service->entries == NULL) return APARTMENT_SERVICE_EMPTY;
+	ServiceEntry entry = NULL;
+	searchShapes(service->shapes, area, rooms, price, &entry);
+	if (entry == NULL) return APARTMENT_SERVICE_NO_FIT;
+	*outApartment = apartmentCopy(entry->apartment);
+	return (*outApartment == NULL) ? APARTMENT_SERVICE_OUT_OF_MEM :
+		APARTMENT_SERVICE_SUCCESS;
+}
+
+/**
+* serviceGetCapacity: returns the most apartments a service holds.
+*
+* @param service the service.
+*
+* @return
+* 	-1 if service is NULL; else the most apartments.
+*/
+int serviceGetCapacity(ApartmentService service) {
+	return (service == NULL) ? NULL_SERVICE_SIZE : service->capacity;
+}
+
+/**
+* serviceGetByIndex: gets a copy of an apartment of a service and its id, by
+* the order the apartments were added in.
+*
+* @param service the service.
+* @param index the index of the apartment, from 0 for the first added.
+* @param outApartment pointer to save the copy in.
+* @param outId pointer to save the id in.
+*
+* @return
+* 	APARTMENT_SERVICE_NULL_ARG if service, outApartment or outId are NULL.
+* 	APARTMENT_SERVICE_OUT_OF_BOUNDS if index is negative, or not below the
+* 	amount of apartments.
+* 	APARTMENT_SERVICE_OUT_OF_MEM if allocations failed.
+* 	APARTMENT_SERVICE_SUCCESS in case of success.
+*/
+ApartmentServiceResult serviceGetByIndex(ApartmentService service, int index,
+		Apartment* outApartment, int* outId) {
+	if ((service == NULL) || (outApartment == NULL) || (outId == NULL))
+		return APARTMENT_SERVICE_NULL_ARG;
+	if ((index < 0) || (index >= getSize(service)))
+		return APARTMENT_SERVICE_OUT_OF_BOUNDS;
+	ServiceEntry entry = selectEntry(service->entries, index);
+	*outApartment = apartmentCopy(entry->apartment);
+	if (*outApartment == NULL) return APARTMENT_SERVICE_OUT_OF_MEM;
+	*outId = entry->id;
+	return APARTMENT_SERVICE_SUCCESS;
+}
+
+/** Function to be used for putting entries in the ids map, which does not
+ * copy them */
+static MapDataElement copyEntry(constMapDataElement data) {
+	return (MapDataElement)data;
+}
+
+/** Function to be used for putting ids in the ids map, which keeps the ids
+ * of the entries */
+static MapKeyElement copyId(constMapKeyElement key) {
+	return (MapKeyElement)key;
+}
+
+/** Function to be used for removing entries from the ids map, which does
+ * not free them */
+static void freeEntry(MapDataElement data) {
+	(void)data;
+}
+
+/** Function to be used for removing ids from the ids map */
+static void freeId(MapKeyElement key) {
+	(void)key;
+}
+
+/** Function to be used for comparing ids in the ids map */
+static int compareIds(constMapKeyElement first, constMapKeyElement second) {
+	int first_id = *(const int*)first, second_id = *(const int*)second;
+	return (first_id > second_id) - (first_id < second_id);
+}
+
+/** Function to be used for hashing ids in the ids map */
+static unsigned int hashId(constMapKeyElement key) {
+	return (unsigned int)*(const int*)key;
+}
+
+/*
+ * nextPriority: draws the priority of a new treap node, by a xorshift
+ * generator.
+ */
+static unsigned int nextPriority(ApartmentService service) {
+	service->seed ^= service->seed << 13;
+	service->seed ^= service->seed >> 17;
+	service->seed ^= service->seed << 5;
+	return service->seed;
+}
+
+/*
+ * getSize: returns the amount of apartments in a service.
+ */
+static int getSize(ApartmentService service) {
+	return (service->entries == NULL) ? 0 : service->entries->size;
+}
+
+/*
+ * addEntry: adds a copy of an apartment with an id not in the service after
+ * its apartments, and indexes it by its id, price and area.
+ */
+static ApartmentServiceResult addEntry(ApartmentService service,
+		Apartment apartment, int id) {
+	ServiceEntry entry = malloc(sizeof(*entry));
+	if (entry == NULL) return APARTMENT_SERVICE_OUT_OF_MEM;
+	entry->apartment = apartmentCopy(apartment);
+	if (entry->apartment == NULL) {
+		free(entry);
+		return APARTMENT_SERVICE_OUT_OF_MEM;
+	}
+	entry->id = id;
+	entry->price = apartmentGetPrice(apartment);
+	entry->area = apartmentTotalArea(apartment);
+	entry->rooms = apartmentNumOfRooms(apartment);
+	entry->sequence = service->next_sequence++;
+	entry->priority = nextPriority(service);
+	entry->left = NULL;
+	entry->right = NULL;
+	updateEntry(entry);
+	bool is_price_added = addRank(service, &service->prices, entry->price);
+	bool is_area_added = is_price_added &&
+		addRank(service, &service->areas, entry->area);
+	bool is_shaped = is_area_added && addToShape(service, entry);
+	if (!is_shaped ||
+		(mapPut(service->ids, &entry->id, entry) != MAP_SUCCESS)) {
+		if (is_shaped) removeFromShape(service, entry);
+		if (is_area_added) removeRank(&service->areas, entry->area);
+		if (is_price_added) removeRank(&service->prices, entry->price);
+		apartmentDestroy(entry->apartment);
+		free(entry);
+		return APARTMENT_SERVICE_OUT_OF_MEM;
+	}
+	service->entries = mergeEntries(service->entries, entry);
+	return APARTMENT_SERVICE_SUCCESS;
+}
+
+/*
+ * removeEntry: takes an entry out of the service and its indexes, and
+ * deallocates it and its apartment.
+ */
+static void removeEntry(ApartmentService service, ServiceEntry entry) {
+	mapRemove(service->ids, &entry->id);
+	removeRank(&service->prices, entry->price);
+	removeRank(&service->areas, entry->area);
+	removeFromShape(service, entry);
+	service->entries = unlinkEntry(service->entries, entry->sequence);
+	apartmentDestroy(entry->apartment);
+	free(entry);
+}
+
+/*
+ * copyEntries: adds copies of the apartments of a subtree to a service, in
+ * their order. returns false if allocations failed.
+ */
+static bool copyEntries(ApartmentService copy, ServiceEntry entry) {
+	if (entry == NULL) return true;
+	return copyEntries(copy, entry->left) &&
+		(addEntry(copy, entry->apartment, entry->id) ==
+		APARTMENT_SERVICE_SUCCESS) &&
+		copyEntries(copy, entry->right);
+}
+
+/*
+ * destroyEntries: deallocates the entries of a subtree and their
+ * apartments.
+ */
+static void destroyEntries(ServiceEntry entry) {
+	if (entry == NULL) return;
+	destroyEntries(entry->left);
+	destroyEntries(entry->right);
+	apartmentDestroy(entry->apartment);
+	free(entry);
+}
+
+/*
+ * updateEntry: recomputes the size of the subtree of an entry from its
+ * children.
+ */
+static void updateEntry(ServiceEntry entry) {
+	entry->size = 1;
+	if (entry->left != NULL) entry->size += entry->left->size;
+	if (entry->right != NULL) entry->size += entry->right->size;
+}
+
+/*
+ * mergeEntries: joins two treaps of entries, all the entries of first added
+ * before those of second, and returns the root of the joined treap.
+ */
+static ServiceEntry mergeEntries(ServiceEntry first, ServiceEntry second) {
+	if (first == NULL) return second;
+	if (second == NULL) return first;
+	if (first->priority > second->priority) {
+		first->right = mergeEntries(first->right, second);
+		updateEntry(first);
+		return first;
+	}
+	second->left = mergeEntries(first, second->left);
+	updateEntry(second);
+	return second;
+}
+
+/*
+ * unlinkEntry: takes the entry of a sequence out of a treap without
+ * deallocating it, and returns the root of the treap.
+ */
+static ServiceEntry unlinkEntry(ServiceEntry entry, long long sequence) {
+	if (entry == NULL) return NULL;
+	if (entry->sequence == sequence)
+		return mergeEntries(entry->left, entry->right);
+	if (sequence < entry->sequence) {
+		entry->left = unlinkEntry(entry->left, sequence);
+	} else {
+		entry->right = unlinkEntry(entry->right, sequence);
+	}
+	updateEntry(entry);
+	return entry;
+}
+
+/*
+ * selectEntry: returns the entry of an index below the size of a treap, in
+ * the order the entries were added in.
+ */
+static ServiceEntry selectEntry(ServiceEntry entry, int index) {
+	while (entry != NULL) {
+		int left_size = (entry->left == NULL) ? 0 : entry->left->size;
+		if (index == left_size) return entry;
+		if (index < left_size) {
+			entry = entry->left;
+		} else {
+			index -= left_size + 1;
+			entry = entry->right;
+		}
+	}
+	return NULL;
+}
+
+/*
+ * findShape: returns the shape of an area and an amount of rooms in a treap
+ * of shapes, or NULL if no apartment has it.
+ */
+static ServiceShape findShape(ServiceShape shape, int area, int rooms) {
+	while ((shape != NULL) &&
+		((shape->area != area) || (shape->rooms != rooms))) {
+		shape = isShapeBefore(area, rooms, shape) ? shape->left : shape->right;
+	}
+	return shape;
+}
+
+/*
+ * addToShape: inserts an entry into the treap of its shape, and adds the
+ * shape if it is new. returns false if allocations failed.
+ */
+static bool addToShape(ApartmentService service, ServiceEntry entry) {
+	entry->cheaper = NULL;
+	entry->pricier = NULL;
+	updatePriced(entry);
+	ServiceShape shape = findShape(service->shapes, entry->area,
+		entry->rooms);
+	if (shape != NULL) {
+		shape->entries = insertPriced(shape->entries, entry);
+		refreshShapes(service->shapes, shape);
+		return true;
+	}
+	shape = malloc(sizeof(*shape));
+	if (shape == NULL) return false;
+	shape->area = entry->area;
+	shape->rooms = entry->rooms;
+	shape->entries = entry;
+	shape->priority = nextPriority(service);
+	shape->left = NULL;
+	shape->right = NULL;
+	updateShape(shape);
+	service->shapes = insertShape(service->shapes, shape);
+	return true;
+}
+
+/*
+ * removeFromShape: takes an entry out of the treap of its shape, and
+ * removes the shape if no apartment has it anymore.
+ */
+static void removeFromShape(ApartmentService service, ServiceEntry entry) {
+	ServiceShape shape = findShape(service->shapes, entry->area,
+		entry->rooms);
+	shape->entries = unlinkPriced(shape->entries, entry);
+	if (shape->entries != NULL) {
+		refreshShapes(service->shapes, shape);
+		return;
+	}
+	service->shapes = unlinkShape(service->shapes, shape);
+	free(shape);
+}
+
+/*
+ * destroyShapes: deallocates a treap of shapes, without their entries.
+ */
+static void destroyShapes(ServiceShape shape) {
+	if (shape == NULL) return;
+	destroyShapes(shape->left);
+	destroyShapes(shape->right);
+	free(shape);
+}
+
+/*
+ * isShapeBefore: checks if an area and an amount of rooms come before a
+ * shape in the treap of shapes, by area and then by rooms.
+ */
+static bool isShapeBefore(int area, int rooms, ServiceShape shape) {
+	if (area != shape->area) return area < shape->area;
+	return rooms < shape->rooms;
+}
+
+/*
+ * updateShape: recomputes the most rooms, the cheapest price and the last
+ * added entry of the subtree of a shape from its entries and its children.
+ */
+static void updateShape(ServiceShape shape) {
+	shape->max_rooms = shape->rooms;
+	shape->min_price = shape->entries->cheapest->price;
+	shape->latest = shape->entries->latest;
+	ServiceShape children[] = {shape->left, shape->right};
+	for (int i = 0; i < 2; i++) {
+		if (children[i] == NULL) continue;
+		if (children[i]->max_rooms > shape->max_rooms)
+			shape->max_rooms = children[i]->max_rooms;
+		if (children[i]->min_price < shape->min_price)
+			shape->min_price = children[i]->min_price;
+		shape->latest = laterOf(shape->latest, children[i]->latest);
+	}
+}
+
+/*
+ * refreshShapes: recomputes the summaries of the subtrees of a treap of
+ * shapes on the way to a shape whose entries changed.
+ */
+static void refreshShapes(ServiceShape node, ServiceShape shape) {
+	if (node != shape) {
+		refreshShapes(isShapeBefore(shape->area, shape->rooms, node) ?
+			node->left : node->right, shape);
+	}
+	updateShape(node);
+}
+
+/*
+ * insertShape: inserts a shape with no children into a treap of shapes, and
+ * returns the root of the treap.
+ */
+static ServiceShape insertShape(ServiceShape node, ServiceShape shape) {
+	if (node == NULL) return shape;
+	if (shape->priority > node->priority) {
+		splitShapes(node, shape, &shape->left, &shape->right);
+		updateShape(shape);
+		return shape;
+	}
+	if (isShapeBefore(shape->area, shape->rooms, node)) {
+		node->left = insertShape(node->left, shape);
+	} else {
+		node->right = insertShape(node->right, shape);
+	}
+	updateShape(node);
+	return node;
+}
+
+/*
+ * splitShapes: splits a treap of shapes into the treap of the shapes before
+ * a given shape and the treap of those after it.
+ */
+static void splitShapes(ServiceShape node, ServiceShape shape,
+		ServiceShape* less, ServiceShape* greater) {
+	if (node == NULL) {
+		*less = NULL;
+		*greater = NULL;
+	} else if (isShapeBefore(node->area, node->rooms, shape)) {
+		splitShapes(node->right, shape, &node->right, greater);
+		updateShape(node);
+		*less = node;
+	} else {
+		splitShapes(node->left, shape, less, &node->left);
+		updateShape(node);
+		*greater = node;
+	}
+}
+
+/*
+ * mergeShapes: joins two treaps of shapes, all the shapes of first before
+ * those of second, and returns the root of the joined treap.
+ */
+static ServiceShape mergeShapes(ServiceShape first, ServiceShape second) {
+	if (first == NULL) return second;
+	if (second == NULL) return first;
+	if (first->priority > second->priority) {
+		first->right = mergeShapes(first->right, second);
+		updateShape(first);
+		return first;
+	}
+	second->left = mergeShapes(first, second->left);
+	updateShape(second);
+	return second;
+}
+
+/*
+ * unlinkShape: takes a shape out of a treap of shapes without deallocating
+ * it, and returns the root of the treap.
+ */
+static ServiceShape unlinkShape(ServiceShape node, ServiceShape shape) {
+	if (node == shape) return mergeShapes(node->left, node->right);
+	if (isShapeBefore(shape->area, shape->rooms, node)) {
+		node->left = unlinkShape(node->left, shape);
+	} else {
+		node->right = unlinkShape(node->right, shape);
+	}
+	updateShape(node);
+	return node;
+}
+
+/*
+ * searchShapes: updates found to the last added entry of a treap of shapes
+ * which has at least area and rooms and at most price, if it is later.
+ * shapes before area and rooms skip their left subtrees, as every shape
+ * that fits comes after them, and subtrees whose summaries show that no
+ * entry fits or is later than found are skipped. the child with the last
+ * added entry is visited first, so found skips more of the other.
+ */
+static void searchShapes(ServiceShape shape, int area, int rooms, int price,
+		ServiceEntry* found) {
+	if ((shape == NULL) || (shape->max_rooms < rooms) ||
+		(shape->min_price > price) || ((*found != NULL) &&
+		(shape->latest->sequence <= (*found)->sequence))) return;
+	if ((shape->area < area) ||
+		((shape->area == area) && (shape->rooms < rooms))) {
+		searchShapes(shape->right, area, rooms, price, found);
+		return;
+	}
+	if ((shape->rooms >= rooms) && ((*found == NULL) ||
+		(shape->entries->latest->sequence > (*found)->sequence)))
+		*found = laterOf(*found, findCheapLatest(shape->entries, price));
+	ServiceShape first = shape->left, second = shape->right;
+	if ((first == NULL) || ((second != NULL) &&
+		(second->latest->sequence > first->latest->sequence))) {
+		first = shape->right;
+		second = shape->left;
+	}
+	searchShapes(first, area, rooms, price, found);
+	searchShapes(second, area, rooms, price, found);
+}
+
+/*
+ * searchIdentical: returns the last added entry of a service whose
+ * apartment is identical to a given apartment, or NULL if there is none.
+ * identical apartments have the same area, rooms and price.
+ */
+static ServiceEntry searchIdentical(ApartmentService service,
+		Apartment apartment) {
+	ServiceShape shape = findShape(service->shapes,
+		apartmentTotalArea(apartment), apartmentNumOfRooms(apartment));
+	return (shape == NULL) ? NULL : findIdentical(shape->entries, apartment,
+		apartmentGetPrice(apartment));
+}
+
+/*
+ * isCheaper: checks if an entry comes before another in the treap of their
+ * shape, by price and then by the order they were added in.
+ */
+static bool isCheaper(ServiceEntry first, ServiceEntry second) {
+	if (first->price != second->price) return first->price < second->price;
+	return first->sequence < second->sequence;
+}
+
+/*
+ * laterOf: returns the last added of two entries, either of which may be
+ * NULL.
+ */
+static ServiceEntry laterOf(ServiceEntry first, ServiceEntry second) {
+	if (first == NULL) return second;
+	if (second == NULL) return first;
+	return (first->sequence > second->sequence) ? first : second;
+}
+
+/*
+ * updatePriced: recomputes the last added and the cheapest entries of the
+ * subtree of an entry in the treap of its shape from its children.
+ */
+static void updatePriced(ServiceEntry entry) {
+	entry->latest = entry;
+	entry->cheapest = (entry->cheaper == NULL) ? entry :
+		entry->cheaper->cheapest;
+	if (entry->cheaper != NULL)
+		entry->latest = laterOf(entry->latest, entry->cheaper->latest);
+	if (entry->pricier != NULL)
+		entry->latest = laterOf(entry->latest, entry->pricier->latest);
+}
+
+/*
+ * insertPriced: inserts an entry with no children into the treap of a
+ * shape, and returns the root of the treap.
+ */
+static ServiceEntry insertPriced(ServiceEntry node, ServiceEntry entry) {
+	if (node == NULL) return entry;
+	if (entry->priority > node->priority) {
+		splitPriced(node, entry, &entry->cheaper, &entry->pricier);
+		updatePriced(entry);
+		return entry;
+	}
+	if (isCheaper(entry, node)) {
+		node->cheaper = insertPriced(node->cheaper, entry);
+	} else {
+		node->pricier = insertPriced(node->pricier, entry);
+	}
+	updatePriced(node);
+	return node;
+}
+
+/*
+ * splitPriced: splits the treap of a shape into the treap of the entries
+ * before a given entry and the treap of those after it.
+ */
+static void splitPriced(ServiceEntry node, ServiceEntry entry,
+		ServiceEntry* less, ServiceEntry* greater) {
+	if (node == NULL) {
+		*less = NULL;
+		*greater = NULL;
+	} else if (isCheaper(node, entry)) {
+		splitPriced(node->pricier, entry, &node->pricier, greater);
+		updatePriced(node);
+		*less = node;
+	} else {
+		splitPriced(node->cheaper, entry, less, &node->cheaper);
+		updatePriced(node);
+		*greater = node;
+	}
+}
+
+/*
+ * mergePriced: joins two treaps of a shape, all the entries of first before
+ * those of second, and returns the root of the joined treap.
+ */
+static ServiceEntry mergePriced(ServiceEntry first, ServiceEntry second) {
+	if (first == NULL) return second;
+	if (second == NULL) return first;
+	if (first->priority > second->priority) {
+		first->pricier = mergePriced(first->pricier, second);
+		updatePriced(first);
+		return first;
+	}
+	second->cheaper = mergePriced(first, second->cheaper);
+	updatePriced(second);
+	return second;
+}
+
+/*
+ * unlinkPriced: takes an entry out of the treap of its shape, and returns
+ * the root of the treap.
+ */
+static ServiceEntry unlinkPriced(ServiceEntry node, ServiceEntry entry) {
+	if (node == NULL) return NULL;
+	if (node == entry) return mergePriced(node->cheaper, node->pricier);
+	if (isCheaper(entry, node)) {
+		node->cheaper = unlinkPriced(node->cheaper, entry);
+	} else {
+		node->pricier = unlinkPriced(node->pricier, entry);
+	}
+	updatePriced(node);
+	return node;
+}
+
+/*
+ * findCheapLatest: returns the last added entry of the treap of a shape
+ * with at most price, or NULL if there is none.
+ */
+static ServiceEntry findCheapLatest(ServiceEntry entry, int price) {
+	ServiceEntry found = NULL;
+	while (entry != NULL) {
+		if (entry->price > price) {
+			entry = entry->cheaper;
+		} else {
+			found = laterOf(found, entry);
+			if (entry->cheaper != NULL)
+				found = laterOf(found, entry->cheaper->latest);
+			entry = entry->pricier;
+		}
+	}
+	return found;
+}
+
+/*
+ * findIdentical: returns the last added entry of the treap of a shape with
+ * price whose apartment is identical to a given apartment, or NULL if there
+ * is none. the entries of equal prices are visited from the last added.
+ */
+static ServiceEntry findIdentical(ServiceEntry entry, Apartment apartment,
+		int price) {
+	if (entry == NULL) return NULL;
+	if (entry->price < price)
+		return findIdentical(entry->pricier, apartment, price);
+	if (entry->price > price)
+		return findIdentical(entry->cheaper, apartment, price);
+	ServiceEntry found = findIdentical(entry->pricier, apartment, price);
+	if (found != NULL) return found;
+	if (apartmentIsIdentical(entry->apartment, apartment)) return entry;
+	return findIdentical(entry->cheaper, apartment, price);
+}
+
+/*
+ * addRank: counts one more apartment with a value in a treap of values.
+ * returns false if allocations failed.
+ */
+static bool addRank(ApartmentService service, RankNode* root, int value) {
+	RankNode node = *root;
+	while ((node != NULL) && (node->value != value)) {
+		node = (value < node->value) ? node->left : node->right;
+	}
+	if (node != NULL) {
+		changeRankCount(*root, value, 1);
+		return true;
+	}
+	RankNode leaf = malloc(sizeof(*leaf));
+	if (leaf == NULL) return false;
+	leaf->value = value;
+	leaf->count = 1;
+	leaf->size = 1;
+	leaf->priority = nextPriority(service);
+	leaf->left = NULL;
+	leaf->right = NULL;
+	*root = insertRank(*root, leaf);
+	return true;
+}
+
+/*
+ * removeRank: counts one less apartment with a value in a treap of values,
+ * and deallocates the node of the value when no apartment has it.
+ */
+static void removeRank(RankNode* root, int value) {
+	RankNode node = *root;
+	if (node == NULL) return;
+	if (node->value != value) {
+		removeRank((value < node->value) ? &node->left : &node->right, value);
+		updateRank(node);
+	} else if (node->count > 1) {
+		node->count--;
+		node->size--;
+	} else {
+		*root = mergeRanks(node->left, node->right);
+		free(node);
+	}
+}
+
+/*
+ * changeRankCount: changes the count of a value in a treap of values, where
+ * the value is, and the sizes of the subtrees on its path.
+ */
+static void changeRankCount(RankNode node, int value, int change) {
+	while (node != NULL) {
+		node->size += change;
+		if (node->value == value) {
+			node->count += change;
+			return;
+		}
+		node = (value < node->value) ? node->left : node->right;
+	}
+}
+
+/*
+ * destroyRanks: deallocates the nodes of a treap of values.
+ */
+static void destroyRanks(RankNode node) {
+	if (node == NULL) return;
+	destroyRanks(node->left);
+	destroyRanks(node->right);
+	free(node);
+}
+
+/*
+ * updateRank: recomputes the amount of apartments in the subtree of a node
+ * from its children.
+ */
+static void updateRank(RankNode node) {
+	node->size = node->count;
+	if (node->left != NULL) node->size += node->left->size;
+	if (node->right != NULL) node->size += node->right->size;
+}
+
+/*
+ * insertRank: inserts a node with a value not in a treap of values, and
+ * returns the root of the treap.
+ */
+static RankNode insertRank(RankNode node, RankNode leaf) {
+	if (node == NULL) return leaf;
+	if (leaf->priority > node->priority) {
+		splitRanks(node, leaf->value, &leaf->left, &leaf->right);
+		updateRank(leaf);
+		return leaf;
+	}
+	if (leaf->value < node->value) {
+		node->left = insertRank(node->left, leaf);
+	} else {
+		node->right = insertRank(node->right, leaf);
+	}
+	updateRank(node);
+	return node;
+}
+
+/*
+ * splitRanks: splits a treap of values without a value into the treap of
+ * the values less than it and the treap of those greater.
+ */
+static void splitRanks(RankNode node, int value, RankNode* less,
+		RankNode* greater) {
+	if (node == NULL) {
+		*less = NULL;
+		*greater = NULL;
+	} else if (node->value < value) {
+		splitRanks(node->right, value, &node->right, greater);
+		updateRank(node);
+		*less = node;
+	} else {
+		splitRanks(node->left, value, less, &node->left);
+		updateRank(node);
+		*greater = node;
+	}
+}
+
+/*
+ * mergeRanks: joins two treaps of values, all the values of first less than
+ * those of second, and returns the root of the joined treap.
+ */
+static RankNode mergeRanks(RankNode first, RankNode second) {
+	if (first == NULL) return second;
+	if (second == NULL) return first;
+	if (first->priority > second->priority) {
+		first->right = mergeRanks(first->right, second);
+		updateRank(first);
+		return first;
+	}
+	second->left = mergeRanks(first, second->left);
+	updateRank(second);
+	return second;
+}
+
+/*
+ * selectRank: returns the value of an index below the size of a treap of
+ * values, counting each value as many times as apartments have it.
+ */
+static int selectRank(RankNode node, int index) {
+	while (node != NULL) {
+		int left_size = (node->left == NULL) ? 0 : node->left->size;
+		if (index < left_size) {
+			node = node->left;
+		} else if (index < left_size + node->count) {
+			return node->value;
+		} else {
+			index -= left_size + node->count;
+			node = node->right;
+		}
+	}
+	return 0;
+}
+
+/*
+ * getMedian: finds the median of a treap of values of the apartments of a
+ * service.
+ */
+static ApartmentServiceResult getMedian(ApartmentService service,
+		RankNode root, int* outResult) {
+	if (outResult == NULL) return APARTMENT_SERVICE_NULL_ARG;
+	int size = getSize(service);
+	if (size == 0) return APARTMENT_SERVICE_EMPTY;
+	int middle = selectRank(root, size / 2);
+	if (size % 2 == 0) middle = (selectRank(root, size / 2 - 1) + middle) / 2;
+	*outResult = middle;
+	return APARTMENT_SERVICE_SUCCESS;
+}
@@ -45,4 +45,9 @@ ApartmentServiceResult serviceSearch(ApartmentService service, int area,
 									 int rooms, int price, 
 									 Apartment* outApartment);
 
+int serviceGetCapacity(ApartmentService service);
+
+ApartmentServiceResult serviceGetByIndex(ApartmentService service, int index,
+										 Apartment* outApartment, int* outId);
+
 #endif /* APARTMENT_SERVICE_H */
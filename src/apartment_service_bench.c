@@ -0,0 +1,222 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "apartment_service.h"
+#include "monotonicClock.h"
+
+#define BENCH_MIN_EXPONENT 2
+#define BENCH_DEFAULT_MAX_EXPONENT 6
+#define BENCH_MAX_EXPONENT 6
+#define BENCH_QUERIES 10000
+#define BENCH_LAYOUTS 4096
+#define BENCH_MAX_SIDE 16
+#define BENCH_MAX_ROOMS 8
+#define BENCH_MAX_PRICE 1000000
+#define BENCH_SEED 88172645463325252ULL
+
+typedef enum {
+	BENCH_ADD,
+	BENCH_GET,
+	BENCH_SEARCH,
+	BENCH_MEDIAN,
+	BENCH_REMOVE,
+	BENCH_OPERATIONS
+} BenchOperation;
+
+static const char* operation_names[BENCH_OPERATIONS] = {"add", "get",
+	"search", "median", "remove"};
+
+static unsigned long long nextRandom(unsigned long long* state);
+static Apartment* createLayouts(unsigned long long* state);
+static void destroyLayouts(Apartment* layouts);
+static int* createIds(int count, unsigned long long* state);
+static bool runService(ApartmentService service, Apartment* layouts,
+	int* ids, int count, bool is_median_measured,
+	double nanoseconds[BENCH_OPERATIONS]);
+int RunApartmentServiceBench(int argc, char *argv[]);
+
+/*
+ * Measures the ApartmentService operations at 10^2 apartments and up by
+ * powers of ten: adding the apartments in random order of their ids,
+ * getting apartments by id, searching, finding the price and area medians
+ * and removing the apartments by id in random order. the gets, searches and
+ * medians are BENCH_QUERIES each, over the full service. prints the
+ * nanoseconds per operation of each.
+ *
+ * arguments are the largest power of ten of apartments, 6 by default and at
+ * most, and the most apartments the medians are measured with, all by
+ * default. the benchmark uses only the apartment_service.h functions, so it
+ * can be linked with Extern/libex1.a instead of apartment_service.c to
+ * measure the library version, whose medians take time quadratic in the
+ * amount of apartments.
+ */
+//int main(int argc, char *argv[]) {
+int RunApartmentServiceBench(int argc, char *argv[]) {
+	int max_exponent = (argc > 1) ? atoi(argv[1]) :
+		BENCH_DEFAULT_MAX_EXPONENT;
+	int median_max = (argc > 2) ? atoi(argv[2]) : -1;
+	if ((max_exponent < BENCH_MIN_EXPONENT) ||
+		(max_exponent > BENCH_MAX_EXPONENT)) {
+		printf("usage: %s [max exponent, %d to %d] [median max apartments]\n",
+			argv[0], BENCH_MIN_EXPONENT, BENCH_MAX_EXPONENT);
+		return 1;
+	}
+	unsigned long long state = BENCH_SEED;
+	Apartment* layouts = createLayouts(&state);
+	if (layouts == NULL) {
+		printf("out of memory\n");
+		return 1;
+	}
+	printf("%10s", "apartments");
+	for (int i = 0; i < BENCH_OPERATIONS; i++) {
+		printf(" %9s", operation_names[i]);
+	}
+	printf("  (ns/op)\n");
+	int count = 1;
+	for (int i = 0; i < BENCH_MIN_EXPONENT; i++) count *= 10;
+	for (int exponent = BENCH_MIN_EXPONENT; exponent <= max_exponent;
+		exponent++, count *= 10) {
+		int* ids = createIds(count, &state);
+		ApartmentService service = serviceCreate(count);
+		double nanoseconds[BENCH_OPERATIONS];
+		printf("%10d", count);
+		if ((ids == NULL) || (service == NULL) || !runService(service,
+			layouts, ids, count, (median_max < 0) || (count <= median_max),
+			nanoseconds)) {
+			printf(" failed\n");
+		} else {
+			for (int i = 0; i < BENCH_OPERATIONS; i++) {
+				if (nanoseconds[i] < 0) {
+					printf(" %9s", "-");
+				} else {
+					printf(" %9.1f", nanoseconds[i]);
+				}
+			}
+			printf("\n");
+		}
+		serviceDestroy(service);
+		free(ids);
+	}
+	destroyLayouts(layouts);
+	return 0;
+}
+
+/*
+ * nextRandom: draws the next number of a xorshift generator.
+ */
+static unsigned long long nextRandom(unsigned long long* state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+/*
+ * createLayouts: returns BENCH_LAYOUTS apartments of random sides and walls,
+ * which the benchmark adds at random prices. they come in thousands of
+ * pairs of area and rooms, so the searches are measured over many shapes.
+ */
+static Apartment* createLayouts(unsigned long long* state) {
+	Apartment* layouts = calloc(BENCH_LAYOUTS, sizeof(*layouts));
+	if (layouts == NULL) return NULL;
+	SquareType row_squares[BENCH_MAX_SIDE][BENCH_MAX_SIDE];
+	SquareType* squares[BENCH_MAX_SIDE];
+	for (int i = 0; i < BENCH_LAYOUTS; i++) {
+		int length = 1 + (int)(nextRandom(state) % BENCH_MAX_SIDE);
+		int width = 1 + (int)(nextRandom(state) % BENCH_MAX_SIDE);
+		for (int row = 0; row < length; row++) {
+			for (int col = 0; col < width; col++) {
+				row_squares[row][col] = (nextRandom(state) % 3 == 0) ?
+					WALL : EMPTY;
+			}
+			squares[row] = row_squares[row];
+		}
+		layouts[i] = apartmentCreate(squares, length, width,
+			(int)(nextRandom(state) % BENCH_MAX_PRICE));
+		if (layouts[i] == NULL) {
+			destroyLayouts(layouts);
+			return NULL;
+		}
+	}
+	return layouts;
+}
+
+/*
+ * destroyLayouts: deallocates the apartments of createLayouts.
+ */
+static void destroyLayouts(Apartment* layouts) {
+	for (int i = 0; i < BENCH_LAYOUTS; i++) apartmentDestroy(layouts[i]);
+	free(layouts);
+}
+
+/*
+ * createIds: returns the numbers below count in a random order.
+ */
+static int* createIds(int count, unsigned long long* state) {
+	int* ids = malloc(count * sizeof(*ids));
+	if (ids == NULL) return NULL;
+	for (int i = 0; i < count; i++) ids[i] = i;
+	for (int i = count - 1; i > 0; i--) {
+		int j = (int)(nextRandom(state) % (unsigned long long)(i + 1));
+		int id = ids[i];
+		ids[i] = ids[j];
+		ids[j] = id;
+	}
+	return ids;
+}
+
+/*
+ * runService: runs the operations over a service, and saves the nanoseconds
+ * per operation of each, or -1 for the medians if they are not measured.
+ * returns false if an operation failed.
+ */
+static bool runService(ApartmentService service, Apartment* layouts,
+		int* ids, int count, bool is_median_measured,
+		double nanoseconds[BENCH_OPERATIONS]) {
+	bool is_valid = true;
+	long long start = monotonicClockNow();
+	for (int i = 0; i < count; i++) {
+		if (serviceAddApartment(service, layouts[i % BENCH_LAYOUTS], ids[i])
+			!= APARTMENT_SERVICE_SUCCESS) is_valid = false;
+	}
+	long long add_end = monotonicClockNow();
+	for (int i = 0; i < BENCH_QUERIES; i++) {
+		Apartment apartment = NULL;
+		if (serviceGetById(service, ids[i % count], &apartment) !=
+			APARTMENT_SERVICE_SUCCESS) is_valid = false;
+		apartmentDestroy(apartment);
+	}
+	long long get_end = monotonicClockNow();
+	for (int i = 0; i < BENCH_QUERIES; i++) {
+		Apartment apartment = NULL;
+		ApartmentServiceResult result = serviceSearch(service,
+			i % (BENCH_MAX_SIDE * BENCH_MAX_SIDE / 2), i % BENCH_MAX_ROOMS,
+			(i * 7919) % BENCH_MAX_PRICE, &apartment);
+		if ((result != APARTMENT_SERVICE_SUCCESS) &&
+			(result != APARTMENT_SERVICE_NO_FIT)) is_valid = false;
+		apartmentDestroy(apartment);
+	}
+	long long search_end = monotonicClockNow();
+	for (int i = 0; is_median_measured && (i < BENCH_QUERIES); i += 2) {
+		int price = 0, area = 0;
+		if ((servicePriceMedian(service, &price) !=
+			APARTMENT_SERVICE_SUCCESS) || (serviceAreaMedian(service, &area)
+			!= APARTMENT_SERVICE_SUCCESS)) is_valid = false;
+	}
+	long long median_end = monotonicClockNow();
+	for (int i = count - 1; i >= 0; i--) {
+		if (serviceDeleteById(service, ids[i]) != APARTMENT_SERVICE_SUCCESS)
+			is_valid = false;
+	}
+	long long remove_end = monotonicClockNow();
+	long long ends[BENCH_OPERATIONS] = {add_end, get_end, search_end,
+		median_end, remove_end};
+	int operations[BENCH_OPERATIONS] = {count, BENCH_QUERIES, BENCH_QUERIES,
+		BENCH_QUERIES, count};
+	for (int i = 0; i < BENCH_OPERATIONS; i++) {
+		nanoseconds[i] = (double)(ends[i] - start) / operations[i];
+		start = ends[i];
+	}
+	if (!is_median_measured) nanoseconds[BENCH_MEDIAN] = -1;
+	return is_valid && (serviceNumberOfApatments(service) == 0);
+}
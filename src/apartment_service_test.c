@@ -0,0 +1,479 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "apartment_service.h"
+#include "test_utilities.h"
+
+#define MANY_APARTMENTS 2000
+#define SCRAMBLE_FACTOR 7919
+#define PRICE_RANGE 1000
+#define MANY_SHAPES 600
+#define SHAPE_SIDE 6
+
+static Apartment createApartment(const char* matrix, int length, int width,
+	int price);
+static int compareInts(const void* first, const void* second);
+static int naiveMedian(int* values, int count);
+static bool testServiceCreate();
+static bool testServiceAddApartment();
+static bool testServiceMedians();
+static bool testServiceDelete();
+static bool testServiceGetById();
+static bool testServiceSearch();
+static bool testServiceCopy();
+static bool testServiceGetByIndex();
+static bool testServiceManyApartments();
+static bool testServiceManyShapes();
+int RunApartmentServiceTest();
+
+//int main() {
+int RunApartmentServiceTest() {
+	RUN_TEST(testServiceCreate);
+	RUN_TEST(testServiceAddApartment);
+	RUN_TEST(testServiceMedians);
+	RUN_TEST(testServiceDelete);
+	RUN_TEST(testServiceGetById);
+	RUN_TEST(testServiceSearch);
+	RUN_TEST(testServiceCopy);
+	RUN_TEST(testServiceGetByIndex);
+	RUN_TEST(testServiceManyApartments);
+	RUN_TEST(testServiceManyShapes);
+	return 0;
+}
+
+/* creates an apartment from a string of 'e' and 'w' squares, row by row */
+static Apartment createApartment(const char* matrix, int length, int width,
+		int price) {
+	SquareType** squares = malloc(length * sizeof(*squares));
+	if (squares == NULL) return NULL;
+	for (int row = 0; row < length; row++) {
+		squares[row] = malloc(width * sizeof(**squares));
+		for (int col = 0; (squares[row] != NULL) && (col < width); col++) {
+			squares[row][col] =
+				(matrix[row * width + col] == 'w') ? WALL : EMPTY;
+		}
+	}
+	Apartment apartment = apartmentCreate(squares, length, width, price);
+	for (int row = 0; row < length; row++) free(squares[row]);
+	free(squares);
+	return apartment;
+}
+
+/* compares int elements */
+static int compareInts(const void* first, const void* second) {
+	int a = *(const int*)first, b = *(const int*)second;
+	return (a > b) - (a < b);
+}
+
+/* finds the median of values by sorting them */
+static int naiveMedian(int* values, int count) {
+	qsort(values, count, sizeof(*values), compareInts);
+	if (count % 2 == 1) return values[count / 2];
+	return (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+/**
+ * Test create & destroy method
+ */
+static bool testServiceCreate() {
+	ASSERT_TEST(serviceCreate(0) == NULL);
+	ASSERT_TEST(serviceCreate(-1) == NULL);
+	ApartmentService service = serviceCreate(3);
+	ASSERT_TEST(service != NULL);
+	ASSERT_TEST(serviceNumberOfApatments(service) == 0);
+	ASSERT_TEST(serviceNumberOfApatments(NULL) == -1);
+	ASSERT_TEST(serviceGetCapacity(service) == 3);
+	ASSERT_TEST(serviceGetCapacity(NULL) == -1);
+	serviceDestroy(service);
+	serviceDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test add method
+ */
+static bool testServiceAddApartment() {
+	ApartmentService service = serviceCreate(2);
+	Apartment apartment = createApartment("eeww", 2, 2, 100);
+	ASSERT_TEST(serviceAddApartment(NULL, apartment, 1) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceAddApartment(service, NULL, 1) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceAddApartment(service, apartment, -1) ==
+		APARTMENT_SERVICE_OUT_OF_BOUNDS);
+	ASSERT_TEST(serviceAddApartment(service, apartment, 1) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(serviceAddApartment(service, apartment, 1) ==
+		APARTMENT_SERVICE_ALREADY_EXISTS);
+	ASSERT_TEST(serviceAddApartment(service, apartment, 2) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(serviceAddApartment(service, apartment, 3) ==
+		APARTMENT_SERVICE_FULL);
+	ASSERT_TEST(serviceNumberOfApatments(service) == 2);
+	ASSERT_TEST(serviceDeleteById(service, 1) == APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(serviceAddApartment(service, apartment, 3) ==
+		APARTMENT_SERVICE_SUCCESS);
+	apartmentDestroy(apartment);
+	serviceDestroy(service);
+	return true;
+}
+
+/**
+ * Test price and area median methods
+ */
+static bool testServiceMedians() {
+	ApartmentService service = serviceCreate(5);
+	int median = 0;
+	ASSERT_TEST(servicePriceMedian(NULL, &median) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceAreaMedian(service, NULL) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(servicePriceMedian(service, &median) ==
+		APARTMENT_SERVICE_EMPTY);
+	Apartment small = createApartment("ewww", 2, 2, 300);
+	Apartment large = createApartment("eeee", 2, 2, 100);
+	Apartment medium = createApartment("eeww", 2, 2, 250);
+	serviceAddApartment(service, small, 1);
+	serviceAddApartment(service, large, 2);
+	ASSERT_TEST(servicePriceMedian(service, &median) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(median == 200);
+	ASSERT_TEST(serviceAreaMedian(service, &median) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(median == 2);
+	serviceAddApartment(service, medium, 3);
+	serviceAddApartment(service, medium, 4);
+	serviceAddApartment(service, small, 5);
+	ASSERT_TEST(servicePriceMedian(service, &median) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(median == 250);
+	ASSERT_TEST(serviceAreaMedian(service, &median) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(median == 2);
+	serviceDeleteById(service, 3);
+	serviceDeleteById(service, 4);
+	serviceDeleteById(service, 2);
+	ASSERT_TEST(servicePriceMedian(service, &median) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(median == 300);
+	ASSERT_TEST(serviceAreaMedian(service, &median) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(median == 1);
+	apartmentDestroy(small);
+	apartmentDestroy(large);
+	apartmentDestroy(medium);
+	serviceDestroy(service);
+	return true;
+}
+
+/**
+ * Test delete by id and delete apartment methods
+ */
+static bool testServiceDelete() {
+	ApartmentService service = serviceCreate(5);
+	Apartment apartment = createApartment("eeww", 2, 2, 100);
+	Apartment other = createApartment("eeww", 2, 2, 200);
+	ASSERT_TEST(serviceDeleteById(NULL, 1) == APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceDeleteById(service, -1) ==
+		APARTMENT_SERVICE_OUT_OF_BOUNDS);
+	ASSERT_TEST(serviceDeleteById(service, 1) == APARTMENT_SERVICE_EMPTY);
+	ASSERT_TEST(serviceDeleteApartment(service, apartment) ==
+		APARTMENT_SERVICE_EMPTY);
+	ASSERT_TEST(serviceDeleteApartment(NULL, apartment) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	serviceAddApartment(service, apartment, 1);
+	serviceAddApartment(service, apartment, 2);
+	ASSERT_TEST(serviceDeleteById(service, 3) == APARTMENT_SERVICE_NO_FIT);
+	ASSERT_TEST(serviceDeleteApartment(service, other) ==
+		APARTMENT_SERVICE_NO_FIT);
+	ASSERT_TEST(serviceDeleteApartment(service, apartment) ==
+		APARTMENT_SERVICE_SUCCESS);
+	Apartment found = NULL;
+	ASSERT_TEST(serviceGetById(service, 2, &found) ==
+		APARTMENT_SERVICE_NO_FIT);
+	ASSERT_TEST(serviceGetById(service, 1, &found) ==
+		APARTMENT_SERVICE_SUCCESS);
+	apartmentDestroy(found);
+	ASSERT_TEST(serviceDeleteById(service, 1) == APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(serviceNumberOfApatments(service) == 0);
+	apartmentDestroy(apartment);
+	apartmentDestroy(other);
+	serviceDestroy(service);
+	return true;
+}
+
+/**
+ * Test get by id method
+ */
+static bool testServiceGetById() {
+	ApartmentService service = serviceCreate(5);
+	Apartment apartment = createApartment("eeww", 2, 2, 100);
+	Apartment found = apartment;
+	ASSERT_TEST(serviceGetById(NULL, 1, &found) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceGetById(service, 1, NULL) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceGetById(service, -1, &found) ==
+		APARTMENT_SERVICE_OUT_OF_BOUNDS);
+	ASSERT_TEST(serviceGetById(service, 1, &found) ==
+		APARTMENT_SERVICE_EMPTY);
+	serviceAddApartment(service, apartment, 7);
+	ASSERT_TEST(serviceGetById(service, 1, &found) ==
+		APARTMENT_SERVICE_NO_FIT);
+	ASSERT_TEST(found == NULL);
+	ASSERT_TEST(serviceGetById(service, 7, &found) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST((found != apartment) && apartmentIsIdentical(found,
+		apartment));
+	apartmentDestroy(found);
+	apartmentDestroy(apartment);
+	serviceDestroy(service);
+	return true;
+}
+
+/**
+ * Test search method finds the last added fitting apartment
+ */
+static bool testServiceSearch() {
+	ApartmentService service = serviceCreate(5);
+	Apartment two_rooms = createApartment("ewe", 1, 3, 100);
+	Apartment one_room = createApartment("eee", 1, 3, 300);
+	Apartment cheap = createApartment("eww", 1, 3, 50);
+	Apartment found = NULL;
+	ASSERT_TEST(serviceSearch(NULL, 1, 1, 100, &found) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceSearch(service, 1, 1, 100, NULL) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceSearch(service, -1, 1, 100, &found) ==
+		APARTMENT_SERVICE_OUT_OF_BOUNDS);
+	ASSERT_TEST(serviceSearch(service, 1, 1, -1, &found) ==
+		APARTMENT_SERVICE_OUT_OF_BOUNDS);
+	ASSERT_TEST(serviceSearch(service, 1, 1, 100, &found) ==
+		APARTMENT_SERVICE_EMPTY);
+	serviceAddApartment(service, two_rooms, 1);
+	serviceAddApartment(service, one_room, 2);
+	serviceAddApartment(service, cheap, 3);
+	ASSERT_TEST(serviceSearch(service, 0, 0, 1000, &found) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(apartmentIsIdentical(found, cheap));
+	apartmentDestroy(found);
+	ASSERT_TEST(serviceSearch(service, 2, 1, 1000, &found) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(apartmentIsIdentical(found, one_room));
+	apartmentDestroy(found);
+	ASSERT_TEST(serviceSearch(service, 2, 2, 1000, &found) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(apartmentIsIdentical(found, two_rooms));
+	apartmentDestroy(found);
+	ASSERT_TEST(serviceSearch(service, 2, 1, 200, &found) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(apartmentIsIdentical(found, two_rooms));
+	apartmentDestroy(found);
+	ASSERT_TEST(serviceSearch(service, 3, 1, 200, &found) ==
+		APARTMENT_SERVICE_NO_FIT);
+	ASSERT_TEST(found == NULL);
+	serviceDeleteById(service, 1);
+	ASSERT_TEST(serviceSearch(service, 2, 2, 1000, &found) ==
+		APARTMENT_SERVICE_NO_FIT);
+	apartmentDestroy(two_rooms);
+	apartmentDestroy(one_room);
+	apartmentDestroy(cheap);
+	serviceDestroy(service);
+	return true;
+}
+
+/**
+ * Test copy method
+ */
+static bool testServiceCopy() {
+	ASSERT_TEST(serviceCopy(NULL) == NULL);
+	ApartmentService service = serviceCreate(4);
+	Apartment apartment = createApartment("eeww", 2, 2, 100);
+	serviceAddApartment(service, apartment, 3);
+	serviceAddApartment(service, apartment, 1);
+	serviceAddApartment(service, apartment, 2);
+	ApartmentService copy = serviceCopy(service);
+	ASSERT_TEST(copy != NULL);
+	ASSERT_TEST(serviceGetCapacity(copy) == 4);
+	ASSERT_TEST(serviceNumberOfApatments(copy) == 3);
+	int expected_ids[] = {3, 1, 2};
+	for (int i = 0; i < 3; i++) {
+		Apartment found = NULL;
+		int id = -1;
+		ASSERT_TEST(serviceGetByIndex(copy, i, &found, &id) ==
+			APARTMENT_SERVICE_SUCCESS);
+		ASSERT_TEST(id == expected_ids[i]);
+		apartmentDestroy(found);
+	}
+	serviceDeleteById(copy, 1);
+	ASSERT_TEST(serviceNumberOfApatments(service) == 3);
+	ASSERT_TEST(serviceAddApartment(copy, apartment, 1) ==
+		APARTMENT_SERVICE_SUCCESS);
+	apartmentDestroy(apartment);
+	serviceDestroy(copy);
+	serviceDestroy(service);
+	return true;
+}
+
+/**
+ * Test get by index method follows the order apartments were added in
+ */
+static bool testServiceGetByIndex() {
+	ApartmentService service = serviceCreate(10);
+	Apartment apartment = createApartment("eeww", 2, 2, 100);
+	Apartment found = NULL;
+	int id = -1;
+	ASSERT_TEST(serviceGetByIndex(NULL, 0, &found, &id) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceGetByIndex(service, 0, &found, NULL) ==
+		APARTMENT_SERVICE_NULL_ARG);
+	ASSERT_TEST(serviceGetByIndex(service, 0, &found, &id) ==
+		APARTMENT_SERVICE_OUT_OF_BOUNDS);
+	for (int i = 0; i < 10; i++) {
+		serviceAddApartment(service, apartment, 10 - i);
+	}
+	serviceDeleteById(service, 10);
+	serviceDeleteById(service, 5);
+	serviceDeleteById(service, 1);
+	int expected_ids[] = {9, 8, 7, 6, 4, 3, 2};
+	for (int i = 0; i < 7; i++) {
+		ASSERT_TEST(serviceGetByIndex(service, i, &found, &id) ==
+			APARTMENT_SERVICE_SUCCESS);
+		ASSERT_TEST(id == expected_ids[i]);
+		apartmentDestroy(found);
+	}
+	ASSERT_TEST(serviceGetByIndex(service, 7, &found, &id) ==
+		APARTMENT_SERVICE_OUT_OF_BOUNDS);
+	ASSERT_TEST(serviceGetByIndex(service, -1, &found, &id) ==
+		APARTMENT_SERVICE_OUT_OF_BOUNDS);
+	apartmentDestroy(apartment);
+	serviceDestroy(service);
+	return true;
+}
+
+/**
+ * Test medians and searches of many apartments against sorting and scanning
+ */
+static bool testServiceManyApartments() {
+	const char* layouts[] = {"eeee", "ewwe", "ewww", "wwww", "eewe"};
+	int areas[] = {4, 2, 1, 0, 3};
+	int rooms[] = {1, 2, 1, 0, 1};
+	ApartmentService service = serviceCreate(MANY_APARTMENTS);
+	int* prices = malloc(MANY_APARTMENTS * sizeof(*prices));
+	int* values = malloc(MANY_APARTMENTS * sizeof(*values));
+	ASSERT_TEST((prices != NULL) && (values != NULL));
+	for (int i = 0; i < MANY_APARTMENTS; i++) {
+		prices[i] = (i * SCRAMBLE_FACTOR) % PRICE_RANGE;
+		Apartment apartment = createApartment(layouts[i % 5], 2, 2,
+			prices[i]);
+		ASSERT_TEST(serviceAddApartment(service, apartment, i) ==
+			APARTMENT_SERVICE_SUCCESS);
+		apartmentDestroy(apartment);
+	}
+	for (int i = 0; i < MANY_APARTMENTS; i += 3) {
+		ASSERT_TEST(serviceDeleteById(service, i) ==
+			APARTMENT_SERVICE_SUCCESS);
+	}
+	int count = 0;
+	for (int i = 0; i < MANY_APARTMENTS; i++) {
+		if (i % 3 != 0) values[count++] = prices[i];
+	}
+	int median = 0;
+	ASSERT_TEST(serviceNumberOfApatments(service) == count);
+	ASSERT_TEST(servicePriceMedian(service, &median) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(median == naiveMedian(values, count));
+	count = 0;
+	for (int i = 0; i < MANY_APARTMENTS; i++) {
+		if (i % 3 != 0) values[count++] = areas[i % 5];
+	}
+	ASSERT_TEST(serviceAreaMedian(service, &median) ==
+		APARTMENT_SERVICE_SUCCESS);
+	ASSERT_TEST(median == naiveMedian(values, count));
+	for (int query = 0; query < 50; query++) {
+		int area = query % 5, room_count = query % 3;
+		int price = (query * SCRAMBLE_FACTOR) % PRICE_RANGE;
+		int expected = -1;
+		for (int i = MANY_APARTMENTS - 1; (i >= 0) && (expected < 0); i--) {
+			if ((i % 3 != 0) && (areas[i % 5] >= area) &&
+				(rooms[i % 5] >= room_count) && (prices[i] <= price))
+				expected = i;
+		}
+		Apartment found = NULL;
+		ApartmentServiceResult result = serviceSearch(service, area,
+			room_count, price, &found);
+		ASSERT_TEST(result == ((expected < 0) ? APARTMENT_SERVICE_NO_FIT :
+			APARTMENT_SERVICE_SUCCESS));
+		if (expected >= 0) {
+			ASSERT_TEST(apartmentGetPrice(found) == prices[expected]);
+			ASSERT_TEST(apartmentTotalArea(found) == areas[expected % 5]);
+		}
+		apartmentDestroy(found);
+	}
+	free(prices);
+	free(values);
+	serviceDestroy(service);
+	return true;
+}
+
+/**
+ * Test searches and deletes over apartments of many areas and rooms
+ */
+static bool testServiceManyShapes() {
+	ApartmentService service = serviceCreate(MANY_SHAPES);
+	Apartment* apartments = malloc(MANY_SHAPES * sizeof(*apartments));
+	bool* is_deleted = calloc(MANY_SHAPES, sizeof(*is_deleted));
+	ASSERT_TEST((apartments != NULL) && (is_deleted != NULL));
+	char matrix[SHAPE_SIDE * SHAPE_SIDE + 1];
+	for (int i = 0; i < MANY_SHAPES; i++) {
+		int length = 1 + i % SHAPE_SIDE, width = 1 + (i / 7) % SHAPE_SIDE;
+		for (int square = 0; square < length * width; square++) {
+			matrix[square] =
+				((i * SCRAMBLE_FACTOR + square * 31) % 7 < 3) ? 'w' : 'e';
+		}
+		apartments[i] = createApartment(matrix, length, width,
+			(i * SCRAMBLE_FACTOR) % PRICE_RANGE);
+		ASSERT_TEST(serviceAddApartment(service, apartments[i], i) ==
+			APARTMENT_SERVICE_SUCCESS);
+	}
+	for (int i = 0; i < MANY_SHAPES; i += 5) {
+		ASSERT_TEST(serviceDeleteById(service, i) ==
+			APARTMENT_SERVICE_SUCCESS);
+		is_deleted[i] = true;
+	}
+	for (int i = 3; i < MANY_SHAPES; i += 11) {
+		int last = -1;
+		for (int j = 0; j < MANY_SHAPES; j++) {
+			if (!is_deleted[j] &&
+				apartmentIsIdentical(apartments[j], apartments[i])) last = j;
+		}
+		ASSERT_TEST(serviceDeleteApartment(service, apartments[i]) ==
+			((last < 0) ? APARTMENT_SERVICE_NO_FIT :
+			APARTMENT_SERVICE_SUCCESS));
+		if (last >= 0) is_deleted[last] = true;
+	}
+	for (int query = 0; query < MANY_SHAPES; query++) {
+		int area = query % (SHAPE_SIDE * SHAPE_SIDE), room_count = query % 5;
+		int price = (query * SCRAMBLE_FACTOR) % PRICE_RANGE;
+		int expected = -1;
+		for (int i = MANY_SHAPES - 1; (i >= 0) && (expected < 0); i--) {
+			if (!is_deleted[i] && (apartmentTotalArea(apartments[i]) >= area)
+				&& (apartmentNumOfRooms(apartments[i]) >= room_count) &&
+				(apartmentGetPrice(apartments[i]) <= price)) expected = i;
+		}
+		Apartment found = NULL;
+		ApartmentServiceResult result = serviceSearch(service, area,
+			room_count, price, &found);
+		ASSERT_TEST(result == ((expected < 0) ? APARTMENT_SERVICE_NO_FIT :
+			APARTMENT_SERVICE_SUCCESS));
+		ASSERT_TEST((expected < 0) ||
+			apartmentIsIdentical(found, apartments[expected]));
+		apartmentDestroy(found);
+	}
+	for (int i = 0; i < MANY_SHAPES; i++) apartmentDestroy(apartments[i]);
+	free(apartments);
+	free(is_deleted);
+	serviceDestroy(service);
+	return true;
+}
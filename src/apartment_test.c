@@ -0,0 +1,400 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "apartment.h"
+#include "test_utilities.h"
+
+#define MANY_LENGTH 37
+#define MANY_WIDTH 29
+#define SCRAMBLE_FACTOR 7919
+#define UPDATE_LENGTH 9
+#define UPDATE_WIDTH 11
+#define UPDATES 600
+
+static Apartment createApartment(const char* matrix, int length, int width,
+	int price);
+static bool isMatching(Apartment apartment, const char* matrix);
+static int naiveRoomArea(const char* matrix, int length, int width,
+	int square, int* rooms, int room);
+static bool isRoomsMatching(Apartment apartment, const char* matrix);
+static bool testApartmentCreate();
+static bool testApartmentCreateFromString();
+static bool testApartmentSquares();
+static bool testApartmentRooms();
+static bool testApartmentSplit();
+static bool testApartmentCopyIdentical();
+static bool testApartmentChangePrice();
+static bool testApartmentManySquares();
+static bool testApartmentRoomUpdates();
+int RunApartmentTest();
+
+//int main() {
+int RunApartmentTest() {
+	RUN_TEST(testApartmentCreate);
+	RUN_TEST(testApartmentCreateFromString);
+	RUN_TEST(testApartmentSquares);
+	RUN_TEST(testApartmentRooms);
+	RUN_TEST(testApartmentSplit);
+	RUN_TEST(testApartmentCopyIdentical);
+	RUN_TEST(testApartmentChangePrice);
+	RUN_TEST(testApartmentManySquares);
+	RUN_TEST(testApartmentRoomUpdates);
+	return 0;
+}
+
+/* creates an apartment from a string of 'e' and 'w' squares, row by row */
+static Apartment createApartment(const char* matrix, int length, int width,
+		int price) {
+	return apartmentCreateFromString(matrix, length, width, price, 'w', 'e');
+}
+
+/* checks the squares of an apartment match a string of them, row by row */
+static bool isMatching(Apartment apartment, const char* matrix) {
+	int length = apartmentGetLength(apartment);
+	int width = apartmentGetWidth(apartment);
+	if (strlen(matrix) != (size_t)(length * width)) return false;
+	for (int row = 0; row < length; row++) {
+		for (int col = 0; col < width; col++) {
+			SquareType square = EMPTY;
+			if ((apartmentGetSquare(apartment, row, col, &square) !=
+				APARTMENT_SUCCESS) || (square !=
+				((matrix[row * width + col] == 'w') ? WALL : EMPTY)))
+				return false;
+		}
+	}
+	return true;
+}
+
+/* labels the room of an 'e' square with room by flooding, returns its area */
+static int naiveRoomArea(const char* matrix, int length, int width,
+		int square, int* rooms, int room) {
+	int row = square / width, col = square % width;
+	if ((matrix[square] == 'w') || (rooms[square] != 0)) return 0;
+	rooms[square] = room;
+	int area = 1;
+	if (row > 0) area += naiveRoomArea(matrix, length, width,
+		square - width, rooms, room);
+	if (row < length - 1) area += naiveRoomArea(matrix, length, width,
+		square + width, rooms, room);
+	if (col > 0) area += naiveRoomArea(matrix, length, width,
+		square - 1, rooms, room);
+	if (col < width - 1) area += naiveRoomArea(matrix, length, width,
+		square + 1, rooms, room);
+	return area;
+}
+
+/* checks the rooms of an apartment match those flooded in its squares */
+static bool isRoomsMatching(Apartment apartment, const char* matrix) {
+	int length = apartmentGetLength(apartment);
+	int width = apartmentGetWidth(apartment);
+	int rooms[UPDATE_LENGTH * UPDATE_WIDTH] = {0};
+	int areas[UPDATE_LENGTH * UPDATE_WIDTH + 1] = {0};
+	int count = 0;
+	for (int square = 0; square < length * width; square++) {
+		if ((matrix[square] == 'e') && (rooms[square] == 0)) {
+			count++;
+			areas[count] = naiveRoomArea(matrix, length, width, square, rooms,
+				count);
+		}
+	}
+	if (apartmentNumOfRooms(apartment) != count) return false;
+	for (int square = 0; square < length * width; square++) {
+		int area = 0;
+		bool is_same = false;
+		int other = (square * SCRAMBLE_FACTOR) % (length * width);
+		if (rooms[square] == 0) continue;
+		if ((apartmentRoomArea(apartment, square / width, square % width,
+			&area) != APARTMENT_SUCCESS) || (area != areas[rooms[square]]))
+			return false;
+		if (rooms[other] == 0) continue;
+		if ((apartmentIsSameRoom(apartment, square / width, square % width,
+			other / width, other % width, &is_same) != APARTMENT_SUCCESS) ||
+			(is_same != (rooms[square] == rooms[other]))) return false;
+	}
+	return true;
+}
+
+/**
+ * Test create & destroy method
+ */
+static bool testApartmentCreate() {
+	SquareType rows[2][3] = {{EMPTY, WALL, EMPTY}, {WALL, WALL, EMPTY}};
+	SquareType* squares[2] = {rows[0], rows[1]};
+	ASSERT_TEST(apartmentCreate(NULL, 2, 3, 100) == NULL);
+	ASSERT_TEST(apartmentCreate(squares, 0, 3, 100) == NULL);
+	ASSERT_TEST(apartmentCreate(squares, 2, -1, 100) == NULL);
+	ASSERT_TEST(apartmentCreate(squares, 2, 3, -1) == NULL);
+	Apartment apartment = apartmentCreate(squares, 2, 3, 0);
+	ASSERT_TEST(apartment != NULL);
+	ASSERT_TEST(apartmentGetLength(apartment) == 2);
+	ASSERT_TEST(apartmentGetWidth(apartment) == 3);
+	ASSERT_TEST(apartmentGetPrice(apartment) == 0);
+	ASSERT_TEST(isMatching(apartment, "ewewwe"));
+	ASSERT_TEST(apartmentTotalArea(apartment) == 3);
+	apartmentDestroy(apartment);
+	apartmentDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test create from string method
+ */
+static bool testApartmentCreateFromString() {
+	ASSERT_TEST(createApartment(NULL, 1, 1, 1) == NULL);
+	ASSERT_TEST(createApartment("e", 0, 1, 1) == NULL);
+	ASSERT_TEST(createApartment("e", 1, 1, -1) == NULL);
+	ASSERT_TEST(createApartment("ewx", 1, 3, 1) == NULL);
+	ASSERT_TEST(createApartment("ew", 1, 3, 1) == NULL);
+	Apartment apartment = createApartment("wweewwweeweww", 1, 13, 10);
+	ASSERT_TEST(apartment != NULL);
+	ASSERT_TEST(isMatching(apartment, "wweewwweeweww"));
+	ASSERT_TEST(apartmentTotalArea(apartment) == 5);
+	apartmentDestroy(apartment);
+	apartment = apartmentCreateFromString("#..#", 2, 2, 10, '#', '.');
+	ASSERT_TEST(isMatching(apartment, "weew"));
+	apartmentDestroy(apartment);
+	return true;
+}
+
+/**
+ * Test get & set square methods
+ */
+static bool testApartmentSquares() {
+	Apartment apartment = createApartment("eeeeeeeee", 3, 3, 10);
+	SquareType square = WALL;
+	ASSERT_TEST(apartmentGetSquare(NULL, 0, 0, &square) == APARTMENT_NULL_ARG);
+	ASSERT_TEST(apartmentGetSquare(apartment, 3, 0, &square) ==
+		APARTMENT_OUT_OF_BOUNDS);
+	ASSERT_TEST(apartmentGetSquare(apartment, 0, -1, &square) ==
+		APARTMENT_OUT_OF_BOUNDS);
+	ASSERT_TEST(apartmentGetSquare(apartment, 2, 2, &square) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(square == EMPTY);
+	ASSERT_TEST(apartmentSetSquare(NULL, 0, 0, WALL) == APARTMENT_NULL_ARG);
+	ASSERT_TEST(apartmentSetSquare(apartment, 0, 3, WALL) ==
+		APARTMENT_OUT_OF_BOUNDS);
+	ASSERT_TEST(apartmentSetSquare(apartment, 1, 1, EMPTY) ==
+		APARTMENT_OLD_VALUE);
+	ASSERT_TEST(apartmentSetSquare(apartment, 1, 1, WALL) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(apartmentSetSquare(apartment, 1, 1, WALL) ==
+		APARTMENT_OLD_VALUE);
+	ASSERT_TEST(apartmentSetSquare(apartment, 2, 0, WALL) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(isMatching(apartment, "eeeewewee"));
+	ASSERT_TEST(apartmentTotalArea(apartment) == 7);
+	ASSERT_TEST(apartmentSetSquare(apartment, 1, 1, EMPTY) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(isMatching(apartment, "eeeeeewee"));
+	ASSERT_TEST(apartmentTotalArea(apartment) == 8);
+	apartmentDestroy(apartment);
+	return true;
+}
+
+/**
+ * Test rooms, same room & room area methods
+ */
+static bool testApartmentRooms() {
+	Apartment apartment = createApartment(
+		"eeweee"
+		"eewwww"
+		"wwweee"
+		"eeweew", 4, 6, 10);
+	bool is_same = false;
+	int area = 0;
+	ASSERT_TEST(apartmentNumOfRooms(apartment) == 4);
+	ASSERT_TEST(apartmentIsSameRoom(NULL, 0, 0, 0, 1, &is_same) ==
+		APARTMENT_NULL_ARG);
+	ASSERT_TEST(apartmentIsSameRoom(apartment, 0, 0, 0, 1, NULL) ==
+		APARTMENT_NULL_ARG);
+	ASSERT_TEST(apartmentIsSameRoom(apartment, 0, 0, 4, 0, &is_same) ==
+		APARTMENT_OUT_OF_BOUNDS);
+	ASSERT_TEST(apartmentIsSameRoom(apartment, 0, 0, 0, 2, &is_same) ==
+		APARTMENT_NO_ROOM);
+	ASSERT_TEST(apartmentIsSameRoom(apartment, 0, 0, 1, 1, &is_same) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(is_same);
+	ASSERT_TEST(apartmentIsSameRoom(apartment, 0, 0, 0, 5, &is_same) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(!is_same);
+	ASSERT_TEST(apartmentIsSameRoom(apartment, 2, 5, 3, 3, &is_same) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(is_same);
+	ASSERT_TEST(apartmentRoomArea(NULL, 0, 0, &area) == APARTMENT_NULL_ARG);
+	ASSERT_TEST(apartmentRoomArea(apartment, 0, 6, &area) ==
+		APARTMENT_OUT_OF_BOUNDS);
+	ASSERT_TEST(apartmentRoomArea(apartment, 1, 2, &area) ==
+		APARTMENT_NO_ROOM);
+	ASSERT_TEST(apartmentRoomArea(apartment, 1, 0, &area) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(area == 4);
+	ASSERT_TEST(apartmentRoomArea(apartment, 0, 4, &area) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(area == 3);
+	ASSERT_TEST(apartmentRoomArea(apartment, 3, 4, &area) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(area == 5);
+	ASSERT_TEST(apartmentRoomArea(apartment, 3, 1, &area) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(area == 2);
+	ASSERT_TEST(apartmentSetSquare(apartment, 2, 1, EMPTY) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(apartmentNumOfRooms(apartment) == 3);
+	apartmentDestroy(apartment);
+	return true;
+}
+
+/**
+ * Test split method
+ */
+static bool testApartmentSplit() {
+	Apartment apartment = createApartment(
+		"eewee"
+		"wwwww"
+		"eewee"
+		"eewee", 4, 5, 100);
+	Apartment first = NULL, second = NULL;
+	ASSERT_TEST(apartmentSplit(NULL, true, 1, &first, &second) ==
+		APARTMENT_NULL_ARG);
+	ASSERT_TEST(apartmentSplit(apartment, true, 1, NULL, &second) ==
+		APARTMENT_NULL_ARG);
+	ASSERT_TEST(apartmentSplit(apartment, true, 4, &first, &second) ==
+		APARTMENT_OUT_OF_BOUNDS);
+	ASSERT_TEST(apartmentSplit(apartment, false, -1, &first, &second) ==
+		APARTMENT_OUT_OF_BOUNDS);
+	ASSERT_TEST(apartmentSplit(apartment, true, 0, &first, &second) ==
+		APARTMENT_BAD_SPLIT);
+	ASSERT_TEST(apartmentSplit(apartment, true, 2, &first, &second) ==
+		APARTMENT_BAD_SPLIT);
+	ASSERT_TEST(apartmentSplit(apartment, false, 1, &first, &second) ==
+		APARTMENT_BAD_SPLIT);
+	ASSERT_TEST(apartmentSplit(apartment, true, 1, &first, &second) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(isMatching(first, "eewee"));
+	ASSERT_TEST(isMatching(second, "eeweeeewee"));
+	ASSERT_TEST(apartmentGetPrice(first) == 50);
+	ASSERT_TEST(apartmentGetPrice(second) == 75);
+	apartmentDestroy(first);
+	apartmentDestroy(second);
+	ASSERT_TEST(apartmentSetSquare(apartment, 1, 2, EMPTY) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(apartmentSplit(apartment, true, 1, &first, &second) ==
+		APARTMENT_BAD_SPLIT);
+	ASSERT_TEST(apartmentSetSquare(apartment, 1, 2, WALL) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(apartmentSplit(apartment, false, 2, &first, &second) ==
+		APARTMENT_SUCCESS);
+	ASSERT_TEST(isMatching(first, "eewweeee"));
+	ASSERT_TEST(isMatching(second, "eewweeee"));
+	ASSERT_TEST(apartmentGetPrice(first) == 60);
+	ASSERT_TEST(apartmentGetPrice(second) == 60);
+	apartmentDestroy(first);
+	apartmentDestroy(second);
+	apartmentDestroy(apartment);
+	return true;
+}
+
+/**
+ * Test copy & is identical methods
+ */
+static bool testApartmentCopyIdentical() {
+	Apartment apartment = createApartment("ewweeweee", 3, 3, 10);
+	ASSERT_TEST(apartmentCopy(NULL) == NULL);
+	Apartment copy = apartmentCopy(apartment);
+	ASSERT_TEST(copy != NULL);
+	ASSERT_TEST(apartmentIsIdentical(apartment, copy));
+	ASSERT_TEST(apartmentIsIdentical(NULL, NULL));
+	ASSERT_TEST(!apartmentIsIdentical(apartment, NULL));
+	ASSERT_TEST(!apartmentIsIdentical(NULL, copy));
+	ASSERT_TEST(apartmentSetSquare(copy, 2, 2, WALL) == APARTMENT_SUCCESS);
+	ASSERT_TEST(!apartmentIsIdentical(apartment, copy));
+	ASSERT_TEST(isMatching(apartment, "ewweeweee"));
+	ASSERT_TEST(apartmentSetSquare(copy, 2, 2, EMPTY) == APARTMENT_SUCCESS);
+	ASSERT_TEST(apartmentIsIdentical(apartment, copy));
+	ASSERT_TEST(apartmentChangePrice(copy, 10) == APARTMENT_SUCCESS);
+	ASSERT_TEST(!apartmentIsIdentical(apartment, copy));
+	Apartment other = createApartment("ewweeweee", 1, 9, 10);
+	ASSERT_TEST(!apartmentIsIdentical(apartment, other));
+	apartmentDestroy(other);
+	apartmentDestroy(copy);
+	apartmentDestroy(apartment);
+	return true;
+}
+
+/**
+ * Test change price method
+ */
+static bool testApartmentChangePrice() {
+	Apartment apartment = createApartment("e", 1, 1, 250);
+	ASSERT_TEST(apartmentChangePrice(NULL, 10) == APARTMENT_NULL_ARG);
+	ASSERT_TEST(apartmentChangePrice(apartment, -101) ==
+		APARTMENT_PRICE_NOT_IN_RANGE);
+	ASSERT_TEST(apartmentGetPrice(apartment) == 250);
+	ASSERT_TEST(apartmentChangePrice(apartment, 10) == APARTMENT_SUCCESS);
+	ASSERT_TEST(apartmentGetPrice(apartment) == 275);
+	ASSERT_TEST(apartmentChangePrice(apartment, -3) == APARTMENT_SUCCESS);
+	ASSERT_TEST(apartmentGetPrice(apartment) == 267);
+	ASSERT_TEST(apartmentChangePrice(apartment, -100) == APARTMENT_SUCCESS);
+	ASSERT_TEST(apartmentGetPrice(apartment) == 0);
+	apartmentDestroy(apartment);
+	return true;
+}
+
+/**
+ * Test an apartment of squares across many bytes of odd dimensions
+ */
+static bool testApartmentManySquares() {
+	char matrix[MANY_LENGTH * MANY_WIDTH + 1];
+	int walls = 0;
+	for (int i = 0; i < MANY_LENGTH * MANY_WIDTH; i++) {
+		bool is_wall = (i * SCRAMBLE_FACTOR) % 5 < 2;
+		matrix[i] = is_wall ? 'w' : 'e';
+		if (is_wall) walls++;
+	}
+	matrix[MANY_LENGTH * MANY_WIDTH] = '\0';
+	Apartment apartment = createApartment(matrix, MANY_LENGTH, MANY_WIDTH, 1);
+	ASSERT_TEST(isMatching(apartment, matrix));
+	ASSERT_TEST(apartmentTotalArea(apartment) ==
+		MANY_LENGTH * MANY_WIDTH - walls);
+	for (int i = 0; i < MANY_LENGTH * MANY_WIDTH; i += 3) {
+		SquareType value = (matrix[i] == 'w') ? EMPTY : WALL;
+		ASSERT_TEST(apartmentSetSquare(apartment, i / MANY_WIDTH,
+			i % MANY_WIDTH, value) == APARTMENT_SUCCESS);
+		matrix[i] = (value == WALL) ? 'w' : 'e';
+	}
+	ASSERT_TEST(isMatching(apartment, matrix));
+	Apartment copy = createApartment(matrix, MANY_LENGTH, MANY_WIDTH, 1);
+	ASSERT_TEST(apartmentIsIdentical(apartment, copy));
+	apartmentDestroy(copy);
+	apartmentDestroy(apartment);
+	return true;
+}
+
+/**
+ * Test the rooms follow squares set one at a time, against flooding
+ */
+static bool testApartmentRoomUpdates() {
+	char matrix[UPDATE_LENGTH * UPDATE_WIDTH + 1];
+	int count = UPDATE_LENGTH * UPDATE_WIDTH;
+	for (int i = 0; i < count; i++) matrix[i] = (i % 3 == 0) ? 'w' : 'e';
+	matrix[count] = '\0';
+	Apartment apartment = createApartment(matrix, UPDATE_LENGTH, UPDATE_WIDTH,
+		1);
+	ASSERT_TEST(isRoomsMatching(apartment, matrix));
+	for (int i = 0; i < UPDATES; i++) {
+		int square = (i * SCRAMBLE_FACTOR + i / 7) % count;
+		SquareType value = (matrix[square] == 'w') ? EMPTY : WALL;
+		ASSERT_TEST(apartmentSetSquare(apartment, square / UPDATE_WIDTH,
+			square % UPDATE_WIDTH, value) == APARTMENT_SUCCESS);
+		matrix[square] = (value == WALL) ? 'w' : 'e';
+		if (i % 3 == 0) {
+			Apartment copy = apartmentCopy(apartment);
+			ASSERT_TEST(isRoomsMatching(copy, matrix));
+			apartmentDestroy(copy);
+		}
+		ASSERT_TEST(isRoomsMatching(apartment, matrix));
+	}
+	apartmentDestroy(apartment);
+	return true;
+}
@@ -10,6 +10,7 @@ struct Cliet_t {
 	int apartment_min_rooms;
 	int apartment_max_price;
 	int total_money_paid;
+	SlabAllocator allocator;
 };
 
 /**
@@ -38,16 +39,50 @@ struct Cliet_t {
 */
 ClientResult clientCreate(Email email, int apartment_min_area,
 		int apartment_min_rooms, int apartment_max_price, Client* result) {
+	return clientCreateWithAllocator(NULL, email, apartment_min_area,
+		apartment_min_rooms, apartment_max_price, result);
+}
+
+/**
+* Allocates a new client from an allocator.
+*
+* Creates a new client like clientCreate, in a block of the given allocator.
+* The client and its copies are freed back to the allocator when destroyed.
+*
+* @param allocator the allocator, or NULL to allocate with malloc.
+* @param email clients email.
+* @param apartment_min_area minimal area for the clients wanted apartments
+* @param apartment_min_rooms minimal room count in clients wanted apartments
+* @param apartment_max_price maximum price for the clients wanted apartments
+* @param result pointer to save the result client in
+*
+* @return
+*
+*	CLIENT_NULL_PARAMETERS - if email is NULL or result are NULL.
+*
+* 	CLIENT_INVALID_PARAMETERS - if apartment_min_area, apartment_min_rooms or
+* 		apartment_max_price are not bigger then zero.
+*
+* 	CLIENT_OUT_OF_MEMORY - if allocations failed.
+*
+* 	CLIENT_SUCCESS - in case of success.
+* 		A new client is saved in the result parameter.
+*/
+ClientResult clientCreateWithAllocator(SlabAllocator allocator, Email email,
+		int apartment_min_area, int apartment_min_rooms,
+		int apartment_max_price, Client* result) {
 	if ((result == NULL) || (email == NULL)) return CLIENT_NULL_PARAMETERS;
 	if ((apartment_min_area <= 0) || (apartment_min_rooms <= 0)
 			|| (apartment_max_price <= 0)) return CLIENT_INVALID_PARAMETERS;
-	Client client = malloc (sizeof(*client));
+	Client client = slabAllocatorAllocate(allocator, SLAB_CLIENT,
+		sizeof(*client));
 	if (client == NULL) return CLIENT_OUT_OF_MEMORY;
 	EmailResult copy_result = emailCopy(email, &(client->email));
 	if (copy_result != EMAIL_SUCCESS) {
-		free(client);
+		slabAllocatorFree(allocator, SLAB_CLIENT, client, sizeof(*client));
 		return CLIENT_OUT_OF_MEMORY;
 	} else {
+		client->allocator = allocator;
 		client->total_money_paid = 0;
 		client->apartment_min_area = apartment_min_area;
 		client->apartment_min_rooms = apartment_min_rooms;
@@ -77,9 +112,10 @@ ClientResult clientCreate(Email email, int apartment_min_area,
 ClientResult clientCopy(Client client, Client* result) {
 	if ((client == NULL) || (result == NULL)) return CLIENT_NULL_PARAMETERS;
 	Client new_client = NULL;
-	ClientResult result_state = clientCreate(client->email,
-			client->apartment_min_area, client->apartment_min_rooms,
-			client->apartment_max_price, &new_client);
+	ClientResult result_state = clientCreateWithAllocator(client->allocator,
+			client->email, client->apartment_min_area,
+			client->apartment_min_rooms, client->apartment_max_price,
+			&new_client);
 	if (result_state != CLIENT_SUCCESS) return  CLIENT_OUT_OF_MEMORY;
 	new_client->total_money_paid = client->total_money_paid;
 	*result = new_client;
@@ -96,7 +132,8 @@ ClientResult clientCopy(Client client, Client* result) {
 void clientDestroy(Client client) {
 	if (client != NULL) {
 		emailDestroy(client->email);
-		free(client);
+		slabAllocatorFree(client->allocator, SLAB_CLIENT, client,
+			sizeof(*client));
 	}
 }
 
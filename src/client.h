@@ -5,6 +5,7 @@
 #define AT_SIGN '@'
 
 #include "email.h"
+#include "slabAllocator.h"
 
 /**
 * This type defines end codes for the methods.
@@ -45,6 +46,35 @@ typedef struct Cliet_t *Client;
 ClientResult clientCreate(Email email, int apartment_min_area,
 		int apartment_min_rooms, int apartment_max_price, Client* result);
 
+/**
+* Allocates a new client from an allocator.
+*
+* Creates a new client like clientCreate, in a block of the given allocator.
+* The client and its copies are freed back to the allocator when destroyed.
+*
+* @param allocator the allocator, or NULL to allocate with malloc.
+* @param email clients email.
+* @param apartment_min_area minimal area for the clients wanted apartments
+* @param apartment_min_rooms minimal room count in clients wanted apartments
+* @param apartment_max_price maximum price for the clients wanted apartments
+* @param result pointer to save the result client in
+*
+* @return
+*
+*	CLIENT_NULL_PARAMETERS - if email is NULL or result are NULL.
+*
+* 	CLIENT_INVALID_PARAMETERS - if apartment_min_area, apartment_min_rooms or
+* 		apartment_max_price are not bigger then zero.
+*
+* 	CLIENT_OUT_OF_MEMORY - if allocations failed.
+*
+* 	CLIENT_SUCCESS - in case of success.
+* 		A new client is saved in the result parameter.
+*/
+ClientResult clientCreateWithAllocator(SlabAllocator allocator, Email email,
+		int apartment_min_area, int apartment_min_rooms,
+		int apartment_max_price, Client* result);
+
 
 /**
 * ClientDestroy: Deallocates an existing client.
@@ -7,6 +7,7 @@
 struct clientPurchaseBill_t {
 	Email email;
 	int total_money_paid;
+	SlabAllocator allocator;
 };
 
 /**
@@ -24,14 +25,36 @@ struct clientPurchaseBill_t {
 * 	negative or allocation failed.
 */
 ClientPurchaseBill clientPurchaseBillCreate(Email email, int total_money_paid){
+	return clientPurchaseBillCreateWithAllocator(NULL, email, total_money_paid);
+}
+
+/**
+* Allocates a new ClientPurchaseBill from an allocator.
+*
+* Creates a new ClientPurchaseBill like clientPurchaseBillCreate, in a block of
+* the given allocator. The bill and its copies are freed back to the allocator
+* when destroyed.
+*
+* @param allocator the allocator, or NULL to allocate with malloc.
+* @param email clients email.
+* @param PurchaseBill the total money the client paid for apartments
+*
+* @return
+* 	A new ClientPurchaseBill element or NULL if email is NULL, PurchaseBill is
+* 	negative or allocation failed.
+*/
+ClientPurchaseBill clientPurchaseBillCreateWithAllocator(
+		SlabAllocator allocator, Email email, int total_money_paid) {
 	if (email == NULL || total_money_paid < 0) return NULL;
-	ClientPurchaseBill bill = malloc(sizeof(*bill));
+	ClientPurchaseBill bill = slabAllocatorAllocate(allocator,
+		SLAB_PURCHASE_BILL, sizeof(*bill));
 	if (bill == NULL) return NULL;
+	bill->allocator = allocator;
 	bill->total_money_paid = total_money_paid;
 	bill->email = NULL;
 	emailCopy(email, &bill->email);
 	if (bill->email == NULL) {
-		free(bill);
+		slabAllocatorFree(allocator, SLAB_PURCHASE_BILL, bill, sizeof(*bill));
 		return NULL;
 	}
 	return bill;
@@ -52,8 +75,8 @@ ClientPurchaseBill clientPurchaseBillCreate(Email email, int total_money_paid){
 */
 ClientPurchaseBill clientPurchaseBillCopy(ClientPurchaseBill purchase_bill){
 	if (purchase_bill == NULL) return NULL;
-	return clientPurchaseBillCreate(purchase_bill->email,
-		purchase_bill->total_money_paid);
+	return clientPurchaseBillCreateWithAllocator(purchase_bill->allocator,
+		purchase_bill->email, purchase_bill->total_money_paid);
 }
 
 /**
@@ -67,7 +90,8 @@ ClientPurchaseBill clientPurchaseBillCopy(ClientPurchaseBill purchase_bill){
 void clientPurchaseBillDestroy(ClientPurchaseBill purchase_bill) {
 	if (purchase_bill != NULL) {
 		emailDestroy(purchase_bill->email);
-		free(purchase_bill);
+		slabAllocatorFree(purchase_bill->allocator, SLAB_PURCHASE_BILL,
+			purchase_bill, sizeof(*purchase_bill));
 	}
 }
 
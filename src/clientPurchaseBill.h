@@ -2,6 +2,7 @@
 #define SRC_CLIENTPurchaseBill_H_
 
 #include "email.h"
+#include "slabAllocator.h"
 
 typedef struct clientPurchaseBill_t *ClientPurchaseBill;
 
@@ -21,6 +22,24 @@ typedef struct clientPurchaseBill_t *ClientPurchaseBill;
 */
 ClientPurchaseBill clientPurchaseBillCreate(Email email, int total_money_paid);
 
+/**
+* Allocates a new ClientPurchaseBill from an allocator.
+*
+* Creates a new ClientPurchaseBill like clientPurchaseBillCreate, in a block of
+* the given allocator. The bill and its copies are freed back to the allocator
+* when destroyed.
+*
+* @param allocator the allocator, or NULL to allocate with malloc.
+* @param email clients email.
+* @param PurchaseBill the total money the client paid for apartments
+*
+* @return
+* 	A new ClientPurchaseBill element or NULL if email is NULL, PurchaseBill is
+* 	negative or allocation failed.
+*/
+ClientPurchaseBill clientPurchaseBillCreateWithAllocator(
+		SlabAllocator allocator, Email email, int total_money_paid);
+
 /**
 * clientPurchaseBillCopy: Allocates a new ClientPurchaseBill, identical to the
 * old ClientPurchaseBill
@@ -7,9 +7,19 @@
 #include "email.h"
 #include "list.h"
 #include "map.h"
+#include "set.h"
 
+/*
+ * payingClients holds the clients of clientsMap who bought apartments,
+ * ordered by their total payments from the highest, then by their emails.
+ * it does not own them, and a client is taken out of it before its total
+ * payments change, as they are its key.
+ */
 struct clientsManager_t {
 	Map clientsMap;
+	Set payingClients;
+	AccountDirectory directory;
+	SlabAllocator allocator;
 };
 
 static MapDataElement GetDataCopy(constMapDataElement data);
@@ -17,9 +27,19 @@ static MapKeyElement GetKeyCopy(constMapKeyElement key);
 static void FreeData(MapDataElement data);
 static void FreeKey(MapKeyElement key);
 static int CompareKeys(constMapKeyElement first, constMapKeyElement second);
+static unsigned int HashKey(constMapKeyElement key);
 static void freeListElement(ListElement element);
 static ListElement copyListElement(ListElement element);
-static int compareListElements(ListElement first, ListElement second);
+static SetElement copyPayingClient(SetElement element);
+static void freePayingClient(SetElement element);
+static int comparePayingClients(SetElement first, SetElement second);
+static Email getPayingClient(Client client, int* total_payments);
+static ClientsManagerResult createPaymentsList(ClientsManager manager,
+		int count, List* list);
+static SnapshotResult loadClient(ClientsManager manager,
+		SnapshotReader reader);
+static ClientsManagerResult registerClient(ClientsManager manager,
+		Email email);
 
 /**
 * Allocates a new ClientsManager.
@@ -29,15 +49,22 @@ static int compareListElements(ListElement first, ListElement second);
 * 	A new clients in case of success.
 */
 ClientsManager clientsManagerCreate() {
-	Map clients = mapCreate(GetDataCopy, GetKeyCopy, FreeData, FreeKey,
-			CompareKeys);
+	Map clients = mapCreateHashed(GetDataCopy, GetKeyCopy, FreeData, FreeKey,
+			CompareKeys, HashKey);
 	if (clients == NULL) return NULL;
+	Set paying_clients = setCreate(copyPayingClient, freePayingClient,
+			comparePayingClients);
 	ClientsManager manager = malloc (sizeof(*manager));
-	if (manager == NULL) {
-		free(clients);
+	if ((manager == NULL) || (paying_clients == NULL)) {
+		mapDestroy(clients);
+		setDestroy(paying_clients);
+		free(manager);
 		return NULL;
 	} else {
 		manager->clientsMap = clients;
+		manager->payingClients = paying_clients;
+		manager->directory = NULL;
+		manager->allocator = NULL;
 		return manager;
 	}
 }
@@ -71,6 +98,12 @@ static int CompareKeys(constMapKeyElement first, constMapKeyElement second) {
 	return emailComapre((Email)first, (Email)second);
 }
 
+/** Function to be used for hashing key elements in the map, by the email
+ * id, which equal emails share */
+static unsigned int HashKey(constMapKeyElement key) {
+	return (unsigned int)emailGetId((Email)key);
+}
+
 /**
 * clientsManagerDestroy: Deallocates an existing manager.
 * Clears the element by using the stored free function.
@@ -80,11 +113,44 @@ static int CompareKeys(constMapKeyElement first, constMapKeyElement second) {
 */
 void clientsManagerDestroy(ClientsManager manager) {
 	if (manager != NULL) {
+		if (manager->directory != NULL) {
+			MAP_FOREACH(Email, email, manager->clientsMap) {
+				accountDirectoryRemove(manager->directory, email);
+			}
+		}
+		setDestroy(manager->payingClients);
 		mapDestroy(manager->clientsMap);
 		free(manager);
 	}
 }
 
+/**
+* clientsManagerSetDirectory: sets the account directory the manager keeps
+* its clients in. clients are added to and removed from the directory with
+* the manager, so it is set while the manager is empty.
+*
+* @param manager Target clients Manager.
+* @param directory the directory, or NULL for none. it must outlive the
+* 	manager.
+*/
+void clientsManagerSetDirectory(ClientsManager manager,
+		AccountDirectory directory) {
+	if (manager != NULL) manager->directory = directory;
+}
+
+/**
+* clientsManagerSetAllocator: sets the allocator the manager creates its
+* clients and purchase bills from. it is set while the manager is empty.
+*
+* @param manager Target clients Manager.
+* @param allocator the allocator, or NULL to use malloc. it must outlive the
+* 	manager and the purchase bills lists it returns.
+*/
+void clientsManagerSetAllocator(ClientsManager manager,
+		SlabAllocator allocator) {
+	if (manager != NULL) manager->allocator = allocator;
+}
+
 /**
 * clientsManagerAddClient: adds the new client to the collection.
 *
@@ -113,8 +179,9 @@ ClientsManagerResult clientsManagerAdd(ClientsManager manager, Email email,
 		return CLIENT_MANAGER_NULL_PARAMETERS;
 
 	Client client = NULL;
-	ClientResult result = clientCreate(email, apartment_min_area,
-			apartment_min_rooms, apartment_max_price, &client);
+	ClientResult result = clientCreateWithAllocator(manager->allocator, email,
+			apartment_min_area, apartment_min_rooms, apartment_max_price,
+			&client);
 	if (result != CLIENT_SUCCESS){
 		if (result == CLIENT_INVALID_PARAMETERS)
 			return CLIENT_MANAGER_INVALID_PARAMETERS;
@@ -125,13 +192,17 @@ ClientsManagerResult clientsManagerAdd(ClientsManager manager, Email email,
 	if (mapContains(manager->clientsMap, email)) {
 		manager_result = CLIENT_MANAGER_ALREADY_EXISTS;
 	} else {
-		MapResult map_result = mapPut( manager->clientsMap,
-			(constMapKeyElement)email, (constMapDataElement)client);
+		MapResult map_result = mapPutTake( manager->clientsMap,
+			(constMapKeyElement)email, (MapDataElement)client);
 
 		if( map_result != MAP_SUCCESS )
 			manager_result = CLIENT_MANAGER_OUT_OF_MEMORY;
+		else {
+			client = NULL;
+			manager_result = registerClient(manager, email);
+		}
 	}
-	clientDestroy(client);
+	if (client != NULL) clientDestroy(client);
 	return manager_result;
 }
 
@@ -150,8 +221,11 @@ ClientsManagerResult clientsManagerAdd(ClientsManager manager, Email email,
 ClientsManagerResult clientsManagerRemove(ClientsManager manager, Email email){
 	if (manager == NULL || email == NULL)
 		return CLIENT_MANAGER_INVALID_PARAMETERS;
-	if (!mapContains(manager->clientsMap, (constMapKeyElement)email))
-		return CLIENT_MANAGER_NOT_EXISTS;
+	Client client = mapGet(manager->clientsMap, (constMapKeyElement)email);
+	if (client == NULL) return CLIENT_MANAGER_NOT_EXISTS;
+	if (clientGetTotalPayments(client) > 0)
+		setRemove(manager->payingClients, client);
+	accountDirectoryRemove(manager->directory, email);
 	mapRemove(manager->clientsMap, (constMapKeyElement)email);
 	return CLIENT_MANAGER_SUCCESS;
 }
@@ -188,23 +262,101 @@ ClientsManagerResult clientsManagerGetSortedPayments(ClientsManager manager,
 		List* list) {
 	if (manager == NULL || list == NULL)
 		return CLIENT_MANAGER_INVALID_PARAMETERS;
+	return createPaymentsList(manager, setGetSize(manager->payingClients),
+		list);
+}
+
+/**
+* clientsManagerGetMostPaying: creates a list of the count registered clients
+* who bought apartments and paid the most, sorted the same as by
+* clientsManagerGetSortedPayments.
+*
+* @param manager Target clients Manager to use.
+* @param count the amount of clients to list.
+* @param list pointer to save destination list in.
+*
+* @return
+* 	CLIENT_MANAGER_INVALID_PARAMETERS - if manager or list are NULL, or count
+* 	is not positive.
+* 	CLIENT_MANAGER_OUT_OF_MEMORY - in case of allocation failure.
+* 	CLIENT_MANAGER_SUCCESS - in case of success.
+*/
+ClientsManagerResult clientsManagerGetMostPaying(ClientsManager manager,
+		int count, List* list) {
+	if (manager == NULL || list == NULL || count <= 0)
+		return CLIENT_MANAGER_INVALID_PARAMETERS;
+	return createPaymentsList(manager, count, list);
+}
+
+/**
+* clientsManagerGetFirstPaying: starts a walk over the registered clients who
+* bought apartments, in the order of clientsManagerGetSortedPayments, and
+* returns the first of them. the walk allocates nothing.
+*
+* @param manager Target clients Manager to use.
+* @param total_payments pointer to save the total payments of the client in.
+*
+* @return
+* 	NULL if manager or total_payments are NULL, or no client bought an
+* 	apartment. else the email of the client, which belongs to the manager.
+*/
+Email clientsManagerGetFirstPaying(ClientsManager manager,
+		int* total_payments) {
+	if ((manager == NULL) || (total_payments == NULL)) return NULL;
+	return getPayingClient(setGetFirst(manager->payingClients),
+		total_payments);
+}
+
+/**
+* clientsManagerGetNextPaying: advances the walk started by
+* clientsManagerGetFirstPaying to the next client. the walk is invalid after
+* clients are added, removed or make purchases.
+*
+* @param manager Target clients Manager to use.
+* @param total_payments pointer to save the total payments of the client in.
+*
+* @return
+* 	NULL if manager or total_payments are NULL, or the walk reached its end.
+* 	else the email of the client, which belongs to the manager.
+*/
+Email clientsManagerGetNextPaying(ClientsManager manager,
+		int* total_payments) {
+	if ((manager == NULL) || (total_payments == NULL)) return NULL;
+	return getPayingClient(setGetNext(manager->payingClients),
+		total_payments);
+}
+
+/*
+ * getPayingClient: returns the email of a paying client and saves its total
+ * payments, or returns NULL if client is NULL.
+ */
+static Email getPayingClient(Client client, int* total_payments) {
+	if (client == NULL) return NULL;
+	*total_payments = clientGetTotalPayments(client);
+	return clientGetMail(client);
+}
+
+/*
+ * createPaymentsList: creates a list of the purchase bills of the count
+ * clients who paid the most, walking them in order.
+ */
+static ClientsManagerResult createPaymentsList(ClientsManager manager,
+		int count, List* list) {
 	List new_list = listCreate(copyListElement, freeListElement);
 	if (new_list == NULL) return CLIENT_MANAGER_OUT_OF_MEMORY;
 	bool error = false;
-	MapDataElement element = mapGetFirst(manager->clientsMap);
-	while (element != NULL && !error) {
-		Client client = (Client)mapGet(manager->clientsMap, element);
-		if (clientGetTotalPayments(client) > 0) {
-			ClientPurchaseBill bill = clientPurchaseBillCreate
-					(clientGetMail(client), clientGetTotalPayments(client));
-			error = (bill == NULL) ||
-					(listInsertLast(new_list, (ListElement)(bill))
-					!= LIST_SUCCESS);
-			clientPurchaseBillDestroy(bill);
-		}
-		element = mapGetNext(manager->clientsMap);
+	Client client = setGetFirst(manager->payingClients);
+	for (; (client != NULL) && (count > 0) && !error; count--) {
+		ClientPurchaseBill bill = clientPurchaseBillCreateWithAllocator
+				(manager->allocator, clientGetMail(client),
+				clientGetTotalPayments(client));
+		error = (bill == NULL) ||
+				(listInsertLastTake(new_list, (ListElement)(bill))
+				!= LIST_SUCCESS);
+		if (error) clientPurchaseBillDestroy(bill);
+		client = setGetNext(manager->payingClients);
 	}
-	if ((error) || (listSort(new_list, compareListElements) != LIST_SUCCESS)) {
+	if (error) {
 		listDestroy(new_list);
 		return CLIENT_MANAGER_OUT_OF_MEMORY;
 	}
@@ -225,10 +377,27 @@ static ListElement copyListElement(ListElement element) {
 	return new_bill;
 }
 
-/** Function to be used for comparing data elements in the list */
-static int compareListElements(ListElement first, ListElement second) {
-	return clientPurchaseBillComapre((ClientPurchaseBill)first,
-			(ClientPurchaseBill)second);
+/** Function to be used for adding clients to the paying clients set, which
+ * does not copy them */
+static SetElement copyPayingClient(SetElement element) {
+	return element;
+}
+
+/** Function to be used for removing clients from the paying clients set,
+ * which does not free them */
+static void freePayingClient(SetElement element) {
+	(void)element;
+}
+
+/** Function to be used for ordering the paying clients set, from the highest
+ * total payments, and by the email for equal payments */
+static int comparePayingClients(SetElement first, SetElement second) {
+	int first_payments = clientGetTotalPayments((Client)first);
+	int second_payments = clientGetTotalPayments((Client)second);
+	if (first_payments != second_payments)
+		return (first_payments < second_payments) ? 1 : -1;
+	return emailComapre(clientGetMail((Client)first),
+			clientGetMail((Client)second));
 }
 
 /**
@@ -278,6 +447,9 @@ ClientsManagerResult clientsManagerGetRestriction(ClientsManager manager,
 *
 * 	CLIENT_MANAGER_NOT_EXISTS - if client email is not registered.
 *
+* 	CLIENT_MANAGER_OUT_OF_MEMORY - if the payment was added, but the client
+* 		could not be ordered among the paying clients.
+*
 * 	CLIENT_MANAGER_SUCCESS - in case of success.
 */
 ClientsManagerResult clientsManagerExecutePurchase(ClientsManager manager,
@@ -286,6 +458,130 @@ ClientsManagerResult clientsManagerExecutePurchase(ClientsManager manager,
 		return CLIENT_MANAGER_INVALID_PARAMETERS;
 	Client client = mapGet(manager->clientsMap, mail);
 	if (client == NULL) return CLIENT_MANAGER_NOT_EXISTS;
+	if (clientGetTotalPayments(client) > 0)
+		setRemove(manager->payingClients, client);
 	clientAddPayment(client, finalPrice);
+	if ((clientGetTotalPayments(client) > 0) &&
+		(setAdd(manager->payingClients, client) == SET_OUT_OF_MEMORY))
+		return CLIENT_MANAGER_OUT_OF_MEMORY;
 	return CLIENT_MANAGER_SUCCESS;
 }
+
+/**
+* clientsManagerSaveSnapshot: writes all the clients to a snapshot: their
+* amount, then for each client its email, apartment preferences and total
+* payments.
+*
+* @param manager Target clients Manager.
+* @param writer the snapshot writer.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS - if manager or writer are NULL.
+*
+* 	SNAPSHOT_WRITE_FAILED - if writing failed.
+*
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult clientsManagerSaveSnapshot(ClientsManager manager,
+		SnapshotWriter writer) {
+	if ((manager == NULL) || (writer == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	if (!snapshotWriteInt(writer, mapGetSize(manager->clientsMap)))
+		return SNAPSHOT_WRITE_FAILED;
+	MAP_FOREACH(Email, email, manager->clientsMap) {
+		Client client = mapGet(manager->clientsMap, email);
+		SnapshotResult result = emailSaveSnapshot(email, writer);
+		if (result != SNAPSHOT_SUCCESS) return result;
+		if (!snapshotWriteInt(writer, clientGetMinArea(client)) ||
+			!snapshotWriteInt(writer, clientGetMinRooms(client)) ||
+			!snapshotWriteInt(writer, clientGetMaxPrice(client)) ||
+			!snapshotWriteInt(writer, clientGetTotalPayments(client)))
+			return SNAPSHOT_WRITE_FAILED;
+	}
+	return SNAPSHOT_SUCCESS;
+}
+
+/**
+* clientsManagerLoadSnapshot: reads clients written by
+* clientsManagerSaveSnapshot into an empty manager. the snapshot is trusted
+* to hold each email once, so clients are not searched for before adding.
+*
+* @param manager Target clients Manager, with no clients.
+* @param reader the snapshot reader.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS - if manager or reader are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT - if the snapshot is truncated or not valid.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY - in case of allocation failure.
+*
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult clientsManagerLoadSnapshot(ClientsManager manager,
+		SnapshotReader reader) {
+	if ((manager == NULL) || (reader == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	int count = 0;
+	if (!snapshotReadInt(reader, &count) || (count < 0))
+		return SNAPSHOT_BAD_FORMAT;
+	for (int i = 0; i < count; i++) {
+		SnapshotResult result = loadClient(manager, reader);
+		if (result != SNAPSHOT_SUCCESS) return result;
+	}
+	return SNAPSHOT_SUCCESS;
+}
+
+/*
+ * loadClient: reads a single client written by clientsManagerSaveSnapshot,
+ * and puts it in the manager.
+ */
+static SnapshotResult loadClient(ClientsManager manager,
+		SnapshotReader reader) {
+	Email email = NULL;
+	SnapshotResult result = emailLoadSnapshot(reader, &email);
+	if (result != SNAPSHOT_SUCCESS) return result;
+	int area = 0, rooms = 0, price = 0, payments = 0;
+	Client client = NULL;
+	if (!snapshotReadInt(reader, &area) || !snapshotReadInt(reader, &rooms) ||
+		!snapshotReadInt(reader, &price) ||
+		!snapshotReadInt(reader, &payments) || (payments < 0)) {
+		emailDestroy(email);
+		return SNAPSHOT_BAD_FORMAT;
+	}
+	ClientResult created = clientCreateWithAllocator(manager->allocator,
+		email, area, rooms, price, &client);
+	if (created != CLIENT_SUCCESS) {
+		emailDestroy(email);
+		return (created == CLIENT_OUT_OF_MEMORY) ? SNAPSHOT_OUT_OF_MEMORY :
+			SNAPSHOT_BAD_FORMAT;
+	}
+	clientAddPayment(client, payments);
+	MapResult put = mapPutTake(manager->clientsMap, email, client);
+	if (put != MAP_SUCCESS) clientDestroy(client);
+	ClientsManagerResult registered = (put == MAP_SUCCESS) ?
+		registerClient(manager, email) : CLIENT_MANAGER_OUT_OF_MEMORY;
+	if ((registered == CLIENT_MANAGER_SUCCESS) && (payments > 0) &&
+		(setAdd(manager->payingClients, client) != SET_SUCCESS))
+		registered = CLIENT_MANAGER_OUT_OF_MEMORY;
+	emailDestroy(email);
+	if (registered == CLIENT_MANAGER_ALREADY_EXISTS)
+		return SNAPSHOT_BAD_FORMAT;
+	return (registered == CLIENT_MANAGER_SUCCESS) ? SNAPSHOT_SUCCESS :
+		SNAPSHOT_OUT_OF_MEMORY;
+}
+
+/*
+ * registerClient: adds a client just put in the manager to the account
+ * directory, with the client the manager holds as its record. the client
+ * is taken out of the manager again if that fails.
+ */
+static ClientsManagerResult registerClient(ClientsManager manager,
+		Email email) {
+	if (manager->directory == NULL) return CLIENT_MANAGER_SUCCESS;
+	Client client = mapGet(manager->clientsMap, email);
+	AccountDirectoryResult result = accountDirectoryAdd(manager->directory,
+		email, ACCOUNT_CLIENT, client);
+	if (result == ACCOUNT_DIRECTORY_SUCCESS) return CLIENT_MANAGER_SUCCESS;
+	mapRemove(manager->clientsMap, email);
+	return (result == ACCOUNT_DIRECTORY_ALREADY_EXISTS) ?
+		CLIENT_MANAGER_ALREADY_EXISTS : CLIENT_MANAGER_OUT_OF_MEMORY;
+}
@@ -4,6 +4,8 @@
 #include "client.h"
 #include "email.h"
 #include "list.h"
+#include "snapshot.h"
+#include "accountDirectory.h"
 
 /**
 * This type defines end codes for the methods.
@@ -37,6 +39,29 @@ ClientsManager clientsManagerCreate();
 */
 void clientsManagerDestroy(ClientsManager manager);
 
+/**
+* clientsManagerSetDirectory: sets the account directory the manager keeps
+* its clients in. clients are added to and removed from the directory with
+* the manager, so it is set while the manager is empty.
+*
+* @param manager Target clients Manager.
+* @param directory the directory, or NULL for none. it must outlive the
+* 	manager.
+*/
+void clientsManagerSetDirectory(ClientsManager manager,
+		AccountDirectory directory);
+
+/**
+* clientsManagerSetAllocator: sets the allocator the manager creates its
+* clients and purchase bills from. it is set while the manager is empty.
+*
+* @param manager Target clients Manager.
+* @param allocator the allocator, or NULL to use malloc. it must outlive the
+* 	manager and the purchase bills lists it returns.
+*/
+void clientsManagerSetAllocator(ClientsManager manager,
+		SlabAllocator allocator);
+
 /**
 * clientsManagerAddClient: adds the new client to the collection.
 *
@@ -125,6 +150,9 @@ ClientsManagerResult clientsManagerGetRestriction(ClientsManager manager,
 *
 * 	CLIENT_MANAGER_NOT_EXISTS - if client email is not registered.
 *
+* 	CLIENT_MANAGER_OUT_OF_MEMORY - if the payment was added, but the client
+* 		could not be ordered among the paying clients.
+*
 * 	CLIENT_MANAGER_SUCCESS - in case of success.
 */
 ClientsManagerResult clientsManagerExecutePurchase(ClientsManager manager,
@@ -146,4 +174,90 @@ ClientsManagerResult clientsManagerExecutePurchase(ClientsManager manager,
 ClientsManagerResult clientsManagerGetSortedPayments(ClientsManager manager,
 		List* list);
 
+/**
+* clientsManagerGetMostPaying: creates a list of the count registered clients
+* who bought apartments and paid the most, sorted the same as by
+* clientsManagerGetSortedPayments.
+*
+* @param manager Target clients Manager to use.
+* @param count the amount of clients to list.
+* @param list pointer to save destination list in.
+*
+* @return
+* 	CLIENT_MANAGER_INVALID_PARAMETERS - if manager or list are NULL, or count
+* 	is not positive.
+* 	CLIENT_MANAGER_OUT_OF_MEMORY - in case of allocation failure.
+* 	CLIENT_MANAGER_SUCCESS - in case of success.
+*/
+ClientsManagerResult clientsManagerGetMostPaying(ClientsManager manager,
+		int count, List* list);
+
+/**
+* clientsManagerGetFirstPaying: starts a walk over the registered clients who
+* bought apartments, in the order of clientsManagerGetSortedPayments, and
+* returns the first of them. the walk allocates nothing.
+*
+* @param manager Target clients Manager to use.
+* @param total_payments pointer to save the total payments of the client in.
+*
+* @return
+* 	NULL if manager or total_payments are NULL, or no client bought an
+* 	apartment. else the email of the client, which belongs to the manager.
+*/
+Email clientsManagerGetFirstPaying(ClientsManager manager,
+		int* total_payments);
+
+/**
+* clientsManagerGetNextPaying: advances the walk started by
+* clientsManagerGetFirstPaying to the next client. the walk is invalid after
+* clients are added, removed or make purchases.
+*
+* @param manager Target clients Manager to use.
+* @param total_payments pointer to save the total payments of the client in.
+*
+* @return
+* 	NULL if manager or total_payments are NULL, or the walk reached its end.
+* 	else the email of the client, which belongs to the manager.
+*/
+Email clientsManagerGetNextPaying(ClientsManager manager,
+		int* total_payments);
+
+/**
+* clientsManagerSaveSnapshot: writes all the clients to a snapshot: their
+* amount, then for each client its email, apartment preferences and total
+* payments.
+*
+* @param manager Target clients Manager.
+* @param writer the snapshot writer.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS - if manager or writer are NULL.
+*
+* 	SNAPSHOT_WRITE_FAILED - if writing failed.
+*
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult clientsManagerSaveSnapshot(ClientsManager manager,
+		SnapshotWriter writer);
+
+/**
+* clientsManagerLoadSnapshot: reads clients written by
+* clientsManagerSaveSnapshot into an empty manager. the snapshot is trusted
+* to hold each email once, so clients are not searched for before adding.
+*
+* @param manager Target clients Manager, with no clients.
+* @param reader the snapshot reader.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS - if manager or reader are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT - if the snapshot is truncated or not valid.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY - in case of allocation failure.
+*
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult clientsManagerLoadSnapshot(ClientsManager manager,
+		SnapshotReader reader);
+
 #endif /* SRC_CLIENTSMANAGER_H_ */
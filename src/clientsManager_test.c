@@ -13,6 +13,8 @@ static bool testClientsManagerRemoveClient();
 static bool testClientsManagerCreate();
 static bool testClientsManagerClientExists();
 static bool testClientsManagerGetSortedPayments();
+static bool testClientsManagerGetMostPaying();
+static bool testClientsManagerPayingWalk();
 static bool testClientsManagerExecurePurchase();
 static bool testClientsManagerGetRestriction();
 
@@ -23,6 +25,8 @@ int RunClientManagerTest(){
 	RUN_TEST(testClientsManagerRemoveClient);
 	RUN_TEST(testClientsManagerClientExists);
 	RUN_TEST(testClientsManagerGetSortedPayments);
+	RUN_TEST(testClientsManagerGetMostPaying);
+	RUN_TEST(testClientsManagerPayingWalk);
 	RUN_TEST(testClientsManagerExecurePurchase);
 	RUN_TEST(testClientsManagerGetRestriction);
 
@@ -129,6 +133,103 @@ static bool testClientsManagerExecurePurchase(){
 	return true;
 }
 
+static bool testClientsManagerPayingWalk(){
+	Email email = NULL, mail1 = NULL ,mail2 = NULL;
+	emailCreate("gaba@ganosh", &email);
+	emailCreate("baba@gash", &mail1);
+	emailCreate("baba@gash2", &mail2);
+	ClientsManager manager = clientsManagerCreate();
+	clientsManagerAdd( manager, email, 1, 1, 200);
+	clientsManagerAdd( manager, mail1, 1, 2, 1000);
+	clientsManagerAdd( manager, mail2, 1, 2, 1000);
+
+	int total = 0;
+	ASSERT_TEST( clientsManagerGetFirstPaying(manager, &total) == NULL);
+	ASSERT_TEST( clientsManagerGetFirstPaying(NULL, &total) == NULL);
+	ASSERT_TEST( clientsManagerGetFirstPaying(manager, NULL) == NULL);
+
+	clientsManagerExecutePurchase( manager, email, 300);
+	clientsManagerExecutePurchase( manager, mail1, 100);
+	clientsManagerExecutePurchase( manager, mail2, 300);
+	ASSERT_TEST( emailAreEqual(clientsManagerGetFirstPaying(manager, &total),
+		mail2));
+	ASSERT_TEST( total == 300);
+	ASSERT_TEST( emailAreEqual(clientsManagerGetNextPaying(manager, &total),
+		email));
+	ASSERT_TEST( total == 300);
+	ASSERT_TEST( emailAreEqual(clientsManagerGetNextPaying(manager, &total),
+		mail1));
+	ASSERT_TEST( total == 100);
+	ASSERT_TEST( clientsManagerGetNextPaying(manager, &total) == NULL);
+
+	clientsManagerExecutePurchase( manager, mail1, 250);
+	ASSERT_TEST( emailAreEqual(clientsManagerGetFirstPaying(manager, &total),
+		mail1));
+	ASSERT_TEST( total == 350);
+	ASSERT_TEST( clientsManagerRemove(manager, mail1) ==
+		CLIENT_MANAGER_SUCCESS);
+	ASSERT_TEST( emailAreEqual(clientsManagerGetFirstPaying(manager, &total),
+		mail2));
+	ASSERT_TEST( emailAreEqual(clientsManagerGetNextPaying(manager, &total),
+		email));
+	ASSERT_TEST( clientsManagerGetNextPaying(manager, &total) == NULL);
+
+	clientsManagerDestroy(manager);
+	emailDestroy(email);
+	emailDestroy(mail1);
+	emailDestroy(mail2);
+	return true;
+}
+
+static bool testClientsManagerGetMostPaying(){
+	Email email = NULL, mail1 = NULL ,mail2 = NULL;
+	emailCreate("gaba@ganosh", &email);
+	emailCreate("baba@gash", &mail1);
+	emailCreate("baba@gash2", &mail2);
+	ClientsManager manager = clientsManagerCreate();
+	clientsManagerAdd( manager, email, 1, 1, 200);
+	clientsManagerAdd( manager, mail1, 1, 2, 1000);
+	clientsManagerAdd( manager, mail2, 1, 2, 1000);
+
+	List clients_list = NULL;
+	ASSERT_TEST( clientsManagerGetMostPaying(NULL, 1, &clients_list) ==
+			CLIENT_MANAGER_INVALID_PARAMETERS);
+	ASSERT_TEST( clientsManagerGetMostPaying(manager, 0, &clients_list) ==
+			CLIENT_MANAGER_INVALID_PARAMETERS);
+	ASSERT_TEST( clientsManagerGetMostPaying(manager, 1, NULL) ==
+			CLIENT_MANAGER_INVALID_PARAMETERS);
+
+	clientsManagerExecutePurchase( manager, email, 330);
+	clientsManagerExecutePurchase( manager, mail1, 900);
+	clientsManagerExecutePurchase( manager, mail2, 100);
+	List sorted_list = NULL;
+	ASSERT_TEST( clientsManagerGetSortedPayments(manager, &sorted_list) ==
+			CLIENT_MANAGER_SUCCESS);
+	ASSERT_TEST( clientsManagerGetMostPaying(manager, 2, &clients_list) ==
+			CLIENT_MANAGER_SUCCESS);
+	ASSERT_TEST( listGetSize(clients_list) == 2);
+	ClientPurchaseBill bill = listGetFirst(clients_list);
+	ClientPurchaseBill sorted_bill = listGetFirst(sorted_list);
+	while (bill != NULL) {
+		ASSERT_TEST( emailAreEqual(clientPurchaseBillGetClientEmail(bill),
+			clientPurchaseBillGetClientEmail(sorted_bill)));
+		bill = listGetNext(clients_list);
+		sorted_bill = listGetNext(sorted_list);
+	}
+	listDestroy(clients_list);
+
+	ASSERT_TEST( clientsManagerGetMostPaying(manager, 5, &clients_list) ==
+			CLIENT_MANAGER_SUCCESS);
+	ASSERT_TEST( listGetSize(clients_list) == 3);
+	listDestroy(clients_list);
+	listDestroy(sorted_list);
+	clientsManagerDestroy(manager);
+	emailDestroy(email);
+	emailDestroy(mail1);
+	emailDestroy(mail2);
+	return true;
+}
+
 static bool testClientsManagerGetSortedPayments(){
 	Email email = NULL, mail1 = NULL ,mail2 = NULL, mail3 = NULL;
 	emailCreate("gaba@ganosh", &email);
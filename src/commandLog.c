@@ -0,0 +1,374 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "commandLog.h"
+
+#define INT_SIZE 4
+#define TAG_SIZE 1
+#define INITIAL_BUFFER_CAPACITY 256
+#define BUFFER_GROWTH_FACTOR 2
+
+struct commandLogReader_t {
+	const unsigned char* data;
+	size_t size;
+	size_t position;
+	CommandTable table;
+};
+
+struct commandLogWriter_t {
+	FILE* file;
+	CommandTable table;
+	unsigned char* buffer;
+	size_t capacity;
+};
+
+static void writeUnsigned(unsigned char* buffer, uint32_t value);
+static uint32_t readUnsigned(const unsigned char* buffer);
+static bool decodeArguments(const unsigned char* data, size_t size,
+	const CommandSpec* spec, size_t* position, CommandArgument* arguments);
+static bool ensureBufferCapacity(CommandLogWriter writer, size_t size);
+
+/**
+* commandLogEncode: encodes a single record.
+*
+* @param record the record to encode, of any kind but COMMAND_RECORD_SKIP
+* 	and COMMAND_RECORD_END.
+* @param spec the command spec of the record, NULL if it has none.
+* @param buffer buffer to encode into, NULL to only get the size.
+*
+* @return
+* 	0 if the record can not be encoded; else returns the encoded size.
+*/
+size_t commandLogEncode(const CommandRecord* record, const CommandSpec* spec,
+	unsigned char* buffer) {
+	if (record == NULL) return 0;
+	if (record->kind == COMMAND_RECORD_UNKNOWN_COMMAND) {
+		if (buffer != NULL) buffer[0] = COMMAND_LOG_TAG_UNKNOWN_COMMAND;
+		return TAG_SIZE;
+	}
+	if ((spec == NULL) || (record->index < 0) ||
+		(record->index >= COMMAND_LOG_TAG_WRONG_ARGUMENTS_COUNT)) return 0;
+	if (record->kind == COMMAND_RECORD_WRONG_ARGUMENTS_COUNT) {
+		if (buffer != NULL) {
+			buffer[0] = COMMAND_LOG_TAG_WRONG_ARGUMENTS_COUNT;
+			buffer[1] = (unsigned char)record->index;
+		}
+		return 2 * TAG_SIZE;
+	}
+	if (record->kind != COMMAND_RECORD_COMMAND) return 0;
+	size_t size = TAG_SIZE;
+	if (buffer != NULL) buffer[0] = (unsigned char)record->index;
+	for (int i = 0; i < spec->arity; i++) {
+		if (spec->types[i] == COMMAND_ARGUMENT_INT) {
+			if (buffer != NULL) {
+				writeUnsigned(buffer + size,
+					(uint32_t)record->arguments[i].number);
+			}
+			size += INT_SIZE;
+			continue;
+		}
+		const char* string = record->arguments[i].string;
+		if (string == NULL) return 0;
+		size_t length = strlen(string);
+		if (length > UINT32_MAX) return 0;
+		if (buffer != NULL) {
+			writeUnsigned(buffer + size, (uint32_t)length);
+			memcpy(buffer + size + INT_SIZE, string, length + 1);
+		}
+		size += INT_SIZE + length + 1;
+	}
+	return size;
+}
+
+/**
+* commandLogDecode: decodes a single record.
+*
+* The string arguments of the record point into the data, and must not be
+* modified.
+*
+* @param data the encoded record.
+* @param size the amount of data available, may be more than the record.
+* @param table the command table the record was encoded with.
+* @param record pointer to save the record in.
+*
+* @return
+* 	0 if a parameter is NULL, or the record is truncated or not valid;
+* 	else returns the decoded size.
+*/
+size_t commandLogDecode(const unsigned char* data, size_t size,
+	CommandTable table, CommandRecord* record) {
+	if ((data == NULL) || (table == NULL) || (record == NULL) ||
+		(size < TAG_SIZE)) return 0;
+	size_t position = 0;
+	int tag = data[position++];
+	record->index = -1;
+	if (tag == COMMAND_LOG_TAG_UNKNOWN_COMMAND) {
+		record->kind = COMMAND_RECORD_UNKNOWN_COMMAND;
+		return position;
+	}
+	if (tag == COMMAND_LOG_TAG_WRONG_ARGUMENTS_COUNT) {
+		if ((position >= size) ||
+			(commandTableGetSpec(table, data[position]) == NULL)) return 0;
+		record->kind = COMMAND_RECORD_WRONG_ARGUMENTS_COUNT;
+		record->index = data[position++];
+		return position;
+	}
+	const CommandSpec* spec = commandTableGetSpec(table, tag);
+	if ((spec == NULL) ||
+		(!decodeArguments(data, size, spec, &position, record->arguments))) {
+		return 0;
+	}
+	record->kind = COMMAND_RECORD_COMMAND;
+	record->index = tag;
+	return position;
+}
+
+/**
+* Allocates a new CommandLogReader over a log in memory.
+*
+* @param data the log data.
+* @param size the log data size.
+* @param table the command table the log is read with.
+* @param result pointer to save the result reader in.
+*
+* @return
+*
+* 	COMMAND_LOG_NULL_PARAMETERS - if data, table or result are NULL.
+*
+* 	COMMAND_LOG_BAD_FORMAT - if the data does not start with a log header or
+* 		was written with a different command table.
+*
+* 	COMMAND_LOG_UNSUPPORTED_VERSION - if the log version is not supported.
+*
+* 	COMMAND_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	COMMAND_LOG_SUCCESS - in case of success.
+*/
+CommandLogResult commandLogReaderCreate(const char* data, size_t size,
+	CommandTable table, CommandLogReader* result) {
+	if ((data == NULL) || (table == NULL) || (result == NULL)) {
+		return COMMAND_LOG_NULL_PARAMETERS;
+	}
+	const unsigned char* header = (const unsigned char*)data;
+	if ((size < COMMAND_LOG_HEADER_SIZE) ||
+		(memcmp(header, COMMAND_LOG_MAGIC, COMMAND_LOG_MAGIC_SIZE) != 0)) {
+		return COMMAND_LOG_BAD_FORMAT;
+	}
+	if (readUnsigned(header + COMMAND_LOG_MAGIC_SIZE) != COMMAND_LOG_VERSION) {
+		return COMMAND_LOG_UNSUPPORTED_VERSION;
+	}
+	if (readUnsigned(header + COMMAND_LOG_MAGIC_SIZE + INT_SIZE) !=
+		commandTableGetFingerprint(table)) {
+		return COMMAND_LOG_BAD_FORMAT;
+	}
+	CommandLogReader reader = malloc(sizeof(*reader));
+	if (reader == NULL) return COMMAND_LOG_OUT_OF_MEMORY;
+	reader->data = header;
+	reader->size = size;
+	reader->position = COMMAND_LOG_HEADER_SIZE;
+	reader->table = table;
+	*result = reader;
+	return COMMAND_LOG_SUCCESS;
+}
+
+/**
+* commandLogReaderNext: reads the next record of the log.
+*
+* The string arguments of the record point into the log data, and must not
+* be modified.
+*
+* @param reader the reader.
+* @param record pointer to save the record in.
+*
+* @return
+*
+* 	COMMAND_LOG_NULL_PARAMETERS - if reader or record are NULL.
+*
+* 	COMMAND_LOG_BAD_FORMAT - if the record is truncated or not valid.
+* 		the rest of the log is skipped.
+*
+* 	COMMAND_LOG_END - if there are no more records.
+*
+* 	COMMAND_LOG_SUCCESS - in case of success.
+*/
+CommandLogResult commandLogReaderNext(CommandLogReader reader,
+	CommandRecord* record) {
+	if ((reader == NULL) || (record == NULL)) {
+		return COMMAND_LOG_NULL_PARAMETERS;
+	}
+	if (reader->position >= reader->size) return COMMAND_LOG_END;
+	size_t size = commandLogDecode(reader->data + reader->position,
+		reader->size - reader->position, reader->table, record);
+	if (size == 0) {
+		reader->position = reader->size;
+		return COMMAND_LOG_BAD_FORMAT;
+	}
+	reader->position += size;
+	return COMMAND_LOG_SUCCESS;
+}
+
+/**
+* commandLogReaderDestroy: Deallocates an existing reader.
+*
+* @param reader Target reader to be deallocated.
+* If reader is NULL nothing will be done
+*/
+void commandLogReaderDestroy(CommandLogReader reader) {
+	free(reader);
+}
+
+/**
+* Allocates a new CommandLogWriter, and writes the log header.
+*
+* @param file the file to write the log to, opened in binary mode.
+* @param table the command table the records are written with.
+* @param result pointer to save the result writer in.
+*
+* @return
+*
+* 	COMMAND_LOG_NULL_PARAMETERS - if file, table or result are NULL.
+*
+* 	COMMAND_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	COMMAND_LOG_WRITE_FAILED - if writing the header failed.
+*
+* 	COMMAND_LOG_SUCCESS - in case of success.
+*/
+CommandLogResult commandLogWriterCreate(FILE* file, CommandTable table,
+	CommandLogWriter* result) {
+	if ((file == NULL) || (table == NULL) || (result == NULL)) {
+		return COMMAND_LOG_NULL_PARAMETERS;
+	}
+	CommandLogWriter writer = malloc(sizeof(*writer));
+	if (writer == NULL) return COMMAND_LOG_OUT_OF_MEMORY;
+	writer->file = file;
+	writer->table = table;
+	writer->buffer = NULL;
+	writer->capacity = 0;
+	unsigned char header[COMMAND_LOG_HEADER_SIZE];
+	memcpy(header, COMMAND_LOG_MAGIC, COMMAND_LOG_MAGIC_SIZE);
+	writeUnsigned(header + COMMAND_LOG_MAGIC_SIZE, COMMAND_LOG_VERSION);
+	writeUnsigned(header + COMMAND_LOG_MAGIC_SIZE + INT_SIZE,
+		commandTableGetFingerprint(table));
+	if (fwrite(header, sizeof(header), 1, file) != 1) {
+		free(writer);
+		return COMMAND_LOG_WRITE_FAILED;
+	}
+	*result = writer;
+	return COMMAND_LOG_SUCCESS;
+}
+
+/**
+* commandLogWriterWrite: writes a record to the log.
+*
+* @param writer the writer.
+* @param record the record, records of kind COMMAND_RECORD_SKIP are ignored.
+*
+* @return
+*
+* 	COMMAND_LOG_NULL_PARAMETERS - if writer or record are NULL.
+*
+* 	COMMAND_LOG_BAD_FORMAT - if the record can not be encoded.
+*
+* 	COMMAND_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	COMMAND_LOG_WRITE_FAILED - if writing failed.
+*
+* 	COMMAND_LOG_SUCCESS - in case of success.
+*/
+CommandLogResult commandLogWriterWrite(CommandLogWriter writer,
+	const CommandRecord* record) {
+	if ((writer == NULL) || (record == NULL)) {
+		return COMMAND_LOG_NULL_PARAMETERS;
+	}
+	if (record->kind == COMMAND_RECORD_SKIP) return COMMAND_LOG_SUCCESS;
+	const CommandSpec* spec = commandTableGetSpec(writer->table, record->index);
+	size_t size = commandLogEncode(record, spec, NULL);
+	if (size == 0) return COMMAND_LOG_BAD_FORMAT;
+	if (!ensureBufferCapacity(writer, size)) return COMMAND_LOG_OUT_OF_MEMORY;
+	commandLogEncode(record, spec, writer->buffer);
+	if (fwrite(writer->buffer, size, 1, writer->file) != 1) {
+		return COMMAND_LOG_WRITE_FAILED;
+	}
+	return COMMAND_LOG_SUCCESS;
+}
+
+/**
+* commandLogWriterDestroy: Deallocates an existing writer.
+*
+* @param writer Target writer to be deallocated.
+* If writer is NULL nothing will be done
+*/
+void commandLogWriterDestroy(CommandLogWriter writer) {
+	if (writer == NULL) return;
+	free(writer->buffer);
+	free(writer);
+}
+
+/*
+* writeUnsigned: writes a 32 bit value in little endian order.
+*/
+static void writeUnsigned(unsigned char* buffer, uint32_t value) {
+	for (int i = 0; i < INT_SIZE; i++) {
+		buffer[i] = (unsigned char)(value >> (8 * i));
+	}
+}
+
+/*
+* readUnsigned: reads a 32 bit value in little endian order.
+*/
+static uint32_t readUnsigned(const unsigned char* buffer) {
+	uint32_t value = 0;
+	for (int i = INT_SIZE - 1; i >= 0; i--) {
+		value = (value << 8) | buffer[i];
+	}
+	return value;
+}
+
+/*
+* decodeArguments: decodes the arguments of a command record by the types
+* of its spec, starting at position of the data and moving it past them.
+*
+* @return
+* 	false if the arguments are truncated or a string is not terminated;
+* 	else returns true.
+*/
+static bool decodeArguments(const unsigned char* data, size_t size,
+	const CommandSpec* spec, size_t* position, CommandArgument* arguments) {
+	for (int i = 0; i < spec->arity; i++) {
+		if (size - *position < INT_SIZE) return false;
+		uint32_t value = readUnsigned(data + *position);
+		*position += INT_SIZE;
+		if (spec->types[i] == COMMAND_ARGUMENT_INT) {
+			arguments[i].number = (int)(int32_t)value;
+			continue;
+		}
+		size_t left = size - *position;
+		if ((left == 0) || (value > left - 1) ||
+			(data[*position + value] != '\0')) return false;
+		arguments[i].string = (char*)(data + *position);
+		*position += (size_t)value + 1;
+	}
+	return true;
+}
+
+/*
+* ensureBufferCapacity: grows the writer buffer geometrically until it can
+* hold size bytes.
+*
+* @return
+* 	false in case of allocation error; else returns true.
+*/
+static bool ensureBufferCapacity(CommandLogWriter writer, size_t size) {
+	if (size <= writer->capacity) return true;
+	size_t capacity = (writer->capacity > 0) ? writer->capacity :
+		INITIAL_BUFFER_CAPACITY;
+	while (capacity < size) capacity *= BUFFER_GROWTH_FACTOR;
+	unsigned char* buffer = realloc(writer->buffer, capacity);
+	if (buffer == NULL) return false;
+	writer->buffer = buffer;
+	writer->capacity = capacity;
+	return true;
+}
@@ -0,0 +1,189 @@
+#ifndef SRC_COMMANDLOG_H_
+#define SRC_COMMANDLOG_H_
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "commandTable.h"
+#include "commandRing.h"
+
+/**
+* The binary command log format.
+*
+* The log starts with a header: the 8 bytes of COMMAND_LOG_MAGIC, the format
+* version and the fingerprint of the command table the log was written with
+* (see commandTableGetFingerprint), both as 32 bit little endian integers.
+* The record tags are spec indexes, so a log is only read with the same
+* table: same specs, in the same order, with the same argument types.
+*
+* Then every record starts with a tag byte:
+* 	- a command spec index, followed by the command arguments.
+* 	- COMMAND_LOG_TAG_WRONG_ARGUMENTS_COUNT followed by a command spec index
+* 		byte, for a line with a known command and too few arguments.
+* 	- COMMAND_LOG_TAG_UNKNOWN_COMMAND, for a line with no known command.
+*
+* Integer arguments are 32 bit little endian. String arguments are their
+* length as a 32 bit little endian integer, followed by the characters and
+* a NUL character, so they can be used in place.
+*/
+#define COMMAND_LOG_MAGIC "YAD3CMDS"
+#define COMMAND_LOG_MAGIC_SIZE 8
+#define COMMAND_LOG_VERSION 1
+#define COMMAND_LOG_HEADER_SIZE (COMMAND_LOG_MAGIC_SIZE + 8)
+#define COMMAND_LOG_TAG_WRONG_ARGUMENTS_COUNT 0xFE
+#define COMMAND_LOG_TAG_UNKNOWN_COMMAND 0xFF
+
+typedef struct commandLogReader_t *CommandLogReader;
+typedef struct commandLogWriter_t *CommandLogWriter;
+
+/**
+* This type defines end codes for the methods.
+*/
+typedef enum {
+	COMMAND_LOG_NULL_PARAMETERS = 0,
+	COMMAND_LOG_OUT_OF_MEMORY = 1,
+	COMMAND_LOG_BAD_FORMAT = 2,
+	COMMAND_LOG_UNSUPPORTED_VERSION = 3,
+	COMMAND_LOG_WRITE_FAILED = 4,
+	COMMAND_LOG_END = 5,
+	COMMAND_LOG_SUCCESS = 6
+} CommandLogResult;
+
+/**
+* commandLogEncode: encodes a single record.
+*
+* @param record the record to encode, of any kind but COMMAND_RECORD_SKIP
+* 	and COMMAND_RECORD_END.
+* @param spec the command spec of the record, NULL if it has none.
+* @param buffer buffer to encode into, NULL to only get the size.
+*
+* @return
+* 	0 if the record can not be encoded; else returns the encoded size.
+*/
+size_t commandLogEncode(const CommandRecord* record, const CommandSpec* spec,
+	unsigned char* buffer);
+
+/**
+* commandLogDecode: decodes a single record.
+*
+* The string arguments of the record point into the data, and must not be
+* modified.
+*
+* @param data the encoded record.
+* @param size the amount of data available, may be more than the record.
+* @param table the command table the record was encoded with.
+* @param record pointer to save the record in.
+*
+* @return
+* 	0 if a parameter is NULL, or the record is truncated or not valid;
+* 	else returns the decoded size.
+*/
+size_t commandLogDecode(const unsigned char* data, size_t size,
+	CommandTable table, CommandRecord* record);
+
+/**
+* Allocates a new CommandLogReader over a log in memory.
+*
+* The log data is not copied and must stay valid while the reader is used.
+* String arguments of the read records point into the data.
+*
+* @param data the log data.
+* @param size the log data size.
+* @param table the command table the log is read with.
+* @param result pointer to save the result reader in.
+*
+* @return
+*
+* 	COMMAND_LOG_NULL_PARAMETERS - if data, table or result are NULL.
+*
+* 	COMMAND_LOG_BAD_FORMAT - if the data does not start with a log header or
+* 		was written with a different command table.
+*
+* 	COMMAND_LOG_UNSUPPORTED_VERSION - if the log version is not supported.
+*
+* 	COMMAND_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	COMMAND_LOG_SUCCESS - in case of success.
+*/
+CommandLogResult commandLogReaderCreate(const char* data, size_t size,
+	CommandTable table, CommandLogReader* result);
+
+/**
+* commandLogReaderNext: reads the next record of the log.
+*
+* @param reader the reader.
+* @param record pointer to save the record in.
+*
+* @return
+*
+* 	COMMAND_LOG_NULL_PARAMETERS - if reader or record are NULL.
+*
+* 	COMMAND_LOG_BAD_FORMAT - if the record is truncated or not valid.
+* 		the rest of the log is skipped.
+*
+* 	COMMAND_LOG_END - if there are no more records.
+*
+* 	COMMAND_LOG_SUCCESS - in case of success.
+*/
+CommandLogResult commandLogReaderNext(CommandLogReader reader,
+	CommandRecord* record);
+
+/**
+* commandLogReaderDestroy: Deallocates an existing reader.
+*
+* @param reader Target reader to be deallocated.
+* If reader is NULL nothing will be done
+*/
+void commandLogReaderDestroy(CommandLogReader reader);
+
+/**
+* Allocates a new CommandLogWriter, and writes the log header.
+* The file is not owned by the writer and will not be closed by it.
+*
+* @param file the file to write the log to, opened in binary mode.
+* @param table the command table the records are written with.
+* @param result pointer to save the result writer in.
+*
+* @return
+*
+* 	COMMAND_LOG_NULL_PARAMETERS - if file, table or result are NULL.
+*
+* 	COMMAND_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	COMMAND_LOG_WRITE_FAILED - if writing the header failed.
+*
+* 	COMMAND_LOG_SUCCESS - in case of success.
+*/
+CommandLogResult commandLogWriterCreate(FILE* file, CommandTable table,
+	CommandLogWriter* result);
+
+/**
+* commandLogWriterWrite: writes a record to the log.
+*
+* @param writer the writer.
+* @param record the record, records of kind COMMAND_RECORD_SKIP are ignored.
+*
+* @return
+*
+* 	COMMAND_LOG_NULL_PARAMETERS - if writer or record are NULL.
+*
+* 	COMMAND_LOG_BAD_FORMAT - if the record can not be encoded.
+*
+* 	COMMAND_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	COMMAND_LOG_WRITE_FAILED - if writing failed.
+*
+* 	COMMAND_LOG_SUCCESS - in case of success.
+*/
+CommandLogResult commandLogWriterWrite(CommandLogWriter writer,
+	const CommandRecord* record);
+
+/**
+* commandLogWriterDestroy: Deallocates an existing writer.
+*
+* @param writer Target writer to be deallocated.
+* If writer is NULL nothing will be done
+*/
+void commandLogWriterDestroy(CommandLogWriter writer);
+
+#endif /* SRC_COMMANDLOG_H_ */
@@ -0,0 +1,261 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include "commandLog.h"
+#include "test_utilities.h"
+
+#define S COMMAND_ARGUMENT_STRING
+#define I COMMAND_ARGUMENT_INT
+#define LOG_CAPACITY 256
+
+static Yad3ServiceResult testHandler(Yad3Program program,
+	const CommandArgument* arguments);
+
+static const CommandSpec TEST_COMMANDS[] = {
+	{"realtor", "add", 3, {S, S, I}, testHandler},
+	{"customer", "remove", 1, {S}, testHandler},
+	{"report", "significant_realtors", 1, {I}, testHandler}
+};
+
+static const CommandSpec REORDERED_COMMANDS[] = {
+	{"customer", "remove", 1, {S}, testHandler},
+	{"realtor", "add", 3, {S, S, I}, testHandler},
+	{"report", "significant_realtors", 1, {I}, testHandler}
+};
+
+static const CommandSpec RETYPED_COMMANDS[] = {
+	{"realtor", "add", 3, {S, S, S}, testHandler},
+	{"customer", "remove", 1, {S}, testHandler},
+	{"report", "significant_realtors", 1, {I}, testHandler}
+};
+
+#define TEST_COMMANDS_COUNT \
+	((int)(sizeof(TEST_COMMANDS) / sizeof(TEST_COMMANDS[0])))
+
+static bool testCommandLogEncode();
+static bool testCommandLogDecode();
+static bool testCommandLogRoundTrip();
+static bool testCommandLogReaderCreate();
+static bool testCommandLogTruncated();
+static size_t writeTestLog(CommandTable table, char* log);
+int RunCommandLogTest();
+
+//int main() {
+int RunCommandLogTest() {
+	RUN_TEST(testCommandLogEncode);
+	RUN_TEST(testCommandLogDecode);
+	RUN_TEST(testCommandLogRoundTrip);
+	RUN_TEST(testCommandLogReaderCreate);
+	RUN_TEST(testCommandLogTruncated);
+	return 0;
+}
+
+/**
+ * Test encode method
+ */
+static bool testCommandLogEncode() {
+	char email[] = "me@a.com";
+	char company[] = "sella";
+	CommandRecord record = {COMMAND_RECORD_COMMAND, 0,
+		{{email}, {company}}, NULL, 0};
+	record.arguments[2].number = -2;
+	unsigned char buffer[32];
+	ASSERT_TEST(commandLogEncode(&record, &TEST_COMMANDS[0], NULL) == 28);
+	ASSERT_TEST(commandLogEncode(&record, &TEST_COMMANDS[0], buffer) == 28);
+	ASSERT_TEST(buffer[0] == 0);
+	ASSERT_TEST((buffer[1] == 8) && (buffer[2] == 0) && (buffer[4] == 0));
+	ASSERT_TEST(strcmp((char*)buffer + 5, "me@a.com") == 0);
+	ASSERT_TEST(buffer[14] == 5);
+	ASSERT_TEST(strcmp((char*)buffer + 18, "sella") == 0);
+	ASSERT_TEST((buffer[24] == 0xFE) && (buffer[27] == 0xFF));
+	ASSERT_TEST(commandLogEncode(&record, NULL, NULL) == 0);
+	record.kind = COMMAND_RECORD_WRONG_ARGUMENTS_COUNT;
+	ASSERT_TEST(commandLogEncode(&record, &TEST_COMMANDS[0], buffer) == 2);
+	ASSERT_TEST((buffer[0] == COMMAND_LOG_TAG_WRONG_ARGUMENTS_COUNT) &&
+		(buffer[1] == 0));
+	record.kind = COMMAND_RECORD_UNKNOWN_COMMAND;
+	ASSERT_TEST(commandLogEncode(&record, NULL, buffer) == 1);
+	ASSERT_TEST(buffer[0] == COMMAND_LOG_TAG_UNKNOWN_COMMAND);
+	record.kind = COMMAND_RECORD_END;
+	ASSERT_TEST(commandLogEncode(&record, &TEST_COMMANDS[0], buffer) == 0);
+	ASSERT_TEST(commandLogEncode(NULL, &TEST_COMMANDS[0], buffer) == 0);
+	return true;
+}
+
+/**
+ * Test decode method reads a single encoded record
+ */
+static bool testCommandLogDecode() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	char email[] = "me@a.com";
+	CommandRecord record = {COMMAND_RECORD_COMMAND, 1, {{email}}, NULL, 0};
+	unsigned char buffer[32];
+	size_t size = commandLogEncode(&record, &TEST_COMMANDS[1], buffer);
+	CommandRecord decoded;
+	ASSERT_TEST(commandLogDecode(buffer, sizeof(buffer), table, &decoded) ==
+		size);
+	ASSERT_TEST(decoded.kind == COMMAND_RECORD_COMMAND);
+	ASSERT_TEST(decoded.index == 1);
+	ASSERT_TEST(strcmp(decoded.arguments[0].string, "me@a.com") == 0);
+	ASSERT_TEST(commandLogDecode(buffer, size - 1, table, &decoded) == 0);
+	ASSERT_TEST(commandLogDecode(buffer, size, NULL, &decoded) == 0);
+	buffer[0] = TEST_COMMANDS_COUNT;
+	ASSERT_TEST(commandLogDecode(buffer, size, table, &decoded) == 0);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test records are read back as they were written
+ */
+static bool testCommandLogRoundTrip() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	char log[LOG_CAPACITY];
+	size_t size = writeTestLog(table, log);
+	ASSERT_TEST(size > COMMAND_LOG_HEADER_SIZE);
+	CommandLogReader reader = NULL;
+	ASSERT_TEST(commandLogReaderCreate(log, size, table, &reader) ==
+		COMMAND_LOG_SUCCESS);
+	CommandRecord record;
+	ASSERT_TEST(commandLogReaderNext(reader, &record) == COMMAND_LOG_SUCCESS);
+	ASSERT_TEST(record.kind == COMMAND_RECORD_COMMAND);
+	ASSERT_TEST(record.index == 0);
+	ASSERT_TEST(strcmp(record.arguments[0].string, "me@a.com") == 0);
+	ASSERT_TEST(strcmp(record.arguments[1].string, "") == 0);
+	ASSERT_TEST(record.arguments[2].number == -7);
+	ASSERT_TEST(commandLogReaderNext(reader, &record) == COMMAND_LOG_SUCCESS);
+	ASSERT_TEST(record.kind == COMMAND_RECORD_COMMAND);
+	ASSERT_TEST(record.index == 2);
+	ASSERT_TEST(record.arguments[0].number == 2147483647);
+	ASSERT_TEST(commandLogReaderNext(reader, &record) == COMMAND_LOG_SUCCESS);
+	ASSERT_TEST(record.kind == COMMAND_RECORD_WRONG_ARGUMENTS_COUNT);
+	ASSERT_TEST(record.index == 1);
+	ASSERT_TEST(commandLogReaderNext(reader, &record) == COMMAND_LOG_SUCCESS);
+	ASSERT_TEST(record.kind == COMMAND_RECORD_UNKNOWN_COMMAND);
+	ASSERT_TEST(commandLogReaderNext(reader, &record) == COMMAND_LOG_END);
+	ASSERT_TEST(commandLogReaderNext(reader, NULL) ==
+		COMMAND_LOG_NULL_PARAMETERS);
+	commandLogReaderDestroy(reader);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test create method
+ */
+static bool testCommandLogReaderCreate() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	CommandTable smaller = commandTableCreate(TEST_COMMANDS, 2);
+	CommandTable reordered = commandTableCreate(REORDERED_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	CommandTable retyped = commandTableCreate(RETYPED_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	char log[LOG_CAPACITY];
+	size_t size = writeTestLog(table, log);
+	CommandLogReader reader = NULL;
+	ASSERT_TEST(commandLogReaderCreate(NULL, size, table, &reader) ==
+		COMMAND_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(commandLogReaderCreate(log, size, NULL, &reader) ==
+		COMMAND_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(commandLogReaderCreate(log, COMMAND_LOG_HEADER_SIZE - 1,
+		table, &reader) == COMMAND_LOG_BAD_FORMAT);
+	ASSERT_TEST(commandLogReaderCreate(log, size, smaller, &reader) ==
+		COMMAND_LOG_BAD_FORMAT);
+	ASSERT_TEST(commandLogReaderCreate(log, size, reordered, &reader) ==
+		COMMAND_LOG_BAD_FORMAT);
+	ASSERT_TEST(commandLogReaderCreate(log, size, retyped, &reader) ==
+		COMMAND_LOG_BAD_FORMAT);
+	ASSERT_TEST(commandLogReaderCreate(log, COMMAND_LOG_HEADER_SIZE, table,
+		&reader) == COMMAND_LOG_SUCCESS);
+	CommandRecord record;
+	ASSERT_TEST(commandLogReaderNext(reader, &record) == COMMAND_LOG_END);
+	commandLogReaderDestroy(reader);
+	log[COMMAND_LOG_MAGIC_SIZE] = COMMAND_LOG_VERSION + 1;
+	ASSERT_TEST(commandLogReaderCreate(log, size, table, &reader) ==
+		COMMAND_LOG_UNSUPPORTED_VERSION);
+	log[0] = 'X';
+	ASSERT_TEST(commandLogReaderCreate(log, size, table, &reader) ==
+		COMMAND_LOG_BAD_FORMAT);
+	commandLogReaderDestroy(NULL);
+	commandTableDestroy(retyped);
+	commandTableDestroy(reordered);
+	commandTableDestroy(smaller);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test a truncated record ends the log
+ */
+static bool testCommandLogTruncated() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	char log[LOG_CAPACITY];
+	writeTestLog(table, log);
+	CommandLogReader reader = NULL;
+	CommandRecord record;
+	ASSERT_TEST(commandLogReaderCreate(log, COMMAND_LOG_HEADER_SIZE + 10,
+		table, &reader) == COMMAND_LOG_SUCCESS);
+	ASSERT_TEST(commandLogReaderNext(reader, &record) ==
+		COMMAND_LOG_BAD_FORMAT);
+	ASSERT_TEST(commandLogReaderNext(reader, &record) == COMMAND_LOG_END);
+	commandLogReaderDestroy(reader);
+	log[COMMAND_LOG_HEADER_SIZE + 13] = 'x';
+	ASSERT_TEST(commandLogReaderCreate(log, LOG_CAPACITY, table, &reader) ==
+		COMMAND_LOG_SUCCESS);
+	ASSERT_TEST(commandLogReaderNext(reader, &record) ==
+		COMMAND_LOG_BAD_FORMAT);
+	commandLogReaderDestroy(reader);
+	commandTableDestroy(table);
+	return true;
+}
+
+/*
+ * Writes a log of four records through a temporary file and reads it into
+ * log, returns the log size
+ */
+static size_t writeTestLog(CommandTable table, char* log) {
+	FILE* file = tmpfile();
+	if (file == NULL) return 0;
+	CommandLogWriter writer = NULL;
+	char email[] = "me@a.com";
+	char empty[] = "";
+	CommandRecord records[] = {
+		{COMMAND_RECORD_COMMAND, 0, {{email}, {empty}}, NULL, 0},
+		{COMMAND_RECORD_COMMAND, 2, {{NULL}}, NULL, 0},
+		{COMMAND_RECORD_SKIP, -1, {{NULL}}, NULL, 0},
+		{COMMAND_RECORD_WRONG_ARGUMENTS_COUNT, 1, {{NULL}}, NULL, 0},
+		{COMMAND_RECORD_UNKNOWN_COMMAND, -1, {{NULL}}, NULL, 0}
+	};
+	records[0].arguments[2].number = -7;
+	records[1].arguments[0].number = 2147483647;
+	bool is_written = (commandLogWriterCreate(file, table, &writer) ==
+		COMMAND_LOG_SUCCESS);
+	for (int i = 0; (is_written) && (i < 5); i++) {
+		is_written = (commandLogWriterWrite(writer, &records[i]) ==
+			COMMAND_LOG_SUCCESS);
+	}
+	commandLogWriterDestroy(writer);
+	size_t size = 0;
+	if (is_written) {
+		rewind(file);
+		size = fread(log, sizeof(char), LOG_CAPACITY, file);
+	}
+	fclose(file);
+	return size;
+}
+
+/*
+ * Handler of the test commands, never called
+ */
+static Yad3ServiceResult testHandler(Yad3Program program,
+	const CommandArgument* arguments) {
+	(void)program;
+	(void)arguments;
+	return YAD3_SERVICE_SUCCESS;
+}
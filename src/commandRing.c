@@ -0,0 +1,233 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <sched.h>
+#include "commandRing.h"
+
+#define CACHE_LINE_SIZE 64
+#define SPINS_BEFORE_YIELD 64
+#define INITIAL_TEXT_CAPACITY 64
+#define TEXT_GROWTH_FACTOR 2
+
+/*
+* head is written only by the producer and tail only by the consumer, each
+* on its own cache line so the two threads do not invalidate each other.
+* each side keeps the last value it saw of the other side index, and reads
+* the shared one again only when the ring looks full or empty.
+*/
+struct commandRing_t {
+	CommandRecord* records;
+	unsigned long mask;
+	char head_padding[CACHE_LINE_SIZE];
+	unsigned long head;
+	unsigned long producer_tail;
+	char tail_padding[CACHE_LINE_SIZE];
+	unsigned long tail;
+	unsigned long consumer_head;
+	char stop_padding[CACHE_LINE_SIZE];
+	int is_stopped;
+};
+
+static void waitForRing(int* spins);
+static bool ensureTextCapacity(CommandRecord* record, int size);
+
+/**
+* Allocates a new CommandRing, a bounded lock free queue of command records
+* between exactly one producer thread and one consumer thread.
+*
+* @param capacity the amount of records, rounded up to a power of two.
+*
+* @return
+* 	NULL - if capacity is not positive or allocations failed.
+* 	A new CommandRing in case of success.
+*/
+CommandRing commandRingCreate(int capacity) {
+	if (capacity <= 0) return NULL;
+	unsigned long size = 1;
+	while (size < (unsigned long)capacity) size <<= 1;
+	CommandRing ring = malloc(sizeof(*ring));
+	if (ring == NULL) return NULL;
+	ring->records = malloc(sizeof(*ring->records) * size);
+	if (ring->records == NULL) {
+		free(ring);
+		return NULL;
+	}
+	for (unsigned long i = 0; i < size; i++) {
+		ring->records[i].kind = COMMAND_RECORD_SKIP;
+		ring->records[i].index = 0;
+		ring->records[i].text = NULL;
+		ring->records[i].text_capacity = 0;
+	}
+	ring->mask = size - 1;
+	ring->head = 0;
+	ring->producer_tail = 0;
+	ring->tail = 0;
+	ring->consumer_head = 0;
+	ring->is_stopped = 0;
+	return ring;
+}
+
+/**
+* commandRingAcquire: producer side, waits for a free record.
+*
+* @param ring the ring.
+*
+* @return
+* 	NULL if ring is NULL or the consumer stopped the ring;
+* 	else returns the free record
+*/
+CommandRecord* commandRingAcquire(CommandRing ring) {
+	if (ring == NULL) return NULL;
+	unsigned long head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+	int spins = 0;
+	while (head - ring->producer_tail > ring->mask) {
+		if (__atomic_load_n(&ring->is_stopped, __ATOMIC_ACQUIRE)) return NULL;
+		ring->producer_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+		if (head - ring->producer_tail > ring->mask) waitForRing(&spins);
+	}
+	if (__atomic_load_n(&ring->is_stopped, __ATOMIC_ACQUIRE)) return NULL;
+	return &ring->records[head & ring->mask];
+}
+
+/**
+* commandRingPublish: producer side, hands the acquired record over to the
+* consumer.
+*
+* @param ring the ring.
+*/
+void commandRingPublish(CommandRing ring) {
+	if (ring == NULL) return;
+	unsigned long head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+* commandRingPeek: consumer side, waits for the next published record.
+*
+* @param ring the ring.
+*
+* @return
+* 	NULL if ring is NULL; else returns the next record
+*/
+CommandRecord* commandRingPeek(CommandRing ring) {
+	if (ring == NULL) return NULL;
+	unsigned long tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+	int spins = 0;
+	while (ring->consumer_head == tail) {
+		ring->consumer_head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+		if (ring->consumer_head == tail) waitForRing(&spins);
+	}
+	return &ring->records[tail & ring->mask];
+}
+
+/**
+* commandRingRelease: consumer side, returns the peeked record to the
+* producer.
+*
+* @param ring the ring.
+*/
+void commandRingRelease(CommandRing ring) {
+	if (ring == NULL) return;
+	unsigned long tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+	__atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+* commandRingStop: consumer side, tells the producer no more records will
+* be read.
+*
+* @param ring the ring.
+*/
+void commandRingStop(CommandRing ring) {
+	if (ring == NULL) return;
+	__atomic_store_n(&ring->is_stopped, 1, __ATOMIC_RELEASE);
+}
+
+/**
+* commandRecordCopy: copies a record into a ring record, copying its string
+* arguments into the target text.
+*
+* @param target the ring record.
+* @param source the record to copy.
+* @param spec the command spec of the source, NULL if it has none.
+*
+* @return
+* 	false in case of allocation error; else returns true.
+*/
+bool commandRecordCopy(CommandRecord* target, const CommandRecord* source,
+	const CommandSpec* spec) {
+	target->kind = source->kind;
+	target->index = source->index;
+	if ((spec == NULL) || (source->kind != COMMAND_RECORD_COMMAND)) {
+		return true;
+	}
+	int size = 0;
+	for (int i = 0; i < spec->arity; i++) {
+		if (spec->types[i] == COMMAND_ARGUMENT_STRING) {
+			size += strlen(source->arguments[i].string) + 1;
+		}
+	}
+	if (!ensureTextCapacity(target, size)) return false;
+	char* text = target->text;
+	for (int i = 0; i < spec->arity; i++) {
+		if (spec->types[i] == COMMAND_ARGUMENT_STRING) {
+			int length = strlen(source->arguments[i].string) + 1;
+			memcpy(text, source->arguments[i].string, length);
+			target->arguments[i].string = text;
+			text += length;
+		} else {
+			target->arguments[i].number = source->arguments[i].number;
+		}
+	}
+	return true;
+}
+
+/**
+* commandRingDestroy: Deallocates an existing CommandRing and the text of
+* its records.
+*
+* @param ring Target ring to be deallocated.
+* If ring is NULL nothing will be done
+*/
+void commandRingDestroy(CommandRing ring) {
+	if (ring == NULL) return;
+	for (unsigned long i = 0; i <= ring->mask; i++) {
+		free(ring->records[i].text);
+	}
+	free(ring->records);
+	free(ring);
+}
+
+/*
+* waitForRing: spins for a while, then lets other threads run while waiting.
+*/
+static void waitForRing(int* spins) {
+	if (*spins < SPINS_BEFORE_YIELD) {
+		(*spins)++;
+	} else {
+		sched_yield();
+	}
+}
+
+/*
+* ensureTextCapacity: grows the record text geometrically until it can hold
+* size characters. nothing is allocated when it is already large enough.
+*
+* @return
+* 	false in case of allocation error; else returns true.
+*/
+static bool ensureTextCapacity(CommandRecord* record, int size) {
+	if (size <= record->text_capacity) return true;
+	int capacity = (record->text_capacity > 0) ? record->text_capacity :
+		INITIAL_TEXT_CAPACITY;
+	while (capacity < size) capacity *= TEXT_GROWTH_FACTOR;
+	char* text = realloc(record->text, sizeof(char) * capacity);
+	if (text == NULL) return false;
+	record->text = text;
+	record->text_capacity = capacity;
+	return true;
+}
@@ -0,0 +1,118 @@
+#ifndef SRC_COMMANDRING_H_
+#define SRC_COMMANDRING_H_
+
+#include <stdbool.h>
+#include "commandTable.h"
+
+typedef struct commandRing_t *CommandRing;
+
+/**
+* The kinds of decoded command records.
+*/
+typedef enum {
+	COMMAND_RECORD_SKIP,
+	COMMAND_RECORD_COMMAND,
+	COMMAND_RECORD_WRONG_ARGUMENTS_COUNT,
+	COMMAND_RECORD_UNKNOWN_COMMAND,
+	COMMAND_RECORD_OUT_OF_MEMORY,
+	COMMAND_RECORD_END
+} CommandRecordKind;
+
+/**
+* A parsed input line, ready to be executed.
+*
+* index is the command spec index, valid for COMMAND_RECORD_COMMAND and
+* COMMAND_RECORD_WRONG_ARGUMENTS_COUNT. The string arguments of a record
+* inside a ring point into the record text, which the ring owns and reuses.
+*/
+typedef struct {
+	CommandRecordKind kind;
+	int index;
+	CommandArgument arguments[COMMAND_MAX_ARGUMENTS];
+	char* text;
+	int text_capacity;
+} CommandRecord;
+
+/**
+* Allocates a new CommandRing, a bounded lock free queue of command records
+* between exactly one producer thread and one consumer thread.
+*
+* @param capacity the amount of records, rounded up to a power of two.
+*
+* @return
+* 	NULL - if capacity is not positive or allocations failed.
+* 	A new CommandRing in case of success.
+*/
+CommandRing commandRingCreate(int capacity);
+
+/**
+* commandRingAcquire: producer side, waits for a free record.
+* The record should be filled and then handed over by commandRingPublish.
+*
+* @param ring the ring.
+*
+* @return
+* 	NULL if ring is NULL or the consumer stopped the ring;
+* 	else returns the free record
+*/
+CommandRecord* commandRingAcquire(CommandRing ring);
+
+/**
+* commandRingPublish: producer side, hands the acquired record over to the
+* consumer.
+*
+* @param ring the ring.
+*/
+void commandRingPublish(CommandRing ring);
+
+/**
+* commandRingPeek: consumer side, waits for the next published record.
+* The record should be returned by commandRingRelease once used.
+*
+* @param ring the ring.
+*
+* @return
+* 	NULL if ring is NULL; else returns the next record
+*/
+CommandRecord* commandRingPeek(CommandRing ring);
+
+/**
+* commandRingRelease: consumer side, returns the peeked record to the
+* producer.
+*
+* @param ring the ring.
+*/
+void commandRingRelease(CommandRing ring);
+
+/**
+* commandRingStop: consumer side, tells the producer no more records will
+* be read. a producer waiting for a free record stops waiting.
+*
+* @param ring the ring.
+*/
+void commandRingStop(CommandRing ring);
+
+/**
+* commandRecordCopy: copies a record into a ring record, copying its string
+* arguments into the target text.
+*
+* @param target the ring record.
+* @param source the record to copy.
+* @param spec the command spec of the source, NULL if it has none.
+*
+* @return
+* 	false in case of allocation error; else returns true.
+*/
+bool commandRecordCopy(CommandRecord* target, const CommandRecord* source,
+	const CommandSpec* spec);
+
+/**
+* commandRingDestroy: Deallocates an existing CommandRing and the text of
+* its records. Both threads must be done using the ring.
+*
+* @param ring Target ring to be deallocated.
+* If ring is NULL nothing will be done
+*/
+void commandRingDestroy(CommandRing ring);
+
+#endif /* SRC_COMMANDRING_H_ */
@@ -0,0 +1,147 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include "commandRing.h"
+#include "test_utilities.h"
+
+#define THREADED_RECORDS_COUNT 100000
+
+static bool testCommandRingCreate();
+static bool testCommandRingOrder();
+static bool testCommandRingStop();
+static bool testCommandRingThreads();
+static bool testCommandRecordCopy();
+static void* produceRecords(void* ring);
+int RunCommandRingTest();
+
+//int main() {
+int RunCommandRingTest() {
+	RUN_TEST(testCommandRingCreate);
+	RUN_TEST(testCommandRingOrder);
+	RUN_TEST(testCommandRingStop);
+	RUN_TEST(testCommandRingThreads);
+	RUN_TEST(testCommandRecordCopy);
+	return 0;
+}
+
+/**
+ * Test create method
+ */
+static bool testCommandRingCreate() {
+	ASSERT_TEST(commandRingCreate(0) == NULL);
+	ASSERT_TEST(commandRingCreate(-4) == NULL);
+	CommandRing ring = commandRingCreate(3);
+	ASSERT_TEST(ring != NULL);
+	ASSERT_TEST(commandRingAcquire(NULL) == NULL);
+	ASSERT_TEST(commandRingPeek(NULL) == NULL);
+	commandRingDestroy(ring);
+	commandRingDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test records are read in the order they are published, around the ring
+ */
+static bool testCommandRingOrder() {
+	CommandRing ring = commandRingCreate(4);
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 4; i++) {
+			CommandRecord* record = commandRingAcquire(ring);
+			ASSERT_TEST(record != NULL);
+			record->kind = COMMAND_RECORD_COMMAND;
+			record->index = round * 4 + i;
+			commandRingPublish(ring);
+		}
+		for (int i = 0; i < 4; i++) {
+			CommandRecord* record = commandRingPeek(ring);
+			ASSERT_TEST(record->index == round * 4 + i);
+			commandRingRelease(ring);
+		}
+	}
+	commandRingDestroy(ring);
+	return true;
+}
+
+/**
+ * Test a producer waiting on a full ring stops when the ring is stopped
+ */
+static bool testCommandRingStop() {
+	CommandRing ring = commandRingCreate(2);
+	ASSERT_TEST(commandRingAcquire(ring) != NULL);
+	commandRingPublish(ring);
+	ASSERT_TEST(commandRingAcquire(ring) != NULL);
+	commandRingPublish(ring);
+	commandRingStop(ring);
+	ASSERT_TEST(commandRingAcquire(ring) == NULL);
+	commandRingDestroy(ring);
+	return true;
+}
+
+/**
+ * Test records cross between two threads in order
+ */
+static bool testCommandRingThreads() {
+	CommandRing ring = commandRingCreate(8);
+	pthread_t producer;
+	ASSERT_TEST(pthread_create(&producer, NULL, produceRecords, ring) == 0);
+	bool is_ordered = true;
+	for (int i = 0; i <= THREADED_RECORDS_COUNT; i++) {
+		CommandRecord* record = commandRingPeek(ring);
+		if (i == THREADED_RECORDS_COUNT) {
+			is_ordered &= (record->kind == COMMAND_RECORD_END);
+		} else {
+			is_ordered &= (record->index == i);
+		}
+		commandRingRelease(ring);
+	}
+	pthread_join(producer, NULL);
+	commandRingDestroy(ring);
+	ASSERT_TEST(is_ordered);
+	return true;
+}
+
+/**
+ * Test copy method
+ */
+static bool testCommandRecordCopy() {
+	CommandSpec spec = {"customer", "purchase", 4,
+		{COMMAND_ARGUMENT_STRING, COMMAND_ARGUMENT_STRING,
+		COMMAND_ARGUMENT_STRING, COMMAND_ARGUMENT_INT}, NULL};
+	char text[] = "me@a.com\0you@b.com\0home";
+	CommandRecord source = {COMMAND_RECORD_COMMAND, 3,
+		{{text}, {text + 9}, {text + 19}}, NULL, 0};
+	source.arguments[3].number = 7;
+	CommandRing ring = commandRingCreate(1);
+	CommandRecord* target = commandRingAcquire(ring);
+	ASSERT_TEST(commandRecordCopy(target, &source, &spec));
+	memset(text, 'x', sizeof(text));
+	ASSERT_TEST(target->kind == COMMAND_RECORD_COMMAND);
+	ASSERT_TEST(target->index == 3);
+	ASSERT_TEST(strcmp(target->arguments[0].string, "me@a.com") == 0);
+	ASSERT_TEST(strcmp(target->arguments[1].string, "you@b.com") == 0);
+	ASSERT_TEST(strcmp(target->arguments[2].string, "home") == 0);
+	ASSERT_TEST(target->arguments[3].number == 7);
+	source.kind = COMMAND_RECORD_UNKNOWN_COMMAND;
+	ASSERT_TEST(commandRecordCopy(target, &source, NULL));
+	ASSERT_TEST(target->kind == COMMAND_RECORD_UNKNOWN_COMMAND);
+	commandRingDestroy(ring);
+	return true;
+}
+
+/*
+ * Producer thread of the threads test
+ */
+static void* produceRecords(void* ring) {
+	for (int i = 0; i <= THREADED_RECORDS_COUNT; i++) {
+		CommandRecord* record = commandRingAcquire(ring);
+		if (record == NULL) return NULL;
+		record->kind = (i == THREADED_RECORDS_COUNT) ? COMMAND_RECORD_END :
+			COMMAND_RECORD_COMMAND;
+		record->index = i;
+		commandRingPublish(ring);
+	}
+	return NULL;
+}
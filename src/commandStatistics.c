@@ -0,0 +1,181 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "commandStatistics.h"
+#include "latencyHistogram.h"
+
+#define NANOSECONDS_PER_MICROSECOND 1000.0
+#define PERCENTILES_COUNT 4
+#define NAME_WIDTH 40
+
+struct commandStatistics_t {
+	CommandTable table;
+	int commands_count;
+	LatencyHistogram* latencies;
+	long long successes;
+	long long errors[COMMAND_STATISTICS_ERROR_CODES];
+};
+
+static const double PERCENTILES[PERCENTILES_COUNT] = {50, 90, 99, 99.9};
+
+static const char* ERROR_NAMES[COMMAND_STATISTICS_ERROR_CODES] = {
+	"MTM_OUT_OF_MEMORY",
+	"MTM_INVALID_COMMAND_LINE_PARAMETERS",
+	"MTM_CANNOT_OPEN_FILE",
+	"MTM_INVALID_PARAMETERS",
+	"MTM_EMAIL_ALREADY_EXISTS",
+	"MTM_EMAIL_DOES_NOT_EXIST",
+	"MTM_EMAIL_WRONG_ACCOUNT_TYPE",
+	"MTM_ALREADY_REQUESTED",
+	"MTM_NOT_REQUESTED",
+	"MTM_APARTMENT_SERVICE_ALREADY_EXISTS",
+	"MTM_APARTMENT_SERVICE_DOES_NOT_EXIST",
+	"MTM_APARTMENT_SERVICE_FULL",
+	"MTM_APARTMENT_ALREADY_EXISTS",
+	"MTM_APARTMENT_DOES_NOT_EXIST",
+	"MTM_PURCHASE_WRONG_PROPERTIES",
+	"MTM_REQUEST_WRONG_PROPERTIES",
+	"MTM_REQUEST_ILLOGICAL_PRICE"
+};
+
+static void printLatencies(CommandStatistics statistics, FILE* output);
+static void printOutcomes(CommandStatistics statistics, FILE* output);
+
+/**
+* Allocates new CommandStatistics for the commands of a table: a latency
+* histogram per command, and the amount of commands of each outcome.
+*
+* @param table the command table, must outlive the statistics.
+*
+* @return
+* 	NULL - if table is NULL or allocations failed.
+* 	New CommandStatistics in case of success.
+*/
+CommandStatistics commandStatisticsCreate(CommandTable table) {
+	if (table == NULL) return NULL;
+	CommandStatistics statistics = malloc(sizeof(*statistics));
+	if (statistics == NULL) return NULL;
+	statistics->table = table;
+	statistics->commands_count = commandTableGetCount(table);
+	statistics->latencies = calloc(statistics->commands_count,
+		sizeof(*statistics->latencies));
+	statistics->successes = 0;
+	for (int i = 0; i < COMMAND_STATISTICS_ERROR_CODES; i++) {
+		statistics->errors[i] = 0;
+	}
+	if (statistics->latencies == NULL) {
+		free(statistics);
+		return NULL;
+	}
+	for (int i = 0; i < statistics->commands_count; i++) {
+		statistics->latencies[i] = latencyHistogramCreate();
+		if (statistics->latencies[i] == NULL) {
+			commandStatisticsDestroy(statistics);
+			return NULL;
+		}
+	}
+	return statistics;
+}
+
+/**
+* commandStatisticsRecordLatency: counts the run time of a command.
+*
+* @param statistics the statistics.
+* @param index the command spec index.
+* @param nanoseconds the command run time.
+*/
+void commandStatisticsRecordLatency(CommandStatistics statistics, int index,
+	long long nanoseconds) {
+	if ((statistics == NULL) || (index < 0) ||
+		(index >= statistics->commands_count)) return;
+	latencyHistogramRecord(statistics->latencies[index], nanoseconds);
+}
+
+/**
+* commandStatisticsRecordSuccess: counts a command which succeeded.
+*
+* @param statistics the statistics.
+*/
+void commandStatisticsRecordSuccess(CommandStatistics statistics) {
+	if (statistics == NULL) return;
+	statistics->successes++;
+}
+
+/**
+* commandStatisticsRecordError: counts a command which failed.
+*
+* @param statistics the statistics.
+* @param code the error the command failed with.
+*/
+void commandStatisticsRecordError(CommandStatistics statistics,
+	MtmErrorCode code) {
+	if ((statistics == NULL) || (code < 0) ||
+		(code >= COMMAND_STATISTICS_ERROR_CODES)) return;
+	statistics->errors[code]++;
+}
+
+/**
+* commandStatisticsPrint: prints the p50, p90, p99, p99.9 and max latency
+* of every command which ran, in microseconds, and the amount of commands
+* of every outcome which happened.
+*
+* @param statistics the statistics.
+* @param output the stream to print to.
+*/
+void commandStatisticsPrint(CommandStatistics statistics, FILE* output) {
+	if ((statistics == NULL) || (output == NULL)) return;
+	printLatencies(statistics, output);
+	printOutcomes(statistics, output);
+}
+
+/**
+* commandStatisticsDestroy: Deallocates existing statistics.
+*
+* @param statistics Target statistics to be deallocated.
+* If statistics is NULL nothing will be done
+*/
+void commandStatisticsDestroy(CommandStatistics statistics) {
+	if (statistics == NULL) return;
+	for (int i = 0; i < statistics->commands_count; i++) {
+		latencyHistogramDestroy(statistics->latencies[i]);
+	}
+	free(statistics->latencies);
+	free(statistics);
+}
+
+/*
+* printLatencies: prints a row of latency percentiles per command which ran.
+*/
+static void printLatencies(CommandStatistics statistics, FILE* output) {
+	fprintf(output, "%-*s %10s %10s %10s %10s %10s %10s\n", NAME_WIDTH,
+		"command latency (us)", "count", "p50", "p90", "p99", "p99.9", "max");
+	for (int i = 0; i < statistics->commands_count; i++) {
+		LatencyHistogram histogram = statistics->latencies[i];
+		long long count = latencyHistogramGetCount(histogram);
+		if (count == 0) continue;
+		const CommandSpec* spec = commandTableGetSpec(statistics->table, i);
+		int width = NAME_WIDTH - (int)strlen(spec->user) - 1;
+		fprintf(output, "%s %-*s %10lld", spec->user, width, spec->action,
+			count);
+		for (int j = 0; j < PERCENTILES_COUNT; j++) {
+			fprintf(output, " %10.1f", latencyHistogramGetPercentile(histogram,
+				PERCENTILES[j]) / NANOSECONDS_PER_MICROSECOND);
+		}
+		fprintf(output, " %10.1f\n", latencyHistogramGetMax(histogram) /
+			NANOSECONDS_PER_MICROSECOND);
+	}
+}
+
+/*
+* printOutcomes: prints the amount of commands per outcome which happened.
+*/
+static void printOutcomes(CommandStatistics statistics, FILE* output) {
+	fprintf(output, "%-*s %10s\n", NAME_WIDTH, "outcome", "count");
+	fprintf(output, "%-*s %10lld\n", NAME_WIDTH, "success",
+		statistics->successes);
+	for (int i = 0; i < COMMAND_STATISTICS_ERROR_CODES; i++) {
+		if (statistics->errors[i] == 0) continue;
+		fprintf(output, "%-*s %10lld\n", NAME_WIDTH, ERROR_NAMES[i],
+			statistics->errors[i]);
+	}
+}
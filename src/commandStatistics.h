@@ -0,0 +1,69 @@
+#ifndef SRC_COMMANDSTATISTICS_H_
+#define SRC_COMMANDSTATISTICS_H_
+
+#include <stdio.h>
+#include "commandTable.h"
+#include "mtm_ex2.h"
+
+/** The amount of MtmErrorCode values */
+#define COMMAND_STATISTICS_ERROR_CODES (MTM_REQUEST_ILLOGICAL_PRICE + 1)
+
+typedef struct commandStatistics_t *CommandStatistics;
+
+/**
+* Allocates new CommandStatistics for the commands of a table: a latency
+* histogram per command, and the amount of commands of each outcome.
+*
+* @param table the command table, must outlive the statistics.
+*
+* @return
+* 	NULL - if table is NULL or allocations failed.
+* 	New CommandStatistics in case of success.
+*/
+CommandStatistics commandStatisticsCreate(CommandTable table);
+
+/**
+* commandStatisticsRecordLatency: counts the run time of a command.
+*
+* @param statistics the statistics.
+* @param index the command spec index.
+* @param nanoseconds the command run time.
+*/
+void commandStatisticsRecordLatency(CommandStatistics statistics, int index,
+	long long nanoseconds);
+
+/**
+* commandStatisticsRecordSuccess: counts a command which succeeded.
+*
+* @param statistics the statistics.
+*/
+void commandStatisticsRecordSuccess(CommandStatistics statistics);
+
+/**
+* commandStatisticsRecordError: counts a command which failed.
+*
+* @param statistics the statistics.
+* @param code the error the command failed with.
+*/
+void commandStatisticsRecordError(CommandStatistics statistics,
+	MtmErrorCode code);
+
+/**
+* commandStatisticsPrint: prints the p50, p90, p99, p99.9 and max latency
+* of every command which ran, in microseconds, and the amount of commands
+* of every outcome which happened.
+*
+* @param statistics the statistics.
+* @param output the stream to print to.
+*/
+void commandStatisticsPrint(CommandStatistics statistics, FILE* output);
+
+/**
+* commandStatisticsDestroy: Deallocates existing statistics.
+*
+* @param statistics Target statistics to be deallocated.
+* If statistics is NULL nothing will be done
+*/
+void commandStatisticsDestroy(CommandStatistics statistics);
+
+#endif /* SRC_COMMANDSTATISTICS_H_ */
@@ -0,0 +1,301 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "commandTable.h"
+
+#define EMPTY_SLOT -1
+#define USER_INDEX 0
+#define ACTION_INDEX 1
+#define MAX_SLOT_BITS 12
+#define SEED_ATTEMPTS 4096
+#define FIRST_SEED 0x9E3779B97F4A7C15ULL
+#define SEED_STEP 0xD1B54A32D192ED02ULL
+#define FINGERPRINT_BASIS 0x811C9DC5U
+#define FINGERPRINT_PRIME 0x01000193U
+
+struct commandTable_t {
+	const CommandSpec* specs;
+	int count;
+	int* slots;
+	int slot_bits;
+	uint64_t seed;
+};
+
+static uint64_t commandKey(const char* user, size_t user_length,
+	const char* action, size_t action_length);
+static uint64_t specKey(const CommandSpec* spec);
+static int slotOf(CommandTable table, uint64_t key);
+static bool trySeed(CommandTable table, const uint64_t* keys);
+static bool buildIndex(CommandTable table);
+static uint32_t addToFingerprint(uint32_t hash, const void* data,
+	size_t size);
+
+/**
+* Allocates a new CommandTable over an array of command specs.
+*
+* @param specs the command specs.
+* @param count the amount of specs.
+*
+* @return
+* 	NULL - if specs is NULL, count is not positive, two specs have words
+* 		with the same lengths and edge characters or allocations failed.
+* 	A new CommandTable in case of success.
+*/
+CommandTable commandTableCreate(const CommandSpec* specs, int count) {
+	if ((specs == NULL) || (count <= 0)) return NULL;
+	CommandTable table = malloc(sizeof(*table));
+	if (table == NULL) return NULL;
+	table->specs = specs;
+	table->count = count;
+	table->slots = NULL;
+	table->slot_bits = 0;
+	table->seed = 0;
+	if (!buildIndex(table)) {
+		commandTableDestroy(table);
+		return NULL;
+	}
+	return table;
+}
+
+/**
+* commandTableFind: finds the command of a split line and checks it has
+* enough arguments. arguments after the last expected one are ignored.
+*
+* @param table the table.
+* @param tokens the split line.
+* @param index pointer to save the index of the command spec in.
+*
+* @return
+*
+* 	COMMAND_TABLE_NULL_PARAMETERS - if one of the parameters is NULL.
+*
+* 	COMMAND_TABLE_UNKNOWN_COMMAND - if there is no command with the user
+* 		and action of the line.
+*
+* 	COMMAND_TABLE_WRONG_ARGUMENTS_COUNT - if the line has less arguments than
+* 		the command expects. the command index is saved in this case too.
+*
+* 	COMMAND_TABLE_SUCCESS - in case of success.
+*/
+CommandTableResult commandTableFind(CommandTable table, CommandTokens tokens,
+	int* index) {
+	if ((table == NULL) || (tokens == NULL) || (index == NULL)) {
+		return COMMAND_TABLE_NULL_PARAMETERS;
+	}
+	int count = commandTokensGetCount(tokens);
+	if (count < COMMAND_ARGUMENTS_START) return COMMAND_TABLE_UNKNOWN_COMMAND;
+	uint64_t key = commandKey(commandTokensGetStart(tokens, USER_INDEX),
+		commandTokensGetView(tokens, USER_INDEX).length,
+		commandTokensGetStart(tokens, ACTION_INDEX),
+		commandTokensGetView(tokens, ACTION_INDEX).length);
+	int spec_index = table->slots[slotOf(table, key)];
+	if (spec_index == EMPTY_SLOT) return COMMAND_TABLE_UNKNOWN_COMMAND;
+	const CommandSpec* spec = &table->specs[spec_index];
+	if ((!commandTokensEquals(tokens, USER_INDEX, spec->user)) ||
+		(!commandTokensEquals(tokens, ACTION_INDEX, spec->action))) {
+		return COMMAND_TABLE_UNKNOWN_COMMAND;
+	}
+	*index = spec_index;
+	if (count < COMMAND_ARGUMENTS_START + spec->arity) {
+		return COMMAND_TABLE_WRONG_ARGUMENTS_COUNT;
+	}
+	return COMMAND_TABLE_SUCCESS;
+}
+
+/**
+* commandTableGetSpec: returns a command spec by its index.
+*
+* @param table the table.
+* @param index the spec index.
+*
+* @return
+* 	NULL if table is NULL or the index is out of range;
+* 	else returns the spec
+*/
+const CommandSpec* commandTableGetSpec(CommandTable table, int index) {
+	if ((table == NULL) || (index < 0) || (index >= table->count)) {
+		return NULL;
+	}
+	return &table->specs[index];
+}
+
+/**
+* commandTableGetCount: returns the amount of specs in the table.
+*
+* @param table the table.
+*
+* @return
+* 	-1 if table is NULL; else returns the amount of specs
+*/
+int commandTableGetCount(CommandTable table) {
+	if (table == NULL) return -1;
+	return table->count;
+}
+
+/**
+* commandTableGetFingerprint: returns a hash of the specs of the table, in
+* order: the user and action words, the arity and the argument types of
+* each spec. Logs which store spec indexes keep it to detect a table change.
+*
+* @param table the table.
+*
+* @return
+* 	0 if table is NULL; else returns the fingerprint
+*/
+uint32_t commandTableGetFingerprint(CommandTable table) {
+	if (table == NULL) return 0;
+	uint32_t hash = FINGERPRINT_BASIS;
+	for (int i = 0; i < table->count; i++) {
+		const CommandSpec* spec = &table->specs[i];
+		hash = addToFingerprint(hash, spec->user, strlen(spec->user) + 1);
+		hash = addToFingerprint(hash, spec->action, strlen(spec->action) + 1);
+		unsigned char shape = (unsigned char)spec->arity;
+		hash = addToFingerprint(hash, &shape, sizeof(shape));
+		for (int j = 0; j < spec->arity; j++) {
+			shape = (unsigned char)spec->types[j];
+			hash = addToFingerprint(hash, &shape, sizeof(shape));
+		}
+	}
+	return hash;
+}
+
+/**
+* commandTableDecode: decodes the arguments of a split line by the types
+* of a command spec.
+*
+* @param spec the command spec, found for the tokens.
+* @param tokens the split line.
+* @param arguments array of at least COMMAND_MAX_ARGUMENTS to save the
+* 	arguments in.
+*/
+void commandTableDecode(const CommandSpec* spec, CommandTokens tokens,
+	CommandArgument* arguments) {
+	if ((spec == NULL) || (tokens == NULL) || (arguments == NULL)) return;
+	for (int i = 0; i < spec->arity; i++) {
+		if (spec->types[i] == COMMAND_ARGUMENT_INT) {
+			arguments[i].number =
+				commandTokensGetInt(tokens, COMMAND_ARGUMENTS_START + i);
+		} else {
+			arguments[i].string =
+				commandTokensGetString(tokens, COMMAND_ARGUMENTS_START + i);
+		}
+	}
+}
+
+/**
+* commandTableDestroy: Deallocates an existing CommandTable.
+*
+* @param table Target table to be deallocated.
+* If table is NULL nothing will be done
+*/
+void commandTableDestroy(CommandTable table) {
+	if (table == NULL) return;
+	free(table->slots);
+	free(table);
+}
+
+/*
+* commandKey: packs the features the perfect hash is built on, the lengths
+* and the edge characters of the user and action words.
+*/
+static uint64_t commandKey(const char* user, size_t user_length,
+	const char* action, size_t action_length) {
+	return (uint64_t)(unsigned char)user_length |
+		((uint64_t)(unsigned char)user[0] << 8) |
+		((uint64_t)(unsigned char)action_length << 16) |
+		((uint64_t)(unsigned char)action[0] << 24) |
+		((uint64_t)(unsigned char)action[action_length - 1] << 32);
+}
+
+/*
+* specKey: returns the key of a command spec.
+*/
+static uint64_t specKey(const CommandSpec* spec) {
+	return commandKey(spec->user, strlen(spec->user), spec->action,
+		strlen(spec->action));
+}
+
+/*
+* slotOf: multiplicative hash of a key into the table slots.
+*/
+static int slotOf(CommandTable table, uint64_t key) {
+	return (int)(((key + 1) * table->seed) >> (64 - table->slot_bits));
+}
+
+/*
+* trySeed: fills the slots using the current seed.
+*
+* @return
+* 	false if two keys fall into the same slot; else returns true.
+*/
+static bool trySeed(CommandTable table, const uint64_t* keys) {
+	int size = 1 << table->slot_bits;
+	for (int i = 0; i < size; i++) {
+		table->slots[i] = EMPTY_SLOT;
+	}
+	for (int i = 0; i < table->count; i++) {
+		int slot = slotOf(table, keys[i]);
+		if (table->slots[slot] != EMPTY_SLOT) return false;
+		table->slots[slot] = i;
+	}
+	return true;
+}
+
+/*
+* buildIndex: searches for a seed and a slots count with no collisions,
+* starting at twice the amount of commands.
+*
+* @return
+* 	false if specs have no words, share a key or allocation failed;
+* 	else returns true.
+*/
+static bool buildIndex(CommandTable table) {
+	uint64_t* keys = malloc(sizeof(*keys) * table->count);
+	if (keys == NULL) return false;
+	for (int i = 0; i < table->count; i++) {
+		if ((table->specs[i].user == NULL) ||
+			(table->specs[i].action == NULL) ||
+			(table->specs[i].user[0] == '\0') ||
+			(table->specs[i].action[0] == '\0')) {
+			free(keys);
+			return false;
+		}
+		keys[i] = specKey(&table->specs[i]);
+		for (int j = 0; j < i; j++) {
+			if (keys[j] == keys[i]) {
+				free(keys);
+				return false;
+			}
+		}
+	}
+	table->slot_bits = 1;
+	while ((1 << table->slot_bits) < 2 * table->count) table->slot_bits++;
+	bool found = false;
+	for (; table->slot_bits <= MAX_SLOT_BITS; table->slot_bits++) {
+		int* slots = realloc(table->slots,
+			sizeof(*slots) * (1 << table->slot_bits));
+		if (slots == NULL) break;
+		table->slots = slots;
+		table->seed = FIRST_SEED;
+		for (int i = 0; (!found) && (i < SEED_ATTEMPTS); i++) {
+			found = trySeed(table, keys);
+			if (!found) table->seed += SEED_STEP;
+		}
+		if (found) break;
+	}
+	free(keys);
+	return found;
+}
+
+/*
+* addToFingerprint: adds bytes to a FNV-1a hash.
+*/
+static uint32_t addToFingerprint(uint32_t hash, const void* data,
+	size_t size) {
+	const unsigned char* bytes = data;
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ bytes[i]) * FINGERPRINT_PRIME;
+	}
+	return hash;
+}
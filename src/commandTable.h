@@ -0,0 +1,159 @@
+#ifndef SRC_COMMANDTABLE_H_
+#define SRC_COMMANDTABLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "commandTokens.h"
+#include "yad3Program.h"
+#include "yad3Service.h"
+
+/** The maximum amount of arguments a command can have */
+#define COMMAND_MAX_ARGUMENTS 7
+
+/** The token index of the first command argument, after user and action */
+#define COMMAND_ARGUMENTS_START 2
+
+typedef struct commandTable_t *CommandTable;
+
+/**
+* The types a command argument can be decoded to.
+*/
+typedef enum {
+	COMMAND_ARGUMENT_STRING,
+	COMMAND_ARGUMENT_INT
+} CommandArgumentType;
+
+/**
+* A decoded command argument, its member is selected by the argument type.
+*/
+typedef union {
+	char* string;
+	int number;
+} CommandArgument;
+
+/**
+* A command handler, receives the decoded arguments of the command.
+*/
+typedef Yad3ServiceResult (*CommandHandler)(Yad3Program program,
+	const CommandArgument* arguments);
+
+/**
+* A single command description: the user type and action words that select
+* it, the amount and types of its arguments, and the handler that runs it.
+*/
+typedef struct {
+	const char* user;
+	const char* action;
+	int arity;
+	CommandArgumentType types[COMMAND_MAX_ARGUMENTS];
+	CommandHandler handler;
+} CommandSpec;
+
+/**
+* This type defines end codes for the methods.
+*/
+typedef enum {
+	COMMAND_TABLE_NULL_PARAMETERS = 0,
+	COMMAND_TABLE_UNKNOWN_COMMAND = 1,
+	COMMAND_TABLE_WRONG_ARGUMENTS_COUNT = 2,
+	COMMAND_TABLE_SUCCESS = 3
+} CommandTableResult;
+
+/**
+* Allocates a new CommandTable over an array of command specs.
+*
+* The specs are indexed by a perfect hash of the user and action words, so
+* finding a command costs one hash and one compare regardless of the amount
+* of commands. The specs array is not copied and must outlive the table.
+*
+* @param specs the command specs.
+* @param count the amount of specs.
+*
+* @return
+* 	NULL - if specs is NULL, count is not positive, two specs have words
+* 		with the same lengths and edge characters or allocations failed.
+* 	A new CommandTable in case of success.
+*/
+CommandTable commandTableCreate(const CommandSpec* specs, int count);
+
+/**
+* commandTableFind: finds the command of a split line and checks it has
+* enough arguments. arguments after the last expected one are ignored.
+*
+* @param table the table.
+* @param tokens the split line.
+* @param index pointer to save the index of the command spec in.
+*
+* @return
+*
+* 	COMMAND_TABLE_NULL_PARAMETERS - if one of the parameters is NULL.
+*
+* 	COMMAND_TABLE_UNKNOWN_COMMAND - if there is no command with the user
+* 		and action of the line.
+*
+* 	COMMAND_TABLE_WRONG_ARGUMENTS_COUNT - if the line has less arguments than
+* 		the command expects. the command index is saved in this case too.
+*
+* 	COMMAND_TABLE_SUCCESS - in case of success.
+*/
+CommandTableResult commandTableFind(CommandTable table, CommandTokens tokens,
+	int* index);
+
+/**
+* commandTableGetSpec: returns a command spec by its index.
+*
+* @param table the table.
+* @param index the spec index.
+*
+* @return
+* 	NULL if table is NULL or the index is out of range;
+* 	else returns the spec
+*/
+const CommandSpec* commandTableGetSpec(CommandTable table, int index);
+
+/**
+* commandTableGetCount: returns the amount of specs in the table.
+*
+* @param table the table.
+*
+* @return
+* 	-1 if table is NULL; else returns the amount of specs
+*/
+int commandTableGetCount(CommandTable table);
+
+/**
+* commandTableGetFingerprint: returns a hash of the specs of the table, in
+* order: the user and action words, the arity and the argument types of
+* each spec. Logs which store spec indexes keep it to detect a table change.
+*
+* @param table the table.
+*
+* @return
+* 	0 if table is NULL; else returns the fingerprint
+*/
+uint32_t commandTableGetFingerprint(CommandTable table);
+
+/**
+* commandTableDecode: decodes the arguments of a split line by the types
+* of a command spec.
+*
+* String arguments point into the tokens buffer and stay valid until the
+* tokens are split again.
+*
+* @param spec the command spec, found for the tokens.
+* @param tokens the split line.
+* @param arguments array of at least COMMAND_MAX_ARGUMENTS to save the
+* 	arguments in.
+*/
+void commandTableDecode(const CommandSpec* spec, CommandTokens tokens,
+	CommandArgument* arguments);
+
+/**
+* commandTableDestroy: Deallocates an existing CommandTable.
+*
+* @param table Target table to be deallocated.
+* If table is NULL nothing will be done
+*/
+void commandTableDestroy(CommandTable table);
+
+#endif /* SRC_COMMANDTABLE_H_ */
@@ -0,0 +1,174 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include "commandTable.h"
+#include "test_utilities.h"
+
+#define S COMMAND_ARGUMENT_STRING
+#define I COMMAND_ARGUMENT_INT
+
+static Yad3ServiceResult testHandler(Yad3Program program,
+	const CommandArgument* arguments);
+
+static const CommandSpec TEST_COMMANDS[] = {
+	{"realtor", "add", 3, {S, S, I}, testHandler},
+	{"realtor", "remove", 1, {S}, testHandler},
+	{"realtor", "add_apartment_service", 3, {S, S, I}, testHandler},
+	{"realtor", "remove_apartment_service", 2, {S, S}, testHandler},
+	{"realtor", "add_apartment", 7, {S, S, I, I, I, I, S}, testHandler},
+	{"realtor", "remove_apartment", 3, {S, S, I}, testHandler},
+	{"realtor", "respond_to_offer", 3, {S, S, S}, testHandler},
+	{"customer", "add", 4, {S, I, I, I}, testHandler},
+	{"customer", "remove", 1, {S}, testHandler},
+	{"customer", "purchase", 4, {S, S, S, I}, testHandler},
+	{"customer", "make_offer", 5, {S, S, S, I, I}, testHandler},
+	{"report", "relevant_realtors", 1, {S}, testHandler},
+	{"report", "significant_realtors", 1, {I}, testHandler},
+	{"report", "most_paying_customers", 1, {I}, testHandler}
+};
+
+#define TEST_COMMANDS_COUNT \
+	((int)(sizeof(TEST_COMMANDS) / sizeof(TEST_COMMANDS[0])))
+
+static bool testCommandTableCreate();
+static bool testCommandTableFind();
+static bool testCommandTableGetSpec();
+static bool testCommandTableDecode();
+static CommandTableResult findLine(CommandTable table, CommandTokens tokens,
+	const char* line, int* index);
+int RunCommandTableTest();
+
+//int main() {
+int RunCommandTableTest() {
+	RUN_TEST(testCommandTableCreate);
+	RUN_TEST(testCommandTableFind);
+	RUN_TEST(testCommandTableGetSpec);
+	RUN_TEST(testCommandTableDecode);
+	return 0;
+}
+
+/**
+ * Test create method
+ */
+static bool testCommandTableCreate() {
+	CommandSpec same_words[] = {
+		{"realtor", "add", 1, {S}, testHandler},
+		{"realtor", "add", 2, {S, S}, testHandler}
+	};
+	CommandSpec empty_words[] = {{"", "add", 1, {S}, testHandler}};
+	ASSERT_TEST(commandTableCreate(NULL, 3) == NULL);
+	ASSERT_TEST(commandTableCreate(TEST_COMMANDS, 0) == NULL);
+	ASSERT_TEST(commandTableCreate(same_words, 2) == NULL);
+	ASSERT_TEST(commandTableCreate(empty_words, 1) == NULL);
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	ASSERT_TEST(table != NULL);
+	commandTableDestroy(table);
+	commandTableDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test find method, every command is found at its own index
+ */
+static bool testCommandTableFind() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	CommandTokens tokens = commandTokensCreate();
+	int index = -1;
+	char line[200];
+	for (int i = 0; i < TEST_COMMANDS_COUNT; i++) {
+		sprintf(line, "%s %s a b c d e f g", TEST_COMMANDS[i].user,
+			TEST_COMMANDS[i].action);
+		ASSERT_TEST(findLine(table, tokens, line, &index) ==
+			COMMAND_TABLE_SUCCESS);
+		ASSERT_TEST(index == i);
+	}
+	ASSERT_TEST(findLine(table, tokens, "realtor remove a", &index) ==
+		COMMAND_TABLE_SUCCESS);
+	index = -1;
+	ASSERT_TEST(findLine(table, tokens, "realtor remove", &index) ==
+		COMMAND_TABLE_WRONG_ARGUMENTS_COUNT);
+	ASSERT_TEST(index == 1);
+	ASSERT_TEST(findLine(table, tokens, "realtor add a b", &index) ==
+		COMMAND_TABLE_WRONG_ARGUMENTS_COUNT);
+	ASSERT_TEST(findLine(table, tokens, "realtor", &index) ==
+		COMMAND_TABLE_UNKNOWN_COMMAND);
+	ASSERT_TEST(findLine(table, tokens, "realtor purchase a b c d", &index)
+		== COMMAND_TABLE_UNKNOWN_COMMAND);
+	ASSERT_TEST(findLine(table, tokens, "realtor rempve a", &index) ==
+		COMMAND_TABLE_UNKNOWN_COMMAND);
+	ASSERT_TEST(findLine(table, tokens, "realtors remove a", &index) ==
+		COMMAND_TABLE_UNKNOWN_COMMAND);
+	ASSERT_TEST(findLine(table, tokens, "reporter add a", &index) ==
+		COMMAND_TABLE_UNKNOWN_COMMAND);
+	ASSERT_TEST(commandTableFind(NULL, tokens, &index) ==
+		COMMAND_TABLE_NULL_PARAMETERS);
+	ASSERT_TEST(commandTableFind(table, NULL, &index) ==
+		COMMAND_TABLE_NULL_PARAMETERS);
+	ASSERT_TEST(commandTableFind(table, tokens, NULL) ==
+		COMMAND_TABLE_NULL_PARAMETERS);
+	commandTokensDestroy(tokens);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test get spec method
+ */
+static bool testCommandTableGetSpec() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	ASSERT_TEST(commandTableGetSpec(table, 0) == &TEST_COMMANDS[0]);
+	ASSERT_TEST(commandTableGetSpec(table, TEST_COMMANDS_COUNT - 1) ==
+		&TEST_COMMANDS[TEST_COMMANDS_COUNT - 1]);
+	ASSERT_TEST(commandTableGetSpec(table, -1) == NULL);
+	ASSERT_TEST(commandTableGetSpec(table, TEST_COMMANDS_COUNT) == NULL);
+	ASSERT_TEST(commandTableGetSpec(NULL, 0) == NULL);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test decode method
+ */
+static bool testCommandTableDecode() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	CommandTokens tokens = commandTokensCreate();
+	CommandArgument arguments[COMMAND_MAX_ARGUMENTS];
+	int index = -1;
+	ASSERT_TEST(findLine(table, tokens,
+		"customer make_offer me@a.com you@b.com home 12 -300", &index) ==
+		COMMAND_TABLE_SUCCESS);
+	commandTableDecode(commandTableGetSpec(table, index), tokens, arguments);
+	ASSERT_TEST(strcmp(arguments[0].string, "me@a.com") == 0);
+	ASSERT_TEST(strcmp(arguments[1].string, "you@b.com") == 0);
+	ASSERT_TEST(strcmp(arguments[2].string, "home") == 0);
+	ASSERT_TEST(arguments[3].number == 12);
+	ASSERT_TEST(arguments[4].number == -300);
+	commandTokensDestroy(tokens);
+	commandTableDestroy(table);
+	return true;
+}
+
+/*
+ * Splits the line and finds its command
+ */
+static CommandTableResult findLine(CommandTable table, CommandTokens tokens,
+	const char* line, int* index) {
+	commandTokensSplit(tokens, line, strlen(line));
+	return commandTableFind(table, tokens, index);
+}
+
+/*
+ * Handler for the test commands, does nothing
+ */
+static Yad3ServiceResult testHandler(Yad3Program program,
+	const CommandArgument* arguments) {
+	(void)program;
+	(void)arguments;
+	return YAD3_SERVICE_SUCCESS;
+}
@@ -0,0 +1,237 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "commandTokens.h"
+#include "utilities.h"
+#include "mtm_ex2.h"
+
+#define TOKEN_SAPARATOR_1 '\t'
+#define TOKEN_SAPARATOR_2 ' '
+#define LINE_END '\n'
+#define TEXT_GROWTH_FACTOR 2
+
+struct commandTokens_t {
+	const char* line;
+	int count;
+	TokenView views[COMMAND_TOKENS_CAPACITY];
+	char* text;
+	size_t text_capacity;
+};
+
+static bool isSaparator(char value);
+static bool ensureTextCapacity(CommandTokens tokens, size_t size);
+
+/**
+* Allocates a new CommandTokens.
+*
+* @return
+* 	NULL - if allocations failed.
+* 	A new CommandTokens in case of success.
+*/
+CommandTokens commandTokensCreate() {
+	CommandTokens tokens = malloc(sizeof(*tokens));
+	if (tokens == NULL) return NULL;
+	tokens->text = malloc(sizeof(char) * MAX_LEN);
+	if (tokens->text == NULL) {
+		free(tokens);
+		return NULL;
+	}
+	tokens->text_capacity = MAX_LEN;
+	tokens->line = NULL;
+	tokens->count = 0;
+	return tokens;
+}
+
+/**
+* commandTokensSplit: splits a line into tokens separated by tabs and spaces.
+*
+* @param tokens the tokens object to save the split result in.
+* @param line the line, does not need to be NUL terminated.
+* @param length the line length.
+*
+* @return
+* 	the amount of tokens found, 0 if tokens or line are NULL,
+* 	-1 in case of allocation error.
+*/
+int commandTokensSplit(CommandTokens tokens, const char* line,
+	size_t length) {
+	if (tokens == NULL) return 0;
+	tokens->line = line;
+	tokens->count = 0;
+	if (line == NULL) return 0;
+	size_t index = 0;
+	while ((index < length) && (tokens->count < COMMAND_TOKENS_CAPACITY)) {
+		while ((index < length) && (isSaparator(line[index]))) index++;
+		size_t start_index = index;
+		while ((index < length) && (!isSaparator(line[index])) &&
+			(line[index] != LINE_END) && (line[index] != END_OF_STRING)) {
+			index++;
+		}
+		if (start_index < index) {
+			tokens->views[tokens->count].offset = start_index;
+			tokens->views[tokens->count].length = index - start_index;
+			tokens->count++;
+		}
+		if ((index < length) && (!isSaparator(line[index]))) break;
+	}
+	if (tokens->count == 0) return 0;
+	TokenView last = tokens->views[tokens->count - 1];
+	if (!ensureTextCapacity(tokens, last.offset + last.length + 1)) {
+		tokens->count = 0;
+		return -1;
+	}
+	return tokens->count;
+}
+
+/**
+* commandTokensGetCount: returns the amount of tokens in the last split line.
+*
+* @param tokens the tokens.
+*
+* @return
+* 	0 if tokens is NULL; else returns the count
+*/
+int commandTokensGetCount(CommandTokens tokens) {
+	return (tokens == NULL) ? 0 : tokens->count;
+}
+
+/**
+* commandTokensGetView: returns the view of a token.
+*
+* @param tokens the tokens.
+* @param index the token index.
+*
+* @return
+* 	an empty view if tokens is NULL or the index is out of range;
+* 	else returns the token view
+*/
+TokenView commandTokensGetView(CommandTokens tokens, int index) {
+	TokenView empty = {0, 0};
+	if ((tokens == NULL) || (index < 0) || (index >= tokens->count)) {
+		return empty;
+	}
+	return tokens->views[index];
+}
+
+/**
+* commandTokensGetStart: returns where a token starts inside the split line.
+*
+* @param tokens the tokens.
+* @param index the token index.
+*
+* @return
+* 	NULL if tokens is NULL or the index is out of range;
+* 	else returns the token start
+*/
+const char* commandTokensGetStart(CommandTokens tokens, int index) {
+	if ((tokens == NULL) || (index < 0) || (index >= tokens->count)) {
+		return NULL;
+	}
+	return tokens->line + tokens->views[index].offset;
+}
+
+/**
+* commandTokensEquals: checks if a token is equal to a given string.
+*
+* @param tokens the tokens.
+* @param index the token index.
+* @param string the string to compare to.
+*
+* @return
+* 	true if equals; else returns false
+*/
+bool commandTokensEquals(CommandTokens tokens, int index, const char* string) {
+	if ((tokens == NULL) || (string == NULL) || (index < 0) ||
+		(index >= tokens->count)) return false;
+	TokenView view = tokens->views[index];
+	return (strncmp(tokens->line + view.offset, string, view.length) == 0) &&
+		(string[view.length] == END_OF_STRING);
+}
+
+/**
+* commandTokensGetInt: converts a token into int, with the same rules as
+* stringToInt. note that there is no validation that the input is correct.
+*
+* @param tokens the tokens.
+* @param index the token index.
+*
+* @return
+* 	0 if tokens is NULL or the index is out of range; else returns the number
+*/
+int commandTokensGetInt(CommandTokens tokens, int index) {
+	if ((tokens == NULL) || (index < 0) || (index >= tokens->count)) return 0;
+	const char* string = tokens->line + tokens->views[index].offset;
+	size_t length = tokens->views[index].length;
+	bool is_negative = (string[0] == NEGATIVE_SIGN);
+	int number = 0;
+	for (size_t i = (is_negative ? 1 : 0); i < length; i++) {
+		number *= 10;
+		if ((string[i] >= '0') && (string[i] <= '9')) {
+			number += ((int)string[i] - (int)'0');
+		}
+	}
+	return is_negative ? -1 * number : number;
+}
+
+/**
+* commandTokensGetString: returns a NUL terminated copy of a token, written
+* into the text buffer at the offset the token has in the line.
+*
+* @param tokens the tokens.
+* @param index the token index.
+*
+* @return
+* 	NULL if tokens is NULL or the index is out of range;
+* 	else returns the token string
+*/
+char* commandTokensGetString(CommandTokens tokens, int index) {
+	if ((tokens == NULL) || (index < 0) || (index >= tokens->count)) {
+		return NULL;
+	}
+	TokenView view = tokens->views[index];
+	char* string = tokens->text + view.offset;
+	memcpy(string, tokens->line + view.offset, view.length);
+	string[view.length] = END_OF_STRING;
+	return string;
+}
+
+/**
+* commandTokensDestroy: Deallocates an existing CommandTokens.
+*
+* @param tokens Target tokens to be deallocated.
+* If tokens is NULL nothing will be done
+*/
+void commandTokensDestroy(CommandTokens tokens) {
+	if (tokens == NULL) return;
+	free(tokens->text);
+	free(tokens);
+}
+
+/*
+* isSaparator: checks if a character separates tokens.
+*/
+static bool isSaparator(char value) {
+	return (value == TOKEN_SAPARATOR_1) || (value == TOKEN_SAPARATOR_2);
+}
+
+/*
+* ensureTextCapacity: grows the text buffer geometrically until it can hold
+* size characters. nothing is allocated when it is already large enough.
+*
+* @return
+* 	false in case of allocation error; else returns true.
+*/
+static bool ensureTextCapacity(CommandTokens tokens, size_t size) {
+	if (size <= tokens->text_capacity) return true;
+	size_t capacity = tokens->text_capacity;
+	while (capacity < size) {
+		if (capacity > SIZE_MAX / TEXT_GROWTH_FACTOR) return false;
+		capacity *= TEXT_GROWTH_FACTOR;
+	}
+	char* text = realloc(tokens->text, sizeof(char) * capacity);
+	if (text == NULL) return false;
+	tokens->text = text;
+	tokens->text_capacity = capacity;
+	return true;
+}
@@ -0,0 +1,139 @@
+#ifndef SRC_COMMANDTOKENS_H_
+#define SRC_COMMANDTOKENS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/** The maximum amount of tokens kept for a single command line */
+#define COMMAND_TOKENS_CAPACITY 16
+
+typedef struct commandTokens_t *CommandTokens;
+
+/**
+* A single token, given as a range inside the split line.
+*/
+typedef struct {
+	size_t offset;
+	size_t length;
+} TokenView;
+
+/**
+* Allocates a new CommandTokens.
+*
+* The tokens object is meant to be created once and reused for every line,
+* splitting a line does not allocate memory.
+*
+* @return
+* 	NULL - if allocations failed.
+* 	A new CommandTokens in case of success.
+*/
+CommandTokens commandTokensCreate();
+
+/**
+* commandTokensSplit: splits a line into tokens separated by tabs and spaces.
+*
+* The tokens are kept as views into the given line, so the line must stay
+* valid for as long as the tokens are used. The line ends after length
+* characters or at the first new line or NUL character. Tokens after the
+* first COMMAND_TOKENS_CAPACITY ones are ignored.
+* Memory is allocated only when the line is longer than any line seen before.
+*
+* @param tokens the tokens object to save the split result in.
+* @param line the line, does not need to be NUL terminated.
+* @param length the line length.
+*
+* @return
+* 	the amount of tokens found, 0 if tokens or line are NULL,
+* 	-1 in case of allocation error.
+*/
+int commandTokensSplit(CommandTokens tokens, const char* line,
+	size_t length);
+
+/**
+* commandTokensGetCount: returns the amount of tokens in the last split line.
+*
+* @param tokens the tokens.
+*
+* @return
+* 	0 if tokens is NULL; else returns the count
+*/
+int commandTokensGetCount(CommandTokens tokens);
+
+/**
+* commandTokensGetView: returns the view of a token.
+*
+* @param tokens the tokens.
+* @param index the token index.
+*
+* @return
+* 	an empty view if tokens is NULL or the index is out of range;
+* 	else returns the token view
+*/
+TokenView commandTokensGetView(CommandTokens tokens, int index);
+
+/**
+* commandTokensGetStart: returns where a token starts inside the split line.
+* the result is not NUL terminated, the token length is given by its view.
+*
+* @param tokens the tokens.
+* @param index the token index.
+*
+* @return
+* 	NULL if tokens is NULL or the index is out of range;
+* 	else returns the token start
+*/
+const char* commandTokensGetStart(CommandTokens tokens, int index);
+
+/**
+* commandTokensEquals: checks if a token is equal to a given string.
+*
+* @param tokens the tokens.
+* @param index the token index.
+* @param string the string to compare to.
+*
+* @return
+* 	true if equals; else returns false
+*/
+bool commandTokensEquals(CommandTokens tokens, int index, const char* string);
+
+/**
+* commandTokensGetInt: converts a token into int, with the same rules as
+* stringToInt. note that there is no validation that the input is correct.
+*
+* @param tokens the tokens.
+* @param index the token index.
+*
+* @return
+* 	0 if tokens is NULL or the index is out of range; else returns the number
+*/
+int commandTokensGetInt(CommandTokens tokens, int index);
+
+/**
+* commandTokensGetString: returns a NUL terminated copy of a token.
+*
+* Only the tokens asked for are copied, each into a buffer owned by the
+* tokens object at the offset it has in the line. This is the one copy the
+* tokenizer makes: yad3Service takes its names and emails as NUL terminated
+* strings, and the line can not be terminated in place as a mapped input is
+* read only. Numbers and command words are read from the views in place.
+* The result stays valid until the next split or until the tokens are
+* destroyed.
+*
+* @param tokens the tokens.
+* @param index the token index.
+*
+* @return
+* 	NULL if tokens is NULL or the index is out of range;
+* 	else returns the token string
+*/
+char* commandTokensGetString(CommandTokens tokens, int index);
+
+/**
+* commandTokensDestroy: Deallocates an existing CommandTokens.
+*
+* @param tokens Target tokens to be deallocated.
+* If tokens is NULL nothing will be done
+*/
+void commandTokensDestroy(CommandTokens tokens);
+
+#endif /* SRC_COMMANDTOKENS_H_ */
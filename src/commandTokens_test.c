@@ -0,0 +1,130 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include "commandTokens.h"
+#include "test_utilities.h"
+
+static bool testCommandTokensCreate();
+static bool testCommandTokensSplit();
+static bool testCommandTokensEquals();
+static bool testCommandTokensGetInt();
+static bool testCommandTokensGetString();
+int RunCommandTokensTest();
+
+//int main() {
+int RunCommandTokensTest() {
+	RUN_TEST(testCommandTokensCreate);
+	RUN_TEST(testCommandTokensSplit);
+	RUN_TEST(testCommandTokensEquals);
+	RUN_TEST(testCommandTokensGetInt);
+	RUN_TEST(testCommandTokensGetString);
+	return 0;
+}
+
+/**
+ * Test create method
+ */
+static bool testCommandTokensCreate() {
+	CommandTokens tokens = commandTokensCreate();
+	ASSERT_TEST(tokens != NULL);
+	ASSERT_TEST(commandTokensGetCount(tokens) == 0);
+	ASSERT_TEST(commandTokensGetCount(NULL) == 0);
+	commandTokensDestroy(tokens);
+	commandTokensDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test split method
+ */
+static bool testCommandTokensSplit() {
+	char* line = "  realtor\tadd  a@b.com\t\tcompany 10\nignored";
+	CommandTokens tokens = commandTokensCreate();
+	ASSERT_TEST(commandTokensSplit(NULL, line, strlen(line)) == 0);
+	ASSERT_TEST(commandTokensSplit(tokens, NULL, 4) == 0);
+	ASSERT_TEST(commandTokensSplit(tokens, line, strlen(line)) == 5);
+	TokenView view = commandTokensGetView(tokens, 0);
+	ASSERT_TEST((view.offset == 2) && (view.length == 7));
+	view = commandTokensGetView(tokens, 4);
+	ASSERT_TEST((view.offset == 32) && (view.length == 2));
+	view = commandTokensGetView(tokens, 5);
+	ASSERT_TEST((view.offset == 0) && (view.length == 0));
+	ASSERT_TEST(commandTokensGetStart(tokens, 1) == line + 10);
+	ASSERT_TEST(commandTokensGetStart(tokens, 5) == NULL);
+	ASSERT_TEST(commandTokensGetStart(NULL, 0) == NULL);
+	ASSERT_TEST(commandTokensSplit(tokens, line, 9) == 1);
+	ASSERT_TEST(commandTokensSplit(tokens, line, 0) == 0);
+	ASSERT_TEST(commandTokensSplit(tokens, " \t ", 3) == 0);
+	char* many = "a b c d e f g h i j k l m n o p q r s t";
+	ASSERT_TEST(commandTokensSplit(tokens, many, strlen(many)) ==
+		COMMAND_TOKENS_CAPACITY);
+	commandTokensDestroy(tokens);
+	return true;
+}
+
+/**
+ * Test equals method
+ */
+static bool testCommandTokensEquals() {
+	char* line = "customer make_offer";
+	CommandTokens tokens = commandTokensCreate();
+	commandTokensSplit(tokens, line, strlen(line));
+	ASSERT_TEST(commandTokensEquals(tokens, 0, "customer"));
+	ASSERT_TEST(commandTokensEquals(tokens, 1, "make_offer"));
+	ASSERT_TEST(!commandTokensEquals(tokens, 0, "custom"));
+	ASSERT_TEST(!commandTokensEquals(tokens, 0, "customers"));
+	ASSERT_TEST(!commandTokensEquals(tokens, 2, "customer"));
+	ASSERT_TEST(!commandTokensEquals(tokens, 0, NULL));
+	ASSERT_TEST(!commandTokensEquals(NULL, 0, "customer"));
+	commandTokensDestroy(tokens);
+	return true;
+}
+
+/**
+ * Test get int method
+ */
+static bool testCommandTokensGetInt() {
+	char* line = "125 -40 0 7x";
+	CommandTokens tokens = commandTokensCreate();
+	commandTokensSplit(tokens, line, strlen(line));
+	ASSERT_TEST(commandTokensGetInt(tokens, 0) == 125);
+	ASSERT_TEST(commandTokensGetInt(tokens, 1) == -40);
+	ASSERT_TEST(commandTokensGetInt(tokens, 2) == 0);
+	ASSERT_TEST(commandTokensGetInt(tokens, 3) == 70);
+	ASSERT_TEST(commandTokensGetInt(tokens, 4) == 0);
+	ASSERT_TEST(commandTokensGetInt(NULL, 0) == 0);
+	commandTokensDestroy(tokens);
+	return true;
+}
+
+/**
+ * Test get string method
+ */
+static bool testCommandTokensGetString() {
+	char line[] = "remove\tme@mail.com ";
+	CommandTokens tokens = commandTokensCreate();
+	commandTokensSplit(tokens, line, strlen(line));
+	ASSERT_TEST(strcmp(commandTokensGetString(tokens, 0), "remove") == 0);
+	ASSERT_TEST(strcmp(commandTokensGetString(tokens, 1), "me@mail.com") == 0);
+	char* first = commandTokensGetString(tokens, 0);
+	char* second = commandTokensGetString(tokens, 1);
+	ASSERT_TEST(strcmp(first, "remove") == 0);
+	ASSERT_TEST(strcmp(second, "me@mail.com") == 0);
+	ASSERT_TEST(commandTokensGetString(tokens, 2) == NULL);
+	ASSERT_TEST(commandTokensGetString(NULL, 0) == NULL);
+	ASSERT_TEST(strcmp(line, "remove\tme@mail.com ") == 0);
+	int length = 1000;
+	char* long_line = malloc(length);
+	ASSERT_TEST(long_line != NULL);
+	memset(long_line, 'e', length);
+	long_line[0] = 'x';
+	long_line[1] = ' ';
+	ASSERT_TEST(commandTokensSplit(tokens, long_line, length) == 2);
+	ASSERT_TEST(strlen(commandTokensGetString(tokens, 1)) ==
+		(size_t)(length - 2));
+	free(long_line);
+	commandTokensDestroy(tokens);
+	return true;
+}
@@ -4,13 +4,49 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdint.h>
 
+#define INITIAL_BUCKETS_COUNT 64
+#define TABLE_GROWTH_FACTOR 2
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+/*
+ * Emails are interned: every distinct address is stored once, in the email
+ * table, and shared by all the emails of it. An email counts the references
+ * to it, and is freed with the last one.
+ */
 struct Email_t {
-	char* address;
+	Email next;
+	uint32_t hash;
+	int id;
+	int references;
+	char address[];
 };
 
+/*
+ * The email table: a hash table of the emails by address, and the ids of
+ * freed emails, which are given to new emails first so the ids stay dense.
+ * the table is freed when its last email is.
+ */
+static struct {
+	Email* buckets;
+	int buckets_count;
+	int count;
+	int ids_count;
+	int* free_ids;
+	int free_ids_capacity;
+	int free_ids_count;
+} table = {NULL, 0, 0, 0, NULL, 0, 0};
+
 static int countSign(char* adress, char sign);
 static char* duplicateString(const char *str);
+static uint32_t hashAddress(const char* address);
+static Email findEmail(const char* address, uint32_t hash);
+static bool insertEmail(Email email);
+static void removeEmail(Email email);
+static bool growBuckets();
+static void releaseTable();
 
 /**
 * Allocates a new email.
@@ -34,17 +70,26 @@ static char* duplicateString(const char *str);
 EmailResult emailCreate(char* address, Email* result) {
 	if (address == NULL || result == NULL) return EMAIL_NULL_PARAMETERS;
 	if (countSign(address, AT_SIGN) != 1) return EMAIL_INVALID_PARAMETERS;
-	char* adress_copy = duplicateString(address);
-	if (adress_copy == NULL) return EMAIL_OUT_OF_MEMORY;
-	Email mail = malloc(sizeof(*mail));
-	if (mail == NULL) {
-		free(adress_copy);
-		return EMAIL_OUT_OF_MEMORY;
-	} else {
-		mail->address = adress_copy;
+	uint32_t hash = hashAddress(address);
+	Email mail = findEmail(address, hash);
+	if (mail != NULL) {
+		mail->references++;
 		*result = mail;
 		return EMAIL_SUCCESS;
 	}
+	size_t length = strlen(address);
+	mail = malloc(sizeof(*mail) + length + 1);
+	if (mail == NULL) return EMAIL_OUT_OF_MEMORY;
+	memcpy(mail->address, address, length + 1);
+	mail->hash = hash;
+	mail->references = 1;
+	if (!insertEmail(mail)) {
+		free(mail);
+		if (table.count == 0) releaseTable();
+		return EMAIL_OUT_OF_MEMORY;
+	}
+	*result = mail;
+	return EMAIL_SUCCESS;
 }
 
 
@@ -65,6 +110,8 @@ static int countSign(char* address, char sign) {
 *
 * Creates a new email. This function receives an email elemnet, and retrieves
 * a new identical email element pointer in the out pointer parameter.
+* As emails are interned, the copy is the same email with one more reference,
+* and allocates nothing.
 *
 * @param email the original email.
 * @param result pointer to save the new email in.
@@ -79,7 +126,9 @@ static int countSign(char* address, char sign) {
 */
 EmailResult emailCopy(Email email, Email* result) {
 	if ((email == NULL) || (result == NULL)) return EMAIL_NULL_PARAMETERS;
-	return emailCreate(email->address, result);
+	email->references++;
+	*result = email;
+	return EMAIL_SUCCESS;
 }
 
 /**
@@ -91,9 +140,10 @@ EmailResult emailCopy(Email email, Email* result) {
 * If email is NULL nothing will be done
 */
 void emailDestroy(Email email) {
-	if (email != NULL) {
-		free(email->address);
+	if ((email != NULL) && (--email->references == 0)) {
+		removeEmail(email);
 		free(email);
+		if (table.count == 0) releaseTable();
 	}
 }
 
@@ -115,6 +165,7 @@ int emailComapre(Email first, Email second) {
 	if ((first == NULL) && (second == NULL)) return 0;
 	if (first == NULL)  return -1;
 	if (second == NULL) return  1;
+	if (first == second) return 0;
 	return strcmp(first->address, second->address);
 }
 
@@ -128,7 +179,20 @@ int emailComapre(Email first, Email second) {
 * 	true if both are NULL or equal, else returns false.
 */
 bool emailAreEqual(Email first, Email second) {
-	return (emailComapre(first, second) == 0);
+	return first == second;
+}
+
+/*
+ * emailGetId: returns the id of the email. equal emails have the same id,
+ * and the ids of the existing emails are dense from 0.
+*
+* @param email the email.
+*
+* @return
+* 	-1 if email is NULL, else the email id.
+*/
+int emailGetId(Email email) {
+	return (email == NULL) ? -1 : email->id;
 }
 
 /*
@@ -145,6 +209,63 @@ char* emailToString(Email email) {
 	return duplicateString(email->address);
 }
 
+/*
+ * emailGetAddress: returns the email address, without copying it. the
+ * address belongs to the email and lives as long as it does.
+*
+* @param email the email.
+*
+* @return
+* 	NULL if email is NULL. else the email address.
+*/
+const char* emailGetAddress(Email email) {
+	return (email == NULL) ? NULL : email->address;
+}
+
+/**
+* emailSaveSnapshot: writes the email address to a snapshot.
+*
+* @param email the email.
+* @param writer the snapshot writer.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS if email or writer are NULL.
+*
+* 	SNAPSHOT_WRITE_FAILED if writing failed.
+*
+* 	SNAPSHOT_SUCCESS in case of success.
+*/
+SnapshotResult emailSaveSnapshot(Email email, SnapshotWriter writer) {
+	if ((email == NULL) || (writer == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	return snapshotWriteString(writer, email->address) ? SNAPSHOT_SUCCESS :
+		SNAPSHOT_WRITE_FAILED;
+}
+
+/**
+* emailLoadSnapshot: reads an email address written by emailSaveSnapshot,
+* and creates an email of it.
+*
+* @param reader the snapshot reader.
+* @param result pointer to save the result email in
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS if reader or result are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT if the address is truncated or not valid.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY if allocations failed.
+*
+* 	SNAPSHOT_SUCCESS in case of success. A new email is saved in the result.
+*/
+SnapshotResult emailLoadSnapshot(SnapshotReader reader, Email* result) {
+	if ((reader == NULL) || (result == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	const char* address = NULL;
+	if (!snapshotReadString(reader, &address)) return SNAPSHOT_BAD_FORMAT;
+	EmailResult created = emailCreate((char*)address, result);
+	if (created == EMAIL_OUT_OF_MEMORY) return SNAPSHOT_OUT_OF_MEMORY;
+	return (created == EMAIL_SUCCESS) ? SNAPSHOT_SUCCESS : SNAPSHOT_BAD_FORMAT;
+}
+
 /*
  * duplicateString: Allocates and duplicates a new copy given string
  *
@@ -161,3 +282,113 @@ static char* duplicateString(const char *string)
 	if (result != NULL) strcpy(result, string);
 	return result;
 }
+
+/*
+ * hashAddress: the 32 bit FNV-1a hash of an address.
+ */
+static uint32_t hashAddress(const char* address) {
+	uint32_t hash = FNV_OFFSET_BASIS;
+	for (const char* c = address; *c != '\0'; c++) {
+		hash = (hash ^ (unsigned char)*c) * FNV_PRIME;
+	}
+	return hash;
+}
+
+/*
+ * findEmail: returns the interned email of an address, NULL if there is
+ * none.
+ */
+static Email findEmail(const char* address, uint32_t hash) {
+	if (table.buckets == NULL) return NULL;
+	Email email = table.buckets[hash & (table.buckets_count - 1)];
+	while ((email != NULL) && ((email->hash != hash) ||
+		(strcmp(email->address, address) != 0))) {
+		email = email->next;
+	}
+	return email;
+}
+
+/*
+ * insertEmail: adds a new email to the table, and gives it a free id. the
+ * free ids array always has room for all the ids given.
+ *
+ * @return
+ * 	false in case of allocation error; else returns true.
+ */
+static bool insertEmail(Email email) {
+	if ((table.count >= table.buckets_count / 4 * 3) && (!growBuckets())) {
+		return false;
+	}
+	if (table.free_ids_count > 0) {
+		email->id = table.free_ids[--table.free_ids_count];
+	} else {
+		if (table.ids_count == table.free_ids_capacity) {
+			int capacity = (table.free_ids_capacity == 0) ?
+				INITIAL_BUCKETS_COUNT :
+				TABLE_GROWTH_FACTOR * table.free_ids_capacity;
+			int* free_ids = realloc(table.free_ids,
+				capacity * sizeof(*free_ids));
+			if (free_ids == NULL) return false;
+			table.free_ids = free_ids;
+			table.free_ids_capacity = capacity;
+		}
+		email->id = table.ids_count++;
+	}
+	Email* bucket = &table.buckets[email->hash & (table.buckets_count - 1)];
+	email->next = *bucket;
+	*bucket = email;
+	table.count++;
+	return true;
+}
+
+/*
+ * removeEmail: removes an email from the table, and frees its id.
+ */
+static void removeEmail(Email email) {
+	Email* link = &table.buckets[email->hash & (table.buckets_count - 1)];
+	while (*link != email) link = &(*link)->next;
+	*link = email->next;
+	table.free_ids[table.free_ids_count++] = email->id;
+	table.count--;
+}
+
+/*
+ * growBuckets: doubles the amount of buckets of the table, or allocates
+ * the first ones, and moves the emails to the new buckets.
+ *
+ * @return
+ * 	false in case of allocation error; else returns true.
+ */
+static bool growBuckets() {
+	int count = (table.buckets_count == 0) ? INITIAL_BUCKETS_COUNT :
+		TABLE_GROWTH_FACTOR * table.buckets_count;
+	Email* buckets = calloc(count, sizeof(*buckets));
+	if (buckets == NULL) return false;
+	for (int i = 0; i < table.buckets_count; i++) {
+		Email email = table.buckets[i];
+		while (email != NULL) {
+			Email next = email->next;
+			email->next = buckets[email->hash & (count - 1)];
+			buckets[email->hash & (count - 1)] = email;
+			email = next;
+		}
+	}
+	free(table.buckets);
+	table.buckets = buckets;
+	table.buckets_count = count;
+	return true;
+}
+
+/*
+ * releaseTable: frees the memory of the table once it has no emails.
+ */
+static void releaseTable() {
+	free(table.buckets);
+	free(table.free_ids);
+	table.buckets = NULL;
+	table.buckets_count = 0;
+	table.ids_count = 0;
+	table.free_ids = NULL;
+	table.free_ids_capacity = 0;
+	table.free_ids_count = 0;
+}
@@ -2,9 +2,17 @@
 #define SRC_EMAIL_H_
 
 #include <stdbool.h>
+#include "snapshot.h"
 
 #define AT_SIGN '@'
 
+/**
+* Emails are interned: all the emails of an address are the same element,
+* which counts its references and is freed with the last one. So copying an
+* email allocates nothing, and equal emails are told by their identity.
+* Emails are not thread safe, and must be created and destroyed by one
+* thread.
+*/
 typedef struct Email_t *Email;
 
 /**
@@ -43,6 +51,8 @@ EmailResult emailCreate(char* address, Email* result);
 *
 * Creates a new email. This function receives an email elemnet, and retrieves
 * a new identical email element pointer in the out pointer parameter.
+* As emails are interned, the copy is the same email with one more reference,
+* and allocates nothing.
 *
 * @param email the original email.
 * @param result pointer to save the new email in.
@@ -94,6 +104,17 @@ int emailComapre(Email first, Email second);
 */
 bool emailAreEqual(Email first, Email second);
 
+/*
+ * emailGetId: returns the id of the email. equal emails have the same id,
+ * and the ids of the existing emails are dense from 0.
+*
+* @param email the email.
+*
+* @return
+* 	-1 if email is NULL, else the email id.
+*/
+int emailGetId(Email email);
+
 /*
  * emailToString: returns a copy of the email address.
  * this method uses malloc in order to allocate memory to save new string in.
@@ -105,4 +126,48 @@ bool emailAreEqual(Email first, Email second);
 */
 char* emailToString(Email email);
 
+/*
+ * emailGetAddress: returns the email address, without copying it. the
+ * address belongs to the email and lives as long as it does.
+*
+* @param email the email.
+*
+* @return
+* 	NULL if email is NULL. else the email address.
+*/
+const char* emailGetAddress(Email email);
+
+/**
+* emailSaveSnapshot: writes the email address to a snapshot.
+*
+* @param email the email.
+* @param writer the snapshot writer.
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS if email or writer are NULL.
+*
+* 	SNAPSHOT_WRITE_FAILED if writing failed.
+*
+* 	SNAPSHOT_SUCCESS in case of success.
+*/
+SnapshotResult emailSaveSnapshot(Email email, SnapshotWriter writer);
+
+/**
+* emailLoadSnapshot: reads an email address written by emailSaveSnapshot,
+* and creates an email of it.
+*
+* @param reader the snapshot reader.
+* @param result pointer to save the result email in
+*
+* @return
+* 	SNAPSHOT_NULL_PARAMETERS if reader or result are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT if the address is truncated or not valid.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY if allocations failed.
+*
+* 	SNAPSHOT_SUCCESS in case of success. A new email is saved in the result.
+*/
+SnapshotResult emailLoadSnapshot(SnapshotReader reader, Email* result);
+
 #endif /* SRC_EMAIL_H_ */
@@ -11,6 +11,7 @@ static bool testEmailCreate();
 static bool testEmailCopy();
 static bool testEmailCompareAndEqals();
 static bool testEmailToString();
+static bool testEmailInterning();
 int RunEmailTest();
 
 //int main() {
@@ -19,6 +20,7 @@ int RunEmailTest() {
 	RUN_TEST(testEmailCopy);
 	RUN_TEST(testEmailCompareAndEqals);
 	RUN_TEST(testEmailToString);
+	RUN_TEST(testEmailInterning);
 	return 0;
 }
 
@@ -128,3 +130,46 @@ static bool testEmailToString() {
 	emailDestroy(mail_2);
 	return true;
 }
+
+/**
+ * Test emails of the same address are shared, and ids are reused
+ */
+static bool testEmailInterning() {
+	Email mail_1 = NULL, mail_2 = NULL, mail_3 = NULL, copy = NULL;
+	ASSERT_TEST(emailCreate("intern@gmail.com", &mail_1) == EMAIL_SUCCESS);
+	ASSERT_TEST(emailCreate("intern@gmail.com", &mail_2) == EMAIL_SUCCESS);
+	ASSERT_TEST(emailCopy(mail_1, &copy) == EMAIL_SUCCESS);
+	ASSERT_TEST((mail_1 == mail_2) && (mail_1 == copy));
+	ASSERT_TEST(emailGetId(mail_1) >= 0);
+	ASSERT_TEST(emailGetId(NULL) == -1);
+	emailDestroy(mail_1);
+	emailDestroy(copy);
+	char* address = emailToString(mail_2);
+	ASSERT_TEST(strcmp(address, "intern@gmail.com") == 0);
+	free(address);
+
+	ASSERT_TEST(emailCreate("other@gmail.com", &mail_3) == EMAIL_SUCCESS);
+	int id = emailGetId(mail_3);
+	ASSERT_TEST(id != emailGetId(mail_2));
+	emailDestroy(mail_3);
+	ASSERT_TEST(emailCreate("third@gmail.com", &mail_3) == EMAIL_SUCCESS);
+	ASSERT_TEST(emailGetId(mail_3) == id);
+
+	Email mails[200];
+	char buffer[32];
+	for (int i = 0; i < 200; i++) {
+		sprintf(buffer, "user%d@gmail.com", i);
+		ASSERT_TEST(emailCreate(buffer, &mails[i]) == EMAIL_SUCCESS);
+	}
+	for (int i = 0; i < 200; i++) {
+		sprintf(buffer, "user%d@gmail.com", i);
+		ASSERT_TEST(emailCreate(buffer, &copy) == EMAIL_SUCCESS);
+		ASSERT_TEST(copy == mails[i]);
+		ASSERT_TEST(emailGetId(copy) != emailGetId(mail_2));
+		emailDestroy(copy);
+		emailDestroy(mails[i]);
+	}
+	emailDestroy(mail_2);
+	emailDestroy(mail_3);
+	return true;
+}
@@ -0,0 +1,387 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "inputReader.h"
+#include "utilities.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define LINE_END '\n'
+#define CARRIAGE_RETURN '\r'
+#define INITIAL_LINE_CAPACITY 1024
+#define LINE_GROWTH_FACTOR 2
+
+struct inputReader_t {
+	const char* data;
+	size_t size;
+	size_t position;
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#endif
+	FILE* stream;
+	bool owns_stream;
+	char* buffer;
+	size_t buffer_capacity;
+};
+
+static InputReader allocateInputReader();
+static bool mapFile(const char* path, InputReader reader);
+static void unmapFile(InputReader reader);
+static bool nextMappedLine(InputReader reader, const char** line,
+	size_t* length);
+static bool nextStreamLine(InputReader reader, const char** line,
+	size_t* length);
+static bool growBuffer(InputReader reader);
+static void skipLine(FILE* stream);
+static bool readWholeStream(InputReader reader);
+
+/**
+* Allocates a new InputReader over a file.
+*
+* @param path the input file path.
+* @param result pointer to save the result reader in.
+*
+* @return
+*
+* 	INPUT_READER_NULL_PARAMETERS - if path or result are NULL.
+*
+* 	INPUT_READER_CANNOT_OPEN_FILE - if the file could not be opened.
+*
+* 	INPUT_READER_OUT_OF_MEMORY - if allocations failed.
+*
+* 	INPUT_READER_SUCCESS - in case of success. A new reader is saved in the
+* 		result.
+*/
+InputReaderResult inputReaderCreateFromPath(const char* path,
+	InputReader* result) {
+	if ((path == NULL) || (result == NULL)) return INPUT_READER_NULL_PARAMETERS;
+	InputReader reader = allocateInputReader();
+	if (reader == NULL) return INPUT_READER_OUT_OF_MEMORY;
+	if (!mapFile(path, reader)) {
+		reader->stream = fopen(path, "rb");
+		if (reader->stream == NULL) {
+			free(reader);
+			return INPUT_READER_CANNOT_OPEN_FILE;
+		}
+		reader->owns_stream = true;
+	}
+	*result = reader;
+	return INPUT_READER_SUCCESS;
+}
+
+/**
+* Allocates a new InputReader over an open stream.
+* The stream is not owned by the reader and will not be closed by it.
+*
+* @param stream the input stream, for example stdin.
+*
+* @return
+* 	NULL - if stream is NULL or allocations failed.
+* 	A new reader in case of success.
+*/
+InputReader inputReaderCreateFromStream(FILE* stream) {
+	if (stream == NULL) return NULL;
+	InputReader reader = allocateInputReader();
+	if (reader == NULL) return NULL;
+	reader->stream = stream;
+	return reader;
+}
+
+/**
+* inputReaderNextLine: advances the reader to the next input line.
+*
+* @param reader the reader.
+* @param line pointer to save the line start in.
+* @param length pointer to save the line length in.
+*
+* @return
+* 	false if one of the parameters is NULL or the input ended;
+* 	else returns true.
+*/
+bool inputReaderNextLine(InputReader reader, const char** line,
+	size_t* length) {
+	if ((reader == NULL) || (line == NULL) || (length == NULL)) return false;
+	if (reader->data != NULL) return nextMappedLine(reader, line, length);
+	return nextStreamLine(reader, line, length);
+}
+
+/**
+* inputReaderReadAll: gives the rest of the input at once.
+*
+* @param reader the reader.
+* @param data pointer to save the data start in.
+* @param size pointer to save the data size in.
+*
+* @return
+* 	false if one of the parameters is NULL or in case of allocation error;
+* 	else returns true.
+*/
+bool inputReaderReadAll(InputReader reader, const char** data, size_t* size) {
+	if ((reader == NULL) || (data == NULL) || (size == NULL)) return false;
+	if (reader->data != NULL) {
+		*data = reader->data + reader->position;
+		*size = reader->size - reader->position;
+		reader->position = reader->size;
+		return true;
+	}
+	if (!readWholeStream(reader)) return false;
+	*data = reader->buffer;
+	*size = reader->size;
+	return true;
+}
+
+/**
+* inputReaderDestroy: Deallocates an existing reader, unmapping or closing
+* the file it opened.
+*
+* @param reader Target reader to be deallocated.
+* If reader is NULL nothing will be done
+*/
+void inputReaderDestroy(InputReader reader) {
+	if (reader == NULL) return;
+	unmapFile(reader);
+	if ((reader->owns_stream) && (reader->stream != NULL)) {
+		fclose(reader->stream);
+	}
+	free(reader->buffer);
+	free(reader);
+}
+
+/*
+* allocateInputReader: allocates an empty reader with no input attached.
+*
+* @return
+* 	NULL in case of allocation error; else returns the reader.
+*/
+static InputReader allocateInputReader() {
+	InputReader reader = malloc(sizeof(*reader));
+	if (reader == NULL) return NULL;
+	reader->data = NULL;
+	reader->size = 0;
+	reader->position = 0;
+#ifdef _WIN32
+	reader->file = INVALID_HANDLE_VALUE;
+	reader->mapping = NULL;
+#endif
+	reader->stream = NULL;
+	reader->owns_stream = false;
+	reader->buffer = NULL;
+	reader->buffer_capacity = 0;
+	return reader;
+}
+
+/*
+* mapFile: maps the whole file read only into the reader.
+*
+* Empty files and files which are not regular can not be mapped, the caller
+* should read those through a stream instead.
+*
+* @param path the file path.
+* @param reader the reader to save the mapping in.
+*
+* @return
+* 	false if the file could not be mapped; else returns true.
+*/
+#ifdef _WIN32
+static bool mapFile(const char* path, InputReader reader) {
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER size;
+	if ((!GetFileSizeEx(file, &size)) || (size.QuadPart <= 0) ||
+		((unsigned long long)size.QuadPart > (size_t)-1)) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		CloseHandle(file);
+		return false;
+	}
+	const char* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == NULL) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	reader->file = file;
+	reader->mapping = mapping;
+	reader->data = data;
+	reader->size = (size_t)size.QuadPart;
+	return true;
+}
+#else
+static bool mapFile(const char* path, InputReader reader) {
+	int file = open(path, O_RDONLY);
+	if (file < 0) return false;
+	struct stat status;
+	if ((fstat(file, &status) != 0) || (!S_ISREG(status.st_mode)) ||
+		(status.st_size <= 0) ||
+		((unsigned long long)status.st_size > (size_t)-1)) {
+		close(file);
+		return false;
+	}
+	size_t size = (size_t)status.st_size;
+	void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED) return false;
+	posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+	reader->data = data;
+	reader->size = size;
+	return true;
+}
+#endif
+
+/*
+* unmapFile: releases the reader mapping, if there is one.
+*
+* @param reader the reader.
+*/
+static void unmapFile(InputReader reader) {
+	if (reader->data == NULL) return;
+#ifdef _WIN32
+	UnmapViewOfFile(reader->data);
+	CloseHandle(reader->mapping);
+	CloseHandle(reader->file);
+	reader->mapping = NULL;
+	reader->file = INVALID_HANDLE_VALUE;
+#else
+	munmap((void*)reader->data, reader->size);
+#endif
+	reader->data = NULL;
+	reader->size = 0;
+}
+
+/*
+* nextMappedLine: returns the next line of the mapping, in place.
+*/
+static bool nextMappedLine(InputReader reader, const char** line,
+	size_t* length) {
+	if (reader->position >= reader->size) return false;
+	const char* start = reader->data + reader->position;
+	size_t left = reader->size - reader->position;
+	const char* end = memchr(start, LINE_END, left);
+	size_t line_length = (end == NULL) ? left : (size_t)(end - start);
+	reader->position += (end == NULL) ? left : line_length + 1;
+	if ((line_length > 0) && (start[line_length - 1] == CARRIAGE_RETURN)) {
+		line_length--;
+	}
+	*line = start;
+	*length = line_length;
+	return true;
+}
+
+/*
+* nextStreamLine: reads the next line of the stream into the reader buffer.
+*
+* Lines of any length are read whole. When a line does not fit the buffer
+* grows geometrically and reading continues where it stopped, so a line is
+* copied at most a constant amount of times on average.
+* A NUL character ends the line where it is, and the rest of the line is
+* skipped. fgets does not tell how much it read past a NUL, so the last
+* character of each read is set to a new line first: fgets overwrites it
+* with its terminator only when it filled the whole read, and otherwise it
+* stopped at the end of the line or of the input.
+* An allocation error ends the input.
+*/
+static bool nextStreamLine(InputReader reader, const char** line,
+	size_t* length) {
+	if ((reader->buffer == NULL) && (!growBuffer(reader))) return false;
+	size_t line_length = 0;
+	bool has_read = false;
+	while (true) {
+		size_t left = reader->buffer_capacity - line_length;
+		int chunk = (left > INT_MAX) ? INT_MAX : (int)left;
+		char* last = reader->buffer + line_length + chunk - 1;
+		*last = LINE_END;
+		if (fgets(reader->buffer + line_length, chunk, reader->stream) ==
+			NULL) break;
+		has_read = true;
+		size_t read = strlen(reader->buffer + line_length);
+		line_length += read;
+		if ((*last != END_OF_STRING) || (*(last - 1) == LINE_END)) break;
+		if (read < (size_t)chunk - 1) {
+			skipLine(reader->stream);
+			break;
+		}
+		if ((line_length == reader->buffer_capacity - 1) &&
+			(!growBuffer(reader))) return false;
+	}
+	if (!has_read) return false;
+	if ((line_length > 0) && (reader->buffer[line_length - 1] == LINE_END)) {
+		line_length--;
+	}
+	if ((line_length > 0) &&
+		(reader->buffer[line_length - 1] == CARRIAGE_RETURN)) {
+		line_length--;
+	}
+	*line = reader->buffer;
+	*length = line_length;
+	return true;
+}
+
+/*
+* growBuffer: allocates the stream line buffer, or grows it geometrically.
+*
+* @return
+* 	false in case of allocation error; else returns true.
+*/
+static bool growBuffer(InputReader reader) {
+	if (reader->buffer_capacity > SIZE_MAX / LINE_GROWTH_FACTOR) return false;
+	size_t capacity = (reader->buffer == NULL) ? INITIAL_LINE_CAPACITY :
+		reader->buffer_capacity * LINE_GROWTH_FACTOR;
+	char* buffer = realloc(reader->buffer, sizeof(char) * capacity);
+	if (buffer == NULL) return false;
+	reader->buffer = buffer;
+	reader->buffer_capacity = capacity;
+	return true;
+}
+
+/*
+* skipLine: reads a stream up to the end of the current line.
+*/
+static void skipLine(FILE* stream) {
+	int character = getc(stream);
+	while ((character != EOF) && (character != LINE_END)) {
+		character = getc(stream);
+	}
+}
+
+/*
+* readWholeStream: reads the stream to its end into the reader buffer, and
+* saves the amount read as the reader size.
+*
+* @return
+* 	false in case of allocation error; else returns true.
+*/
+static bool readWholeStream(InputReader reader) {
+#ifdef _WIN32
+	_setmode(_fileno(reader->stream), _O_BINARY);
+#endif
+	size_t size = 0;
+	do {
+		if ((size == reader->buffer_capacity) &&
+			(!growBuffer(reader))) return false;
+		size += fread(reader->buffer + size, sizeof(char),
+			reader->buffer_capacity - size, reader->stream);
+	} while (size == reader->buffer_capacity);
+	reader->size = size;
+	return true;
+}
@@ -0,0 +1,105 @@
+#ifndef SRC_INPUTREADER_H_
+#define SRC_INPUTREADER_H_
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef struct inputReader_t *InputReader;
+
+/**
+* This type defines end codes for the methods.
+*/
+typedef enum {
+	INPUT_READER_NULL_PARAMETERS = 0,
+	INPUT_READER_CANNOT_OPEN_FILE = 1,
+	INPUT_READER_OUT_OF_MEMORY = 2,
+	INPUT_READER_SUCCESS = 3
+} InputReaderResult;
+
+/**
+* Allocates a new InputReader over a file.
+*
+* The file is memory mapped and its lines are walked in place, so the page
+* cache is the only copy of the input. If the file can not be mapped (for
+* example an empty file, a pipe, or a file too large for the address space)
+* the reader falls back to reading it through a FILE* stream.
+*
+* @param path the input file path.
+* @param result pointer to save the result reader in.
+*
+* @return
+*
+* 	INPUT_READER_NULL_PARAMETERS - if path or result are NULL.
+*
+* 	INPUT_READER_CANNOT_OPEN_FILE - if the file could not be opened.
+*
+* 	INPUT_READER_OUT_OF_MEMORY - if allocations failed.
+*
+* 	INPUT_READER_SUCCESS - in case of success. A new reader is saved in the
+* 		result.
+*/
+InputReaderResult inputReaderCreateFromPath(const char* path,
+	InputReader* result);
+
+/**
+* Allocates a new InputReader over an open stream.
+* The stream is not owned by the reader and will not be closed by it.
+*
+* @param stream the input stream, for example stdin.
+*
+* @return
+* 	NULL - if stream is NULL or allocations failed.
+* 	A new reader in case of success.
+*/
+InputReader inputReaderCreateFromStream(FILE* stream);
+
+/**
+* inputReaderNextLine: advances the reader to the next input line.
+*
+* The line is given as a pointer and a length. It is not NUL terminated and
+* does not include the line terminator, a new line and a carriage return
+* before it, so files with Windows line endings read the same. A NUL
+* character ends a line read from a stream, and the rest of that line is
+* skipped. The pointed memory stays valid until the next call to
+* inputReaderNextLine or inputReaderDestroy.
+*
+* @param reader the reader.
+* @param line pointer to save the line start in.
+* @param length pointer to save the line length in.
+*
+* @return
+* 	false if one of the parameters is NULL or the input ended;
+* 	else returns true.
+*/
+bool inputReaderNextLine(InputReader reader, const char** line,
+	size_t* length);
+
+/**
+* inputReaderReadAll: gives the rest of the input at once, for inputs which
+* are not made of lines.
+*
+* A mapped file is given in place. A stream is read to its end into the
+* reader buffer, in binary mode. The pointed memory stays valid until
+* inputReaderDestroy, and no more lines are read after this call.
+*
+* @param reader the reader.
+* @param data pointer to save the data start in.
+* @param size pointer to save the data size in.
+*
+* @return
+* 	false if one of the parameters is NULL or in case of allocation error;
+* 	else returns true.
+*/
+bool inputReaderReadAll(InputReader reader, const char** data, size_t* size);
+
+/**
+* inputReaderDestroy: Deallocates an existing reader, unmapping or closing
+* the file it opened.
+*
+* @param reader Target reader to be deallocated.
+* If reader is NULL nothing will be done
+*/
+void inputReaderDestroy(InputReader reader);
+
+#endif /* SRC_INPUTREADER_H_ */
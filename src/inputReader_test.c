@@ -0,0 +1,194 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include "inputReader.h"
+#include "test_utilities.h"
+
+#define TEST_FILE_PATH "inputReader_test.tmp"
+#define TEST_CONTENT "first line\n\n# comment\r\nlast line"
+
+static bool testInputReaderCreateFromPath();
+static bool testInputReaderCreateFromStream();
+static bool testInputReaderNextLine();
+static bool testInputReaderEmptyFile();
+static bool testInputReaderLongLines();
+static bool testInputReaderNulLine();
+static bool writeTestFile(const char* content);
+static bool isLine(InputReader reader, const char* expected);
+int RunInputReaderTest();
+
+//int main() {
+int RunInputReaderTest() {
+	RUN_TEST(testInputReaderCreateFromPath);
+	RUN_TEST(testInputReaderCreateFromStream);
+	RUN_TEST(testInputReaderNextLine);
+	RUN_TEST(testInputReaderEmptyFile);
+	RUN_TEST(testInputReaderLongLines);
+	RUN_TEST(testInputReaderNulLine);
+	return 0;
+}
+
+/**
+ * Test create from path method
+ */
+static bool testInputReaderCreateFromPath() {
+	InputReader reader = NULL;
+	ASSERT_TEST(writeTestFile(TEST_CONTENT));
+	ASSERT_TEST(inputReaderCreateFromPath(NULL, NULL) ==
+		INPUT_READER_NULL_PARAMETERS);
+	ASSERT_TEST(inputReaderCreateFromPath(TEST_FILE_PATH, NULL) ==
+		INPUT_READER_NULL_PARAMETERS);
+	ASSERT_TEST(inputReaderCreateFromPath(NULL, &reader) ==
+		INPUT_READER_NULL_PARAMETERS);
+	ASSERT_TEST(inputReaderCreateFromPath("no/such/file.txt", &reader) ==
+		INPUT_READER_CANNOT_OPEN_FILE);
+	ASSERT_TEST(inputReaderCreateFromPath(TEST_FILE_PATH, &reader) ==
+		INPUT_READER_SUCCESS);
+	ASSERT_TEST(reader != NULL);
+	inputReaderDestroy(reader);
+	inputReaderDestroy(NULL);
+	remove(TEST_FILE_PATH);
+	return true;
+}
+
+/**
+ * Test create from stream method
+ */
+static bool testInputReaderCreateFromStream() {
+	ASSERT_TEST(inputReaderCreateFromStream(NULL) == NULL);
+	FILE* stream = tmpfile();
+	ASSERT_TEST(stream != NULL);
+	fputs(TEST_CONTENT, stream);
+	rewind(stream);
+	InputReader reader = inputReaderCreateFromStream(stream);
+	ASSERT_TEST(reader != NULL);
+	ASSERT_TEST(isLine(reader, "first line"));
+	ASSERT_TEST(isLine(reader, ""));
+	ASSERT_TEST(isLine(reader, "# comment"));
+	ASSERT_TEST(isLine(reader, "last line"));
+	ASSERT_TEST(isLine(reader, NULL));
+	inputReaderDestroy(reader);
+	fclose(stream);
+	return true;
+}
+
+/**
+ * Test next line method over a mapped file
+ */
+static bool testInputReaderNextLine() {
+	InputReader reader = NULL;
+	const char* line = NULL;
+	size_t length = 0;
+	ASSERT_TEST(writeTestFile(TEST_CONTENT));
+	ASSERT_TEST(inputReaderCreateFromPath(TEST_FILE_PATH, &reader) ==
+		INPUT_READER_SUCCESS);
+	ASSERT_TEST(!inputReaderNextLine(NULL, &line, &length));
+	ASSERT_TEST(!inputReaderNextLine(reader, NULL, &length));
+	ASSERT_TEST(!inputReaderNextLine(reader, &line, NULL));
+	ASSERT_TEST(isLine(reader, "first line"));
+	ASSERT_TEST(isLine(reader, ""));
+	ASSERT_TEST(isLine(reader, "# comment"));
+	ASSERT_TEST(isLine(reader, "last line"));
+	ASSERT_TEST(isLine(reader, NULL));
+	ASSERT_TEST(isLine(reader, NULL));
+	inputReaderDestroy(reader);
+	remove(TEST_FILE_PATH);
+	return true;
+}
+
+/**
+ * Test an empty file has no lines
+ */
+static bool testInputReaderEmptyFile() {
+	InputReader reader = NULL;
+	ASSERT_TEST(writeTestFile(""));
+	ASSERT_TEST(inputReaderCreateFromPath(TEST_FILE_PATH, &reader) ==
+		INPUT_READER_SUCCESS);
+	ASSERT_TEST(isLine(reader, NULL));
+	inputReaderDestroy(reader);
+	remove(TEST_FILE_PATH);
+	return true;
+}
+
+/**
+ * Test lines longer than any buffer are read whole, from a stream and from
+ * a mapped file
+ */
+static bool testInputReaderLongLines() {
+	int length = 100000;
+	char* content = malloc(length + 3);
+	ASSERT_TEST(content != NULL);
+	memset(content, 'w', length);
+	strcpy(content + length, "\nx");
+	ASSERT_TEST(writeTestFile(content));
+	content[length] = '\0';
+	FILE* stream = fopen(TEST_FILE_PATH, "r");
+	ASSERT_TEST(stream != NULL);
+	InputReader reader = inputReaderCreateFromStream(stream);
+	ASSERT_TEST(isLine(reader, content));
+	ASSERT_TEST(isLine(reader, "x"));
+	ASSERT_TEST(isLine(reader, NULL));
+	inputReaderDestroy(reader);
+	fclose(stream);
+	ASSERT_TEST(inputReaderCreateFromPath(TEST_FILE_PATH, &reader) ==
+		INPUT_READER_SUCCESS);
+	ASSERT_TEST(isLine(reader, content));
+	ASSERT_TEST(isLine(reader, "x"));
+	ASSERT_TEST(isLine(reader, NULL));
+	inputReaderDestroy(reader);
+	free(content);
+	remove(TEST_FILE_PATH);
+	return true;
+}
+
+/**
+ * Test a NUL character ends a stream line where it is, at its start, in its
+ * middle and in a line longer than the buffer, and the next line is kept
+ */
+static bool testInputReaderNulLine() {
+	int length = 100000;
+	FILE* stream = tmpfile();
+	ASSERT_TEST(stream != NULL);
+	ASSERT_TEST(fwrite("\0ab\nx\0y\nz\n", sizeof(char), 10, stream) == 10);
+	for (int i = 0; i < length; i++) {
+		ASSERT_TEST(fputc((i == 1) ? '\0' : 'w', stream) != EOF);
+	}
+	ASSERT_TEST(fputs("\nlast", stream) != EOF);
+	rewind(stream);
+	InputReader reader = inputReaderCreateFromStream(stream);
+	ASSERT_TEST(isLine(reader, ""));
+	ASSERT_TEST(isLine(reader, "x"));
+	ASSERT_TEST(isLine(reader, "z"));
+	ASSERT_TEST(isLine(reader, "w"));
+	ASSERT_TEST(isLine(reader, "last"));
+	ASSERT_TEST(isLine(reader, NULL));
+	inputReaderDestroy(reader);
+	fclose(stream);
+	return true;
+}
+
+/*
+ * Writes the content to the test file
+ */
+static bool writeTestFile(const char* content) {
+	FILE* file = fopen(TEST_FILE_PATH, "wb");
+	if (file == NULL) return false;
+	fputs(content, file);
+	fclose(file);
+	return true;
+}
+
+/*
+ * Checks the next line of the reader is the expected one,
+ * NULL expected means the input should be over
+ */
+static bool isLine(InputReader reader, const char* expected) {
+	const char* line = NULL;
+	size_t length = 0;
+	bool has_line = inputReaderNextLine(reader, &line, &length);
+	if (expected == NULL) return !has_line;
+	return (has_line) && (length == strlen(expected)) &&
+		(strncmp(line, expected, length) == 0);
+}
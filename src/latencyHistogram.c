@@ -0,0 +1,128 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "latencyHistogram.h"
+
+#define SUB_BUCKET_BITS 3
+#define SUB_BUCKETS (1 << SUB_BUCKET_BITS)
+#define VALUE_BITS 64
+#define BUCKETS_COUNT ((VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS)
+
+struct latencyHistogram_t {
+	long long counts[BUCKETS_COUNT];
+	long long count;
+	long long max;
+};
+
+static int bucketOf(uint64_t value);
+static uint64_t bucketTop(int bucket);
+
+/**
+* Allocates a new, empty LatencyHistogram.
+*
+* @return
+* 	NULL - if allocations failed.
+* 	A new LatencyHistogram in case of success.
+*/
+LatencyHistogram latencyHistogramCreate() {
+	LatencyHistogram histogram = calloc(1, sizeof(*histogram));
+	return histogram;
+}
+
+/**
+* latencyHistogramRecord: counts a value.
+*
+* @param histogram the histogram.
+* @param value the value, negative values are counted as 0.
+*/
+void latencyHistogramRecord(LatencyHistogram histogram, long long value) {
+	if (histogram == NULL) return;
+	if (value < 0) value = 0;
+	histogram->counts[bucketOf((uint64_t)value)]++;
+	histogram->count++;
+	if (value > histogram->max) histogram->max = value;
+}
+
+/**
+* latencyHistogramGetCount: returns the amount of counted values.
+*
+* @param histogram the histogram.
+*
+* @return
+* 	0 if histogram is NULL; else returns the amount of values
+*/
+long long latencyHistogramGetCount(LatencyHistogram histogram) {
+	return (histogram == NULL) ? 0 : histogram->count;
+}
+
+/**
+* latencyHistogramGetMax: returns the largest counted value.
+*
+* @param histogram the histogram.
+*
+* @return
+* 	0 if histogram is NULL or empty; else returns the largest value
+*/
+long long latencyHistogramGetMax(LatencyHistogram histogram) {
+	return (histogram == NULL) ? 0 : histogram->max;
+}
+
+/**
+* latencyHistogramGetPercentile: returns a value no smaller than the given
+* percent of the counted values, the top of the bucket they reach.
+*
+* @param histogram the histogram.
+* @param percent the percent, between 0 and 100.
+*
+* @return
+* 	0 if histogram is NULL or empty; else returns the percentile value,
+* 	at most the largest counted value
+*/
+long long latencyHistogramGetPercentile(LatencyHistogram histogram,
+	double percent) {
+	if ((histogram == NULL) || (histogram->count == 0)) return 0;
+	long long rank = (long long)(percent / 100 * histogram->count);
+	if ((double)rank < percent / 100 * histogram->count) rank++;
+	if (rank < 1) rank = 1;
+	long long seen = 0;
+	for (int bucket = 0; bucket < BUCKETS_COUNT; bucket++) {
+		seen += histogram->counts[bucket];
+		if (seen >= rank) {
+			uint64_t top = bucketTop(bucket);
+			return (top < (uint64_t)histogram->max) ? (long long)top :
+				histogram->max;
+		}
+	}
+	return histogram->max;
+}
+
+/**
+* latencyHistogramDestroy: Deallocates an existing histogram.
+*
+* @param histogram Target histogram to be deallocated.
+* If histogram is NULL nothing will be done
+*/
+void latencyHistogramDestroy(LatencyHistogram histogram) {
+	free(histogram);
+}
+
+/*
+* bucketOf: returns the bucket of a value. values below SUB_BUCKETS have a
+* bucket each, larger ones share a bucket with the values of the same
+* highest bit and the same SUB_BUCKET_BITS bits below it.
+*/
+static int bucketOf(uint64_t value) {
+	if (value < SUB_BUCKETS) return (int)value;
+	int exponent = VALUE_BITS - 1 - __builtin_clzll(value);
+	int shift = exponent - SUB_BUCKET_BITS;
+	return (shift + 1) * SUB_BUCKETS + (int)((value >> shift) - SUB_BUCKETS);
+}
+
+/*
+* bucketTop: returns the largest value of a bucket.
+*/
+static uint64_t bucketTop(int bucket) {
+	if (bucket < SUB_BUCKETS) return (uint64_t)bucket;
+	int shift = bucket / SUB_BUCKETS - 1;
+	uint64_t low = (uint64_t)(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+	return low + (((uint64_t)1 << shift) - 1);
+}
@@ -0,0 +1,69 @@
+#ifndef SRC_LATENCYHISTOGRAM_H_
+#define SRC_LATENCYHISTOGRAM_H_
+
+typedef struct latencyHistogram_t *LatencyHistogram;
+
+/**
+* Allocates a new, empty LatencyHistogram.
+*
+* Values are counted in buckets which grow with the value: each power of
+* two is split into 8 buckets, so a percentile is known to about 12.5% of
+* its value, in constant memory and constant time per value.
+*
+* @return
+* 	NULL - if allocations failed.
+* 	A new LatencyHistogram in case of success.
+*/
+LatencyHistogram latencyHistogramCreate();
+
+/**
+* latencyHistogramRecord: counts a value.
+*
+* @param histogram the histogram.
+* @param value the value, negative values are counted as 0.
+*/
+void latencyHistogramRecord(LatencyHistogram histogram, long long value);
+
+/**
+* latencyHistogramGetCount: returns the amount of counted values.
+*
+* @param histogram the histogram.
+*
+* @return
+* 	0 if histogram is NULL; else returns the amount of values
+*/
+long long latencyHistogramGetCount(LatencyHistogram histogram);
+
+/**
+* latencyHistogramGetMax: returns the largest counted value.
+*
+* @param histogram the histogram.
+*
+* @return
+* 	0 if histogram is NULL or empty; else returns the largest value
+*/
+long long latencyHistogramGetMax(LatencyHistogram histogram);
+
+/**
+* latencyHistogramGetPercentile: returns a value no smaller than the given
+* percent of the counted values, the top of the bucket they reach.
+*
+* @param histogram the histogram.
+* @param percent the percent, between 0 and 100.
+*
+* @return
+* 	0 if histogram is NULL or empty; else returns the percentile value,
+* 	at most the largest counted value
+*/
+long long latencyHistogramGetPercentile(LatencyHistogram histogram,
+	double percent);
+
+/**
+* latencyHistogramDestroy: Deallocates an existing histogram.
+*
+* @param histogram Target histogram to be deallocated.
+* If histogram is NULL nothing will be done
+*/
+void latencyHistogramDestroy(LatencyHistogram histogram);
+
+#endif /* SRC_LATENCYHISTOGRAM_H_ */
@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "latencyHistogram.h"
+#include "test_utilities.h"
+
+static bool testLatencyHistogramCreate();
+static bool testLatencyHistogramSmallValues();
+static bool testLatencyHistogramPrecision();
+static bool testLatencyHistogramPercentiles();
+int RunLatencyHistogramTest();
+
+//int main() {
+int RunLatencyHistogramTest() {
+	RUN_TEST(testLatencyHistogramCreate);
+	RUN_TEST(testLatencyHistogramSmallValues);
+	RUN_TEST(testLatencyHistogramPrecision);
+	RUN_TEST(testLatencyHistogramPercentiles);
+	return 0;
+}
+
+/**
+ * Test create method
+ */
+static bool testLatencyHistogramCreate() {
+	LatencyHistogram histogram = latencyHistogramCreate();
+	ASSERT_TEST(histogram != NULL);
+	ASSERT_TEST(latencyHistogramGetCount(histogram) == 0);
+	ASSERT_TEST(latencyHistogramGetMax(histogram) == 0);
+	ASSERT_TEST(latencyHistogramGetPercentile(histogram, 50) == 0);
+	ASSERT_TEST(latencyHistogramGetCount(NULL) == 0);
+	latencyHistogramRecord(NULL, 1);
+	latencyHistogramDestroy(histogram);
+	latencyHistogramDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test small values are counted exactly
+ */
+static bool testLatencyHistogramSmallValues() {
+	LatencyHistogram histogram = latencyHistogramCreate();
+	for (int value = 1; value <= 4; value++) {
+		latencyHistogramRecord(histogram, value);
+	}
+	latencyHistogramRecord(histogram, -5);
+	ASSERT_TEST(latencyHistogramGetCount(histogram) == 5);
+	ASSERT_TEST(latencyHistogramGetPercentile(histogram, 0) == 0);
+	ASSERT_TEST(latencyHistogramGetPercentile(histogram, 20) == 0);
+	ASSERT_TEST(latencyHistogramGetPercentile(histogram, 21) == 1);
+	ASSERT_TEST(latencyHistogramGetPercentile(histogram, 60) == 2);
+	ASSERT_TEST(latencyHistogramGetPercentile(histogram, 100) == 4);
+	ASSERT_TEST(latencyHistogramGetMax(histogram) == 4);
+	latencyHistogramDestroy(histogram);
+	return true;
+}
+
+/**
+ * Test large values are known to an eighth of their power of two
+ */
+static bool testLatencyHistogramPrecision() {
+	long long values[] = {9, 1000, 123456, 987654321, 1LL << 40,
+		(1LL << 61) + 12345};
+	for (int i = 0; i < (int)(sizeof(values) / sizeof(values[0])); i++) {
+		LatencyHistogram histogram = latencyHistogramCreate();
+		latencyHistogramRecord(histogram, values[i]);
+		latencyHistogramRecord(histogram, values[i] * 2);
+		long long median = latencyHistogramGetPercentile(histogram, 50);
+		ASSERT_TEST(median >= values[i]);
+		ASSERT_TEST(median - values[i] <= values[i] / 8);
+		latencyHistogramDestroy(histogram);
+	}
+	return true;
+}
+
+/**
+ * Test the percentiles of a known distribution
+ */
+static bool testLatencyHistogramPercentiles() {
+	LatencyHistogram histogram = latencyHistogramCreate();
+	for (int value = 1; value <= 10000; value++) {
+		latencyHistogramRecord(histogram, value);
+	}
+	long long expected[] = {5000, 9000, 9900, 9990};
+	double percents[] = {50, 90, 99, 99.9};
+	for (int i = 0; i < 4; i++) {
+		long long value = latencyHistogramGetPercentile(histogram, percents[i]);
+		ASSERT_TEST((value >= expected[i]) &&
+			(value <= expected[i] + expected[i] / 8));
+	}
+	ASSERT_TEST(latencyHistogramGetPercentile(histogram, 100) == 10000);
+	ASSERT_TEST(latencyHistogramGetMax(histogram) == 10000);
+	latencyHistogramDestroy(histogram);
+	return true;
+}
@@ -18,12 +18,16 @@
 *   listGetSize              - Returns the size of a given list
 *   listInsertFirst          - Inserts an element in the beginning of the list
 *   listInsertLast           - Inserts an element in the end of the list
+*   listInsertLastTake       - Inserts an element in the end of the list
+*                              without copying it
 *   listInsertBeforeCurrent  - Inserts an element right before the place of
 *                              internal iterator
 *   listInsertAfterCurrent   - Inserts an element right after the place of the
 *                              internal iterator
 *   listRemoveCurrent        - Removes the element pointed by the internal
 *                              iterator
+*   listRemoveIf             - Removes all the elements which satisfy a
+*                              boolean predicate
 *   listGetCurrent           - Return the current element (pointed by the
 *                              internal iterator)
 *   listGetFirst             - Sets the internal iterator (also called current
@@ -32,6 +36,8 @@
 *   listGetNext              - Advances the list's iterator to the next element
 *                              and return it
 *   listSort                 - Sorts the list according to a given criteria
+*   listSortTopK             - Sorts the list according to a given criteria
+*                              and keeps only its first k elements
 *   listFilter               - Creates a copy of an existing list, filtered by
 *                              a boolean predicate
 *   listClear		      	  - Clears all the data from the list
@@ -231,6 +237,20 @@ ListResult listInsertFirst(List list, ListElement element);
 */
 ListResult listInsertLast(List list, ListElement element);
 
+/**
+* Adds an element to the end of the list without copying it: the list takes
+* the element itself, and frees it with its free function.
+*
+* @param list The list for which to add an element in its end
+* @param element The element to insert. On failure it is not taken, and is
+* left to the caller.
+* @return
+* LIST_NULL_ARGUMENT if a NULL was sent as list or element
+* LIST_OUT_OF_MEMORY if an allocation failed
+* LIST_SUCCESS the element has been inserted successfully
+*/
+ListResult listInsertLastTake(List list, ListElement element);
+
 /**
 * Adds a new element to the list, the new element will be place right before
 * the current element (As pointed by the inner iterator of the list)
@@ -277,9 +297,43 @@ ListResult listInsertAfterCurrent(List list, ListElement element);
 */
 ListResult listRemoveCurrent(List list);
 
+/**
+* Removes all the elements of the list for which the predicate returns true,
+* using the stored freeing function, in a single pass over the list.
+*
+* For example, the following code removes from a list of strings the strings
+* which are longer than 10 characters.
+* @code
+*
+* bool isLongerThan(ListElement string, ListFilterKey key) {
+*   return strlen(string) > *(int*)key;
+* }
+*
+* void removeLongStrings(List listOfStrings) {
+*   int key = 10;
+*   listRemoveIf(listOfStrings, isLongerThan, &key);
+* }
+* @endcode
+*
+* The internal iterator is in an invalid state after the call.
+*
+* @param list The list to remove the elements from
+* @param predicate The function used for determining whether a given element
+* should be removed from the list or not.
+* @param key Any extra values that need to be sent to the predicate when called
+* @return
+* LIST_NULL_ARGUMENT if list or predicate are NULL
+* LIST_SUCCESS the elements were removed successfully
+*/
+ListResult listRemoveIf(List list, FilterListElement predicate,
+		ListFilterKey key);
+
 /**
 * Sorts the list according to the given function.
 *
+* The elements are ordered from the greatest to the smallest. The sort is
+* stable: elements which are equal keep their relative order.
+*
 * For example, the following code will sort a list of integers according to
 * their distance from 0.
 * @code
@@ -308,6 +362,30 @@ ListResult listRemoveCurrent(List list);
 */
 ListResult listSort(List list, CompareListElements compareElement);
 
+/**
+* Sorts the list according to the given function, and keeps only the first k
+* elements of the sorted list.
+*
+* The list is ordered the same as by listSort, but only k elements are kept in
+* a bounded heap while the list is scanned, so sorting n elements takes
+* O(n log k) comparisons. The other elements are deallocated using the stored
+* freeing function. If k is not positive all the elements are removed.
+*
+* The internal iterator is in an invalid state after the call.
+*
+* @param list the target list to sort
+* @param compareElement A comparison function as defined in the type
+* CompareListElements.
+* @param k the amount of elements to keep
+*
+* @return
+* LIST_NULL_ARGUMENT if list or compareElement are NULL
+* LIST_OUT_OF_MEMORY if a memory allocation failed, the list will be intact
+* in this case.
+* LIST_SUCCESS if sorting completed successfully.
+*/
+ListResult listSortTopK(List list, CompareListElements compareElement, int k);
+
 /**
 * Creates a new filtered copy of a list.
 *
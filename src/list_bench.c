@@ -0,0 +1,192 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "list_mtm.h"
+#include "monotonicClock.h"
+
+#define BENCH_MIN_EXPONENT 3
+#define BENCH_DEFAULT_MAX_EXPONENT 6
+#define BENCH_MAX_EXPONENT 7
+#define BENCH_DEFAULT_RESTART_MAX_ELEMENTS 30000
+#define BENCH_REMOVED_DIVISOR 2
+#define BENCH_SCRAMBLE_FACTOR 7919
+#define BENCH_TOP_K 10
+
+typedef enum {
+	BENCH_REMOVE_IF,
+	BENCH_FILTER,
+	BENCH_RESTART,
+	BENCH_SORT,
+	BENCH_SORT_TOP_K,
+	BENCH_METHODS
+} BenchMethod;
+
+static const char* method_names[BENCH_METHODS] = {"remove if", "filter",
+	"restart", "sort", "sort top k"};
+
+static ListElement copyInt(ListElement element);
+static void freeInt(ListElement element);
+static bool isDivisibleBy(ListElement element, ListFilterKey key);
+static int compareInts(ListElement first, ListElement second);
+static List createIntList(int count, bool is_scrambled);
+static int removeByRestarting(List list, int divisor);
+static double runMethod(BenchMethod method, int count);
+int RunListBench(int argc, char *argv[]);
+
+/*
+ * Measures removing half of the elements of a list of 10^3 elements and up
+ * by powers of ten: with listRemoveIf, by a listFilter copy of the other
+ * half, and by restarting from the first element after every
+ * listRemoveCurrent, as the offers cascades used to. then measures sorting
+ * a scrambled list of as many elements with listSort, and keeping its
+ * BENCH_TOP_K greatest elements with listSortTopK. prints the nanoseconds
+ * per element of each, which stay flat for the linear methods and grow
+ * with the logarithm of the size for listSort.
+ *
+ * arguments are the largest power of ten of elements, 6 by default and 7 at
+ * most, and the most elements the restarting method is measured with, as it
+ * takes time quadratic in the size.
+ */
+//int main(int argc, char *argv[]) {
+int RunListBench(int argc, char *argv[]) {
+	int max_exponent = (argc > 1) ? atoi(argv[1]) :
+		BENCH_DEFAULT_MAX_EXPONENT;
+	int restart_max = (argc > 2) ? atoi(argv[2]) :
+		BENCH_DEFAULT_RESTART_MAX_ELEMENTS;
+	if ((max_exponent < BENCH_MIN_EXPONENT) ||
+		(max_exponent > BENCH_MAX_EXPONENT) || (restart_max < 0)) {
+		printf("usage: %s [max exponent, %d to %d] [restart max elements]\n",
+			argv[0], BENCH_MIN_EXPONENT, BENCH_MAX_EXPONENT);
+		return 1;
+	}
+	printf("%10s", "elements");
+	for (int i = 0; i < BENCH_METHODS; i++) {
+		printf(" %10s", method_names[i]);
+	}
+	printf("  (ns/element)\n");
+	int count = 1;
+	for (int i = 0; i < BENCH_MIN_EXPONENT; i++) count *= 10;
+	for (int exponent = BENCH_MIN_EXPONENT; exponent <= max_exponent;
+		exponent++, count *= 10) {
+		printf("%10d", count);
+		for (int method = 0; method < BENCH_METHODS; method++) {
+			double nanoseconds = ((method == BENCH_RESTART) &&
+				(count > restart_max)) ? 0 : runMethod(method, count);
+			if (nanoseconds > 0) {
+				printf(" %10.1f", nanoseconds);
+			} else if (nanoseconds == 0) {
+				printf(" %10s", "-");
+			} else {
+				printf(" %10s", "failed");
+			}
+		}
+		printf("\n");
+	}
+	return 0;
+}
+
+/* copies an int element */
+static ListElement copyInt(ListElement element) {
+	int* copy = malloc(sizeof(*copy));
+	if (copy != NULL) *copy = *(int*)element;
+	return copy;
+}
+
+/* frees an int element */
+static void freeInt(ListElement element) {
+	free(element);
+}
+
+/* checks if an int element is divisible by the int key */
+static bool isDivisibleBy(ListElement element, ListFilterKey key) {
+	return (*(int*)element % *(int*)key) == 0;
+}
+
+/* compares int elements */
+static int compareInts(ListElement first, ListElement second) {
+	int first_value = *(int*)first, second_value = *(int*)second;
+	return (first_value > second_value) - (first_value < second_value);
+}
+
+/*
+ * createIntList: creates a list of the ints from 0 to count - 1, inserting
+ * them first from the last as inserting last walks the list. if
+ * is_scrambled, the ints are multiplied by BENCH_SCRAMBLE_FACTOR modulo
+ * count. returns NULL if allocations failed.
+ */
+static List createIntList(int count, bool is_scrambled) {
+	List list = listCreate(copyInt, freeInt);
+	for (int i = count - 1; (list != NULL) && (i >= 0); i--) {
+		int value = is_scrambled ?
+			(int)((long long)i * BENCH_SCRAMBLE_FACTOR % count) : i;
+		if (listInsertFirst(list, &value) != LIST_SUCCESS) {
+			listDestroy(list);
+			list = NULL;
+		}
+	}
+	return list;
+}
+
+/*
+ * removeByRestarting: removes the elements divisible by divisor, going back
+ * to the first element after every removal. returns the amount removed.
+ */
+static int removeByRestarting(List list, int divisor) {
+	int removed = 0;
+	int* current = listGetFirst(list);
+	while (current != NULL) {
+		if (*current % divisor == 0) {
+			listRemoveCurrent(list);
+			removed++;
+			current = listGetFirst(list);
+		} else {
+			current = listGetNext(list);
+		}
+	}
+	return removed;
+}
+
+/*
+ * runMethod: removes half of the elements of a new list of count elements
+ * or sorts it with a method. returns the nanoseconds per element, or -1 if
+ * the method failed.
+ */
+static double runMethod(BenchMethod method, int count) {
+	List list = createIntList(count, method >= BENCH_SORT);
+	if (list == NULL) return -1;
+	int divisor = BENCH_REMOVED_DIVISOR;
+	bool is_valid = true;
+	List filtered = NULL;
+	long long start = monotonicClockNow();
+	switch (method) {
+		case BENCH_REMOVE_IF: {
+			is_valid = listRemoveIf(list, isDivisibleBy, &divisor) ==
+				LIST_SUCCESS;
+			break;
+		}
+		case BENCH_FILTER: {
+			filtered = listFilter(list, isDivisibleBy, &divisor);
+			is_valid = filtered != NULL;
+			break;
+		}
+		case BENCH_SORT: {
+			is_valid = listSort(list, compareInts) == LIST_SUCCESS;
+			break;
+		}
+		case BENCH_SORT_TOP_K: {
+			is_valid = (listSortTopK(list, compareInts, BENCH_TOP_K) ==
+				LIST_SUCCESS) && (*(int*)listGetFirst(list) == count - 1);
+			break;
+		}
+		case BENCH_RESTART:
+		default: {
+			is_valid = removeByRestarting(list, divisor) ==
+				(count + divisor - 1) / divisor;
+			break;
+		}
+	}
+	long long end = monotonicClockNow();
+	listDestroy(filtered);
+	listDestroy(list);
+	return is_valid ? (double)(end - start) / count : -1;
+}
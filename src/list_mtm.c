@@ -7,6 +7,11 @@
 
 typedef struct ListItem_t *ListItem;
 
+typedef struct HeapItem_t {
+	ListItem Item;
+	int Index;
+} HeapItem;
+
 struct ListItem_t {
 	ListElement Element;
 	ListItem Next;
@@ -16,12 +21,25 @@ struct List_t {
 	CopyListElement copyElementFunc;
 	FreeListElement freeElementFunc;
 	ListItem First;
+	ListItem Last;
 	ListItem Current;
 };
 
 static ListItem CreateListItem(CopyListElement copy, ListElement element);
+static void AppendListItem(List list, ListItem item);
 static void DestroyListItem(FreeListElement freeElement, ListItem item);
 static int GetListLength(List list);
+static void RemoveItems(List list, FilterListElement filterElement,
+		ListFilterKey key, bool remove_matching);
+static ListItem SplitItems(ListItem items, int count);
+static ListItem MergeItems(ListItem* link, ListItem left, ListItem right,
+		CompareListElements compareElement);
+static bool IsBetterItem(HeapItem first, HeapItem second,
+		CompareListElements compareElement);
+static void HeapSiftUp(HeapItem* heap, int index,
+		CompareListElements compareElement);
+static void HeapSiftDown(HeapItem* heap, int size, int index,
+		CompareListElements compareElement);
 
 /**
 * Sets the internal iterator to the first element and retrieves it.
@@ -148,6 +166,7 @@ List listCreate(CopyListElement copyElement, FreeListElement freeElement) {
 	list->copyElementFunc = copyElement;
 	list->freeElementFunc = freeElement;
 	list->First = NULL;
+	list->Last = NULL;
 	list->Current = NULL;
 	return list;
 }
@@ -173,13 +192,7 @@ List listCopy(List list) {
 		ListItem item_to_copy = list->First;
 		while ((item_to_copy != NULL) &&  (copy != NULL)) {
 			if (listInsertLast(copy, item_to_copy->Element) == LIST_SUCCESS) {
-				if (list->Current == item_to_copy){
-					int size = GetListLength(copy);
-					listGetFirst(copy);
-					for (int i = 1; i < size; i++) {
-						listGetNext(copy);
-					}
-				}
+				if (list->Current == item_to_copy) copy->Current = copy->Last;
 				item_to_copy = item_to_copy->Next;
 			} else {
 				listDestroy(copy);
@@ -208,6 +221,7 @@ ListResult listInsertFirst( List list, ListElement element ) {
 	if (new_list_item == NULL) return LIST_OUT_OF_MEMORY;
 	new_list_item->Next = list->First;
 	list->First = new_list_item;
+	if (list->Last == NULL) list->Last = new_list_item;
 	return LIST_SUCCESS;
 }
 
@@ -227,17 +241,45 @@ ListResult listInsertLast( List list, ListElement element ) {
 	if ((list == NULL) || (element == NULL)) return LIST_NULL_ARGUMENT;
 	ListItem new_list_item = CreateListItem(list->copyElementFunc, element);
 	if (new_list_item == NULL) return LIST_OUT_OF_MEMORY;
+	AppendListItem(list, new_list_item);
+	return LIST_SUCCESS;
+}
+
+/**
+* Adds an element to the end of the list without copying it: the list takes
+* the element itself, and frees it with its free function.
+*
+* @param list The list for which to add an element in its end
+* @param element The element to insert. On failure it is not taken, and is
+* left to the caller.
+* @return
+* LIST_NULL_ARGUMENT if a NULL was sent as list or element
+* LIST_OUT_OF_MEMORY if an allocation failed
+* LIST_SUCCESS the element has been inserted successfully
+*/
+ListResult listInsertLastTake(List list, ListElement element) {
+	if ((list == NULL) || (element == NULL)) return LIST_NULL_ARGUMENT;
+	ListItem new_list_item = malloc(sizeof(*new_list_item));
+	if (new_list_item == NULL) return LIST_OUT_OF_MEMORY;
+	new_list_item->Element = element;
+	new_list_item->Next = NULL;
+	AppendListItem(list, new_list_item);
+	return LIST_SUCCESS;
+}
+
+/**
+ * Links an item after the last item of the list.
+ *
+ * @param list Target list
+ * @param item The item to link
+ */
+static void AppendListItem(List list, ListItem item) {
 	if (list->First == NULL) {
-		list->First = new_list_item;
+		list->First = item;
 	} else {
-		ListItem last_item = list->First;
-		while ( last_item->Next != NULL ) {
-
-			last_item = last_item->Next;
-		}
-		last_item->Next = new_list_item;
+		list->Last->Next = item;
 	}
-	return LIST_SUCCESS;
+	list->Last = item;
 }
 
 /**
@@ -296,6 +338,7 @@ ListResult listInsertAfterCurrent(List list, ListElement element) {
 	if (new_list_item == NULL) return LIST_OUT_OF_MEMORY;
 	new_list_item->Next = list->Current->Next;
 	list->Current->Next = new_list_item;
+	if (list->Last == list->Current) list->Last = new_list_item;
 	return LIST_SUCCESS;
 }
 
@@ -352,27 +395,75 @@ static ListItem CreateListItem(CopyListElement copy, ListElement element) {
 * for.
 */
 List listFilter(List list, FilterListElement filterElement, ListFilterKey key){
-	if((list == NULL) && (filterElement == NULL)) return NULL;
+	if((list == NULL) || (filterElement == NULL)) return NULL;
 	List filtered = listCopy(list);
 	if (filtered == NULL) return NULL;
-	if (filtered->First != NULL) {
-		filtered->Current = filtered->First;
-		while((filtered != NULL) && (filtered->Current != NULL)) {
-			if (!filterElement(filtered->Current->Element, key)) {
-				ListItem new_current = filtered->Current->Next;
-				if (listRemoveCurrent(filtered) != LIST_SUCCESS) {
-					listDestroy(filtered);
-					filtered = NULL;
-				} else {
-					filtered->Current = new_current;
-				}
-			} else {
-				filtered->Current = filtered->Current->Next;
-			}
+	RemoveItems(filtered, filterElement, key, false);
+	filtered->Current = filtered->First;
+	return filtered;
+}
+
+/**
+* Removes all the elements of the list for which the predicate returns true,
+* using the stored freeing function, in a single pass over the list.
+*
+* For example, the following code removes from a list of strings the strings
+* which are longer than 10 characters.
+* @code
+*
+* bool isLongerThan(ListElement string, ListFilterKey key) {
+*   return strlen(string) > *(int*)key;
+* }
+*
+* void removeLongStrings(List listOfStrings) {
+*   int key = 10;
+*   listRemoveIf(listOfStrings, isLongerThan, &key);
+* }
+* @endcode
+*
+* The internal iterator is in an invalid state after the call.
+*
+* @param list The list to remove the elements from
+* @param predicate The function used for determining whether a given element
+* should be removed from the list or not.
+* @param key Any extra values that need to be sent to the predicate when called
+* @return
+* LIST_NULL_ARGUMENT if list or predicate are NULL
+* LIST_SUCCESS the elements were removed successfully
+*/
+ListResult listRemoveIf(List list, FilterListElement predicate,
+		ListFilterKey key) {
+	if ((list == NULL) || (predicate == NULL)) return LIST_NULL_ARGUMENT;
+	RemoveItems(list, predicate, key, true);
+	list->Current = NULL;
+	return LIST_SUCCESS;
+}
+
+/**
+ * Removes in a single pass the items of the list whose elements the filter
+ * function returns remove_matching for, keeping a link to the last kept
+ * item instead of searching for it.
+ *
+ * @param list Target list
+ * @param filterElement The filter function
+ * @param key The key to send to the filter function
+ * @param remove_matching whether the items the function returns true or false
+ * for are removed
+ */
+static void RemoveItems(List list, FilterListElement filterElement,
+		ListFilterKey key, bool remove_matching) {
+	ListItem* link = &list->First;
+	list->Last = NULL;
+	while (*link != NULL) {
+		ListItem current = *link;
+		if (filterElement(current->Element, key) == remove_matching) {
+			*link = current->Next;
+			DestroyListItem(list->freeElementFunc, current);
+		} else {
+			list->Last = current;
+			link = &current->Next;
 		}
 	}
-	if (filtered != NULL) filtered->Current = filtered->First;
-	return filtered;
 }
 
 /**
@@ -388,23 +479,28 @@ List listFilter(List list, FilterListElement filterElement, ListFilterKey key){
 ListResult listRemoveCurrent(List list) {
 	if (list == NULL) return LIST_NULL_ARGUMENT;
 	if (list->Current == NULL) return LIST_INVALID_CURRENT;
+	ListItem toRemoveNext = NULL;
 	if (list->First == list->Current) {
 		list->First = list->Current->Next;
 	} else {
-		ListItem toRemoveNext = list->First;
+		toRemoveNext = list->First;
 		while (toRemoveNext->Next != list->Current) {
 			toRemoveNext = toRemoveNext->Next;
 		}
 		toRemoveNext->Next = toRemoveNext->Next->Next;
 	}
+	if (list->Last == list->Current) list->Last = toRemoveNext;
 	DestroyListItem(list->freeElementFunc, list->Current);
 	list->Current = NULL;
 	return LIST_SUCCESS;
 }
 
 /**
- * Sorts the list according to the given function, using a max sort sorting
- * method.
+ * Sorts the list according to the given function, from the greatest element
+ * to the smallest, using a stable bottom up merge sort.
+ *
+ * Runs of width 1, 2, 4... are merged by relinking the items in place, until
+ * a single run is left, so no memory is allocated.
  *
  * For example, the following code will sort a list of integers according to
  * their distance from 0.
@@ -433,24 +529,166 @@ ListResult listRemoveCurrent(List list) {
  */
 ListResult listSort( List list, CompareListElements compareElement ) {
 	if ((list == NULL) || (compareElement == NULL)) return LIST_NULL_ARGUMENT;
-	int list_size = listGetSize(list);
-	if (list_size > 1) {
-		for (int i = list_size - 1; list_size > 1; list_size--) {
-			ListItem current = list->First;
-			for (int j = 0; j < i; j++) {
-				if (compareElement(current->Element, current->Next->Element)
-						< 0) {
-					ListElement element = current->Element;
-					current->Element = current->Next->Element;
-					current->Next->Element = element;
-				}
-				current = current->Next;
-			}
+	int merges_count = 2;
+	for (int width = 1; merges_count > 1; width *= 2) {
+		ListItem rest = list->First;
+		ListItem* link = &list->First;
+		merges_count = 0;
+		while (rest != NULL) {
+			ListItem left = rest;
+			ListItem right = SplitItems(left, width);
+			rest = SplitItems(right, width);
+			list->Last = MergeItems(link, left, right, compareElement);
+			link = &list->Last->Next;
+			merges_count++;
+		}
+	}
+	return LIST_SUCCESS;
+}
+
+/**
+ * Sorts the list according to the given function, and keeps only the first k
+ * elements of the sorted list.
+ *
+ * The best k items seen so far are kept in a heap whose root is the worst of
+ * them, so every other item is compared with the root and either replaces it
+ * or is deallocated. Equal items are ordered by their place in the list, so
+ * the order is the same as of listSort.
+ *
+ * @param list the target list to sort
+ * @param compareElement A comparison function as defined in the type
+ * CompareListElements.
+ * @param k the amount of elements to keep
+ *
+ * @return
+ * LIST_NULL_ARGUMENT if list or compareElement are NULL
+ * LIST_OUT_OF_MEMORY if a memory allocation failed, the list will be intact
+ * in this case.
+ * LIST_SUCCESS if sorting completed successfully.
+ */
+ListResult listSortTopK(List list, CompareListElements compareElement,
+		int k) {
+	if ((list == NULL) || (compareElement == NULL)) return LIST_NULL_ARGUMENT;
+	if (k <= 0) return listClear(list);
+	if (GetListLength(list) <= k) return listSort(list, compareElement);
+	HeapItem* heap = malloc(sizeof(*heap) * k);
+	if (heap == NULL) return LIST_OUT_OF_MEMORY;
+	int size = 0;
+	ListItem current = list->First;
+	for (int index = 0; current != NULL; index++) {
+		HeapItem item = {current, index};
+		current = current->Next;
+		if (size < k) {
+			heap[size] = item;
+			HeapSiftUp(heap, size++, compareElement);
+		} else if (IsBetterItem(item, heap[0], compareElement)) {
+			DestroyListItem(list->freeElementFunc, heap[0].Item);
+			heap[0] = item;
+			HeapSiftDown(heap, size, 0, compareElement);
+		} else {
+			DestroyListItem(list->freeElementFunc, item.Item);
 		}
 	}
+	list->First = NULL;
+	list->Last = heap[0].Item;
+	while (size > 0) {
+		ListItem worst = heap[0].Item;
+		heap[0] = heap[--size];
+		HeapSiftDown(heap, size, 0, compareElement);
+		worst->Next = list->First;
+		list->First = worst;
+	}
+	list->Current = NULL;
+	free(heap);
 	return LIST_SUCCESS;
 }
 
+/*
+ * SplitItems: cuts a chain of items after its first count items, and returns
+ * the rest of it. returns NULL if the chain is shorter.
+ */
+static ListItem SplitItems(ListItem items, int count) {
+	for (int i = 1; (items != NULL) && (i < count); i++) {
+		items = items->Next;
+	}
+	if (items == NULL) return NULL;
+	ListItem rest = items->Next;
+	items->Next = NULL;
+	return rest;
+}
+
+/*
+ * MergeItems: merges two sorted chains of items into link. an item of right
+ * goes before an item of left only if it is greater, so the merge is stable.
+ * returns the last item of the merged chain.
+ */
+static ListItem MergeItems(ListItem* link, ListItem left, ListItem right,
+		CompareListElements compareElement) {
+	ListItem last = NULL;
+	while ((left != NULL) && (right != NULL)) {
+		if (compareElement(left->Element, right->Element) < 0) {
+			last = right;
+			right = right->Next;
+		} else {
+			last = left;
+			left = left->Next;
+		}
+		*link = last;
+		link = &last->Next;
+	}
+	*link = (left != NULL) ? left : right;
+	while (*link != NULL) {
+		last = *link;
+		link = &last->Next;
+	}
+	return last;
+}
+
+/*
+ * IsBetterItem: checks whether the first heap item goes before the second
+ * one in the sorted list.
+ */
+static bool IsBetterItem(HeapItem first, HeapItem second,
+		CompareListElements compareElement) {
+	int compare = compareElement(first.Item->Element, second.Item->Element);
+	return (compare > 0) || ((compare == 0) && (first.Index < second.Index));
+}
+
+/*
+ * HeapSiftUp: moves a heap item up until its parent is worse than it.
+ */
+static void HeapSiftUp(HeapItem* heap, int index,
+		CompareListElements compareElement) {
+	while (index > 0) {
+		int parent = (index - 1) / 2;
+		if (IsBetterItem(heap[index], heap[parent], compareElement)) return;
+		HeapItem item = heap[index];
+		heap[index] = heap[parent];
+		heap[parent] = item;
+		index = parent;
+	}
+}
+
+/*
+ * HeapSiftDown: moves a heap item down until its children are better than
+ * it.
+ */
+static void HeapSiftDown(HeapItem* heap, int size, int index,
+		CompareListElements compareElement) {
+	while (2 * index + 1 < size) {
+		int worst = 2 * index + 1;
+		if ((worst + 1 < size) &&
+				IsBetterItem(heap[worst], heap[worst + 1], compareElement)) {
+			worst++;
+		}
+		if (IsBetterItem(heap[worst], heap[index], compareElement)) return;
+		HeapItem item = heap[index];
+		heap[index] = heap[worst];
+		heap[worst] = item;
+		index = worst;
+	}
+}
+
 /**
  * Removes all elements from target list.
  *
@@ -464,6 +702,7 @@ ListResult listClear(List list) {
 	if (list == NULL) return LIST_NULL_ARGUMENT;
 	ListItem current = list->First;
 	list->First = NULL;
+	list->Last = NULL;
 	while (current != NULL) {
 		ListItem temp = current;
 		current = current->Next;
@@ -0,0 +1,282 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "list_mtm.h"
+#include "test_utilities.h"
+
+#define MANY_ELEMENTS 1000
+
+static ListElement copyInt(ListElement element);
+static void freeInt(ListElement element);
+static bool isDivisibleBy(ListElement element, ListFilterKey key);
+static int compareTens(ListElement first, ListElement second);
+static List createIntList(int count);
+static bool testListRemoveIf();
+static bool testListRemoveIfMany();
+static bool testListFilter();
+static bool testListInsertLast();
+static bool testListSort();
+static bool testListSortMany();
+static bool testListSortTopK();
+static bool isListEqual(List list, const int* expected, int count);
+int RunListTest();
+
+//int main() {
+int RunListTest() {
+	RUN_TEST(testListRemoveIf);
+	RUN_TEST(testListRemoveIfMany);
+	RUN_TEST(testListFilter);
+	RUN_TEST(testListInsertLast);
+	RUN_TEST(testListSort);
+	RUN_TEST(testListSortMany);
+	RUN_TEST(testListSortTopK);
+	return 0;
+}
+
+/* copies an int element */
+static ListElement copyInt(ListElement element) {
+	int* copy = malloc(sizeof(*copy));
+	if (copy != NULL) *copy = *(int*)element;
+	return copy;
+}
+
+/* frees an int element */
+static void freeInt(ListElement element) {
+	free(element);
+}
+
+/* checks if an int element is divisible by the int key */
+static bool isDivisibleBy(ListElement element, ListFilterKey key) {
+	return (*(int*)element % *(int*)key) == 0;
+}
+
+/* compares int elements by their tens only */
+static int compareTens(ListElement first, ListElement second) {
+	return *(int*)first / 10 - *(int*)second / 10;
+}
+
+/* checks if the elements of a list of ints are the expected ints */
+static bool isListEqual(List list, const int* expected, int count) {
+	if (listGetSize(list) != count) return false;
+	int i = 0;
+	LIST_FOREACH(int*, element, list) {
+		if (*element != expected[i++]) return false;
+	}
+	return true;
+}
+
+/* creates a list of the ints from 0 to count - 1 */
+static List createIntList(int count) {
+	List list = listCreate(copyInt, freeInt);
+	for (int i = count - 1; i >= 0; i--) {
+		listInsertFirst(list, &i);
+	}
+	return list;
+}
+
+/**
+ * Test remove if method
+ */
+static bool testListRemoveIf() {
+	int key = 2;
+	ASSERT_TEST(listRemoveIf(NULL, isDivisibleBy, &key) ==
+		LIST_NULL_ARGUMENT);
+	List list = createIntList(7);
+	ASSERT_TEST(listRemoveIf(list, NULL, &key) == LIST_NULL_ARGUMENT);
+	ASSERT_TEST(listRemoveIf(list, isDivisibleBy, &key) == LIST_SUCCESS);
+	ASSERT_TEST(listGetSize(list) == 3);
+	ASSERT_TEST(listGetCurrent(list) == NULL);
+	int expected = 1;
+	LIST_FOREACH(int*, element, list) {
+		ASSERT_TEST(*element == expected);
+		expected += 2;
+	}
+	key = 1;
+	ASSERT_TEST(listRemoveIf(list, isDivisibleBy, &key) == LIST_SUCCESS);
+	ASSERT_TEST(listGetSize(list) == 0);
+	ASSERT_TEST(listGetFirst(list) == NULL);
+	ASSERT_TEST(listRemoveIf(list, isDivisibleBy, &key) == LIST_SUCCESS);
+	int value = 5;
+	ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+	ASSERT_TEST(*(int*)listGetFirst(list) == 5);
+	listDestroy(list);
+	return true;
+}
+
+/**
+ * Test remove if method keeps the order of the remaining elements
+ */
+static bool testListRemoveIfMany() {
+	List list = createIntList(MANY_ELEMENTS);
+	int key = 3;
+	ASSERT_TEST(listRemoveIf(list, isDivisibleBy, &key) == LIST_SUCCESS);
+	ASSERT_TEST(listGetSize(list) == MANY_ELEMENTS - (MANY_ELEMENTS + 2) / 3);
+	int previous = -1;
+	LIST_FOREACH(int*, element, list) {
+		ASSERT_TEST((*element % 3 != 0) && (*element > previous));
+		previous = *element;
+	}
+	int value = MANY_ELEMENTS;
+	ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+	ASSERT_TEST(listGetSize(list) == MANY_ELEMENTS + 1 -
+		(MANY_ELEMENTS + 2) / 3);
+	listDestroy(list);
+	return true;
+}
+
+/**
+ * Test filter method
+ */
+static bool testListFilter() {
+	List list = createIntList(10);
+	int key = 3;
+	ASSERT_TEST(listFilter(list, NULL, &key) == NULL);
+	ASSERT_TEST(listFilter(NULL, isDivisibleBy, &key) == NULL);
+	List filtered = listFilter(list, isDivisibleBy, &key);
+	ASSERT_TEST(filtered != NULL);
+	ASSERT_TEST(listGetSize(filtered) == 4);
+	ASSERT_TEST(*(int*)listGetCurrent(filtered) == 0);
+	int expected = 0;
+	LIST_FOREACH(int*, element, filtered) {
+		ASSERT_TEST(*element == expected);
+		expected += 3;
+	}
+	ASSERT_TEST(listGetSize(list) == 10);
+	listDestroy(filtered);
+	listDestroy(list);
+	return true;
+}
+
+/**
+ * Test insert last after the methods which change the last element
+ */
+static bool testListInsertLast() {
+	List list = createIntList(2);
+	int value = 2;
+	listGetFirst(list);
+	listGetNext(list);
+	ASSERT_TEST(listInsertAfterCurrent(list, &value) == LIST_SUCCESS);
+	value = 3;
+	ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+	int after_insert[] = {0, 1, 2, 3};
+	ASSERT_TEST(isListEqual(list, after_insert, 4));
+
+	listGetFirst(list);
+	for (int i = 0; i < 3; i++) listGetNext(list);
+	ASSERT_TEST(listRemoveCurrent(list) == LIST_SUCCESS);
+	value = 4;
+	ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+	int after_remove[] = {0, 1, 2, 4};
+	ASSERT_TEST(isListEqual(list, after_remove, 4));
+
+	int key = 4;
+	ASSERT_TEST(listRemoveIf(list, isDivisibleBy, &key) == LIST_SUCCESS);
+	value = 5;
+	ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+	int after_remove_if[] = {1, 2, 5};
+	ASSERT_TEST(isListEqual(list, after_remove_if, 3));
+
+	listGetFirst(list);
+	listGetNext(list);
+	List copy = listCopy(list);
+	ASSERT_TEST(*(int*)listGetCurrent(copy) == 2);
+	value = 6;
+	ASSERT_TEST(listInsertLast(copy, &value) == LIST_SUCCESS);
+	int copied[] = {1, 2, 5, 6};
+	ASSERT_TEST(isListEqual(copy, copied, 4));
+
+	ASSERT_TEST(listClear(list) == LIST_SUCCESS);
+	ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+	ASSERT_TEST(isListEqual(list, &value, 1));
+	listDestroy(copy);
+	listDestroy(list);
+	return true;
+}
+
+/**
+ * Test sort method orders from the greatest and keeps equal elements in order
+ */
+static bool testListSort() {
+	List list = listCreate(copyInt, freeInt);
+	ASSERT_TEST(listSort(NULL, compareTens) == LIST_NULL_ARGUMENT);
+	ASSERT_TEST(listSort(list, NULL) == LIST_NULL_ARGUMENT);
+	ASSERT_TEST(listSort(list, compareTens) == LIST_SUCCESS);
+	ASSERT_TEST(listGetSize(list) == 0);
+	int values[] = {12, 5, 31, 17, 8, 33, 10, 39, 1};
+	for (int i = 0; i < 9; i++) {
+		listInsertLast(list, &values[i]);
+	}
+	ASSERT_TEST(listSort(list, compareTens) == LIST_SUCCESS);
+	int sorted[] = {31, 33, 39, 12, 17, 10, 5, 8, 1};
+	ASSERT_TEST(isListEqual(list, sorted, 9));
+	int value = 40;
+	ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+	ASSERT_TEST(listSort(list, compareTens) == LIST_SUCCESS);
+	ASSERT_TEST(*(int*)listGetFirst(list) == 40);
+	value = 0;
+	ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+	ASSERT_TEST(listGetSize(list) == 11);
+	listDestroy(list);
+	return true;
+}
+
+/**
+ * Test sort method over lists of many elements
+ */
+static bool testListSortMany() {
+	for (int count = 1; count <= MANY_ELEMENTS; count = count * 3 + 1) {
+		List list = listCreate(copyInt, freeInt);
+		for (int i = 0; i < count; i++) {
+			int value = (i * 7919) % count;
+			listInsertFirst(list, &value);
+		}
+		ASSERT_TEST(listSort(list, compareTens) == LIST_SUCCESS);
+		ASSERT_TEST(listGetSize(list) == count);
+		int* previous = NULL;
+		LIST_FOREACH(int*, element, list) {
+			ASSERT_TEST((previous == NULL) ||
+				(compareTens(previous, element) >= 0));
+			previous = element;
+		}
+		int value = -1;
+		ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+		ASSERT_TEST(listGetSize(list) == count + 1);
+		listDestroy(list);
+	}
+	return true;
+}
+
+/**
+ * Test sort top k method keeps the first k elements of the sorted list
+ */
+static bool testListSortTopK() {
+	List list = listCreate(copyInt, freeInt);
+	ASSERT_TEST(listSortTopK(NULL, compareTens, 1) == LIST_NULL_ARGUMENT);
+	ASSERT_TEST(listSortTopK(list, NULL, 1) == LIST_NULL_ARGUMENT);
+	int values[] = {12, 5, 31, 17, 8, 33, 10, 39, 1};
+	for (int i = 0; i < 9; i++) {
+		listInsertLast(list, &values[i]);
+	}
+	List copy = listCopy(list);
+	ASSERT_TEST(listSortTopK(list, compareTens, 5) == LIST_SUCCESS);
+	int sorted[] = {31, 33, 39, 12, 17};
+	ASSERT_TEST(isListEqual(list, sorted, 5));
+	int value = 20;
+	ASSERT_TEST(listInsertLast(list, &value) == LIST_SUCCESS);
+	ASSERT_TEST(listSortTopK(list, compareTens, 4) == LIST_SUCCESS);
+	int top[] = {31, 33, 39, 20};
+	ASSERT_TEST(isListEqual(list, top, 4));
+	ASSERT_TEST(listSortTopK(list, compareTens, 10) == LIST_SUCCESS);
+	ASSERT_TEST(isListEqual(list, top, 4));
+	ASSERT_TEST(listSortTopK(list, compareTens, 0) == LIST_SUCCESS);
+	ASSERT_TEST(listGetSize(list) == 0);
+
+	ASSERT_TEST(listSortTopK(copy, compareTens, 1) == LIST_SUCCESS);
+	ASSERT_TEST(isListEqual(copy, sorted, 1));
+	ASSERT_TEST(listInsertLast(copy, &value) == LIST_SUCCESS);
+	int appended[] = {31, 20};
+	ASSERT_TEST(isListEqual(copy, appended, 2));
+	listDestroy(copy);
+	listDestroy(list);
+	return true;
+}
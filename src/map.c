@@ -0,0 +1,674 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "map.h"
+
+#define NULL_MAP_SIZE -1
+#define NO_ITERATOR -1
+#define INITIAL_SLOTS 16
+#define INITIAL_ORDER 8
+
+typedef struct MapNode_t *MapNode;
+
+/*
+ * A pair of the map. position is the index of the node in the order of a
+ * hashed map.
+ */
+struct MapNode_t {
+	MapKeyElement key;
+	MapDataElement data;
+	unsigned int hash;
+	int position;
+};
+
+/*
+ * The nodes of the map are kept in order, an array of them by their keys,
+ * which the iterator walks.
+ *
+ * A map without a hash function keeps order sorted at all times, and finds
+ * keys by a binary search of it.
+ *
+ * A hashed map finds keys in slots, an open addressing table with linear
+ * probing, and keeps order sorted lazily: nodes are added at its end and
+ * removed nodes leave NULL holes, and order is sorted again only when it is
+ * iterated. the nodes of order below sorted are in order of their keys.
+ */
+struct Map_t {
+	copyMapDataElements copyData;
+	copyMapKeyElements copyKey;
+	freeMapDataElements freeData;
+	freeMapKeyElements freeKey;
+	compareMapKeyElements compare;
+	hashMapKeyElements hash;
+	int size;
+	MapNode* slots;
+	int slots_count;
+	MapNode* order;
+	MapNode* scratch;
+	int order_count;
+	int order_capacity;
+	int sorted;
+	int holes;
+	int iterator;
+};
+
+static Map createMap(copyMapDataElements copyDataElement,
+	copyMapKeyElements copyKeyElement, freeMapDataElements freeDataElement,
+	freeMapKeyElements freeKeyElement, compareMapKeyElements compareKeyElements,
+	hashMapKeyElements hashKeyElement);
+static MapNode findNode(Map map, constMapKeyElement key, int* index);
+static int searchOrder(Map map, constMapKeyElement key, bool* found);
+static int findSlot(Map map, constMapKeyElement key, unsigned int hash);
+static unsigned int hashKey(Map map, constMapKeyElement key);
+static MapResult putData(Map map, constMapKeyElement key,
+	MapDataElement data, bool take);
+static MapResult addNode(Map map, constMapKeyElement key, MapDataElement data,
+	bool take, int index);
+static bool growOrder(Map map);
+static bool growSlots(Map map);
+static void removeSlot(Map map, int slot);
+static void sortOrder(Map map);
+static void sortNodes(Map map, MapNode* nodes, MapNode* buffer, int count);
+static void mergeNodes(Map map, MapNode* first, int first_count,
+	MapNode* second, int second_count, MapNode* result);
+static void destroyNode(Map map, MapNode node);
+
+/**
+* mapCreate: Allocates a new empty map.
+*
+* @param copyDataElement - Function pointer to be used for copying data
+* 		elements into the map or when copying the map.
+* @param copyKeyElement - Function pointer to be used for copying key
+* 		elements into the map or when copying the map.
+* @param freeDataElement - Function pointer to be used for removing data
+* 		elements from the map
+* @param freeKeyElement - Function pointer to be used for removing key
+* 		elements from the map
+* @param compareKeyElements - Function pointer to be used for comparing key
+* 		elements inside the map. Used to check if new elements already exist
+* 		in the map.
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreate(copyMapDataElements copyDataElement,
+		copyMapKeyElements copyKeyElement,
+		freeMapDataElements freeDataElement,
+		freeMapKeyElements freeKeyElement,
+		compareMapKeyElements compareKeyElements) {
+	return createMap(copyDataElement, copyKeyElement, freeDataElement,
+		freeKeyElement, compareKeyElements, NULL);
+}
+
+/**
+* mapCreateHashed: Allocates a new empty map, which finds key elements by
+* their hash instead of by their order, in constant expected time. The map is
+* still iterated in the order of the compare function.
+*
+* @param copyDataElement - Function pointer to be used for copying data
+* 		elements into the map or when copying the map.
+* @param copyKeyElement - Function pointer to be used for copying key
+* 		elements into the map or when copying the map.
+* @param freeDataElement - Function pointer to be used for removing data
+* 		elements from the map
+* @param freeKeyElement - Function pointer to be used for removing key
+* 		elements from the map
+* @param compareKeyElements - Function pointer to be used for comparing key
+* 		elements inside the map.
+* @param hashKeyElement - Function pointer to be used for hashing key
+* 		elements.
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreateHashed(copyMapDataElements copyDataElement,
+		copyMapKeyElements copyKeyElement,
+		freeMapDataElements freeDataElement,
+		freeMapKeyElements freeKeyElement,
+		compareMapKeyElements compareKeyElements,
+		hashMapKeyElements hashKeyElement) {
+	if (hashKeyElement == NULL) return NULL;
+	return createMap(copyDataElement, copyKeyElement, freeDataElement,
+		freeKeyElement, compareKeyElements, hashKeyElement);
+}
+
+/**
+* mapDestroy: Deallocates an existing map. Clears all elements by using the
+* stored free functions.
+*
+* @param map - Target map to be deallocated. If map is NULL nothing will be
+* 		done
+*/
+void mapDestroy(Map map) {
+	if (map == NULL) return;
+	mapClear(map);
+	free(map->slots);
+	free(map->order);
+	free(map->scratch);
+	free(map);
+}
+
+/**
+* mapCopy: Creates a copy of target map.
+* Iterator values for both maps is undefined after this operation.
+*
+* @param map - Target map.
+* @return
+* 	NULL if a NULL was sent or a memory allocation failed.
+* 	A Map containing the same elements as map otherwise.
+*/
+Map mapCopy(Map map) {
+	if (map == NULL) return NULL;
+	Map copy = createMap(map->copyData, map->copyKey, map->freeData,
+		map->freeKey, map->compare, map->hash);
+	if (copy == NULL) return NULL;
+	sortOrder(map);
+	map->iterator = NO_ITERATOR;
+	for (int i = 0; i < map->order_count; i++) {
+		MapNode node = map->order[i];
+		if (mapPut(copy, node->key, node->data) != MAP_SUCCESS) {
+			mapDestroy(copy);
+			return NULL;
+		}
+	}
+	return copy;
+}
+
+/**
+* mapGetSize: Returns the number of elements in a map
+* @param map - The map which size is requested
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of elements in the map.
+*/
+int mapGetSize(Map map) {
+	return (map == NULL) ? NULL_MAP_SIZE : map->size;
+}
+
+/**
+* mapContains: Checks if a key element exists in the map. The key element will
+* be considered in the map if one of the key elements in the map it determined
+* equal using the comparison function used to initialize the map.
+*
+* @param map - The map to search in
+* @param element - The element to look for. Will be compared using the
+* 		comparison function.
+* @return
+* 	false - if one or more of the inputs is null, or if the key element was
+* 		not found.
+* 	true - if the key element was found in the map.
+*/
+bool mapContains(Map map, constMapKeyElement element) {
+	if ((map == NULL) || (element == NULL)) return false;
+	return findNode(map, element, NULL) != NULL;
+}
+
+/**
+*	mapPut: Gives a specified key a specific value.
+*  Iterator's value is undefined after this operation.
+*
+* @param map - The map for which to reassign the data element
+* @param keyElement - The key element which need to be reassigned
+* @param dataElement - The new data element to associate with the given key.
+*      A copy of the element will be inserted as supplied by the copying
+*      function which is given at initialization and old data memory would be
+*      deleted using the free function given at initialization.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map
+* 	MAP_OUT_OF_MEMORY if an allocation failed (Meaning the function for
+* 	copying an element failed)
+* 	MAP_SUCCESS the paired elements had been inserted successfully
+*/
+MapResult mapPut(Map map, constMapKeyElement keyElement,
+		constMapDataElement dataElement) {
+	return putData(map, keyElement, (MapDataElement)dataElement, false);
+}
+
+/**
+*	mapPutTake: Gives a specified key a specific value, without copying the
+*	value: the map takes the data element itself, and frees it with its free
+*	function. The key element is copied as in mapPut.
+*  Iterator's value is undefined after this operation.
+*
+* @param map - The map for which to reassign the data element
+* @param keyElement - The key element which need to be reassigned
+* @param dataElement - The new data element to associate with the given key.
+*      On failure it is not taken, and is left to the caller.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map, key or data
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS the paired elements had been inserted successfully
+*/
+MapResult mapPutTake(Map map, constMapKeyElement keyElement,
+		MapDataElement dataElement) {
+	return putData(map, keyElement, dataElement, true);
+}
+
+/**
+*	mapGet: Returns the data associated with a specific key in the map.
+*			Iterator status unchanged
+*
+* @param map - The map for which to get the data element from.
+* @param keyElement - The key element which need to be found and whos data
+we want to get.
+* @return
+*  NULL if a NULL pointer was sent or if the map does not contain the
+*  requested key.
+* 	The data element associated with the key otherwise.
+*/
+MapDataElement mapGet(Map map, constMapKeyElement keyElement) {
+	if ((map == NULL) || (keyElement == NULL)) return NULL;
+	MapNode node = findNode(map, keyElement, NULL);
+	return (node == NULL) ? NULL : node->data;
+}
+
+/**
+* 	mapRemove: Removes a pair of key and data elements from the map. The
+*  elements are found using the comparison function given at initialization.
+*  Once found, the elements are removed and deallocated using the free
+*  functions supplied at initialization.
+*  Iterator's value is undefined after this operation.
+*
+* @param map -
+* 	The map to remove the elements from.
+* @param keyElement
+* 	The key element to find and remove from the map. The element will be
+* 	freed using the free function given at initialization. The data element
+* 	associated with this key will also be freed using the free function given
+* 	at initialization.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent to the function
+*  MAP_ITEM_DOES_NOT_EXIST if an equal key item does not already exists in
+*  the map
+* 	MAP_SUCCESS the paired elements had been removed successfully
+*/
+MapResult mapRemove(Map map, constMapKeyElement keyElement) {
+	if ((map == NULL) || (keyElement == NULL)) return MAP_NULL_ARGUMENT;
+	int index = 0;
+	MapNode node = findNode(map, keyElement, &index);
+	if (node == NULL) return MAP_ITEM_DOES_NOT_EXIST;
+	map->iterator = NO_ITERATOR;
+	if (map->hash == NULL) {
+		memmove(map->order + index, map->order + index + 1,
+			(map->order_count - index - 1) * sizeof(MapNode));
+		map->order_count--;
+		map->sorted--;
+	} else {
+		removeSlot(map, index);
+		map->order[node->position] = NULL;
+		map->holes++;
+	}
+	map->size--;
+	destroyNode(map, node);
+	if (map->holes > map->size) sortOrder(map);
+	return MAP_SUCCESS;
+}
+
+/**
+*	mapGetFirst: Sets the internal iterator (also called current key element)
+*	to the first key element in the map, the smallest by the compare
+*	function. Use this to start iterating over the map.
+*	To continue iteration use mapGetNext
+*
+* @param map - The map for which to set the iterator and return the first
+* 		key element.
+* @return
+* 	NULL if a NULL pointer was sent or the map is empty.
+* 	The first key element of the map otherwise
+*/
+MapKeyElement mapGetFirst(Map map) {
+	if (map == NULL) return NULL;
+	map->iterator = NO_ITERATOR;
+	if (map->size == 0) return NULL;
+	sortOrder(map);
+	map->iterator = 0;
+	return map->order[0]->key;
+}
+
+/**
+*	mapGetNext: Advances the map iterator to the next key element, in the
+*	order of the compare function, and returns it.
+* @param map - The map for which to advance the iterator
+* @return
+* 	NULL if reached the end of the map, or the iterator is at an invalid state
+* 	or a NULL sent as argument
+* 	The next key element on the map in case of success
+*/
+MapKeyElement mapGetNext(Map map) {
+	if ((map == NULL) || (map->iterator == NO_ITERATOR)) return NULL;
+	map->iterator++;
+	if (map->iterator >= map->order_count) {
+		map->iterator = NO_ITERATOR;
+		return NULL;
+	}
+	return map->order[map->iterator]->key;
+}
+
+/**
+* mapClear: Removes all key and data elements from target map.
+* The elements are deallocated using the stored free functions.
+* @param map
+* 	Target map to remove all element from.
+* @return
+* 	MAP_NULL_ARGUMENT - if a NULL pointer was sent.
+* 	MAP_SUCCESS - Otherwise.
+*/
+MapResult mapClear(Map map) {
+	if (map == NULL) return MAP_NULL_ARGUMENT;
+	for (int i = 0; i < map->order_count; i++) {
+		if (map->order[i] != NULL) destroyNode(map, map->order[i]);
+	}
+	if (map->slots != NULL) {
+		memset(map->slots, 0, map->slots_count * sizeof(MapNode));
+	}
+	map->size = 0;
+	map->order_count = 0;
+	map->sorted = 0;
+	map->holes = 0;
+	map->iterator = NO_ITERATOR;
+	return MAP_SUCCESS;
+}
+
+/*
+ * createMap: allocates a new empty map, hashed if hashKeyElement is not
+ * NULL.
+ */
+static Map createMap(copyMapDataElements copyDataElement,
+		copyMapKeyElements copyKeyElement,
+		freeMapDataElements freeDataElement,
+		freeMapKeyElements freeKeyElement,
+		compareMapKeyElements compareKeyElements,
+		hashMapKeyElements hashKeyElement) {
+	if ((copyDataElement == NULL) || (copyKeyElement == NULL) ||
+		(freeDataElement == NULL) || (freeKeyElement == NULL) ||
+		(compareKeyElements == NULL)) return NULL;
+	Map map = malloc(sizeof(*map));
+	if (map == NULL) return NULL;
+	map->copyData = copyDataElement;
+	map->copyKey = copyKeyElement;
+	map->freeData = freeDataElement;
+	map->freeKey = freeKeyElement;
+	map->compare = compareKeyElements;
+	map->hash = hashKeyElement;
+	map->size = 0;
+	map->slots = NULL;
+	map->slots_count = 0;
+	map->order = NULL;
+	map->scratch = NULL;
+	map->order_count = 0;
+	map->order_capacity = 0;
+	map->sorted = 0;
+	map->holes = 0;
+	map->iterator = NO_ITERATOR;
+	return map;
+}
+
+/*
+ * putData: gives a key a value, a copy of data or data itself if take is
+ * true.
+ */
+static MapResult putData(Map map, constMapKeyElement key,
+		MapDataElement data, bool take) {
+	if ((map == NULL) || (key == NULL) || (data == NULL))
+		return MAP_NULL_ARGUMENT;
+	int index = 0;
+	MapNode node = findNode(map, key, &index);
+	if (node == NULL) return addNode(map, key, data, take, index);
+	MapDataElement new_data = take ? data : map->copyData(data);
+	if (new_data == NULL) return MAP_OUT_OF_MEMORY;
+	map->freeData(node->data);
+	node->data = new_data;
+	return MAP_SUCCESS;
+}
+
+/*
+ * findNode: returns the node of a key, or NULL if the key is not in the
+ * map. if index is not NULL, saves in it the slot of the node in a hashed
+ * map, or its index in order in a map without a hash function. if the key
+ * is not in the map, saves the slot or index to add it at.
+ */
+static MapNode findNode(Map map, constMapKeyElement key, int* index) {
+	int found_index = 0;
+	MapNode node = NULL;
+	if (map->hash == NULL) {
+		bool found = false;
+		found_index = searchOrder(map, key, &found);
+		if (found) node = map->order[found_index];
+	} else if (map->slots != NULL) {
+		found_index = findSlot(map, key, hashKey(map, key));
+		node = map->slots[found_index];
+	}
+	if (index != NULL) *index = found_index;
+	return node;
+}
+
+/*
+ * searchOrder: binary searches the sorted order of a map without a hash
+ * function for a key. returns the index of the key, or the index to add it
+ * at if it is not in the map.
+ */
+static int searchOrder(Map map, constMapKeyElement key, bool* found) {
+	int low = 0, high = map->order_count;
+	while (low < high) {
+		int middle = low + (high - low) / 2;
+		int compared = map->compare(map->order[middle]->key, key);
+		if (compared == 0) {
+			*found = true;
+			return middle;
+		}
+		if (compared < 0) low = middle + 1;
+		else high = middle;
+	}
+	*found = false;
+	return low;
+}
+
+/*
+ * findSlot: returns the slot of a key in a hashed map, or the empty slot
+ * its probe ends at if it is not in the map.
+ */
+static int findSlot(Map map, constMapKeyElement key, unsigned int hash) {
+	unsigned int mask = map->slots_count - 1;
+	unsigned int slot = hash & mask;
+	MapNode node = map->slots[slot];
+	while ((node != NULL) && ((node->hash != hash) ||
+		(map->compare(node->key, key) != 0))) {
+		slot = (slot + 1) & mask;
+		node = map->slots[slot];
+	}
+	return (int)slot;
+}
+
+/*
+ * hashKey: hashes a key by the hash function of the map, and mixes the
+ * result so that keys with close hashes, such as ids, spread over the
+ * slots.
+ */
+static unsigned int hashKey(Map map, constMapKeyElement key) {
+	unsigned int hash = map->hash(key);
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bU;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35U;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+/*
+ * addNode: adds a new pair to the map, at the index or slot findNode
+ * returned for its key. the data is copied unless take is true.
+ */
+static MapResult addNode(Map map, constMapKeyElement key, MapDataElement data,
+		bool take, int index) {
+	if ((map->order_count == map->order_capacity) && !growOrder(map))
+		return MAP_OUT_OF_MEMORY;
+	unsigned int hash = (map->hash == NULL) ? 0 : hashKey(map, key);
+	if ((map->hash != NULL) && ((map->size + 1) * 2 > map->slots_count)) {
+		if (!growSlots(map)) return MAP_OUT_OF_MEMORY;
+		index = findSlot(map, key, hash);
+	}
+	MapNode node = malloc(sizeof(*node));
+	if (node == NULL) return MAP_OUT_OF_MEMORY;
+	node->key = map->copyKey(key);
+	node->data = ((node->key == NULL) || take) ? data : map->copyData(data);
+	if ((node->key == NULL) || (node->data == NULL)) {
+		if (node->key != NULL) map->freeKey(node->key);
+		free(node);
+		return MAP_OUT_OF_MEMORY;
+	}
+	map->iterator = NO_ITERATOR;
+	if (map->hash == NULL) {
+		memmove(map->order + index + 1, map->order + index,
+			(map->order_count - index) * sizeof(MapNode));
+		map->order[index] = node;
+		map->sorted++;
+	} else {
+		node->hash = hash;
+		node->position = map->order_count;
+		map->slots[index] = node;
+		map->order[map->order_count] = node;
+		MapNode last = (map->sorted == 0) ? NULL :
+			map->order[map->sorted - 1];
+		if ((map->sorted == map->order_count) && ((map->sorted == 0) ||
+			((last != NULL) && (map->compare(last->key, key) < 0))))
+			map->sorted++;
+	}
+	map->order_count++;
+	map->size++;
+	return MAP_SUCCESS;
+}
+
+/*
+ * growOrder: doubles the capacity of order and of the scratch array it is
+ * sorted with.
+ */
+static bool growOrder(Map map) {
+	int capacity = (map->order_capacity == 0) ? INITIAL_ORDER :
+		map->order_capacity * 2;
+	MapNode* order = realloc(map->order, capacity * sizeof(MapNode));
+	if (order == NULL) return false;
+	map->order = order;
+	if (map->hash != NULL) {
+		MapNode* scratch = realloc(map->scratch, capacity * sizeof(MapNode));
+		if (scratch == NULL) return false;
+		map->scratch = scratch;
+	}
+	map->order_capacity = capacity;
+	return true;
+}
+
+/*
+ * growSlots: doubles the slots of a hashed map, and moves the nodes to
+ * their new slots.
+ */
+static bool growSlots(Map map) {
+	int count = (map->slots_count == 0) ? INITIAL_SLOTS :
+		map->slots_count * 2;
+	MapNode* slots = calloc(count, sizeof(MapNode));
+	if (slots == NULL) return false;
+	unsigned int mask = count - 1;
+	for (int i = 0; i < map->slots_count; i++) {
+		MapNode node = map->slots[i];
+		if (node == NULL) continue;
+		unsigned int slot = node->hash & mask;
+		while (slots[slot] != NULL) slot = (slot + 1) & mask;
+		slots[slot] = node;
+	}
+	free(map->slots);
+	map->slots = slots;
+	map->slots_count = count;
+	return true;
+}
+
+/*
+ * removeSlot: empties a slot of a hashed map, and shifts back the nodes
+ * probed past it, so that no probe stops early at the emptied slot.
+ */
+static void removeSlot(Map map, int slot) {
+	unsigned int mask = map->slots_count - 1;
+	unsigned int empty = slot;
+	unsigned int current = slot;
+	while (true) {
+		current = (current + 1) & mask;
+		MapNode node = map->slots[current];
+		if (node == NULL) break;
+		unsigned int home = node->hash & mask;
+		/* the node may move to the empty slot if its home is not in the
+		 * cyclic range (empty, current] */
+		bool in_range = (empty <= current) ?
+			((home > empty) && (home <= current)) :
+			((home > empty) || (home <= current));
+		if (!in_range) {
+			map->slots[empty] = node;
+			empty = current;
+		}
+	}
+	map->slots[empty] = NULL;
+}
+
+/*
+ * sortOrder: sorts the order of a hashed map: drops the holes, sorts the
+ * nodes added since the last sort, and merges them into the sorted nodes.
+ */
+static void sortOrder(Map map) {
+	if ((map->sorted == map->order_count) && (map->holes == 0)) return;
+	int count = 0;
+	for (int i = 0; i < map->sorted; i++) {
+		if (map->order[i] != NULL) map->order[count++] = map->order[i];
+	}
+	int sorted = count;
+	for (int i = map->sorted; i < map->order_count; i++) {
+		if (map->order[i] != NULL) map->order[count++] = map->order[i];
+	}
+	sortNodes(map, map->order + sorted, map->scratch, count - sorted);
+	mergeNodes(map, map->order, sorted, map->order + sorted, count - sorted,
+		map->scratch);
+	MapNode* order = map->order;
+	map->order = map->scratch;
+	map->scratch = order;
+	for (int i = 0; i < count; i++) {
+		map->order[i]->position = i;
+	}
+	map->order_count = count;
+	map->sorted = count;
+	map->holes = 0;
+}
+
+/*
+ * sortNodes: merge sorts nodes by their keys, with a buffer of the same
+ * size.
+ */
+static void sortNodes(Map map, MapNode* nodes, MapNode* buffer, int count) {
+	if (count < 2) return;
+	int half = count / 2;
+	sortNodes(map, nodes, buffer, half);
+	sortNodes(map, nodes + half, buffer, count - half);
+	mergeNodes(map, nodes, half, nodes + half, count - half, buffer);
+	memcpy(nodes, buffer, count * sizeof(MapNode));
+}
+
+/*
+ * mergeNodes: merges two arrays of nodes sorted by their keys into result.
+ */
+static void mergeNodes(Map map, MapNode* first, int first_count,
+		MapNode* second, int second_count, MapNode* result) {
+	int i = 0, j = 0, k = 0;
+	while ((i < first_count) && (j < second_count)) {
+		if (map->compare(first[i]->key, second[j]->key) <= 0) {
+			result[k++] = first[i++];
+		} else {
+			result[k++] = second[j++];
+		}
+	}
+	while (i < first_count) result[k++] = first[i++];
+	while (j < second_count) result[k++] = second[j++];
+}
+
+/*
+ * destroyNode: frees a node and its elements.
+ */
+static void destroyNode(Map map, MapNode node) {
+	map->freeKey(node->key);
+	map->freeData(node->data);
+	free(node);
+}
@@ -20,6 +20,8 @@
 *
 * The following functions are available:
 *   mapCreate		- Creates a new empty map
+*   mapCreateHashed	- Creates a new empty map which finds keys by a hash
+*   				  function
 *   mapDestroy		- Deletes an existing map and frees all resources
 *   mapCopy		- Copies an existing map
 *   mapGetSize		- Returns the size of a given map
@@ -28,6 +30,8 @@
 *   mapPut		    - Gives a specific key a given value.
 *   				  If the key exists, the value is overridden.
 *   				  This resets the internal iterator.
+*   mapPutTake		- Gives a specific key a given value, which the map
+*   				  takes without copying it.
 *   mapGet  	    - Returns the data paired to a key which matches the given key.
 *					  Iterator status unchanged
 *   mapRemove		- Removes a pair of (key,data) elements for which the key
@@ -84,6 +88,12 @@ typedef void(*freeMapKeyElements)(MapKeyElement);
 */
 typedef int(*compareMapKeyElements)(constMapKeyElement, constMapKeyElement);
 
+/**
+* Type of function used by the map to hash key elements. Key elements which
+* are equal by the compare function must have the same hash.
+*/
+typedef unsigned int(*hashMapKeyElements)(constMapKeyElement);
+
 /**
 * mapCreate: Allocates a new empty map.
 *
@@ -105,6 +115,32 @@ Map mapCreate(copyMapDataElements copyDataElement, copyMapKeyElements copyKeyEle
 	freeMapDataElements freeDataElement, freeMapKeyElements freeKeyElement,
 	compareMapKeyElements compareKeyElements);
 
+/**
+* mapCreateHashed: Allocates a new empty map, which finds key elements by
+* their hash instead of by their order, in constant expected time. The map is
+* still iterated in the order of the compare function.
+*
+* @param copyDataElement - Function pointer to be used for copying data
+* 		elements into the map or when copying the map.
+* @param copyKeyElement - Function pointer to be used for copying key
+* 		elements into the map or when copying the map.
+* @param freeDataElement - Function pointer to be used for removing data
+* 		elements from the map
+* @param freeKeyElement - Function pointer to be used for removing key
+* 		elements from the map
+* @param compareKeyElements - Function pointer to be used for comparing key
+* 		elements inside the map.
+* @param hashKeyElement - Function pointer to be used for hashing key
+* 		elements.
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreateHashed(copyMapDataElements copyDataElement,
+	copyMapKeyElements copyKeyElement, freeMapDataElements freeDataElement,
+	freeMapKeyElements freeKeyElement, compareMapKeyElements compareKeyElements,
+	hashMapKeyElements hashKeyElement);
+
 /**
 * mapDestroy: Deallocates an existing map. Clears all elements by using the
 * stored free functions.
@@ -166,6 +202,24 @@ bool mapContains(Map map, constMapKeyElement element);
 */
 MapResult mapPut(Map map, constMapKeyElement keyElement, constMapDataElement dataElement);
 
+/**
+*	mapPutTake: Gives a specified key a specific value, without copying the
+*	value: the map takes the data element itself, and frees it with its free
+*	function. The key element is copied as in mapPut.
+*  Iterator's value is undefined after this operation.
+*
+* @param map - The map for which to reassign the data element
+* @param keyElement - The key element which need to be reassigned
+* @param dataElement - The new data element to associate with the given key.
+*      On failure it is not taken, and is left to the caller.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map, key or data
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS the paired elements had been inserted successfully
+*/
+MapResult mapPutTake(Map map, constMapKeyElement keyElement,
+	MapDataElement dataElement);
+
 /**
 *	mapGet: Returns the data associated with a specific key in the map.
 *			Iterator status unchanged
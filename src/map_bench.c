@@ -0,0 +1,191 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "map.h"
+#include "monotonicClock.h"
+
+#define BENCH_MIN_EXPONENT 3
+#define BENCH_DEFAULT_MAX_EXPONENT 6
+#define BENCH_MAX_EXPONENT 7
+#define BENCH_DEFAULT_ORDERED_MAX_KEYS 100000
+#define BENCH_SEED 88172645463325252ULL
+
+typedef enum {
+	BENCH_PUT,
+	BENCH_GET,
+	BENCH_MISS,
+	BENCH_ITERATE,
+	BENCH_REMOVE,
+	BENCH_OPERATIONS
+} BenchOperation;
+
+static const char* operation_names[BENCH_OPERATIONS] = {"put", "get",
+	"miss", "iterate", "remove"};
+
+static MapKeyElement copyInt(constMapKeyElement element);
+static void freeInt(MapKeyElement element);
+static int compareInts(constMapKeyElement first, constMapKeyElement second);
+#ifndef MAP_BENCH_LIBRARY
+static unsigned int hashInt(constMapKeyElement element);
+#endif
+static int* createKeys(int count);
+static bool runMap(Map map, int* keys, int count,
+	double nanoseconds[BENCH_OPERATIONS]);
+static void printRun(const char* name, int count, Map map, int* keys);
+int RunMapBench(int argc, char *argv[]);
+
+/*
+ * Measures the Map operations at 10^3 keys and up by powers of ten: adding
+ * the keys in random order, getting each, looking up as many missing keys,
+ * iterating over the map and removing the keys in random order. prints the
+ * nanoseconds per operation of each.
+ *
+ * arguments are the largest power of ten of keys, 6 by default and 7 at
+ * most, and the most keys a map without a hash function is measured with,
+ * as adding to it takes time linear in its size. built with
+ * MAP_BENCH_LIBRARY defined, the benchmark uses only the map.h functions of
+ * the library map, so it can be linked with Extern/libmtm.a instead of
+ * map.c to measure the library version.
+ */
+//int main(int argc, char *argv[]) {
+int RunMapBench(int argc, char *argv[]) {
+	int max_exponent = (argc > 1) ? atoi(argv[1]) :
+		BENCH_DEFAULT_MAX_EXPONENT;
+	int ordered_max = (argc > 2) ? atoi(argv[2]) :
+		BENCH_DEFAULT_ORDERED_MAX_KEYS;
+	if ((max_exponent < BENCH_MIN_EXPONENT) ||
+		(max_exponent > BENCH_MAX_EXPONENT) || (ordered_max < 0)) {
+		printf("usage: %s [max exponent, %d to %d] [ordered max keys]\n",
+			argv[0], BENCH_MIN_EXPONENT, BENCH_MAX_EXPONENT);
+		return 1;
+	}
+	printf("%-8s %10s", "map", "keys");
+	for (int i = 0; i < BENCH_OPERATIONS; i++) {
+		printf(" %9s", operation_names[i]);
+	}
+	printf("  (ns/op)\n");
+	int count = 1;
+	for (int i = 0; i < BENCH_MIN_EXPONENT; i++) count *= 10;
+	for (int exponent = BENCH_MIN_EXPONENT; exponent <= max_exponent;
+		exponent++, count *= 10) {
+		int* keys = createKeys(count);
+		if (keys == NULL) {
+			printf("out of memory at %d keys\n", count);
+			return 1;
+		}
+		if (count <= ordered_max) {
+			printRun("ordered", count, mapCreate(copyInt, copyInt, freeInt,
+				freeInt, compareInts), keys);
+		}
+#ifndef MAP_BENCH_LIBRARY
+		printRun("hashed", count, mapCreateHashed(copyInt, copyInt, freeInt,
+			freeInt, compareInts, hashInt), keys);
+#endif
+		free(keys);
+	}
+	return 0;
+}
+
+/* copies an int element */
+static MapKeyElement copyInt(constMapKeyElement element) {
+	int* copy = malloc(sizeof(*copy));
+	if (copy != NULL) *copy = *(const int*)element;
+	return copy;
+}
+
+/* frees an int element */
+static void freeInt(MapKeyElement element) {
+	free(element);
+}
+
+/* compares int elements */
+static int compareInts(constMapKeyElement first, constMapKeyElement second) {
+	int a = *(const int*)first, b = *(const int*)second;
+	return (a > b) - (a < b);
+}
+
+#ifndef MAP_BENCH_LIBRARY
+/* hashes an int element */
+static unsigned int hashInt(constMapKeyElement element) {
+	return (unsigned int)*(const int*)element;
+}
+#endif
+
+/*
+ * createKeys: returns the even numbers below twice count in a random order,
+ * the same on every run. the odd numbers are the missing keys.
+ */
+static int* createKeys(int count) {
+	int* keys = malloc(count * sizeof(*keys));
+	if (keys == NULL) return NULL;
+	for (int i = 0; i < count; i++) keys[i] = i * 2;
+	unsigned long long state = BENCH_SEED;
+	for (int i = count - 1; i > 0; i--) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		int j = (int)(state % (unsigned long long)(i + 1));
+		int key = keys[i];
+		keys[i] = keys[j];
+		keys[j] = key;
+	}
+	return keys;
+}
+
+/*
+ * runMap: runs the operations over a map, and saves the nanoseconds per
+ * operation of each. returns false if an operation failed.
+ */
+static bool runMap(Map map, int* keys, int count,
+		double nanoseconds[BENCH_OPERATIONS]) {
+	bool is_valid = true;
+	long long start = monotonicClockNow();
+	for (int i = 0; i < count; i++) {
+		if (mapPut(map, &keys[i], &i) != MAP_SUCCESS) is_valid = false;
+	}
+	long long put_end = monotonicClockNow();
+	for (int i = 0; i < count; i++) {
+		if (mapGet(map, &keys[i]) == NULL) is_valid = false;
+	}
+	long long get_end = monotonicClockNow();
+	for (int i = 0; i < count; i++) {
+		int missing = keys[i] + 1;
+		if (mapContains(map, &missing)) is_valid = false;
+	}
+	long long miss_end = monotonicClockNow();
+	int iterated = 0;
+	MAP_FOREACH(int*, key, map) {
+		iterated++;
+	}
+	if (iterated != count) is_valid = false;
+	long long iterate_end = monotonicClockNow();
+	for (int i = count - 1; i >= 0; i--) {
+		if (mapRemove(map, &keys[i]) != MAP_SUCCESS) is_valid = false;
+	}
+	long long remove_end = monotonicClockNow();
+	long long ends[BENCH_OPERATIONS] = {put_end, get_end, miss_end,
+		iterate_end, remove_end};
+	for (int i = 0; i < BENCH_OPERATIONS; i++) {
+		nanoseconds[i] = (double)(ends[i] - start) / count;
+		start = ends[i];
+	}
+	return is_valid;
+}
+
+/*
+ * printRun: runs the operations over a new map, prints the results and
+ * destroys the map.
+ */
+static void printRun(const char* name, int count, Map map, int* keys) {
+	double nanoseconds[BENCH_OPERATIONS];
+	printf("%-8s %10d", name, count);
+	if ((map == NULL) || !runMap(map, keys, count, nanoseconds)) {
+		printf(" failed\n");
+	} else {
+		for (int i = 0; i < BENCH_OPERATIONS; i++) {
+			printf(" %9.1f", nanoseconds[i]);
+		}
+		printf("\n");
+	}
+	mapDestroy(map);
+}
@@ -0,0 +1,326 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "map.h"
+#include "test_utilities.h"
+
+#define MANY_KEYS 5000
+
+static MapKeyElement copyInt(constMapKeyElement element);
+static void freeInt(MapKeyElement element);
+static int compareInts(constMapKeyElement first, constMapKeyElement second);
+static unsigned int hashInt(constMapKeyElement element);
+static unsigned int hashConstant(constMapKeyElement element);
+static Map createMap(bool hashed);
+static bool testMapCreate();
+static bool testMapPutGet(bool hashed);
+static bool testMapPutTake(bool hashed);
+static bool testMapRemove(bool hashed);
+static bool testMapOrder(bool hashed);
+static bool testMapGetDuringIteration(bool hashed);
+static bool testMapCopyClear(bool hashed);
+static bool testMapManyKeys(bool hashed);
+static bool testMapCollisions();
+static bool testMapOrdered();
+static bool testMapHashed();
+int RunMapTest();
+
+//int main() {
+int RunMapTest() {
+	RUN_TEST(testMapCreate);
+	RUN_TEST(testMapOrdered);
+	RUN_TEST(testMapHashed);
+	RUN_TEST(testMapCollisions);
+	return 0;
+}
+
+/* copies an int element */
+static MapKeyElement copyInt(constMapKeyElement element) {
+	int* copy = malloc(sizeof(*copy));
+	if (copy != NULL) *copy = *(const int*)element;
+	return copy;
+}
+
+/* frees an int element */
+static void freeInt(MapKeyElement element) {
+	free(element);
+}
+
+/* compares int elements */
+static int compareInts(constMapKeyElement first, constMapKeyElement second) {
+	int a = *(const int*)first, b = *(const int*)second;
+	return (a > b) - (a < b);
+}
+
+/* hashes an int element */
+static unsigned int hashInt(constMapKeyElement element) {
+	return (unsigned int)*(const int*)element;
+}
+
+/* hashes every element to the same value */
+static unsigned int hashConstant(constMapKeyElement element) {
+	(void)element;
+	return 7;
+}
+
+/* creates a map of ints to ints */
+static Map createMap(bool hashed) {
+	return hashed ? mapCreateHashed(copyInt, copyInt, freeInt, freeInt,
+		compareInts, hashInt) :
+		mapCreate(copyInt, copyInt, freeInt, freeInt, compareInts);
+}
+
+/**
+ * Test create methods
+ */
+static bool testMapCreate() {
+	ASSERT_TEST(mapCreate(NULL, copyInt, freeInt, freeInt, compareInts) ==
+		NULL);
+	ASSERT_TEST(mapCreateHashed(copyInt, copyInt, freeInt, freeInt,
+		compareInts, NULL) == NULL);
+	Map map = createMap(true);
+	ASSERT_TEST(map != NULL);
+	ASSERT_TEST(mapGetSize(map) == 0);
+	ASSERT_TEST(mapGetSize(NULL) == -1);
+	ASSERT_TEST(mapGetFirst(map) == NULL);
+	ASSERT_TEST(mapGetNext(map) == NULL);
+	ASSERT_TEST(mapClear(NULL) == MAP_NULL_ARGUMENT);
+	mapDestroy(map);
+	mapDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test the map without a hash function
+ */
+static bool testMapOrdered() {
+	ASSERT_TEST(testMapPutGet(false));
+	ASSERT_TEST(testMapPutTake(false));
+	ASSERT_TEST(testMapRemove(false));
+	ASSERT_TEST(testMapOrder(false));
+	ASSERT_TEST(testMapGetDuringIteration(false));
+	ASSERT_TEST(testMapCopyClear(false));
+	ASSERT_TEST(testMapManyKeys(false));
+	return true;
+}
+
+/**
+ * Test the hashed map
+ */
+static bool testMapHashed() {
+	ASSERT_TEST(testMapPutGet(true));
+	ASSERT_TEST(testMapPutTake(true));
+	ASSERT_TEST(testMapRemove(true));
+	ASSERT_TEST(testMapOrder(true));
+	ASSERT_TEST(testMapGetDuringIteration(true));
+	ASSERT_TEST(testMapCopyClear(true));
+	ASSERT_TEST(testMapManyKeys(true));
+	return true;
+}
+
+/**
+ * Test put, get and contains methods
+ */
+static bool testMapPutGet(bool hashed) {
+	Map map = createMap(hashed);
+	int key = 3, data = 30, other = 4;
+	ASSERT_TEST(mapPut(NULL, &key, &data) == MAP_NULL_ARGUMENT);
+	ASSERT_TEST(mapPut(map, NULL, &data) == MAP_NULL_ARGUMENT);
+	ASSERT_TEST(mapPut(map, &key, NULL) == MAP_NULL_ARGUMENT);
+	ASSERT_TEST(mapPut(map, &key, &data) == MAP_SUCCESS);
+	ASSERT_TEST(mapGetSize(map) == 1);
+	ASSERT_TEST(mapContains(map, &key));
+	ASSERT_TEST(!mapContains(map, &other));
+	ASSERT_TEST(!mapContains(map, NULL));
+	ASSERT_TEST(*(int*)mapGet(map, &key) == 30);
+	ASSERT_TEST(mapGet(map, &other) == NULL);
+	ASSERT_TEST(mapGet(NULL, &key) == NULL);
+
+	data = 31;
+	ASSERT_TEST(mapPut(map, &key, &data) == MAP_SUCCESS);
+	ASSERT_TEST(mapGetSize(map) == 1);
+	ASSERT_TEST(*(int*)mapGet(map, &key) == 31);
+	mapDestroy(map);
+	return true;
+}
+
+/**
+ * Test the map takes data put by mapPutTake without copying it
+ */
+static bool testMapPutTake(bool hashed) {
+	Map map = createMap(hashed);
+	int key = 3;
+	int* data = malloc(sizeof(*data));
+	*data = 30;
+	ASSERT_TEST(mapPutTake(map, &key, NULL) == MAP_NULL_ARGUMENT);
+	ASSERT_TEST(mapPutTake(NULL, &key, data) == MAP_NULL_ARGUMENT);
+	ASSERT_TEST(mapPutTake(map, &key, data) == MAP_SUCCESS);
+	ASSERT_TEST(mapGet(map, &key) == data);
+
+	int* replacement = malloc(sizeof(*replacement));
+	*replacement = 31;
+	ASSERT_TEST(mapPutTake(map, &key, replacement) == MAP_SUCCESS);
+	ASSERT_TEST(mapGet(map, &key) == replacement);
+	ASSERT_TEST(mapGetSize(map) == 1);
+	mapDestroy(map);
+	return true;
+}
+
+/**
+ * Test remove method
+ */
+static bool testMapRemove(bool hashed) {
+	Map map = createMap(hashed);
+	for (int i = 0; i < 10; i++) {
+		ASSERT_TEST(mapPut(map, &i, &i) == MAP_SUCCESS);
+	}
+	int key = 4, missing = 10;
+	ASSERT_TEST(mapRemove(NULL, &key) == MAP_NULL_ARGUMENT);
+	ASSERT_TEST(mapRemove(map, NULL) == MAP_NULL_ARGUMENT);
+	ASSERT_TEST(mapRemove(map, &missing) == MAP_ITEM_DOES_NOT_EXIST);
+	ASSERT_TEST(mapRemove(map, &key) == MAP_SUCCESS);
+	ASSERT_TEST(mapRemove(map, &key) == MAP_ITEM_DOES_NOT_EXIST);
+	ASSERT_TEST(mapGetSize(map) == 9);
+	ASSERT_TEST(!mapContains(map, &key));
+	for (int i = 0; i < 10; i++) {
+		if (i != 4) ASSERT_TEST(*(int*)mapGet(map, &i) == i);
+	}
+	int expected = 0;
+	MAP_FOREACH(int*, iterator, map) {
+		if (expected == 4) expected++;
+		ASSERT_TEST(*iterator == expected);
+		expected++;
+	}
+	ASSERT_TEST(expected == 10);
+	mapDestroy(map);
+	return true;
+}
+
+/**
+ * Test the map is iterated by the order of its keys
+ */
+static bool testMapOrder(bool hashed) {
+	Map map = createMap(hashed);
+	int keys[] = {50, 10, 40, 20, 30, 0, 60};
+	for (int i = 0; i < 7; i++) {
+		ASSERT_TEST(mapPut(map, &keys[i], &i) == MAP_SUCCESS);
+	}
+	int expected = 0;
+	MAP_FOREACH(int*, iterator, map) {
+		ASSERT_TEST(*iterator == expected);
+		expected += 10;
+	}
+	ASSERT_TEST(expected == 70);
+
+	int added = 25;
+	ASSERT_TEST(mapPut(map, &added, &added) == MAP_SUCCESS);
+	ASSERT_TEST(mapRemove(map, &keys[0]) == MAP_SUCCESS);
+	int sorted[] = {0, 10, 20, 25, 30, 40, 60};
+	int index = 0;
+	MAP_FOREACH(int*, iterator, map) {
+		ASSERT_TEST(*iterator == sorted[index]);
+		index++;
+	}
+	ASSERT_TEST(index == 7);
+	mapDestroy(map);
+	return true;
+}
+
+/**
+ * Test getting data while iterating keeps the iterator
+ */
+static bool testMapGetDuringIteration(bool hashed) {
+	Map map = createMap(hashed);
+	for (int i = 9; i >= 0; i--) {
+		int data = i * 2;
+		ASSERT_TEST(mapPut(map, &i, &data) == MAP_SUCCESS);
+	}
+	int count = 0;
+	MAP_FOREACH(int*, iterator, map) {
+		ASSERT_TEST(*(int*)mapGet(map, iterator) == *iterator * 2);
+		ASSERT_TEST(mapContains(map, iterator));
+		ASSERT_TEST(*iterator == count);
+		count++;
+	}
+	ASSERT_TEST(count == 10);
+	mapDestroy(map);
+	return true;
+}
+
+/**
+ * Test copy and clear methods
+ */
+static bool testMapCopyClear(bool hashed) {
+	Map map = createMap(hashed);
+	for (int i = 20; i > 0; i--) {
+		ASSERT_TEST(mapPut(map, &i, &i) == MAP_SUCCESS);
+	}
+	Map copy = mapCopy(map);
+	ASSERT_TEST(copy != NULL);
+	ASSERT_TEST(mapCopy(NULL) == NULL);
+	ASSERT_TEST(mapClear(map) == MAP_SUCCESS);
+	ASSERT_TEST(mapGetSize(map) == 0);
+	ASSERT_TEST(mapGetFirst(map) == NULL);
+	ASSERT_TEST(mapGetSize(copy) == 20);
+	int expected = 1;
+	MAP_FOREACH(int*, iterator, copy) {
+		ASSERT_TEST(*iterator == expected);
+		ASSERT_TEST(*(int*)mapGet(copy, iterator) == expected);
+		expected++;
+	}
+	int key = 5;
+	ASSERT_TEST(mapPut(map, &key, &key) == MAP_SUCCESS);
+	ASSERT_TEST(mapGetSize(map) == 1);
+	mapDestroy(map);
+	mapDestroy(copy);
+	return true;
+}
+
+/**
+ * Test a map through growing and removing many keys
+ */
+static bool testMapManyKeys(bool hashed) {
+	Map map = createMap(hashed);
+	for (int i = 0; i < MANY_KEYS; i++) {
+		int key = (i * 7919) % MANY_KEYS;
+		ASSERT_TEST(mapPut(map, &key, &i) == MAP_SUCCESS);
+	}
+	ASSERT_TEST(mapGetSize(map) == MANY_KEYS);
+	for (int key = 0; key < MANY_KEYS; key += 2) {
+		ASSERT_TEST(mapRemove(map, &key) == MAP_SUCCESS);
+	}
+	ASSERT_TEST(mapGetSize(map) == MANY_KEYS / 2);
+	for (int key = 0; key < MANY_KEYS; key++) {
+		ASSERT_TEST(mapContains(map, &key) == (key % 2 == 1));
+	}
+	int expected = 1;
+	MAP_FOREACH(int*, iterator, map) {
+		ASSERT_TEST(*iterator == expected);
+		expected += 2;
+	}
+	ASSERT_TEST(expected == MANY_KEYS + 1);
+	mapDestroy(map);
+	return true;
+}
+
+/**
+ * Test a hashed map where all the keys collide
+ */
+static bool testMapCollisions() {
+	Map map = mapCreateHashed(copyInt, copyInt, freeInt, freeInt,
+		compareInts, hashConstant);
+	for (int i = 0; i < 100; i++) {
+		ASSERT_TEST(mapPut(map, &i, &i) == MAP_SUCCESS);
+	}
+	for (int key = 0; key < 100; key += 3) {
+		ASSERT_TEST(mapRemove(map, &key) == MAP_SUCCESS);
+	}
+	for (int key = 0; key < 100; key++) {
+		void* data = mapGet(map, &key);
+		ASSERT_TEST((key % 3 == 0) ? (data == NULL) :
+			((data != NULL) && (*(int*)data == key)));
+	}
+	mapDestroy(map);
+	return true;
+}
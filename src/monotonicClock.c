@@ -0,0 +1,38 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "monotonicClock.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/**
+* monotonicClockNow: returns the time of a clock which never goes back, in
+* nanoseconds from an unspecified start.
+*
+* @return
+* 	the current time in nanoseconds.
+*/
+#ifdef _WIN32
+long long monotonicClockNow() {
+	static LARGE_INTEGER frequency;
+	if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	long long seconds = counter.QuadPart / frequency.QuadPart;
+	long long rest = counter.QuadPart % frequency.QuadPart;
+	return seconds * MONOTONIC_CLOCK_TICKS_PER_SECOND +
+		rest * MONOTONIC_CLOCK_TICKS_PER_SECOND / frequency.QuadPart;
+}
+#else
+long long monotonicClockNow() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * MONOTONIC_CLOCK_TICKS_PER_SECOND +
+		now.tv_nsec;
+}
+#endif
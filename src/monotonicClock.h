@@ -0,0 +1,17 @@
+#ifndef SRC_MONOTONICCLOCK_H_
+#define SRC_MONOTONICCLOCK_H_
+
+/** The amount of clock ticks in a second */
+#define MONOTONIC_CLOCK_TICKS_PER_SECOND 1000000000LL
+
+/**
+* monotonicClockNow: returns the time of a clock which never goes back, in
+* nanoseconds from an unspecified start. only differences between two
+* times are meaningful.
+*
+* @return
+* 	the current time in nanoseconds.
+*/
+long long monotonicClockNow();
+
+#endif /* SRC_MONOTONICCLOCK_H_ */
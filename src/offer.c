@@ -12,6 +12,7 @@ struct offer_t {
 	int apartment_id;
 	char* service_name;
 	int price;
+	SlabAllocator allocator;
 };
 
 /**
@@ -35,27 +36,55 @@ struct offer_t {
 */
 OfferResult offerCreate(Email client, Email agent, char* service_name,
 						int apartment_id, int price, Offer* result) {
+	return offerCreateWithAllocator(NULL, client, agent, service_name,
+		apartment_id, price, result);
+}
+
+/**
+* Allocates a new apartment perches offer from an allocator.
+*
+* Creates a new offer like offerCreate, with the offer and its service name
+* in blocks of the given allocator. The offer and its copies are freed back
+* to the allocator when destroyed.
+*
+* @param allocator the allocator, or NULL to allocate with malloc.
+*
+* @return
+*
+* 	OFFER_NULL_PARAMETERS - if emails or service_name or result are NULL.
+*
+* 	OFFER_INVALID_PARAMETERS - apartment_id or price are not positive.
+*
+* 	OFFER_OUT_OF_MEMORY - if allocations failed.
+*
+* 	OFFER_SUCCESS - in case of success.  A new offer is saved in the result.
+*/
+OfferResult offerCreateWithAllocator(SlabAllocator allocator, Email client,
+		Email agent, char* service_name, int apartment_id, int price,
+		Offer* result) {
 	if (client == NULL || agent == NULL || service_name == NULL ||
 			result == NULL) return OFFER_NULL_PARAMETERS;
 	if ((price <= 0) || (apartment_id <= 0)) return OFFER_INVALID_PARAMETERS;
-	Offer offer = malloc(sizeof(*offer));
+	Offer offer = slabAllocatorAllocate(allocator, SLAB_OFFER, sizeof(*offer));
 	if (offer == NULL) return OFFER_OUT_OF_MEMORY;
+	offer->allocator = allocator;
 	offer->apartment_id = apartment_id;
 	offer->price = price;
 	if (emailCopy(client, &offer->client) != EMAIL_SUCCESS) {
-		free(offer);
+		slabAllocatorFree(allocator, SLAB_OFFER, offer, sizeof(*offer));
 		return OFFER_OUT_OF_MEMORY;
 	}
 	if (emailCopy(agent, &offer->agent) != EMAIL_SUCCESS) {
 		emailDestroy(offer->client);
-		free(offer);
+		slabAllocatorFree(allocator, SLAB_OFFER, offer, sizeof(*offer));
 		return OFFER_OUT_OF_MEMORY;
 	}
-	offer->service_name = duplicateString(service_name);
+	offer->service_name = slabAllocatorDuplicateString(allocator,
+		service_name);
 	if (offer->service_name == NULL) {
 		emailDestroy(offer->agent);
 		emailDestroy(offer->client);
-		free(offer);
+		slabAllocatorFree(allocator, SLAB_OFFER, offer, sizeof(*offer));
 		return OFFER_OUT_OF_MEMORY;
 	}
 	*result = offer;
@@ -74,8 +103,8 @@ void offerDestroy(Offer offer) {
 	if (offer != NULL) {
 		emailDestroy(offer->agent);
 		emailDestroy(offer->client);
-		free(offer->service_name);
-		free(offer);
+		slabAllocatorFreeString(offer->allocator, offer->service_name);
+		slabAllocatorFree(offer->allocator, SLAB_OFFER, offer, sizeof(*offer));
 	}
 }
 
@@ -173,7 +202,8 @@ int offerGetApartmentId(Offer offer) {
 */
 OfferResult offerCopy(Offer offer, Offer* result) {
 	if ((offer == NULL) || (result == NULL)) return OFFER_NULL_PARAMETERS;
-	return offerCreate(offer->client, offer->agent, offer->service_name,
+	return offerCreateWithAllocator(offer->allocator, offer->client,
+			offer->agent, offer->service_name,
 			offer->apartment_id, offer->price, result);
 }
 
@@ -2,6 +2,7 @@
 #define SRC_OFFER_H_
 
 #include "email.h"
+#include "slabAllocator.h"
 
 #define NO_OFFER_VAL -1
 
@@ -39,6 +40,29 @@ typedef enum {
 OfferResult offerCreate(Email client, Email agent, char* service_name,
 						int apartment_id, int price, Offer* result);
 
+/**
+* Allocates a new apartment perches offer from an allocator.
+*
+* Creates a new offer like offerCreate, with the offer and its service name
+* in blocks of the given allocator. The offer and its copies are freed back
+* to the allocator when destroyed.
+*
+* @param allocator the allocator, or NULL to allocate with malloc.
+*
+* @return
+*
+* 	OFFER_NULL_PARAMETERS - if emails or service_name or result are NULL.
+*
+* 	OFFER_INVALID_PARAMETERS - apartment_id or price are not positive.
+*
+* 	OFFER_OUT_OF_MEMORY - if allocations failed.
+*
+* 	OFFER_SUCCESS - in case of success.  A new offer is saved in the result.
+*/
+OfferResult offerCreateWithAllocator(SlabAllocator allocator, Email client,
+		Email agent, char* service_name, int apartment_id, int price,
+		Offer* result);
+
 /**
 * offerDestroy: Deallocates an existing offer.
 * Clears the offer by using the stored free function.
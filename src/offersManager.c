@@ -1,40 +1,96 @@
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "email.h"
 #include "offersManager.h"
 #include "offer.h"
-#include "list.h"
 #include "utilities.h"
 
+#define INITIAL_BUCKETS_COUNT 64
+#define BUCKETS_GROWTH_FACTOR 2
+#define HASH_COMBINE_CONSTANT 0x9e3779b9u
+
+#define KEY_CLIENT 1
+#define KEY_AGENT 2
+#define KEY_SERVICE 4
+#define KEY_APARTMENT 8
+#define KEY_ALL (KEY_CLIENT | KEY_AGENT | KEY_SERVICE | KEY_APARTMENT)
+
+/*
+ * The offers are kept in the order they were added, and every offer is also
+ * linked into a hash index on each of the keys the offers are looked up and
+ * removed by. each index is a chained hash table whose chains keep the
+ * order the offers were added in, so the first match in a chain is the
+ * oldest offer that matches.
+ */
+typedef enum {
+	INDEX_CLIENT = 0,
+	INDEX_AGENT = 1,
+	INDEX_CLIENT_AGENT = 2,
+	INDEX_SERVICE = 3,
+	INDEX_APARTMENT = 4,
+	INDEXES_COUNT = 5
+} OfferIndex;
+
+/* the fields of the offers each index is on */
+static const int index_keys[INDEXES_COUNT] = {KEY_CLIENT, KEY_AGENT,
+	KEY_CLIENT | KEY_AGENT, KEY_AGENT | KEY_SERVICE,
+	KEY_AGENT | KEY_SERVICE | KEY_APARTMENT};
+
+/*
+ * The fields an offer is looked up by. only the fields of the index, or of
+ * the keys mask, that is searched are used.
+ */
+typedef struct {
+	Email client;
+	Email agent;
+	const char* service_name;
+	int apartment_id;
+} OfferKey;
+
+typedef struct offerEntry_t *OfferEntry;
+
+struct offerEntry_t {
+	Offer offer;
+	OfferEntry order_previous;
+	OfferEntry order_next;
+	unsigned int hashes[INDEXES_COUNT];
+	OfferEntry previous[INDEXES_COUNT];
+	OfferEntry next[INDEXES_COUNT];
+};
+
+typedef struct {
+	OfferEntry first;
+	OfferEntry last;
+} OfferBucket;
+
 struct offerManager_t {
-	List offers;
+	OfferEntry first;
+	OfferEntry last;
+	int size;
+	OfferBucket* buckets[INDEXES_COUNT];
+	int buckets_count;
+	SlabAllocator allocator;
 };
 
-/**
-* This type defines end codes for the compare methods.
-*/
-typedef enum {
-	COMPARE_OUT_OF_MEMORY = 0,
-	COMPARE_FIT = 1,
-	COMPARE_UNFIT = 2
-} CompareResult;
-
-typedef void* checkOfferParam;
-typedef CompareResult (*checkOffer)(Offer offer, checkOfferParam param);
-
-static OfferManagerResult filteredRemoveOffers(OffersManager manager,
-	checkOffer function, checkOfferParam param);
-static CompareResult isEmailConnectedToOffer(Offer offer,
-	checkOfferParam parameter);
-static CompareResult isServiceConnectedToOffer(Offer offer,
-	checkOfferParam parameter);
-static CompareResult isApartmentConnectedToOffer(Offer offer,
-	checkOfferParam parameter);
-static void FreeOfferListElement(ListElement element);
-static ListElement CopyOfferListElement(ListElement);
 static OfferManagerResult convertOfferResult(OfferResult value);
-static CompareResult isOfferBetweenAgentAndClient(Offer offer,
-		checkOfferParam parameter);
+static SnapshotResult loadOffer(OffersManager manager,
+		SnapshotReader reader);
+static OfferKey offerKeyOf(Offer offer);
+static unsigned int combineHash(unsigned int hash, unsigned int value);
+static unsigned int hashOfferKey(const OfferKey* key, OfferIndex index);
+static bool offerMatches(Offer offer, const OfferKey* key, int keys);
+static OfferBucket* bucketOf(OffersManager manager, OfferIndex index,
+		unsigned int hash);
+static OfferEntry findOffer(OffersManager manager, const OfferKey* key,
+		OfferIndex index, int keys);
+static void removeOffers(OffersManager manager, const OfferKey* key,
+		OfferIndex index);
+static void linkToBucket(OfferBucket* bucket, OfferEntry entry,
+		OfferIndex index);
+static void linkEntry(OffersManager manager, OfferEntry entry);
+static void unlinkEntry(OffersManager manager, OfferEntry entry);
+static bool growBuckets(OffersManager manager);
 
 /**
 * Allocates a new OfferManager.
@@ -44,31 +100,24 @@ static CompareResult isOfferBetweenAgentAndClient(Offer offer,
 * 	A new offer manager in case of success.
 */
 OffersManager offersManagerCreate() {
-	List list = listCreate(CopyOfferListElement, FreeOfferListElement);
-	if (list == NULL) return NULL;
 	OffersManager manager = malloc (sizeof(*manager));
-	if (manager == NULL) {
-		free(list);
-		return NULL;
-	} else {
-		manager->offers = list;
-		return manager;
+	if (manager == NULL) return NULL;
+	manager->first = NULL;
+	manager->last = NULL;
+	manager->size = 0;
+	manager->buckets_count = INITIAL_BUCKETS_COUNT;
+	manager->allocator = NULL;
+	bool allocated = true;
+	for (int i = 0; i < INDEXES_COUNT; i++) {
+		manager->buckets[i] = calloc(INITIAL_BUCKETS_COUNT,
+			sizeof(OfferBucket));
+		allocated = allocated && (manager->buckets[i] != NULL);
 	}
-}
-
-/** Function to be used for coping offer data elements from the list */
-static ListElement CopyOfferListElement(ListElement element) {
-	if (element == NULL) return NULL;
-	Offer new_offer = NULL;
-	offerCopy((Offer)element, &new_offer);
-	return new_offer;
-}
-
-/** Function to be used for freeing offer data elements from the list */
-static void FreeOfferListElement(ListElement element) {
-	if (element != NULL) {
-		offerDestroy((Offer)element);
+	if (!allocated) {
+		offersManagerDestroy(manager);
+		return NULL;
 	}
+	return manager;
 }
 
 /**
@@ -80,13 +129,33 @@ static void FreeOfferListElement(ListElement element) {
 */
 void offersManagerDestroy(OffersManager manager) {
 	if (manager != NULL) {
-		if (manager->offers != NULL) {
-			listDestroy(manager->offers);
+		OfferEntry entry = manager->first;
+		while (entry != NULL) {
+			OfferEntry next = entry->order_next;
+			offerDestroy(entry->offer);
+			free(entry);
+			entry = next;
+		}
+		for (int i = 0; i < INDEXES_COUNT; i++) {
+			free(manager->buckets[i]);
 		}
 		free(manager);
 	}
 }
 
+/**
+* offersManagerSetAllocator: sets the allocator the manager creates its
+* offers from. it is set while the manager is empty.
+*
+* @param manager Target offers manager.
+* @param allocator the allocator, or NULL to use malloc. it must outlive the
+* 	manager.
+*/
+void offersManagerSetAllocator(OffersManager manager,
+		SlabAllocator allocator) {
+	if (manager != NULL) manager->allocator = allocator;
+}
+
 /*
  * offersMenagerRemoveAllConnectedOffers: Removes all the offers associated
  * with the given email.
@@ -102,7 +171,12 @@ void offersManagerDestroy(OffersManager manager) {
 */
 OfferManagerResult offersMenagerRemoveAllEmailOffers(OffersManager manager,
 	Email mail) {
-	return filteredRemoveOffers(manager, isEmailConnectedToOffer, mail);
+	if ((manager == NULL) || (mail == NULL))
+		return OFFERS_MANAGER_NULL_PARAMETERS;
+	OfferKey key = {mail, mail, NULL, 0};
+	removeOffers(manager, &key, INDEX_CLIENT);
+	removeOffers(manager, &key, INDEX_AGENT);
+	return OFFERS_MANAGER_SUCCESS;
 }
 
 /*
@@ -125,14 +199,9 @@ OfferManagerResult offersMenagerRemoveAllServiceOffers(OffersManager manager,
 	Email mail, char* service_name) {
 	if ((manager == NULL) || (mail == NULL) || (service_name == NULL))
 		return OFFERS_MANAGER_NULL_PARAMETERS;
-	void** parameters = malloc (2 * sizeof(void*));
-	if (parameters == NULL) return OFFERS_MANAGER_OUT_OF_MEMORY;
-	parameters[0] = mail;
-	parameters[1] = service_name;
-	OfferManagerResult result = filteredRemoveOffers(manager,
-			isServiceConnectedToOffer, parameters);
-	free (parameters);
-	return result;
+	OfferKey key = {NULL, mail, service_name, 0};
+	removeOffers(manager, &key, INDEX_SERVICE);
+	return OFFERS_MANAGER_SUCCESS;
 }
 
 /*
@@ -156,15 +225,9 @@ OfferManagerResult offersMenagerRemoveAllApartmentOffers(OffersManager manager,
 	Email mail, char* service_name, int apartment_id) {
 	if ((manager == NULL) || (mail == NULL) || (service_name == NULL))
 		return OFFERS_MANAGER_NULL_PARAMETERS;
-	void** parameters = malloc (3 * sizeof(void*));
-	if (parameters == NULL) return OFFERS_MANAGER_OUT_OF_MEMORY;
-	parameters[0] = mail;
-	parameters[1] = service_name;
-	parameters[2] = &apartment_id;
-	OfferManagerResult result = filteredRemoveOffers(manager,
-			isApartmentConnectedToOffer, parameters);
-	free (parameters);
-	return result;
+	OfferKey key = {NULL, mail, service_name, apartment_id};
+	removeOffers(manager, &key, INDEX_APARTMENT);
+	return OFFERS_MANAGER_SUCCESS;
 }
 
 /*
@@ -187,179 +250,11 @@ OfferManagerResult offersMenagerRemoveOffer(OffersManager manager,
 	Email client, Email agent) {
 	if ((manager == NULL) || (client == NULL) || (agent == NULL))
 		return OFFERS_MANAGER_NULL_PARAMETERS;
-	void** parameters = malloc (2 * sizeof(void*));
-	if (parameters == NULL) return OFFERS_MANAGER_OUT_OF_MEMORY;
-	parameters[0] = agent;
-	parameters[1] = client;
-	OfferManagerResult result = filteredRemoveOffers(manager,
-			isOfferBetweenAgentAndClient, parameters);
-	free (parameters);
-	return result;
-}
-
-/*
-* offersManagerRemoveOffer: removes all the offers from the given offer manager
-* that are associated to the given parameters. the association is checked
-* using the given checkOffer method and uses the given checkOfferParam
-* parameters.
-*
-* For example, here is a proper function for checking if an offer's client
-* has the given email address:
-*
-* @code
-* CompareResult compareOffersEquel(Offer first, checkOfferParam parameter) {
-*   if (parameter == NULL) return COMPARE_UNFIT;
-*   return emailAreEqual(offerGetClientEmail(offer), (Email)parameter) ?
-*   	COMPARE_FIT : COMPARE_UNFIT;
-* }
-*
-* @endcode
-*
-* @param offer OffersManager to remove from add to.
-* @param checkOfferParam parameters to check.
-*
-* @return
-*
-* 	OFFERS_MANAGER_NULL_PARAMETERS if manager or function are NULL.
-*
-* 	OFFERS_MANAGER_SUCCESS associated offers had been removed successfully.
-*
-* 	OFFERS_MANAGER_OUT_OF_MEMORY method had a memory allocation error.
-*/
-static OfferManagerResult filteredRemoveOffers(OffersManager manager,
-		checkOffer function, checkOfferParam param) {
-	if ((manager == NULL) || (param == NULL))
-		return OFFERS_MANAGER_NULL_PARAMETERS;
-	Offer current = (Offer)listGetFirst(manager->offers);
-	while (current != NULL) {
-		CompareResult copare = function(current, param);
-		if (copare == COMPARE_FIT) {
-			listRemoveCurrent(manager->offers);
-			current = (Offer)listGetFirst(manager->offers);
-		} else if (copare == COMPARE_UNFIT) {
-			current = listGetNext(manager->offers);
-		} else {
-			return OFFERS_MANAGER_OUT_OF_MEMORY;
-		}
-	}
+	OfferKey key = {client, agent, NULL, 0};
+	removeOffers(manager, &key, INDEX_CLIENT_AGENT);
 	return OFFERS_MANAGER_SUCCESS;
 }
 
-/*
-* isEmailConnectedToOffer: checks if the offers is associated with the given
-* email string adress.
-*
-* @param offer offer to compare.
-* @param parameter a pointer to the email string address.
-*
-* @return
-*
-* 	COMPARE_UNFIT if manager or parameter NULL, or if the email address is
-* 		invalid, or if the email is not associated with the offer.
-*
-* 	COMPARE_FIT email is associated with the offer.
-*
-* 	COMPARE_OUT_OF_MEMORY method had a memory allocation error.
-*/
-static CompareResult isEmailConnectedToOffer(Offer offer,
-		checkOfferParam parameter) {
-	if ((offer == NULL) || (parameter == NULL)) return COMPARE_UNFIT;
-	Email mail;
-	EmailResult result = emailCreate((char*)parameter, &mail);
-	if (result == EMAIL_OUT_OF_MEMORY) return COMPARE_OUT_OF_MEMORY;
-	if (result == EMAIL_NULL_PARAMETERS || result == EMAIL_INVALID_PARAMETERS)
-		return COMPARE_UNFIT;
-	bool fits = ((emailAreEqual(offerGetClientEmail(offer), mail)) ||
-			     (emailAreEqual(offerGetClientEmail(offer), mail)));
-	emailDestroy(mail);
-	return fits ? COMPARE_FIT : COMPARE_UNFIT;
-}
-
-/*
-* isServiceConnectedToOffer: checks if the offers is associated with the
-* given apartment service.
-*
-* @param offer Offer to check.
-* @param parameter a pointer to a two cells array. first cell contains the
-* 	agent Email, the second contains the service name.
-*
-* @return
-*
-* 	COMPARE_UNFIT if manager or parameter NULL, or if the email address is
-* 		invalid, or if the apartment service is not associated with the offer.
-*
-* 	COMPARE_FIT apartment service is associated with the offer.
-*
-* 	COMPARE_OUT_OF_MEMORY method had a memory allocation error.
-*/
-static CompareResult isServiceConnectedToOffer(Offer offer,
-		checkOfferParam parameter) {
-	if ((offer == NULL) || (parameter == NULL)) return COMPARE_UNFIT;
-	return ((emailAreEqual(offerGetAgentEmail(offer),
-				(Email)(((void**)parameter)[0]))) &&
-			(areStringsEqual(offerGetServiceName(offer),
-			    (char*)(((void**)parameter)[1])))) ?
-			COMPARE_FIT : COMPARE_UNFIT;
-}
-
-/*
-* isApartmentConnectedToOffer: checks if the offers is associated with the
-* given apartment identifier.
-*
-* @param offer Offer to check.
-* @param parameter a pointer to a three cells array. first cell contains the
-* 	agent Email, the second contains the service name and the last one contains
-* 	a pointer to the apartment id.
-*
-* @return
-*
-* 	COMPARE_UNFIT if manager or parameter NULL, or if the email address is
-* 		invalid, or if the apartment is not associated with the offer.
-*
-* 	COMPARE_FIT apartment is associated with the offer.
-*
-* 	COMPARE_OUT_OF_MEMORY method had a memory allocation error.
-*/
-static CompareResult isApartmentConnectedToOffer(Offer offer,
-		checkOfferParam parameter) {
-	if ((offer == NULL) || (parameter == NULL)) return COMPARE_UNFIT;
-	return ((emailAreEqual(offerGetAgentEmail(offer),
-				(Email)(((void**)parameter)[0]))) &&
-			(areStringsEqual(offerGetServiceName(offer),
-			    (char*)(((void**)parameter)[1]))) &&
-			(offerGetApartmentId(offer) == *(int*)(((void**)parameter)[2]))) ?
-			COMPARE_FIT : COMPARE_UNFIT;
-}
-
-/*
-* isApartmentConnectedToOffer: checks if the offers is associated with the
-* given apartment identifier.
-*
-* @param offer Offer to check.
-* @param parameter a pointer to a three cells array. first cell contains the
-* 	agent Email, the second contains the service name and the last one contains
-* 	a pointer to the apartment id.
-*
-* @return
-*
-* 	COMPARE_UNFIT if manager or parameter NULL, or if the email address is
-* 		invalid, or if the apartment is not associated with the offer.
-*
-* 	COMPARE_FIT apartment is associated with the offer.
-*
-* 	COMPARE_OUT_OF_MEMORY method had a memory allocation error.
-*/
-static CompareResult isOfferBetweenAgentAndClient(Offer offer,
-		checkOfferParam parameter) {
-	if ((offer == NULL) || (parameter == NULL)) return COMPARE_UNFIT;
-	return ((emailAreEqual(offerGetAgentEmail(offer),
-				(Email)(((void**)parameter)[0]))) &&
-			(emailAreEqual(offerGetClientEmail(offer),
-				(Email)(((void**)parameter)[1])))) ?
-			COMPARE_FIT : COMPARE_UNFIT;
-}
-
-
 /*
 * OfferManagerOfferExist: checks if an offer with the given parameters exists
 *
@@ -378,16 +273,8 @@ bool offersManagerOfferExist(OffersManager manager, Email client,
 	if ((manager == NULL) || (client == NULL) || (agent == NULL)
 			|| (service_name == NULL) || (apartment_id < 0))
 		return false;
-	bool found = false;
-	Offer current = listGetFirst(manager->offers);
-	while ((current != NULL) && (!found)) {
-		found = (emailAreEqual(offerGetClientEmail(current), client) &&
-				 emailAreEqual(offerGetAgentEmail(current), agent) &&
-				 (offerGetApartmentId(current) == apartment_id) &&
-				 areStringsEqual(service_name, offerGetServiceName(current)));
-		current = listGetNext(manager->offers);
-	}
-	return found;
+	OfferKey key = {client, agent, service_name, apartment_id};
+	return findOffer(manager, &key, INDEX_CLIENT_AGENT, KEY_ALL) != NULL;
 }
 
 /*
@@ -406,14 +293,9 @@ bool offersManagerOfferExistForAgent(OffersManager manager, Email client,
 		Email agent) {
 	if ((manager == NULL) || (client == NULL) || (agent == NULL))
 		return false;
-	bool found = false;
-	Offer current = listGetFirst(manager->offers);
-	while ((current != NULL) && (!found)) {
-		found = (emailAreEqual(offerGetClientEmail(current), client) &&
-				 emailAreEqual(offerGetAgentEmail(current), agent));
-		current = listGetNext(manager->offers);
-	}
-	return found;
+	OfferKey key = {client, agent, NULL, 0};
+	return findOffer(manager, &key, INDEX_CLIENT_AGENT,
+		index_keys[INDEX_CLIENT_AGENT]) != NULL;
 }
 
 /*
@@ -432,20 +314,14 @@ bool offersManagerGetOfferDetails(OffersManager manager, Email client,
 		Email agent, int* apartment_id, char** service_name, int* price) {
 	if ((manager == NULL) || (client == NULL) || (agent == NULL))
 		return false;
-	bool found = false;
-	Offer current = listGetFirst(manager->offers);
-	while ((current != NULL) && (!found)) {
-		if (emailAreEqual(offerGetClientEmail(current), client) &&
-			 emailAreEqual(offerGetAgentEmail(current), agent)) {
-			 found = true;
-			 *apartment_id = offerGetApartmentId(current);
-			 *service_name = duplicateString(offerGetServiceName(current));
-			 *price = offerGetPrice(current);
-
-		}
-		current = listGetNext(manager->offers);
-	}
-	return found;
+	OfferKey key = {client, agent, NULL, 0};
+	OfferEntry entry = findOffer(manager, &key, INDEX_CLIENT_AGENT,
+		index_keys[INDEX_CLIENT_AGENT]);
+	if (entry == NULL) return false;
+	*apartment_id = offerGetApartmentId(entry->offer);
+	*service_name = duplicateString(offerGetServiceName(entry->offer));
+	*price = offerGetPrice(entry->offer);
+	return true;
 }
 
 
@@ -469,15 +345,118 @@ OfferManagerResult offersManagerAddOffer(OffersManager manager, Email client,
 	if( manager == NULL ||  client == NULL || agent == NULL ||
 			service_name == NULL ) return OFFERS_MANAGER_NULL_PARAMETERS;
 	Offer new_offer = NULL;
-	OfferResult result = offerCreate(client, agent, service_name,
-		id, price, &new_offer);
+	OfferResult result = offerCreateWithAllocator(manager->allocator, client,
+		agent, service_name, id, price, &new_offer);
 	if ( result != OFFER_SUCCESS) return convertOfferResult(result);
-	ListResult offer_result = listInsertLast(manager->offers, new_offer);
-	offerDestroy(new_offer);
-	if (offer_result != LIST_SUCCESS) return OFFERS_MANAGER_OUT_OF_MEMORY;
+	OfferEntry entry = malloc(sizeof(*entry));
+	if (entry == NULL) {
+		offerDestroy(new_offer);
+		return OFFERS_MANAGER_OUT_OF_MEMORY;
+	}
+	entry->offer = new_offer;
+	if (manager->size >= manager->buckets_count) growBuckets(manager);
+	linkEntry(manager, entry);
 	return OFFERS_MANAGER_SUCCESS;
 }
 
+/**
+* offersManagerSaveSnapshot: writes all the offers to a snapshot, in their
+* order: their amount, then for each offer its client email, agent email,
+* apartment service name, apartment id and price.
+*
+* @param manager OffersManager to use.
+* @param writer the snapshot writer.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS if manager or writer are NULL
+*
+* 	SNAPSHOT_WRITE_FAILED if writing failed
+*
+* 	SNAPSHOT_SUCCESS the offers were written successfully
+*/
+SnapshotResult offersManagerSaveSnapshot(OffersManager manager,
+		SnapshotWriter writer) {
+	if ((manager == NULL) || (writer == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	if (!snapshotWriteInt(writer, manager->size))
+		return SNAPSHOT_WRITE_FAILED;
+	for (OfferEntry entry = manager->first; entry != NULL;
+			entry = entry->order_next) {
+		Offer offer = entry->offer;
+		SnapshotResult result = emailSaveSnapshot(offerGetClientEmail(offer),
+			writer);
+		if (result == SNAPSHOT_SUCCESS) {
+			result = emailSaveSnapshot(offerGetAgentEmail(offer), writer);
+		}
+		if (result != SNAPSHOT_SUCCESS) return result;
+		if (!snapshotWriteString(writer, offerGetServiceName(offer)) ||
+			!snapshotWriteInt(writer, offerGetApartmentId(offer)) ||
+			!snapshotWriteInt(writer, offerGetPrice(offer)))
+			return SNAPSHOT_WRITE_FAILED;
+	}
+	return SNAPSHOT_SUCCESS;
+}
+
+/**
+* offersManagerLoadSnapshot: reads offers written by
+* offersManagerSaveSnapshot into an empty manager, in their order.
+*
+* @param manager OffersManager to add to, with no offers.
+* @param reader the snapshot reader.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS if manager or reader are NULL
+*
+* 	SNAPSHOT_BAD_FORMAT if the snapshot is truncated or not valid
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocation error
+*
+* 	SNAPSHOT_SUCCESS the offers were read successfully
+*/
+SnapshotResult offersManagerLoadSnapshot(OffersManager manager,
+		SnapshotReader reader) {
+	if ((manager == NULL) || (reader == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	int count = 0;
+	if (!snapshotReadInt(reader, &count) || (count < 0))
+		return SNAPSHOT_BAD_FORMAT;
+	for (int i = 0; i < count; i++) {
+		SnapshotResult result = loadOffer(manager, reader);
+		if (result != SNAPSHOT_SUCCESS) return result;
+	}
+	return SNAPSHOT_SUCCESS;
+}
+
+/*
+ * loadOffer: reads a single offer written by offersManagerSaveSnapshot, and
+ * adds it last.
+ */
+static SnapshotResult loadOffer(OffersManager manager,
+		SnapshotReader reader) {
+	Email client = NULL, agent = NULL;
+	SnapshotResult result = emailLoadSnapshot(reader, &client);
+	if (result != SNAPSHOT_SUCCESS) return result;
+	result = emailLoadSnapshot(reader, &agent);
+	const char* service_name = NULL;
+	int id = 0, price = 0;
+	if ((result == SNAPSHOT_SUCCESS) &&
+		(!snapshotReadString(reader, &service_name) ||
+		!snapshotReadInt(reader, &id) || !snapshotReadInt(reader, &price))) {
+		result = SNAPSHOT_BAD_FORMAT;
+	}
+	if (result == SNAPSHOT_SUCCESS) {
+		OfferManagerResult added = offersManagerAddOffer(manager, client,
+			agent, (char*)service_name, id, price);
+		if (added != OFFERS_MANAGER_SUCCESS) {
+			result = (added == OFFERS_MANAGER_OUT_OF_MEMORY) ?
+				SNAPSHOT_OUT_OF_MEMORY : SNAPSHOT_BAD_FORMAT;
+		}
+	}
+	emailDestroy(client);
+	emailDestroy(agent);
+	return result;
+}
+
 /**
 * convertOfferResult: Converts a OfferResult to OfferManagerResult.
 *
@@ -508,3 +487,200 @@ static OfferManagerResult convertOfferResult(OfferResult value) {
 	}
 	return result;
 }
+
+/*
+ * offerKeyOf: returns the key of all the fields of an offer.
+ */
+static OfferKey offerKeyOf(Offer offer) {
+	OfferKey key = {offerGetClientEmail(offer), offerGetAgentEmail(offer),
+		offerGetServiceName(offer), offerGetApartmentId(offer)};
+	return key;
+}
+
+/*
+ * combineHash: mixes a value into a hash.
+ */
+static unsigned int combineHash(unsigned int hash, unsigned int value) {
+	return hash ^ (value + HASH_COMBINE_CONSTANT + (hash << 6) + (hash >> 2));
+}
+
+/*
+ * hashOfferKey: hashes the fields of a key an index is on. emails are
+ * hashed by their ids, as equal emails are the same email.
+ */
+static unsigned int hashOfferKey(const OfferKey* key, OfferIndex index) {
+	int keys = index_keys[index];
+	unsigned int hash = 0;
+	if (keys & KEY_CLIENT) {
+		hash = combineHash(hash, (unsigned int)emailGetId(key->client));
+	}
+	if (keys & KEY_AGENT) {
+		hash = combineHash(hash, (unsigned int)emailGetId(key->agent));
+	}
+	if (keys & KEY_SERVICE) {
+		hash = combineHash(hash, hashString(key->service_name));
+	}
+	if (keys & KEY_APARTMENT) {
+		hash = combineHash(hash, (unsigned int)key->apartment_id);
+	}
+	return hash;
+}
+
+/*
+ * offerMatches: checks if the given fields of an offer are equal to the
+ * fields of a key.
+ */
+static bool offerMatches(Offer offer, const OfferKey* key, int keys) {
+	return (!(keys & KEY_CLIENT) ||
+			emailAreEqual(offerGetClientEmail(offer), key->client)) &&
+		(!(keys & KEY_AGENT) ||
+			emailAreEqual(offerGetAgentEmail(offer), key->agent)) &&
+		(!(keys & KEY_APARTMENT) ||
+			(offerGetApartmentId(offer) == key->apartment_id)) &&
+		(!(keys & KEY_SERVICE) ||
+			areStringsEqual(offerGetServiceName(offer), key->service_name));
+}
+
+/*
+ * bucketOf: returns the bucket of a hash in an index. the buckets count is
+ * a power of two, so the hash bits are mixed before they are masked.
+ */
+static OfferBucket* bucketOf(OffersManager manager, OfferIndex index,
+		unsigned int hash) {
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bu;
+	hash ^= hash >> 13;
+	return &manager->buckets[index][hash & (manager->buckets_count - 1)];
+}
+
+/*
+ * findOffer: returns the oldest offer whose fields in keys are equal to the
+ * key, searching the chain of the key in the given index. keys must
+ * include the fields of the index. returns NULL if none is found.
+ */
+static OfferEntry findOffer(OffersManager manager, const OfferKey* key,
+		OfferIndex index, int keys) {
+	unsigned int hash = hashOfferKey(key, index);
+	OfferEntry entry = bucketOf(manager, index, hash)->first;
+	while ((entry != NULL) && ((entry->hashes[index] != hash) ||
+			!offerMatches(entry->offer, key, keys))) {
+		entry = entry->next[index];
+	}
+	return entry;
+}
+
+/*
+ * removeOffers: removes and destroys all the offers whose fields of the
+ * given index are equal to the key.
+ */
+static void removeOffers(OffersManager manager, const OfferKey* key,
+		OfferIndex index) {
+	unsigned int hash = hashOfferKey(key, index);
+	OfferEntry entry = bucketOf(manager, index, hash)->first;
+	while (entry != NULL) {
+		OfferEntry next = entry->next[index];
+		if ((entry->hashes[index] == hash) &&
+				offerMatches(entry->offer, key, index_keys[index])) {
+			unlinkEntry(manager, entry);
+			offerDestroy(entry->offer);
+			free(entry);
+		}
+		entry = next;
+	}
+}
+
+/*
+ * linkToBucket: adds an entry last to the chain of a bucket of an index.
+ */
+static void linkToBucket(OfferBucket* bucket, OfferEntry entry,
+		OfferIndex index) {
+	entry->previous[index] = bucket->last;
+	entry->next[index] = NULL;
+	if (bucket->last != NULL) {
+		bucket->last->next[index] = entry;
+	} else {
+		bucket->first = entry;
+	}
+	bucket->last = entry;
+}
+
+/*
+ * linkEntry: adds an entry last to the offers, and to every index.
+ */
+static void linkEntry(OffersManager manager, OfferEntry entry) {
+	OfferKey key = offerKeyOf(entry->offer);
+	for (int i = 0; i < INDEXES_COUNT; i++) {
+		entry->hashes[i] = hashOfferKey(&key, i);
+		linkToBucket(bucketOf(manager, i, entry->hashes[i]), entry, i);
+	}
+	entry->order_previous = manager->last;
+	entry->order_next = NULL;
+	if (manager->last != NULL) {
+		manager->last->order_next = entry;
+	} else {
+		manager->first = entry;
+	}
+	manager->last = entry;
+	manager->size++;
+}
+
+/*
+ * unlinkEntry: removes an entry from the offers and from every index.
+ */
+static void unlinkEntry(OffersManager manager, OfferEntry entry) {
+	for (int i = 0; i < INDEXES_COUNT; i++) {
+		OfferBucket* bucket = bucketOf(manager, i, entry->hashes[i]);
+		if (entry->previous[i] != NULL) {
+			entry->previous[i]->next[i] = entry->next[i];
+		} else {
+			bucket->first = entry->next[i];
+		}
+		if (entry->next[i] != NULL) {
+			entry->next[i]->previous[i] = entry->previous[i];
+		} else {
+			bucket->last = entry->previous[i];
+		}
+	}
+	if (entry->order_previous != NULL) {
+		entry->order_previous->order_next = entry->order_next;
+	} else {
+		manager->first = entry->order_next;
+	}
+	if (entry->order_next != NULL) {
+		entry->order_next->order_previous = entry->order_previous;
+	} else {
+		manager->last = entry->order_previous;
+	}
+	manager->size--;
+}
+
+/*
+ * growBuckets: multiplies the buckets count of every index, and links the
+ * offers to the new buckets in their order, so the chains keep it. if
+ * allocations failed the buckets are kept, and false is returned.
+ */
+static bool growBuckets(OffersManager manager) {
+	int count = manager->buckets_count * BUCKETS_GROWTH_FACTOR;
+	OfferBucket* buckets[INDEXES_COUNT];
+	bool allocated = true;
+	for (int i = 0; i < INDEXES_COUNT; i++) {
+		buckets[i] = calloc(count, sizeof(OfferBucket));
+		allocated = allocated && (buckets[i] != NULL);
+	}
+	if (!allocated) {
+		for (int i = 0; i < INDEXES_COUNT; i++) free(buckets[i]);
+		return false;
+	}
+	for (int i = 0; i < INDEXES_COUNT; i++) {
+		free(manager->buckets[i]);
+		manager->buckets[i] = buckets[i];
+	}
+	manager->buckets_count = count;
+	for (OfferEntry entry = manager->first; entry != NULL;
+			entry = entry->order_next) {
+		for (int i = 0; i < INDEXES_COUNT; i++) {
+			linkToBucket(bucketOf(manager, i, entry->hashes[i]), entry, i);
+		}
+	}
+	return true;
+}
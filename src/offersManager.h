@@ -3,6 +3,7 @@
 
 #include "offer.h"
 #include "email.h"
+#include "snapshot.h"
 
 typedef struct offerManager_t *OffersManager;
 
@@ -34,6 +35,17 @@ OffersManager offersManagerCreate();
 */
 void offersManagerDestroy(OffersManager manager);
 
+/**
+* offersManagerSetAllocator: sets the allocator the manager creates its
+* offers from. it is set while the manager is empty.
+*
+* @param manager Target offers manager.
+* @param allocator the allocator, or NULL to use malloc. it must outlive the
+* 	manager.
+*/
+void offersManagerSetAllocator(OffersManager manager,
+		SlabAllocator allocator);
+
 /*
  * offersMenagerRemoveAllConnectedOffers: Removes all the offers associated
  * with the given email.
@@ -172,4 +184,43 @@ OfferManagerResult offersManagerAddOffer(OffersManager manager,
 bool offersManagerGetOfferDetails(OffersManager manager, Email client,
 		Email agent, int* apartment_id, char** service_name, int* price);
 
+/**
+* offersManagerSaveSnapshot: writes all the offers to a snapshot, in their
+* order: their amount, then for each offer its client email, agent email,
+* apartment service name, apartment id and price.
+*
+* @param manager OffersManager to use.
+* @param writer the snapshot writer.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS if manager or writer are NULL
+*
+* 	SNAPSHOT_WRITE_FAILED if writing failed
+*
+* 	SNAPSHOT_SUCCESS the offers were written successfully
+*/
+SnapshotResult offersManagerSaveSnapshot(OffersManager manager,
+		SnapshotWriter writer);
+
+/**
+* offersManagerLoadSnapshot: reads offers written by
+* offersManagerSaveSnapshot into an empty manager, in their order.
+*
+* @param manager OffersManager to add to, with no offers.
+* @param reader the snapshot reader.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS if manager or reader are NULL
+*
+* 	SNAPSHOT_BAD_FORMAT if the snapshot is truncated or not valid
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocation error
+*
+* 	SNAPSHOT_SUCCESS the offers were read successfully
+*/
+SnapshotResult offersManagerLoadSnapshot(OffersManager manager,
+		SnapshotReader reader);
+
 #endif /* SRC_OFFERSMANAGER_H_ */
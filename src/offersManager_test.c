@@ -8,12 +8,15 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "offersManager.h"
 #include "test_utilities.h"
 #include "email.h"
 #include "agent.h"
 #include "client.h"
 
+#define OFFERS_TEST_CLIENTS 500
+
 
 static bool testOfferManagerCreate();
 static bool testOffersMenagerRemoveAllEmailOffers();
@@ -21,6 +24,9 @@ static bool testOffersMenagerRemoveAllServiceOffers();
 static bool testOffersMenagerRemoveAllApartmentOffers();
 static bool testOffersManagerOfferExist();
 static bool testOffersManagerAddOffer();
+static bool testOffersManagerSnapshot();
+static bool testOffersManagerIndexes();
+static bool testOffersManagerManyOffers();
 
 
 int RunOffersManagerTest() {
@@ -31,6 +37,9 @@ int RunOffersManagerTest() {
 	RUN_TEST(testOffersMenagerRemoveAllApartmentOffers);
 	RUN_TEST(testOffersManagerOfferExist);
 	RUN_TEST(testOffersManagerAddOffer);
+	RUN_TEST(testOffersManagerSnapshot);
+	RUN_TEST(testOffersManagerIndexes);
+	RUN_TEST(testOffersManagerManyOffers);
 
 	return 0;
 }
@@ -174,3 +183,159 @@ static bool testOffersManagerAddOffer(){
 	return true;
 }
 
+static bool testOffersManagerSnapshot(){
+	OffersManager manager = offersManagerCreate();
+	Email email = NULL, mail = NULL, other = NULL;
+	emailCreate("baba@ganosh", &email);
+	emailCreate("ba@ganosh", &mail);
+	emailCreate("b@ganosh", &other);
+	offersManagerAddOffer(manager, mail, email, "serveMe", 1, 100);
+	offersManagerAddOffer(manager, other, email, "other", 2, 300);
+
+	FILE* file = tmpfile();
+	SnapshotWriter writer = NULL;
+	ASSERT_TEST( snapshotWriterCreate(file, 0, &writer) ==
+			SNAPSHOT_SUCCESS );
+	ASSERT_TEST( offersManagerSaveSnapshot(NULL, writer) ==
+			SNAPSHOT_NULL_PARAMETERS );
+	ASSERT_TEST( offersManagerSaveSnapshot(manager, writer) ==
+			SNAPSHOT_SUCCESS );
+	snapshotWriterDestroy(writer);
+	char data[256];
+	rewind(file);
+	size_t size = fread(data, 1, sizeof(data), file);
+	fclose(file);
+
+	OffersManager copy = offersManagerCreate();
+	SnapshotReader reader = NULL;
+	ASSERT_TEST( snapshotReaderCreate(data, size - 1, &reader) ==
+			SNAPSHOT_SUCCESS );
+	ASSERT_TEST( offersManagerLoadSnapshot(copy, reader) ==
+			SNAPSHOT_BAD_FORMAT );
+	snapshotReaderDestroy(reader);
+	offersManagerDestroy(copy);
+
+	copy = offersManagerCreate();
+	ASSERT_TEST( snapshotReaderCreate(data, size, &reader) ==
+			SNAPSHOT_SUCCESS );
+	ASSERT_TEST( offersManagerLoadSnapshot(copy, reader) == SNAPSHOT_SUCCESS );
+	ASSERT_TEST( snapshotReaderIsDone(reader) );
+	snapshotReaderDestroy(reader);
+	int id = 0, price = 0;
+	char* service_name = NULL;
+	ASSERT_TEST( offersManagerGetOfferDetails(copy, other, email, &id,
+			&service_name, &price) );
+	ASSERT_TEST( (id == 2) && (price == 300) );
+	ASSERT_TEST( strcmp(service_name, "other") == 0 );
+	free(service_name);
+	ASSERT_TEST( offersManagerOfferExist(copy, mail, email, "serveMe", 1) );
+
+	offersManagerDestroy(copy);
+	emailDestroy(email);
+	emailDestroy(mail);
+	emailDestroy(other);
+	offersManagerDestroy(manager);
+	return true;
+}
+
+static bool testOffersManagerIndexes(){
+	OffersManager manager = offersManagerCreate();
+	Email client = NULL, other = NULL, agent = NULL, realtor = NULL;
+	emailCreate("client@m", &client);
+	emailCreate("other@m", &other);
+	emailCreate("agent@m", &agent);
+	emailCreate("realtor@m", &realtor);
+	offersManagerAddOffer(manager, client, agent, "first", 1, 100);
+	offersManagerAddOffer(manager, client, agent, "second", 2, 200);
+	offersManagerAddOffer(manager, other, agent, "first", 1, 300);
+	offersManagerAddOffer(manager, other, agent, "first", 2, 400);
+	offersManagerAddOffer(manager, client, realtor, "first", 1, 500);
+
+	int id = 0, price = 0;
+	char* service_name = NULL;
+	ASSERT_TEST( offersManagerGetOfferDetails(manager, client, agent, &id,
+			&service_name, &price) );
+	ASSERT_TEST( (id == 1) && (price == 100) );
+	ASSERT_TEST( strcmp(service_name, "first") == 0 );
+	free(service_name);
+	ASSERT_TEST( offersManagerOfferExist(manager, client, agent, "second", 2) );
+	ASSERT_TEST( !offersManagerOfferExist(manager, client, agent, "second",
+			1) );
+	ASSERT_TEST( !offersManagerOfferExistForAgent(manager, other, realtor) );
+
+	ASSERT_TEST( offersMenagerRemoveAllApartmentOffers(manager, agent, "first",
+			1) == OFFERS_MANAGER_SUCCESS );
+	ASSERT_TEST( !offersManagerOfferExist(manager, client, agent, "first", 1) );
+	ASSERT_TEST( offersManagerOfferExist(manager, other, agent, "first", 2) );
+	ASSERT_TEST( offersManagerOfferExist(manager, client, realtor, "first",
+			1) );
+	ASSERT_TEST( offersManagerGetOfferDetails(manager, client, agent, &id,
+			&service_name, &price) );
+	ASSERT_TEST( (id == 2) && (price == 200) );
+	free(service_name);
+
+	ASSERT_TEST( offersMenagerRemoveAllServiceOffers(manager, agent, "first")
+			== OFFERS_MANAGER_SUCCESS );
+	ASSERT_TEST( !offersManagerOfferExistForAgent(manager, other, agent) );
+	ASSERT_TEST( offersManagerOfferExistForAgent(manager, client, agent) );
+
+	ASSERT_TEST( offersMenagerRemoveOffer(manager, client, agent) ==
+			OFFERS_MANAGER_SUCCESS );
+	ASSERT_TEST( !offersManagerOfferExistForAgent(manager, client, agent) );
+	ASSERT_TEST( offersManagerOfferExistForAgent(manager, client, realtor) );
+
+	offersManagerAddOffer(manager, other, realtor, "first", 3, 600);
+	ASSERT_TEST( offersMenagerRemoveAllEmailOffers(manager, realtor) ==
+			OFFERS_MANAGER_SUCCESS );
+	ASSERT_TEST( !offersManagerOfferExistForAgent(manager, client, realtor) );
+	ASSERT_TEST( !offersManagerOfferExistForAgent(manager, other, realtor) );
+
+	offersManagerAddOffer(manager, client, agent, "first", 1, 100);
+	offersManagerAddOffer(manager, other, agent, "first", 1, 100);
+	ASSERT_TEST( offersMenagerRemoveAllEmailOffers(manager, client) ==
+			OFFERS_MANAGER_SUCCESS );
+	ASSERT_TEST( !offersManagerOfferExistForAgent(manager, client, agent) );
+	ASSERT_TEST( offersManagerOfferExistForAgent(manager, other, agent) );
+
+	emailDestroy(client);
+	emailDestroy(other);
+	emailDestroy(agent);
+	emailDestroy(realtor);
+	offersManagerDestroy(manager);
+	return true;
+}
+
+static bool testOffersManagerManyOffers(){
+	OffersManager manager = offersManagerCreate();
+	Email clients[OFFERS_TEST_CLIENTS];
+	Email agent = NULL;
+	emailCreate("agent@m", &agent);
+	char address[32];
+	for (int i = 0; i < OFFERS_TEST_CLIENTS; i++) {
+		sprintf(address, "client%d@m", i);
+		emailCreate(address, &clients[i]);
+		ASSERT_TEST( offersManagerAddOffer(manager, clients[i], agent,
+				(i % 2 == 0) ? "even" : "odd", i + 1, 100) ==
+				OFFERS_MANAGER_SUCCESS );
+	}
+	for (int i = 0; i < OFFERS_TEST_CLIENTS; i++) {
+		ASSERT_TEST( offersManagerOfferExist(manager, clients[i], agent,
+				(i % 2 == 0) ? "even" : "odd", i + 1) );
+	}
+	ASSERT_TEST( offersMenagerRemoveAllServiceOffers(manager, agent, "even")
+			== OFFERS_MANAGER_SUCCESS );
+	for (int i = 0; i < OFFERS_TEST_CLIENTS; i++) {
+		ASSERT_TEST( offersManagerOfferExistForAgent(manager, clients[i],
+				agent) == (i % 2 == 1) );
+	}
+	ASSERT_TEST( offersMenagerRemoveAllEmailOffers(manager, agent) ==
+			OFFERS_MANAGER_SUCCESS );
+	for (int i = 0; i < OFFERS_TEST_CLIENTS; i++) {
+		ASSERT_TEST( !offersManagerOfferExistForAgent(manager, clients[i],
+				agent) );
+		emailDestroy(clients[i]);
+	}
+	emailDestroy(agent);
+	offersManagerDestroy(manager);
+	return true;
+}
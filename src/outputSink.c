@@ -0,0 +1,206 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "outputSink.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#define STREAMS_COUNT 2
+
+/*
+* stdout and stderr outlive any sink, so their buffers are static and are
+* set only once per process.
+*/
+static char standard_out_buffer[OUTPUT_SINK_OUT_BUFFER_SIZE];
+static char standard_error_buffer[OUTPUT_SINK_ERROR_BUFFER_SIZE];
+static bool is_standard_out_buffered = false;
+static bool is_standard_error_buffered = false;
+
+struct outputSink_t {
+	FILE* streams[STREAMS_COUNT];
+	char* buffers[STREAMS_COUNT];
+	bool is_pending[STREAMS_COUNT];
+	bool is_shared;
+	OutputSinkStream last;
+};
+
+static bool bufferStream(OutputSink sink, OutputSinkStream stream,
+	int size);
+static bool isSameDestination(FILE* first, FILE* second);
+static void closeStream(OutputSink sink, OutputSinkStream stream);
+
+/**
+* Allocates a new OutputSink over an output stream and an error stream.
+*
+* @param output the output stream.
+* @param error the error stream.
+*
+* @return
+* 	NULL - if one of the streams is NULL or allocations failed, the streams
+* 		are not closed in this case.
+* 	A new OutputSink in case of success.
+*/
+OutputSink outputSinkCreate(FILE* output, FILE* error) {
+	if ((output == NULL) || (error == NULL)) return NULL;
+	OutputSink sink = malloc(sizeof(*sink));
+	if (sink == NULL) return NULL;
+	sink->streams[OUTPUT_SINK_OUT] = output;
+	sink->streams[OUTPUT_SINK_ERROR] = error;
+	for (int i = 0; i < STREAMS_COUNT; i++) {
+		sink->buffers[i] = NULL;
+		sink->is_pending[i] = false;
+	}
+	sink->last = OUTPUT_SINK_OUT;
+	if ((!bufferStream(sink, OUTPUT_SINK_OUT, OUTPUT_SINK_OUT_BUFFER_SIZE)) ||
+		(!bufferStream(sink, OUTPUT_SINK_ERROR,
+			OUTPUT_SINK_ERROR_BUFFER_SIZE))) {
+		free(sink->buffers[OUTPUT_SINK_OUT]);
+		free(sink->buffers[OUTPUT_SINK_ERROR]);
+		free(sink);
+		return NULL;
+	}
+	sink->is_shared = isSameDestination(output, error);
+	return sink;
+}
+
+/**
+* outputSinkGetStream: returns a stream of the sink to print to.
+*
+* @param sink the sink.
+* @param stream the stream to print to.
+*
+* @return
+* 	NULL if sink is NULL; else returns the stream
+*/
+FILE* outputSinkGetStream(OutputSink sink, OutputSinkStream stream) {
+	if (sink == NULL) return NULL;
+	if ((stream != sink->last) && (sink->is_shared) &&
+		(sink->is_pending[sink->last])) {
+		fflush(sink->streams[sink->last]);
+		sink->is_pending[sink->last] = false;
+	}
+	sink->last = stream;
+	sink->is_pending[stream] = true;
+	return sink->streams[stream];
+}
+
+/**
+* outputSinkFlush: writes everything printed to the sink streams so far.
+*
+* @param sink the sink.
+*/
+void outputSinkFlush(OutputSink sink) {
+	if (sink == NULL) return;
+	for (int i = 0; i < STREAMS_COUNT; i++) {
+		if (sink->is_pending[i]) {
+			fflush(sink->streams[i]);
+			sink->is_pending[i] = false;
+		}
+	}
+}
+
+/**
+* outputSinkDestroy: flushes and deallocates an existing sink, closing the
+* streams it owns.
+*
+* @param sink Target sink to be deallocated.
+* If sink is NULL nothing will be done
+*/
+void outputSinkDestroy(OutputSink sink) {
+	if (sink == NULL) return;
+	outputSinkFlush(sink);
+	closeStream(sink, OUTPUT_SINK_OUT);
+	closeStream(sink, OUTPUT_SINK_ERROR);
+	free(sink);
+}
+
+/*
+* bufferStream: gives a sink stream a fully buffered buffer of the given
+* size. the standard streams use their static buffers, the first time only.
+* failing to set the buffer leaves the stream with its default buffering.
+*
+* @return
+* 	false in case of allocation error; else returns true.
+*/
+static bool bufferStream(OutputSink sink, OutputSinkStream stream,
+	int size) {
+	FILE* file = sink->streams[stream];
+	if (file == stdout) {
+		if (!is_standard_out_buffered) {
+			setvbuf(file, standard_out_buffer, _IOFBF, size);
+			is_standard_out_buffered = true;
+		}
+		return true;
+	}
+	if (file == stderr) {
+		if (!is_standard_error_buffered) {
+			setvbuf(file, standard_error_buffer, _IOFBF, size);
+			is_standard_error_buffered = true;
+		}
+		return true;
+	}
+	if ((stream == OUTPUT_SINK_ERROR) &&
+		(file == sink->streams[OUTPUT_SINK_OUT])) return true;
+	sink->buffers[stream] = malloc(sizeof(char) * size);
+	if (sink->buffers[stream] == NULL) return false;
+	setvbuf(file, sink->buffers[stream], _IOFBF, size);
+	return true;
+}
+
+/*
+* isSameDestination: checks if two streams write to the same file, so their
+* order has to be kept. when it can not be told, they are assumed to.
+* on windows a console or a pipe has no file identity, so two of them are
+* always assumed to be the same destination.
+*/
+#ifdef _WIN32
+static bool isSameDestination(FILE* first, FILE* second) {
+	if (first == second) return true;
+	HANDLE first_handle = (HANDLE)_get_osfhandle(_fileno(first));
+	HANDLE second_handle = (HANDLE)_get_osfhandle(_fileno(second));
+	BY_HANDLE_FILE_INFORMATION first_information, second_information;
+	if ((first_handle == INVALID_HANDLE_VALUE) ||
+		(second_handle == INVALID_HANDLE_VALUE) ||
+		(!GetFileInformationByHandle(first_handle, &first_information)) ||
+		(!GetFileInformationByHandle(second_handle, &second_information))) {
+		return true;
+	}
+	return (first_information.dwVolumeSerialNumber ==
+			second_information.dwVolumeSerialNumber) &&
+		(first_information.nFileIndexHigh ==
+			second_information.nFileIndexHigh) &&
+		(first_information.nFileIndexLow == second_information.nFileIndexLow);
+}
+#else
+static bool isSameDestination(FILE* first, FILE* second) {
+	if (first == second) return true;
+	struct stat first_status, second_status;
+	if ((fstat(fileno(first), &first_status) != 0) ||
+		(fstat(fileno(second), &second_status) != 0)) return true;
+	return (first_status.st_dev == second_status.st_dev) &&
+		(first_status.st_ino == second_status.st_ino);
+}
+#endif
+
+/*
+* closeStream: closes a sink stream if the sink owns it, and then releases
+* its buffer.
+*/
+static void closeStream(OutputSink sink, OutputSinkStream stream) {
+	FILE* file = sink->streams[stream];
+	if ((file != stdout) && (file != stderr) && ((stream == OUTPUT_SINK_OUT) ||
+		(file != sink->streams[OUTPUT_SINK_OUT]))) {
+		fclose(file);
+	}
+	free(sink->buffers[stream]);
+	sink->buffers[stream] = NULL;
+}
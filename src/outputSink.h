@@ -0,0 +1,74 @@
+#ifndef SRC_OUTPUTSINK_H_
+#define SRC_OUTPUTSINK_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+
+/** The buffer size of the output stream */
+#define OUTPUT_SINK_OUT_BUFFER_SIZE (1 << 20)
+
+/** The buffer size of the error stream */
+#define OUTPUT_SINK_ERROR_BUFFER_SIZE (1 << 16)
+
+typedef struct outputSink_t *OutputSink;
+
+/**
+* The streams of a sink.
+*/
+typedef enum {
+	OUTPUT_SINK_OUT = 0,
+	OUTPUT_SINK_ERROR = 1
+} OutputSinkStream;
+
+/**
+* Allocates a new OutputSink over an output stream and an error stream.
+*
+* Both streams are given large buffers, and are written to the system only
+* when the sink is flushed or a buffer fills up. When both streams write to
+* the same destination, switching between them flushes the one written
+* before, so the destination gets the text in the order it was printed.
+*
+* The sink owns the streams which are not stdout or stderr, and closes them
+* when it is destroyed. the streams must not have been used yet.
+*
+* @param output the output stream.
+* @param error the error stream.
+*
+* @return
+* 	NULL - if one of the streams is NULL or allocations failed, the streams
+* 		are not closed in this case.
+* 	A new OutputSink in case of success.
+*/
+OutputSink outputSinkCreate(FILE* output, FILE* error);
+
+/**
+* outputSinkGetStream: returns a stream of the sink to print to.
+*
+* Should be called before every print, so the order between the streams is
+* kept.
+*
+* @param sink the sink.
+* @param stream the stream to print to.
+*
+* @return
+* 	NULL if sink is NULL; else returns the stream
+*/
+FILE* outputSinkGetStream(OutputSink sink, OutputSinkStream stream);
+
+/**
+* outputSinkFlush: writes everything printed to the sink streams so far.
+*
+* @param sink the sink.
+*/
+void outputSinkFlush(OutputSink sink);
+
+/**
+* outputSinkDestroy: flushes and deallocates an existing sink, closing the
+* streams it owns.
+*
+* @param sink Target sink to be deallocated.
+* If sink is NULL nothing will be done
+*/
+void outputSinkDestroy(OutputSink sink);
+
+#endif /* SRC_OUTPUTSINK_H_ */
@@ -0,0 +1,103 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include "outputSink.h"
+#include "test_utilities.h"
+
+#define TEST_FILE "outputSink_test.tmp"
+#define TEST_TEXT_CAPACITY 64
+
+static bool testOutputSinkCreate();
+static bool testOutputSinkBuffering();
+static bool testOutputSinkOrder();
+static bool readTestFile(char* text);
+int RunOutputSinkTest();
+
+//int main() {
+int RunOutputSinkTest() {
+	RUN_TEST(testOutputSinkCreate);
+	RUN_TEST(testOutputSinkBuffering);
+	RUN_TEST(testOutputSinkOrder);
+	return 0;
+}
+
+/**
+ * Test create method
+ */
+static bool testOutputSinkCreate() {
+	ASSERT_TEST(outputSinkCreate(NULL, stderr) == NULL);
+	ASSERT_TEST(outputSinkCreate(stdout, NULL) == NULL);
+	ASSERT_TEST(outputSinkGetStream(NULL, OUTPUT_SINK_OUT) == NULL);
+	FILE* file = tmpfile();
+	ASSERT_TEST(file != NULL);
+	OutputSink sink = outputSinkCreate(file, file);
+	ASSERT_TEST(sink != NULL);
+	ASSERT_TEST(outputSinkGetStream(sink, OUTPUT_SINK_OUT) == file);
+	ASSERT_TEST(outputSinkGetStream(sink, OUTPUT_SINK_ERROR) == file);
+	outputSinkFlush(NULL);
+	outputSinkDestroy(sink);
+	outputSinkDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test nothing is written until the sink is flushed
+ */
+static bool testOutputSinkBuffering() {
+	FILE* output = fopen(TEST_FILE, "w");
+	FILE* error = tmpfile();
+	ASSERT_TEST((output != NULL) && (error != NULL));
+	OutputSink sink = outputSinkCreate(output, error);
+	ASSERT_TEST(sink != NULL);
+	char text[TEST_TEXT_CAPACITY];
+	fprintf(outputSinkGetStream(sink, OUTPUT_SINK_OUT), "report\n");
+	fprintf(outputSinkGetStream(sink, OUTPUT_SINK_ERROR), "error\n");
+	ASSERT_TEST(readTestFile(text));
+	ASSERT_TEST(strcmp(text, "") == 0);
+	outputSinkFlush(sink);
+	ASSERT_TEST(readTestFile(text));
+	ASSERT_TEST(strcmp(text, "report\n") == 0);
+	fprintf(outputSinkGetStream(sink, OUTPUT_SINK_OUT), "end\n");
+	outputSinkDestroy(sink);
+	ASSERT_TEST(readTestFile(text));
+	ASSERT_TEST(strcmp(text, "report\nend\n") == 0);
+	remove(TEST_FILE);
+	return true;
+}
+
+/**
+ * Test two streams writing to the same file keep the order of the prints
+ */
+static bool testOutputSinkOrder() {
+	remove(TEST_FILE);
+	FILE* output = fopen(TEST_FILE, "a");
+	FILE* error = fopen(TEST_FILE, "a");
+	ASSERT_TEST((output != NULL) && (error != NULL));
+	OutputSink sink = outputSinkCreate(output, error);
+	ASSERT_TEST(sink != NULL);
+	fprintf(outputSinkGetStream(sink, OUTPUT_SINK_OUT), "1");
+	fprintf(outputSinkGetStream(sink, OUTPUT_SINK_OUT), "2");
+	fprintf(outputSinkGetStream(sink, OUTPUT_SINK_ERROR), "3");
+	fprintf(outputSinkGetStream(sink, OUTPUT_SINK_OUT), "4");
+	fprintf(outputSinkGetStream(sink, OUTPUT_SINK_ERROR), "5");
+	outputSinkDestroy(sink);
+	char text[TEST_TEXT_CAPACITY];
+	ASSERT_TEST(readTestFile(text));
+	ASSERT_TEST(strcmp(text, "12345") == 0);
+	remove(TEST_FILE);
+	return true;
+}
+
+/*
+ * Reads the test file into text, returns false if it could not be read
+ */
+static bool readTestFile(char* text) {
+	FILE* file = fopen(TEST_FILE, "r");
+	if (file == NULL) return false;
+	size_t size = fread(text, sizeof(char), TEST_TEXT_CAPACITY - 1, file);
+	text[size] = '\0';
+	fclose(file);
+	return true;
+}
@@ -0,0 +1,422 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include "set.h"
+
+#define NULL_SET_SIZE -1
+#define MAX_LEVEL 32
+#define LEVEL_UP_MASK 3
+#define INITIAL_SEED 2463534242u
+
+typedef struct SetNode_t *SetNode;
+
+/*
+ * A node of the set, linked to the next node in each of its levels.
+ */
+struct SetNode_t {
+	SetElement element;
+	int level;
+	SetNode next[];
+};
+
+/*
+ * The elements of the set are kept in a skip list, in the order of the
+ * compare function. every node is in level 0, which the iterator walks, and
+ * each level above it holds about a quarter of the nodes of the level
+ * below, so elements are found, added and removed in logarithmic expected
+ * time. head is a node with no element in all the levels.
+ *
+ * the levels of nodes are drawn from a generator seeded the same for every
+ * set, so runs over the same elements build the same lists.
+ */
+struct Set_t {
+	copySetElements copyElement;
+	freeSetElements freeElement;
+	compareSetElements compare;
+	SetNode head;
+	int level;
+	int size;
+	SetNode iterator;
+	unsigned int seed;
+};
+
+static SetNode createNode(int level);
+static SetNode findNode(Set set, SetElement element, SetNode* previous);
+static int randomLevel(Set set);
+static SetNode unlinkNode(Set set, SetElement element);
+static bool appendElement(Set set, SetNode* last, SetElement element);
+
+/**
+* setCreate: Allocates a new empty set.
+*
+* @param copyElement - Function pointer to be used for copying elements into
+*  	the set or when copying the set.
+* @param freeElement - Function pointer to be used for removing elements from
+* 		the set
+* @param compareElements - Function pointer to be used for comparing elements
+* 		inside the set. Used to check if new elements already exist in the set.
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new Set in case of success.
+*/
+Set setCreate(copySetElements copyElement, freeSetElements freeElement,
+		compareSetElements compareElements) {
+	if ((copyElement == NULL) || (freeElement == NULL) ||
+		(compareElements == NULL)) return NULL;
+	Set set = malloc(sizeof(*set));
+	if (set == NULL) return NULL;
+	set->head = createNode(MAX_LEVEL);
+	if (set->head == NULL) {
+		free(set);
+		return NULL;
+	}
+	set->copyElement = copyElement;
+	set->freeElement = freeElement;
+	set->compare = compareElements;
+	set->level = 1;
+	set->size = 0;
+	set->iterator = NULL;
+	set->seed = INITIAL_SEED;
+	return set;
+}
+
+/**
+* setCopy: Creates a copy of target set.
+*
+* @param set - Target set.
+* @return
+* 	NULL if a NULL was sent or a memory allocation failed.
+* 	A Set containing the same elements as set otherwise.
+*/
+Set setCopy(Set set) {
+	if (set == NULL) return NULL;
+	Set copy = setCreate(set->copyElement, set->freeElement, set->compare);
+	if (copy == NULL) return NULL;
+	SetNode last[MAX_LEVEL];
+	for (int i = 0; i < MAX_LEVEL; i++) last[i] = copy->head;
+	for (SetNode node = set->head->next[0]; node != NULL;
+		node = node->next[0]) {
+		if (!appendElement(copy, last, node->element)) {
+			setDestroy(copy);
+			return NULL;
+		}
+	}
+	return copy;
+}
+
+/**
+* setDestroy: Deallocates an existing set. Clears all elements by using the
+* stored free function.
+*
+* @param set - Target set to be deallocated. If set is NULL nothing will be
+* 		done
+*/
+void setDestroy(Set set) {
+	if (set == NULL) return;
+	setClear(set);
+	free(set->head);
+	free(set);
+}
+
+/**
+* setGetSize: Returns the number of elements in a set
+* @param set - The set which size is requested
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of elements in the set.
+*/
+int setGetSize(Set set) {
+	return (set == NULL) ? NULL_SET_SIZE : set->size;
+}
+
+/**
+* setIsIn: Checks if an element exists in the set. The element will be
+* considered in the set if one of the elements in the set it determined equal
+* using the comparison function used to initialize the set.
+*
+* @param set - The set to search in
+* @param element - The element to look for. Will be compared using the
+* 		comparison function.
+* @return
+* 	false - if the input set is null, or if the element was not found.
+* 	true - if the element was found in the set.
+*/
+bool setIsIn(Set set, SetElement element) {
+	if ((set == NULL) || (element == NULL)) return false;
+	set->iterator = NULL;
+	return findNode(set, element, NULL) != NULL;
+}
+
+/**
+*	setGetFirst: Sets the internal iterator (also called current element) to
+*	the first element in the set. The "first" element is the one having the
+*	lowest value as determined by the comparison function used to initialize
+*	the set.
+*
+* @param set - The set for which to set the iterator and return the first
+* 		element.
+* @return
+* 	NULL if a NULL pointer was sent or the set is empty.
+* 	The first element of the set otherwise
+*/
+SetElement setGetFirst(Set set) {
+	if (set == NULL) return NULL;
+	set->iterator = set->head->next[0];
+	return setGetCurrent(set);
+}
+
+/**
+*	setGetNext: Advances the set iterator to the next element and returns it
+*	The next element is determined by the comparison function induced order.
+* @param set - The set for which to advance the iterator
+* @return
+* 	NULL if reached the end of the set, or the iterator is at an invalid state
+* 	or a NULL sent as argument
+* 	The next element on the set in case of success
+*/
+SetElement setGetNext(Set set) {
+	if ((set == NULL) || (set->iterator == NULL)) return NULL;
+	set->iterator = set->iterator->next[0];
+	return setGetCurrent(set);
+}
+
+/**
+* setGetCurrent: Returns the element pointed by the iterator.
+* @param set - The set from which to get the current element
+* @return
+*   NULL if the iterator is at an invalid state
+*   or a NULL sent as argument
+*   The current element in the set in case of success
+*/
+SetElement setGetCurrent(Set set) {
+	if ((set == NULL) || (set->iterator == NULL)) return NULL;
+	return set->iterator->element;
+}
+
+/**
+*	setAdd: Adds a new element to the set.
+*  Iterator's value is undefined after this operation.
+*
+* @param set - The set for which to add an element
+* @param element - The element to insert. A copy of the element will be
+* 		inserted as supplied by the copying function which is given at
+* 		initialization.
+* @return
+* 	SET_NULL_ARGUMENT if a NULL was sent as set or element
+* 	SET_OUT_OF_MEMORY if an allocation failed (Meaning the function for copying
+* 	an element failed)
+*  SET_ITEM_ALREADY_EXISTS if an equal item already exists in the set
+* 	SET_SUCCESS the element has been inserted successfully
+*/
+SetResult setAdd(Set set, SetElement element) {
+	if ((set == NULL) || (element == NULL)) return SET_NULL_ARGUMENT;
+	set->iterator = NULL;
+	SetNode previous[MAX_LEVEL];
+	if (findNode(set, element, previous) != NULL)
+		return SET_ITEM_ALREADY_EXISTS;
+	int level = randomLevel(set);
+	SetNode node = createNode(level);
+	if (node == NULL) return SET_OUT_OF_MEMORY;
+	node->element = set->copyElement(element);
+	if (node->element == NULL) {
+		free(node);
+		return SET_OUT_OF_MEMORY;
+	}
+	for (; set->level < level; set->level++) {
+		previous[set->level] = set->head;
+	}
+	for (int i = 0; i < level; i++) {
+		node->next[i] = previous[i]->next[i];
+		previous[i]->next[i] = node;
+	}
+	set->size++;
+	return SET_SUCCESS;
+}
+
+/**
+* 	setRemove: Removes an element from the set. The element is found using the
+* 	comparison function given at initialization. Once found, the element is
+* 	removed and deallocated using the free function supplied at initialzation.
+*   Iterator's value is undefined after this operation.
+*
+* @param set -
+* 	The set to remove the element from.
+* @param element
+* 	The element to remove from the set.
+* @return
+* 	SET_NULL_ARGUMENT if a NULL was sent as set or element
+* 	SET_ITEM_DOES_NOT_EXIST if the element doesn't exist in the set
+* 	SET_SUCCESS if the element was successfully removed.
+*/
+SetResult setRemove(Set set, SetElement element) {
+	if ((set == NULL) || (element == NULL)) return SET_NULL_ARGUMENT;
+	SetNode node = unlinkNode(set, element);
+	if (node == NULL) return SET_ITEM_DOES_NOT_EXIST;
+	set->freeElement(node->element);
+	free(node);
+	return SET_SUCCESS;
+}
+
+/**
+*   setExtract: Removes an element from the set. The element is found using the
+*   comparison function given at initialization. Once found, the element is
+*   removed from the set **but not deallocated**.
+*   Iterator's value is undefined after this operation.
+*
+* @param set -
+*   The set to remove the element from.
+* @param element
+*   The element to remove from the set.
+* @return
+*   NULL if a NULL was sent as set or if the element doesn't exist in the set,
+*   the removed element otherwise.
+*/
+SetElement setExtract(Set set, SetElement element) {
+	if ((set == NULL) || (element == NULL)) return NULL;
+	SetNode node = unlinkNode(set, element);
+	if (node == NULL) return NULL;
+	SetElement extracted = node->element;
+	free(node);
+	return extracted;
+}
+
+/**
+* setClear: Removes all elements from target set.
+* The elements are deallocated using the stored free function
+* @param set
+* 	Target set to remove all element from
+* @return
+* 	SET_NULL_ARGUMENT - if a NULL pointer was sent.
+* 	SET_SUCCESS - Otherwise.
+*/
+SetResult setClear(Set set) {
+	if (set == NULL) return SET_NULL_ARGUMENT;
+	SetNode node = set->head->next[0];
+	while (node != NULL) {
+		SetNode next = node->next[0];
+		set->freeElement(node->element);
+		free(node);
+		node = next;
+	}
+	for (int i = 0; i < MAX_LEVEL; i++) set->head->next[i] = NULL;
+	set->level = 1;
+	set->size = 0;
+	set->iterator = NULL;
+	return SET_SUCCESS;
+}
+
+/**
+* setFilter: Creates a new set which contains the elements in the
+* source set that satisfy the logical condition passed as an argument.
+* @param set
+*   Source set to filter.
+* @return
+*   NULL if a NULL pointer was sent or memory allocation failed,
+*   the new filtered set otherwise.
+*/
+Set setFilter(Set set, logicalCondition condition) {
+	if ((set == NULL) || (condition == NULL)) return NULL;
+	Set filtered = setCreate(set->copyElement, set->freeElement,
+		set->compare);
+	if (filtered == NULL) return NULL;
+	SetNode last[MAX_LEVEL];
+	for (int i = 0; i < MAX_LEVEL; i++) last[i] = filtered->head;
+	for (SetNode node = set->head->next[0]; node != NULL;
+		node = node->next[0]) {
+		if (condition(node->element) &&
+			!appendElement(filtered, last, node->element)) {
+			setDestroy(filtered);
+			return NULL;
+		}
+	}
+	return filtered;
+}
+
+/*
+ * createNode: allocates a node of the given level, linked to nothing.
+ */
+static SetNode createNode(int level) {
+	SetNode node = malloc(sizeof(*node) + sizeof(SetNode) * level);
+	if (node == NULL) return NULL;
+	node->element = NULL;
+	node->level = level;
+	for (int i = 0; i < level; i++) node->next[i] = NULL;
+	return node;
+}
+
+/*
+ * findNode: finds the node of an element. if previous is not NULL, the last
+ * node before the element in each level of the set is saved in it. returns
+ * NULL if the element is not in the set.
+ */
+static SetNode findNode(Set set, SetElement element, SetNode* previous) {
+	SetNode node = set->head;
+	for (int i = set->level - 1; i >= 0; i--) {
+		while ((node->next[i] != NULL) &&
+			(set->compare(node->next[i]->element, element) < 0)) {
+			node = node->next[i];
+		}
+		if (previous != NULL) previous[i] = node;
+	}
+	node = node->next[0];
+	if ((node == NULL) || (set->compare(node->element, element) != 0))
+		return NULL;
+	return node;
+}
+
+/*
+ * randomLevel: draws the level of a new node, by a xorshift generator.
+ * each level is reached with a quarter of the chance of the level below.
+ */
+static int randomLevel(Set set) {
+	int level = 1;
+	while (level < MAX_LEVEL) {
+		set->seed ^= set->seed << 13;
+		set->seed ^= set->seed >> 17;
+		set->seed ^= set->seed << 5;
+		if ((set->seed & LEVEL_UP_MASK) != 0) break;
+		level++;
+	}
+	return level;
+}
+
+/*
+ * unlinkNode: takes the node of an element out of all the levels of the
+ * set, and returns it. returns NULL if the element is not in the set.
+ */
+static SetNode unlinkNode(Set set, SetElement element) {
+	set->iterator = NULL;
+	SetNode previous[MAX_LEVEL];
+	SetNode node = findNode(set, element, previous);
+	if (node == NULL) return NULL;
+	for (int i = 0; i < node->level; i++) {
+		previous[i]->next[i] = node->next[i];
+	}
+	while ((set->level > 1) && (set->head->next[set->level - 1] == NULL)) {
+		set->level--;
+	}
+	set->size--;
+	return node;
+}
+
+/*
+ * appendElement: adds a copy of an element greater than all the elements of
+ * the set after them, where last holds the last node of each level. returns
+ * false if allocations failed.
+ */
+static bool appendElement(Set set, SetNode* last, SetElement element) {
+	int level = randomLevel(set);
+	SetNode node = createNode(level);
+	if (node == NULL) return false;
+	node->element = set->copyElement(element);
+	if (node->element == NULL) {
+		free(node);
+		return false;
+	}
+	for (int i = 0; i < level; i++) {
+		last[i]->next[i] = node;
+		last[i] = node;
+	}
+	if (set->level < level) set->level = level;
+	set->size++;
+	return true;
+}
@@ -0,0 +1,212 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "set.h"
+#include "test_utilities.h"
+
+#define MANY_ELEMENTS 5000
+#define SCRAMBLE_FACTOR 7919
+
+static SetElement copyInt(SetElement element);
+static void freeInt(SetElement element);
+static int compareInts(SetElement first, SetElement second);
+static bool isEven(SetElement element);
+static bool isSetOrdered(Set set, int expected_size);
+static bool testSetCreate();
+static bool testSetAddRemove();
+static bool testSetIterate();
+static bool testSetExtract();
+static bool testSetCopyFilter();
+static bool testSetManyElements();
+int RunSetTest();
+
+//int main() {
+int RunSetTest() {
+	RUN_TEST(testSetCreate);
+	RUN_TEST(testSetAddRemove);
+	RUN_TEST(testSetIterate);
+	RUN_TEST(testSetExtract);
+	RUN_TEST(testSetCopyFilter);
+	RUN_TEST(testSetManyElements);
+	return 0;
+}
+
+/* copies an int element */
+static SetElement copyInt(SetElement element) {
+	int* copy = malloc(sizeof(*copy));
+	if (copy != NULL) *copy = *(int*)element;
+	return copy;
+}
+
+/* frees an int element */
+static void freeInt(SetElement element) {
+	free(element);
+}
+
+/* compares int elements */
+static int compareInts(SetElement first, SetElement second) {
+	int a = *(int*)first, b = *(int*)second;
+	return (a > b) - (a < b);
+}
+
+/* checks if an int element is even */
+static bool isEven(SetElement element) {
+	return *(int*)element % 2 == 0;
+}
+
+/* checks the set iterates its expected amount of elements in order */
+static bool isSetOrdered(Set set, int expected_size) {
+	int count = 0;
+	int* previous = NULL;
+	SET_FOREACH(int*, element, set) {
+		if ((previous != NULL) && (*previous >= *element)) return false;
+		previous = element;
+		count++;
+	}
+	return (count == expected_size) && (setGetSize(set) == expected_size);
+}
+
+/**
+ * Test create method
+ */
+static bool testSetCreate() {
+	ASSERT_TEST(setCreate(NULL, freeInt, compareInts) == NULL);
+	ASSERT_TEST(setCreate(copyInt, NULL, compareInts) == NULL);
+	ASSERT_TEST(setCreate(copyInt, freeInt, NULL) == NULL);
+	Set set = setCreate(copyInt, freeInt, compareInts);
+	ASSERT_TEST(set != NULL);
+	ASSERT_TEST(setGetSize(set) == 0);
+	ASSERT_TEST(setGetSize(NULL) == -1);
+	ASSERT_TEST(setGetFirst(set) == NULL);
+	ASSERT_TEST(setGetNext(set) == NULL);
+	ASSERT_TEST(setGetCurrent(set) == NULL);
+	setDestroy(set);
+	setDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test add, is in and remove methods
+ */
+static bool testSetAddRemove() {
+	Set set = setCreate(copyInt, freeInt, compareInts);
+	int values[] = {5, 1, 9, 3, 7};
+	for (int i = 0; i < 5; i++) {
+		ASSERT_TEST(setAdd(set, &values[i]) == SET_SUCCESS);
+	}
+	ASSERT_TEST(setAdd(set, &values[2]) == SET_ITEM_ALREADY_EXISTS);
+	ASSERT_TEST(setAdd(NULL, &values[0]) == SET_NULL_ARGUMENT);
+	ASSERT_TEST(setGetSize(set) == 5);
+	int missing = 4;
+	ASSERT_TEST(setIsIn(set, &values[3]));
+	ASSERT_TEST(!setIsIn(set, &missing));
+	ASSERT_TEST(!setIsIn(NULL, &missing));
+	ASSERT_TEST(setRemove(set, &missing) == SET_ITEM_DOES_NOT_EXIST);
+	ASSERT_TEST(setRemove(NULL, &missing) == SET_NULL_ARGUMENT);
+	ASSERT_TEST(setRemove(set, &values[0]) == SET_SUCCESS);
+	ASSERT_TEST(!setIsIn(set, &values[0]));
+	ASSERT_TEST(isSetOrdered(set, 4));
+	ASSERT_TEST(setClear(set) == SET_SUCCESS);
+	ASSERT_TEST(setClear(NULL) == SET_NULL_ARGUMENT);
+	ASSERT_TEST(isSetOrdered(set, 0));
+	ASSERT_TEST(setAdd(set, &values[0]) == SET_SUCCESS);
+	ASSERT_TEST(isSetOrdered(set, 1));
+	setDestroy(set);
+	return true;
+}
+
+/**
+ * Test the iterator walks the elements from the lowest
+ */
+static bool testSetIterate() {
+	Set set = setCreate(copyInt, freeInt, compareInts);
+	for (int i = 9; i >= 0; i--) {
+		ASSERT_TEST(setAdd(set, &i) == SET_SUCCESS);
+	}
+	int expected = 0;
+	SET_FOREACH(int*, element, set) {
+		ASSERT_TEST(*element == expected);
+		ASSERT_TEST(*(int*)setGetCurrent(set) == expected);
+		expected++;
+	}
+	ASSERT_TEST(expected == 10);
+	ASSERT_TEST(setGetCurrent(set) == NULL);
+	ASSERT_TEST(setGetNext(set) == NULL);
+	setDestroy(set);
+	return true;
+}
+
+/**
+ * Test extract method
+ */
+static bool testSetExtract() {
+	Set set = setCreate(copyInt, freeInt, compareInts);
+	int value = 3, missing = 4;
+	ASSERT_TEST(setAdd(set, &value) == SET_SUCCESS);
+	ASSERT_TEST(setExtract(set, &missing) == NULL);
+	ASSERT_TEST(setExtract(NULL, &value) == NULL);
+	int* extracted = setExtract(set, &value);
+	ASSERT_TEST((extracted != NULL) && (extracted != &value));
+	ASSERT_TEST(*extracted == 3);
+	ASSERT_TEST(setGetSize(set) == 0);
+	freeInt(extracted);
+	setDestroy(set);
+	return true;
+}
+
+/**
+ * Test copy and filter methods
+ */
+static bool testSetCopyFilter() {
+	Set set = setCreate(copyInt, freeInt, compareInts);
+	for (int i = 0; i < 100; i++) {
+		int value = (i * SCRAMBLE_FACTOR) % 100;
+		ASSERT_TEST(setAdd(set, &value) == SET_SUCCESS);
+	}
+	Set copy = setCopy(set);
+	ASSERT_TEST(isSetOrdered(copy, 100));
+	int value = 50;
+	ASSERT_TEST(setRemove(copy, &value) == SET_SUCCESS);
+	ASSERT_TEST(setIsIn(set, &value));
+	value = 100;
+	ASSERT_TEST(setAdd(copy, &value) == SET_SUCCESS);
+	ASSERT_TEST(isSetOrdered(copy, 100));
+
+	Set filtered = setFilter(set, isEven);
+	ASSERT_TEST(isSetOrdered(filtered, 50));
+	SET_FOREACH(int*, element, filtered) {
+		ASSERT_TEST(isEven(element));
+	}
+	value = 7;
+	ASSERT_TEST(setAdd(filtered, &value) == SET_SUCCESS);
+	ASSERT_TEST(isSetOrdered(filtered, 51));
+	ASSERT_TEST(setFilter(set, NULL) == NULL);
+	ASSERT_TEST(setCopy(NULL) == NULL);
+	setDestroy(filtered);
+	setDestroy(copy);
+	setDestroy(set);
+	return true;
+}
+
+/**
+ * Test a set of many elements added and removed in scrambled order
+ */
+static bool testSetManyElements() {
+	Set set = setCreate(copyInt, freeInt, compareInts);
+	for (int i = 0; i < MANY_ELEMENTS; i++) {
+		int value = (i * SCRAMBLE_FACTOR) % MANY_ELEMENTS;
+		ASSERT_TEST(setAdd(set, &value) == SET_SUCCESS);
+	}
+	ASSERT_TEST(isSetOrdered(set, MANY_ELEMENTS));
+	for (int i = 0; i < MANY_ELEMENTS; i += 2) {
+		int value = (i * SCRAMBLE_FACTOR) % MANY_ELEMENTS;
+		ASSERT_TEST(setRemove(set, &value) == SET_SUCCESS);
+	}
+	ASSERT_TEST(isSetOrdered(set, MANY_ELEMENTS / 2));
+	for (int i = 0; i < MANY_ELEMENTS; i++) {
+		int value = (i * SCRAMBLE_FACTOR) % MANY_ELEMENTS;
+		ASSERT_TEST(setIsIn(set, &value) == (i % 2 == 1));
+	}
+	setDestroy(set);
+	return true;
+}
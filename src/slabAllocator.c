@@ -0,0 +1,278 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "slabAllocator.h"
+
+#define NAME_WIDTH 24
+
+typedef struct freeBlock_t *FreeBlock;
+
+struct freeBlock_t {
+	FreeBlock next;
+};
+
+/*
+ * A slab starts with the link to the previous slab, padded to the
+ * alignment, followed by its blocks.
+ */
+typedef union slab_t *Slab;
+
+union slab_t {
+	Slab next;
+	char padding[SLAB_ALLOCATOR_ALIGNMENT];
+};
+
+struct slabAllocator_t {
+	Slab slabs;
+	long long slabs_count;
+	char* bump;
+	size_t bump_left;
+	FreeBlock free_blocks[SLAB_ALLOCATOR_CLASSES];
+	long long live_counts[SLAB_TYPES_COUNT];
+	long long live_bytes[SLAB_TYPES_COUNT];
+};
+
+static const char* type_names[SLAB_TYPES_COUNT] = {"client", "offer",
+	"agent details", "purchase bill", "string"};
+
+static int classOf(size_t size);
+static bool isValidType(SlabType type);
+static void* bumpBlock(SlabAllocator allocator, size_t block_size);
+static void pushFreeBlock(SlabAllocator allocator, int class_index,
+	void* block);
+
+/**
+* Allocates a new SlabAllocator, with no slabs.
+*
+* @return
+* 	NULL - if allocations failed.
+* 	A new SlabAllocator in case of success.
+*/
+SlabAllocator slabAllocatorCreate() {
+	return calloc(1, sizeof(struct slabAllocator_t));
+}
+
+/**
+* slabAllocatorDestroy: Deallocates an existing allocator and all its slabs.
+* Blocks larger than SLAB_ALLOCATOR_MAX_BLOCK must be freed before.
+*
+* @param allocator Target allocator to be deallocated.
+* If allocator is NULL nothing will be done
+*/
+void slabAllocatorDestroy(SlabAllocator allocator) {
+	if (allocator == NULL) return;
+	while (allocator->slabs != NULL) {
+		Slab next = allocator->slabs->next;
+		free(allocator->slabs);
+		allocator->slabs = next;
+	}
+	free(allocator);
+}
+
+/**
+* slabAllocatorAllocate: allocates a block.
+*
+* @param allocator the allocator, or NULL to use malloc.
+* @param type the type of the block.
+* @param size the size of the block.
+*
+* @return
+* 	NULL if allocations failed; else returns the block, aligned to
+* 	SLAB_ALLOCATOR_ALIGNMENT.
+*/
+void* slabAllocatorAllocate(SlabAllocator allocator, SlabType type,
+		size_t size) {
+	if ((allocator == NULL) || !isValidType(type)) return malloc(size);
+	void* block = NULL;
+	size_t block_size = size;
+	if (size > SLAB_ALLOCATOR_MAX_BLOCK) {
+		block = malloc(size);
+	} else {
+		int class_index = classOf(size);
+		block_size = (size_t)(class_index + 1) * SLAB_ALLOCATOR_ALIGNMENT;
+		block = allocator->free_blocks[class_index];
+		if (block != NULL) {
+			allocator->free_blocks[class_index] =
+				allocator->free_blocks[class_index]->next;
+		} else {
+			block = bumpBlock(allocator, block_size);
+		}
+	}
+	if (block != NULL) {
+		allocator->live_counts[type]++;
+		allocator->live_bytes[type] += block_size;
+	}
+	return block;
+}
+
+/**
+* slabAllocatorFree: frees a block allocated by slabAllocatorAllocate.
+*
+* @param allocator the allocator of the block, or NULL to use free.
+* @param type the type the block was allocated with.
+* @param block the block. If block is NULL nothing will be done
+* @param size the size the block was allocated with.
+*/
+void slabAllocatorFree(SlabAllocator allocator, SlabType type, void* block,
+		size_t size) {
+	if (block == NULL) return;
+	if ((allocator == NULL) || !isValidType(type)) {
+		free(block);
+		return;
+	}
+	size_t block_size = size;
+	if (size > SLAB_ALLOCATOR_MAX_BLOCK) {
+		free(block);
+	} else {
+		int class_index = classOf(size);
+		block_size = (size_t)(class_index + 1) * SLAB_ALLOCATOR_ALIGNMENT;
+		pushFreeBlock(allocator, class_index, block);
+	}
+	allocator->live_counts[type]--;
+	allocator->live_bytes[type] -= block_size;
+}
+
+/**
+* slabAllocatorDuplicateString: allocates a copy of a string, of type
+* SLAB_STRING.
+*
+* @param allocator the allocator, or NULL to use malloc.
+* @param string the string.
+*
+* @return
+* 	NULL if string is NULL or allocations failed; else returns the copy.
+*/
+char* slabAllocatorDuplicateString(SlabAllocator allocator,
+		const char* string) {
+	if (string == NULL) return NULL;
+	size_t size = strlen(string) + 1;
+	char* copy = slabAllocatorAllocate(allocator, SLAB_STRING, size);
+	if (copy != NULL) memcpy(copy, string, size);
+	return copy;
+}
+
+/**
+* slabAllocatorFreeString: frees a string copied by
+* slabAllocatorDuplicateString.
+*
+* @param allocator the allocator of the string, or NULL to use free.
+* @param string the string. If string is NULL nothing will be done
+*/
+void slabAllocatorFreeString(SlabAllocator allocator, char* string) {
+	if (string == NULL) return;
+	slabAllocatorFree(allocator, SLAB_STRING, string, strlen(string) + 1);
+}
+
+/**
+* slabAllocatorGetLiveCount: returns the amount of blocks of a type which
+* are allocated and not freed.
+*
+* @param allocator the allocator.
+* @param type the type.
+*
+* @return
+* 	0 if allocator is NULL or type is not valid; else returns the amount.
+*/
+long long slabAllocatorGetLiveCount(SlabAllocator allocator, SlabType type) {
+	if ((allocator == NULL) || !isValidType(type)) return 0;
+	return allocator->live_counts[type];
+}
+
+/**
+* slabAllocatorGetLiveBytes: returns the bytes the live blocks of a type
+* take, rounded up to their size classes.
+*
+* @param allocator the allocator.
+* @param type the type.
+*
+* @return
+* 	0 if allocator is NULL or type is not valid; else returns the bytes.
+*/
+long long slabAllocatorGetLiveBytes(SlabAllocator allocator, SlabType type) {
+	if ((allocator == NULL) || !isValidType(type)) return 0;
+	return allocator->live_bytes[type];
+}
+
+/**
+* slabAllocatorGetSlabsCount: returns the amount of slabs of the allocator.
+*
+* @param allocator the allocator.
+*
+* @return
+* 	0 if allocator is NULL; else returns the amount of slabs.
+*/
+long long slabAllocatorGetSlabsCount(SlabAllocator allocator) {
+	return (allocator == NULL) ? 0 : allocator->slabs_count;
+}
+
+/**
+* slabAllocatorPrint: prints the live count and bytes of every type, and
+* the amount and size of the slabs.
+*
+* @param allocator the allocator.
+* @param output the stream to print to.
+*/
+void slabAllocatorPrint(SlabAllocator allocator, FILE* output) {
+	if ((allocator == NULL) || (output == NULL)) return;
+	fprintf(output, "%-*s %12s %12s\n", NAME_WIDTH, "live blocks", "count",
+		"bytes");
+	for (int type = 0; type < SLAB_TYPES_COUNT; type++) {
+		fprintf(output, "%-*s %12lld %12lld\n", NAME_WIDTH, type_names[type],
+			allocator->live_counts[type], allocator->live_bytes[type]);
+	}
+	fprintf(output, "%-*s %12lld %12lld\n", NAME_WIDTH, "slabs",
+		allocator->slabs_count,
+		allocator->slabs_count * SLAB_ALLOCATOR_SLAB_SIZE);
+}
+
+/*
+ * classOf: returns the size class of a block size, at most
+ * SLAB_ALLOCATOR_MAX_BLOCK.
+ */
+static int classOf(size_t size) {
+	if (size == 0) return 0;
+	return (int)((size - 1) / SLAB_ALLOCATOR_ALIGNMENT);
+}
+
+/*
+ * isValidType: checks a block type is one the allocator counts.
+ */
+static bool isValidType(SlabType type) {
+	return (type >= 0) && (type < SLAB_TYPES_COUNT);
+}
+
+/*
+ * bumpBlock: carves a new block from the current slab, and starts a new
+ * slab if the current one is full. the rest of a full slab is kept as a
+ * free block of its size.
+ */
+static void* bumpBlock(SlabAllocator allocator, size_t block_size) {
+	if (allocator->bump_left < block_size) {
+		Slab slab = malloc(SLAB_ALLOCATOR_SLAB_SIZE);
+		if (slab == NULL) return NULL;
+		if (allocator->bump_left >= SLAB_ALLOCATOR_ALIGNMENT) {
+			pushFreeBlock(allocator, classOf(allocator->bump_left -
+				allocator->bump_left % SLAB_ALLOCATOR_ALIGNMENT),
+				allocator->bump);
+		}
+		slab->next = allocator->slabs;
+		allocator->slabs = slab;
+		allocator->slabs_count++;
+		allocator->bump = (char*)(slab + 1);
+		allocator->bump_left = SLAB_ALLOCATOR_SLAB_SIZE - sizeof(*slab);
+	}
+	void* block = allocator->bump;
+	allocator->bump += block_size;
+	allocator->bump_left -= block_size;
+	return block;
+}
+
+/*
+ * pushFreeBlock: adds a block to the free list of its class.
+ */
+static void pushFreeBlock(SlabAllocator allocator, int class_index,
+		void* block) {
+	FreeBlock free_block = block;
+	free_block->next = allocator->free_blocks[class_index];
+	allocator->free_blocks[class_index] = free_block;
+}
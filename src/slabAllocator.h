@@ -0,0 +1,148 @@
+#ifndef SRC_SLABALLOCATOR_H_
+#define SRC_SLABALLOCATOR_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+/**
+* An allocator of the small entities of a service and their strings.
+*
+* Blocks are carved by bumping a pointer through large slabs, in size
+* classes of SLAB_ALLOCATOR_ALIGNMENT bytes. A freed block goes to the free
+* list of its class and is reused by the next block of the class, so the
+* entities of a service stay packed in its slabs instead of spreading over
+* the heap. Destroying the allocator releases all the slabs at once.
+*
+* Blocks larger than SLAB_ALLOCATOR_MAX_BLOCK are allocated with malloc.
+* A NULL allocator allocates every block with malloc, so entities created
+* without an allocator keep working the same way.
+*/
+#define SLAB_ALLOCATOR_ALIGNMENT 16
+#define SLAB_ALLOCATOR_CLASSES 16
+#define SLAB_ALLOCATOR_MAX_BLOCK \
+	(SLAB_ALLOCATOR_ALIGNMENT * SLAB_ALLOCATOR_CLASSES)
+#define SLAB_ALLOCATOR_SLAB_SIZE (64 * 1024)
+
+typedef struct slabAllocator_t *SlabAllocator;
+
+/**
+* The types of blocks the allocator counts.
+*/
+typedef enum {
+	SLAB_CLIENT = 0,
+	SLAB_OFFER = 1,
+	SLAB_AGENT_DETAILS = 2,
+	SLAB_PURCHASE_BILL = 3,
+	SLAB_STRING = 4,
+	SLAB_TYPES_COUNT = 5
+} SlabType;
+
+/**
+* Allocates a new SlabAllocator, with no slabs.
+*
+* @return
+* 	NULL - if allocations failed.
+* 	A new SlabAllocator in case of success.
+*/
+SlabAllocator slabAllocatorCreate();
+
+/**
+* slabAllocatorDestroy: Deallocates an existing allocator and all its slabs.
+* Blocks larger than SLAB_ALLOCATOR_MAX_BLOCK must be freed before.
+*
+* @param allocator Target allocator to be deallocated.
+* If allocator is NULL nothing will be done
+*/
+void slabAllocatorDestroy(SlabAllocator allocator);
+
+/**
+* slabAllocatorAllocate: allocates a block.
+*
+* @param allocator the allocator, or NULL to use malloc.
+* @param type the type of the block.
+* @param size the size of the block.
+*
+* @return
+* 	NULL if allocations failed; else returns the block, aligned to
+* 	SLAB_ALLOCATOR_ALIGNMENT.
+*/
+void* slabAllocatorAllocate(SlabAllocator allocator, SlabType type,
+	size_t size);
+
+/**
+* slabAllocatorFree: frees a block allocated by slabAllocatorAllocate.
+*
+* @param allocator the allocator of the block, or NULL to use free.
+* @param type the type the block was allocated with.
+* @param block the block. If block is NULL nothing will be done
+* @param size the size the block was allocated with.
+*/
+void slabAllocatorFree(SlabAllocator allocator, SlabType type, void* block,
+	size_t size);
+
+/**
+* slabAllocatorDuplicateString: allocates a copy of a string, of type
+* SLAB_STRING.
+*
+* @param allocator the allocator, or NULL to use malloc.
+* @param string the string.
+*
+* @return
+* 	NULL if string is NULL or allocations failed; else returns the copy.
+*/
+char* slabAllocatorDuplicateString(SlabAllocator allocator,
+	const char* string);
+
+/**
+* slabAllocatorFreeString: frees a string copied by
+* slabAllocatorDuplicateString.
+*
+* @param allocator the allocator of the string, or NULL to use free.
+* @param string the string. If string is NULL nothing will be done
+*/
+void slabAllocatorFreeString(SlabAllocator allocator, char* string);
+
+/**
+* slabAllocatorGetLiveCount: returns the amount of blocks of a type which
+* are allocated and not freed.
+*
+* @param allocator the allocator.
+* @param type the type.
+*
+* @return
+* 	0 if allocator is NULL or type is not valid; else returns the amount.
+*/
+long long slabAllocatorGetLiveCount(SlabAllocator allocator, SlabType type);
+
+/**
+* slabAllocatorGetLiveBytes: returns the bytes the live blocks of a type
+* take, rounded up to their size classes.
+*
+* @param allocator the allocator.
+* @param type the type.
+*
+* @return
+* 	0 if allocator is NULL or type is not valid; else returns the bytes.
+*/
+long long slabAllocatorGetLiveBytes(SlabAllocator allocator, SlabType type);
+
+/**
+* slabAllocatorGetSlabsCount: returns the amount of slabs of the allocator.
+*
+* @param allocator the allocator.
+*
+* @return
+* 	0 if allocator is NULL; else returns the amount of slabs.
+*/
+long long slabAllocatorGetSlabsCount(SlabAllocator allocator);
+
+/**
+* slabAllocatorPrint: prints the live count and bytes of every type, and
+* the amount and size of the slabs.
+*
+* @param allocator the allocator.
+* @param output the stream to print to.
+*/
+void slabAllocatorPrint(SlabAllocator allocator, FILE* output);
+
+#endif /* SRC_SLABALLOCATOR_H_ */
@@ -0,0 +1,157 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "slabAllocator.h"
+#include "test_utilities.h"
+
+#define MANY_BLOCKS 10000
+
+static bool testSlabAllocatorCreate();
+static bool testSlabAllocatorAllocateFree();
+static bool testSlabAllocatorReuse();
+static bool testSlabAllocatorStrings();
+static bool testSlabAllocatorManyBlocks();
+int RunSlabAllocatorTest();
+
+//int main() {
+int RunSlabAllocatorTest() {
+	RUN_TEST(testSlabAllocatorCreate);
+	RUN_TEST(testSlabAllocatorAllocateFree);
+	RUN_TEST(testSlabAllocatorReuse);
+	RUN_TEST(testSlabAllocatorStrings);
+	RUN_TEST(testSlabAllocatorManyBlocks);
+	return 0;
+}
+
+/**
+ * Test create method
+ */
+static bool testSlabAllocatorCreate() {
+	SlabAllocator allocator = slabAllocatorCreate();
+	ASSERT_TEST(allocator != NULL);
+	ASSERT_TEST(slabAllocatorGetSlabsCount(allocator) == 0);
+	for (int type = 0; type < SLAB_TYPES_COUNT; type++) {
+		ASSERT_TEST(slabAllocatorGetLiveCount(allocator, type) == 0);
+		ASSERT_TEST(slabAllocatorGetLiveBytes(allocator, type) == 0);
+	}
+	ASSERT_TEST(slabAllocatorGetLiveCount(NULL, SLAB_CLIENT) == 0);
+	ASSERT_TEST(slabAllocatorGetSlabsCount(NULL) == 0);
+	slabAllocatorDestroy(allocator);
+	slabAllocatorDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test allocate and free methods
+ */
+static bool testSlabAllocatorAllocateFree() {
+	SlabAllocator allocator = slabAllocatorCreate();
+	void* client = slabAllocatorAllocate(allocator, SLAB_CLIENT, 24);
+	void* offer = slabAllocatorAllocate(allocator, SLAB_OFFER, 40);
+	void* large = slabAllocatorAllocate(allocator, SLAB_OFFER,
+		SLAB_ALLOCATOR_MAX_BLOCK + 1);
+	ASSERT_TEST((client != NULL) && (offer != NULL) && (large != NULL));
+	ASSERT_TEST((uintptr_t)client % SLAB_ALLOCATOR_ALIGNMENT == 0);
+	ASSERT_TEST((uintptr_t)offer % SLAB_ALLOCATOR_ALIGNMENT == 0);
+	memset(client, 0, 24);
+	memset(offer, 0, 40);
+	ASSERT_TEST(slabAllocatorGetSlabsCount(allocator) == 1);
+	ASSERT_TEST(slabAllocatorGetLiveCount(allocator, SLAB_CLIENT) == 1);
+	ASSERT_TEST(slabAllocatorGetLiveBytes(allocator, SLAB_CLIENT) == 32);
+	ASSERT_TEST(slabAllocatorGetLiveCount(allocator, SLAB_OFFER) == 2);
+	ASSERT_TEST(slabAllocatorGetLiveBytes(allocator, SLAB_OFFER) ==
+		48 + SLAB_ALLOCATOR_MAX_BLOCK + 1);
+
+	slabAllocatorFree(allocator, SLAB_OFFER, large,
+		SLAB_ALLOCATOR_MAX_BLOCK + 1);
+	slabAllocatorFree(allocator, SLAB_OFFER, offer, 40);
+	slabAllocatorFree(allocator, SLAB_CLIENT, client, 24);
+	slabAllocatorFree(allocator, SLAB_CLIENT, NULL, 24);
+	ASSERT_TEST(slabAllocatorGetLiveCount(allocator, SLAB_CLIENT) == 0);
+	ASSERT_TEST(slabAllocatorGetLiveBytes(allocator, SLAB_OFFER) == 0);
+
+	void* block = slabAllocatorAllocate(NULL, SLAB_CLIENT, 24);
+	ASSERT_TEST(block != NULL);
+	slabAllocatorFree(NULL, SLAB_CLIENT, block, 24);
+	slabAllocatorDestroy(allocator);
+	return true;
+}
+
+/**
+ * Test freed blocks are reused by blocks of their size class
+ */
+static bool testSlabAllocatorReuse() {
+	SlabAllocator allocator = slabAllocatorCreate();
+	void* first = slabAllocatorAllocate(allocator, SLAB_CLIENT, 24);
+	void* second = slabAllocatorAllocate(allocator, SLAB_CLIENT, 24);
+	ASSERT_TEST(first != second);
+	slabAllocatorFree(allocator, SLAB_CLIENT, first, 24);
+	void* other_class = slabAllocatorAllocate(allocator, SLAB_OFFER, 40);
+	ASSERT_TEST(other_class != first);
+	void* same_class = slabAllocatorAllocate(allocator, SLAB_PURCHASE_BILL,
+		17);
+	ASSERT_TEST(same_class == first);
+	ASSERT_TEST(slabAllocatorGetLiveCount(allocator, SLAB_CLIENT) == 1);
+	ASSERT_TEST(slabAllocatorGetLiveCount(allocator, SLAB_PURCHASE_BILL) == 1);
+	slabAllocatorDestroy(allocator);
+	return true;
+}
+
+/**
+ * Test string methods
+ */
+static bool testSlabAllocatorStrings() {
+	SlabAllocator allocator = slabAllocatorCreate();
+	char* copy = slabAllocatorDuplicateString(allocator, "company");
+	ASSERT_TEST(copy != NULL);
+	ASSERT_TEST(strcmp(copy, "company") == 0);
+	ASSERT_TEST(slabAllocatorGetLiveCount(allocator, SLAB_STRING) == 1);
+	ASSERT_TEST(slabAllocatorGetLiveBytes(allocator, SLAB_STRING) == 16);
+	ASSERT_TEST(slabAllocatorDuplicateString(allocator, NULL) == NULL);
+	slabAllocatorFreeString(allocator, copy);
+	slabAllocatorFreeString(allocator, NULL);
+	ASSERT_TEST(slabAllocatorGetLiveCount(allocator, SLAB_STRING) == 0);
+
+	char* heap_copy = slabAllocatorDuplicateString(NULL, "company");
+	ASSERT_TEST(strcmp(heap_copy, "company") == 0);
+	slabAllocatorFreeString(NULL, heap_copy);
+	slabAllocatorDestroy(allocator);
+	return true;
+}
+
+/**
+ * Test blocks spread over several slabs and are released with them
+ */
+static bool testSlabAllocatorManyBlocks() {
+	SlabAllocator allocator = slabAllocatorCreate();
+	void** blocks = malloc(MANY_BLOCKS * sizeof(*blocks));
+	ASSERT_TEST(blocks != NULL);
+	for (int i = 0; i < MANY_BLOCKS; i++) {
+		size_t size = (i % 2 == 0) ? 24 : 100;
+		blocks[i] = slabAllocatorAllocate(allocator, SLAB_OFFER, size);
+		ASSERT_TEST(blocks[i] != NULL);
+		memset(blocks[i], i % 256, size);
+	}
+	long long slabs = slabAllocatorGetSlabsCount(allocator);
+	ASSERT_TEST(slabs > 1);
+	ASSERT_TEST(slabAllocatorGetLiveCount(allocator, SLAB_OFFER) ==
+		MANY_BLOCKS);
+	for (int i = 0; i < MANY_BLOCKS; i++) {
+		unsigned char* block = blocks[i];
+		ASSERT_TEST(block[0] == i % 256);
+		if (i % 4 < 2) {
+			slabAllocatorFree(allocator, SLAB_OFFER, blocks[i],
+				(i % 2 == 0) ? 24 : 100);
+		}
+	}
+	for (int i = 0; i < MANY_BLOCKS / 2; i++) {
+		ASSERT_TEST(slabAllocatorAllocate(allocator, SLAB_OFFER,
+			(i % 2 == 0) ? 24 : 100) != NULL);
+	}
+	ASSERT_TEST(slabAllocatorGetSlabsCount(allocator) == slabs);
+	free(blocks);
+	slabAllocatorDestroy(allocator);
+	return true;
+}
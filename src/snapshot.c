@@ -0,0 +1,285 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "snapshot.h"
+
+#define INT_SIZE 4
+#define SEQUENCE_OFFSET (SNAPSHOT_MAGIC_SIZE + INT_SIZE)
+
+struct snapshotWriter_t {
+	FILE* file;
+};
+
+struct snapshotReader_t {
+	const unsigned char* data;
+	size_t size;
+	size_t position;
+	long long sequence;
+};
+
+static void writeUnsigned(unsigned char* buffer, uint32_t value);
+static uint32_t readUnsigned(const unsigned char* buffer);
+
+/**
+* Allocates a new SnapshotWriter, and writes the snapshot header.
+*
+* @param file the file to write to, must outlive the writer.
+* @param sequence the snapshot sequence, not negative.
+* @param result pointer to save the writer in.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS - if file or result are NULL, or sequence is
+* 		negative.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY - if allocations failed.
+*
+* 	SNAPSHOT_WRITE_FAILED - if writing the header failed.
+*
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult snapshotWriterCreate(FILE* file, long long sequence,
+	SnapshotWriter* result) {
+	if ((file == NULL) || (sequence < 0) || (result == NULL)) {
+		return SNAPSHOT_NULL_PARAMETERS;
+	}
+	SnapshotWriter writer = malloc(sizeof(*writer));
+	if (writer == NULL) return SNAPSHOT_OUT_OF_MEMORY;
+	writer->file = file;
+	unsigned char header[SNAPSHOT_HEADER_SIZE];
+	memcpy(header, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+	writeUnsigned(header + SNAPSHOT_MAGIC_SIZE, SNAPSHOT_VERSION);
+	writeUnsigned(header + SEQUENCE_OFFSET, (uint32_t)sequence);
+	writeUnsigned(header + SEQUENCE_OFFSET + INT_SIZE,
+		(uint32_t)((unsigned long long)sequence >> 32));
+	if (fwrite(header, sizeof(header), 1, file) != 1) {
+		free(writer);
+		return SNAPSHOT_WRITE_FAILED;
+	}
+	*result = writer;
+	return SNAPSHOT_SUCCESS;
+}
+
+/**
+* snapshotWriteInt: writes an integer.
+*
+* @param writer the writer.
+* @param value the integer.
+*
+* @return
+* 	false if writer is NULL or writing failed; else returns true.
+*/
+bool snapshotWriteInt(SnapshotWriter writer, int value) {
+	if (writer == NULL) return false;
+	unsigned char buffer[INT_SIZE];
+	writeUnsigned(buffer, (uint32_t)value);
+	return fwrite(buffer, INT_SIZE, 1, writer->file) == 1;
+}
+
+/**
+* snapshotWriteString: writes a string.
+*
+* @param writer the writer.
+* @param string the string.
+*
+* @return
+* 	false if a parameter is NULL or writing failed; else returns true.
+*/
+bool snapshotWriteString(SnapshotWriter writer, const char* string) {
+	if ((writer == NULL) || (string == NULL)) return false;
+	size_t length = strlen(string);
+	if (length > INT32_MAX) return false;
+	return snapshotWriteInt(writer, (int)length) &&
+		(fwrite(string, length + 1, 1, writer->file) == 1);
+}
+
+/**
+* snapshotWriteBytes: writes raw bytes.
+*
+* @param writer the writer.
+* @param bytes the bytes.
+* @param size the amount of bytes.
+*
+* @return
+* 	false if a parameter is NULL or writing failed; else returns true.
+*/
+bool snapshotWriteBytes(SnapshotWriter writer, const unsigned char* bytes,
+	size_t size) {
+	if ((writer == NULL) || (bytes == NULL)) return false;
+	return (size == 0) || (fwrite(bytes, size, 1, writer->file) == 1);
+}
+
+/**
+* snapshotWriterDestroy: Deallocates an existing writer. the file is not
+* closed.
+*
+* @param writer Target writer to be deallocated.
+* If writer is NULL nothing will be done
+*/
+void snapshotWriterDestroy(SnapshotWriter writer) {
+	free(writer);
+}
+
+/**
+* Allocates a new SnapshotReader over snapshot data, and checks its header.
+*
+* @param data the snapshot data, must outlive the reader and the strings
+* 	read from it.
+* @param size the data size.
+* @param result pointer to save the reader in.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS - if data or result are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT - if the data is not a snapshot.
+*
+* 	SNAPSHOT_UNSUPPORTED_VERSION - if the snapshot version is not supported.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY - if allocations failed.
+*
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult snapshotReaderCreate(const char* data, size_t size,
+	SnapshotReader* result) {
+	if ((data == NULL) || (result == NULL)) return SNAPSHOT_NULL_PARAMETERS;
+	const unsigned char* header = (const unsigned char*)data;
+	if ((size < SNAPSHOT_HEADER_SIZE) ||
+		(memcmp(header, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0)) {
+		return SNAPSHOT_BAD_FORMAT;
+	}
+	if (readUnsigned(header + SNAPSHOT_MAGIC_SIZE) != SNAPSHOT_VERSION) {
+		return SNAPSHOT_UNSUPPORTED_VERSION;
+	}
+	uint64_t sequence = ((uint64_t)readUnsigned(header + SEQUENCE_OFFSET +
+		INT_SIZE) << 32) | readUnsigned(header + SEQUENCE_OFFSET);
+	if (sequence > INT64_MAX) return SNAPSHOT_BAD_FORMAT;
+	SnapshotReader reader = malloc(sizeof(*reader));
+	if (reader == NULL) return SNAPSHOT_OUT_OF_MEMORY;
+	reader->data = header;
+	reader->size = size;
+	reader->position = SNAPSHOT_HEADER_SIZE;
+	reader->sequence = (long long)sequence;
+	*result = reader;
+	return SNAPSHOT_SUCCESS;
+}
+
+/**
+* snapshotReaderGetSequence: returns the sequence of the snapshot.
+*
+* @param reader the reader.
+*
+* @return
+* 	0 if reader is NULL; else returns the sequence written in the header.
+*/
+long long snapshotReaderGetSequence(SnapshotReader reader) {
+	return (reader == NULL) ? 0 : reader->sequence;
+}
+
+/**
+* snapshotReadInt: reads an integer.
+*
+* @param reader the reader.
+* @param value pointer to save the integer in.
+*
+* @return
+* 	false if a parameter is NULL or the data ended; else returns true.
+*/
+bool snapshotReadInt(SnapshotReader reader, int* value) {
+	if ((reader == NULL) || (value == NULL) ||
+		(reader->size - reader->position < INT_SIZE)) return false;
+	*value = (int)(int32_t)readUnsigned(reader->data + reader->position);
+	reader->position += INT_SIZE;
+	return true;
+}
+
+/**
+* snapshotReadString: reads a string. the string points into the snapshot
+* data, and must not be modified.
+*
+* @param reader the reader.
+* @param string pointer to save the string in.
+*
+* @return
+* 	false if a parameter is NULL, the data ended or the string is not
+* 	terminated; else returns true.
+*/
+bool snapshotReadString(SnapshotReader reader, const char** string) {
+	if ((reader == NULL) || (string == NULL)) return false;
+	size_t position = reader->position;
+	int length = 0;
+	if (!snapshotReadInt(reader, &length)) return false;
+	size_t left = reader->size - reader->position;
+	if ((length < 0) || (left == 0) || ((size_t)length > left - 1) ||
+		(reader->data[reader->position + length] != '\0')) {
+		reader->position = position;
+		return false;
+	}
+	*string = (const char*)(reader->data + reader->position);
+	reader->position += (size_t)length + 1;
+	return true;
+}
+
+/**
+* snapshotReadBytes: reads raw bytes. the bytes point into the snapshot
+* data.
+*
+* @param reader the reader.
+* @param bytes pointer to save the bytes in.
+* @param size the amount of bytes.
+*
+* @return
+* 	false if a parameter is NULL or the data ended; else returns true.
+*/
+bool snapshotReadBytes(SnapshotReader reader, const unsigned char** bytes,
+	size_t size) {
+	if ((reader == NULL) || (bytes == NULL) ||
+		(reader->size - reader->position < size)) return false;
+	*bytes = reader->data + reader->position;
+	reader->position += size;
+	return true;
+}
+
+/**
+* snapshotReaderIsDone: checks if all the data was read.
+*
+* @param reader the reader.
+*
+* @return
+* 	true if reader is not NULL and all the data was read; else false.
+*/
+bool snapshotReaderIsDone(SnapshotReader reader) {
+	return (reader != NULL) && (reader->position == reader->size);
+}
+
+/**
+* snapshotReaderDestroy: Deallocates an existing reader.
+*
+* @param reader Target reader to be deallocated.
+* If reader is NULL nothing will be done
+*/
+void snapshotReaderDestroy(SnapshotReader reader) {
+	free(reader);
+}
+
+/*
+* writeUnsigned: writes a 32 bit value in little endian order.
+*/
+static void writeUnsigned(unsigned char* buffer, uint32_t value) {
+	for (int i = 0; i < INT_SIZE; i++) {
+		buffer[i] = (unsigned char)(value >> (8 * i));
+	}
+}
+
+/*
+* readUnsigned: reads a 32 bit value in little endian order.
+*/
+static uint32_t readUnsigned(const unsigned char* buffer) {
+	uint32_t value = 0;
+	for (int i = INT_SIZE - 1; i >= 0; i--) {
+		value = (value << 8) | buffer[i];
+	}
+	return value;
+}
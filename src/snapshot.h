@@ -0,0 +1,196 @@
+#ifndef SRC_SNAPSHOT_H_
+#define SRC_SNAPSHOT_H_
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+* The binary snapshot format.
+*
+* A snapshot starts with a header: the 8 bytes of SNAPSHOT_MAGIC, the
+* format version as a 32 bit little endian integer and the snapshot sequence
+* as a 64 bit little endian integer. The sequence is the last command of the
+* write ahead log the snapshot includes, so recovery replays only the
+* commands after it. The rest is written and read in order by the modules
+* owning the state, out of these fields:
+* 	- integers, 32 bit little endian.
+* 	- strings, their length as an integer, followed by the characters and
+* 		a NUL character, so they can be used in place.
+* 	- raw bytes, of a length both sides know.
+*/
+#define SNAPSHOT_MAGIC "YAD3SNAP"
+#define SNAPSHOT_MAGIC_SIZE 8
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_HEADER_SIZE (SNAPSHOT_MAGIC_SIZE + 4 + 8)
+
+typedef struct snapshotWriter_t *SnapshotWriter;
+typedef struct snapshotReader_t *SnapshotReader;
+
+/**
+* This type defines end codes for the methods.
+*/
+typedef enum {
+	SNAPSHOT_NULL_PARAMETERS = 0,
+	SNAPSHOT_OUT_OF_MEMORY = 1,
+	SNAPSHOT_BAD_FORMAT = 2,
+	SNAPSHOT_UNSUPPORTED_VERSION = 3,
+	SNAPSHOT_WRITE_FAILED = 4,
+	SNAPSHOT_SUCCESS = 5
+} SnapshotResult;
+
+/**
+* Allocates a new SnapshotWriter, and writes the snapshot header.
+*
+* @param file the file to write to, must outlive the writer.
+* @param sequence the snapshot sequence, not negative.
+* @param result pointer to save the writer in.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS - if file or result are NULL, or sequence is
+* 		negative.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY - if allocations failed.
+*
+* 	SNAPSHOT_WRITE_FAILED - if writing the header failed.
+*
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult snapshotWriterCreate(FILE* file, long long sequence,
+	SnapshotWriter* result);
+
+/**
+* snapshotWriteInt: writes an integer.
+*
+* @param writer the writer.
+* @param value the integer.
+*
+* @return
+* 	false if writer is NULL or writing failed; else returns true.
+*/
+bool snapshotWriteInt(SnapshotWriter writer, int value);
+
+/**
+* snapshotWriteString: writes a string.
+*
+* @param writer the writer.
+* @param string the string.
+*
+* @return
+* 	false if a parameter is NULL or writing failed; else returns true.
+*/
+bool snapshotWriteString(SnapshotWriter writer, const char* string);
+
+/**
+* snapshotWriteBytes: writes raw bytes.
+*
+* @param writer the writer.
+* @param bytes the bytes.
+* @param size the amount of bytes.
+*
+* @return
+* 	false if a parameter is NULL or writing failed; else returns true.
+*/
+bool snapshotWriteBytes(SnapshotWriter writer, const unsigned char* bytes,
+	size_t size);
+
+/**
+* snapshotWriterDestroy: Deallocates an existing writer. the file is not
+* closed.
+*
+* @param writer Target writer to be deallocated.
+* If writer is NULL nothing will be done
+*/
+void snapshotWriterDestroy(SnapshotWriter writer);
+
+/**
+* Allocates a new SnapshotReader over snapshot data, and checks its header.
+*
+* @param data the snapshot data, must outlive the reader and the strings
+* 	read from it.
+* @param size the data size.
+* @param result pointer to save the reader in.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS - if data or result are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT - if the data is not a snapshot.
+*
+* 	SNAPSHOT_UNSUPPORTED_VERSION - if the snapshot version is not supported.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY - if allocations failed.
+*
+* 	SNAPSHOT_SUCCESS - in case of success.
+*/
+SnapshotResult snapshotReaderCreate(const char* data, size_t size,
+	SnapshotReader* result);
+
+/**
+* snapshotReaderGetSequence: returns the sequence of the snapshot.
+*
+* @param reader the reader.
+*
+* @return
+* 	0 if reader is NULL; else returns the sequence written in the header.
+*/
+long long snapshotReaderGetSequence(SnapshotReader reader);
+
+/**
+* snapshotReadInt: reads an integer.
+*
+* @param reader the reader.
+* @param value pointer to save the integer in.
+*
+* @return
+* 	false if a parameter is NULL or the data ended; else returns true.
+*/
+bool snapshotReadInt(SnapshotReader reader, int* value);
+
+/**
+* snapshotReadString: reads a string. the string points into the snapshot
+* data, and must not be modified.
+*
+* @param reader the reader.
+* @param string pointer to save the string in.
+*
+* @return
+* 	false if a parameter is NULL, the data ended or the string is not
+* 	terminated; else returns true.
+*/
+bool snapshotReadString(SnapshotReader reader, const char** string);
+
+/**
+* snapshotReadBytes: reads raw bytes. the bytes point into the snapshot
+* data.
+*
+* @param reader the reader.
+* @param bytes pointer to save the bytes in.
+* @param size the amount of bytes.
+*
+* @return
+* 	false if a parameter is NULL or the data ended; else returns true.
+*/
+bool snapshotReadBytes(SnapshotReader reader, const unsigned char** bytes,
+	size_t size);
+
+/**
+* snapshotReaderIsDone: checks if all the data was read.
+*
+* @param reader the reader.
+*
+* @return
+* 	true if reader is not NULL and all the data was read; else false.
+*/
+bool snapshotReaderIsDone(SnapshotReader reader);
+
+/**
+* snapshotReaderDestroy: Deallocates an existing reader.
+*
+* @param reader Target reader to be deallocated.
+* If reader is NULL nothing will be done
+*/
+void snapshotReaderDestroy(SnapshotReader reader);
+
+#endif /* SRC_SNAPSHOT_H_ */
@@ -0,0 +1,148 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "snapshot.h"
+#include "test_utilities.h"
+
+#define SEQUENCE ((1LL << 40) + 5)
+
+static bool testSnapshotWriterCreate();
+static bool testSnapshotReaderCreate();
+static bool testSnapshotRoundTrip();
+static bool testSnapshotTruncated();
+int RunSnapshotTest();
+
+//int main() {
+int RunSnapshotTest() {
+	RUN_TEST(testSnapshotWriterCreate);
+	RUN_TEST(testSnapshotReaderCreate);
+	RUN_TEST(testSnapshotRoundTrip);
+	RUN_TEST(testSnapshotTruncated);
+	return 0;
+}
+
+/* Writes a snapshot of a few fields to memory, returns its size */
+static size_t writeSnapshot(char* data, size_t capacity) {
+	FILE* file = tmpfile();
+	if (file == NULL) return 0;
+	SnapshotWriter writer = NULL;
+	const unsigned char bytes[] = {0x00, 0xA5, 0xFF};
+	size_t size = 0;
+	if ((snapshotWriterCreate(file, SEQUENCE, &writer) == SNAPSHOT_SUCCESS) &&
+		snapshotWriteInt(writer, -7) &&
+		snapshotWriteString(writer, "baba@ganosh") &&
+		snapshotWriteString(writer, "") &&
+		snapshotWriteBytes(writer, bytes, sizeof(bytes)) &&
+		snapshotWriteInt(writer, 123456789)) {
+		rewind(file);
+		size = fread(data, 1, capacity, file);
+	}
+	snapshotWriterDestroy(writer);
+	fclose(file);
+	return size;
+}
+
+/**
+ * Test writer create method
+ */
+static bool testSnapshotWriterCreate() {
+	SnapshotWriter writer = NULL;
+	ASSERT_TEST(snapshotWriterCreate(NULL, 0, &writer) ==
+		SNAPSHOT_NULL_PARAMETERS);
+	ASSERT_TEST(snapshotWriterCreate(stdout, 0, NULL) ==
+		SNAPSHOT_NULL_PARAMETERS);
+	ASSERT_TEST(snapshotWriterCreate(stdout, -1, &writer) ==
+		SNAPSHOT_NULL_PARAMETERS);
+	ASSERT_TEST(!snapshotWriteInt(NULL, 1));
+	ASSERT_TEST(!snapshotWriteString(NULL, "a"));
+	snapshotWriterDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test reader create method
+ */
+static bool testSnapshotReaderCreate() {
+	char data[SNAPSHOT_HEADER_SIZE] = SNAPSHOT_MAGIC;
+	SnapshotReader reader = NULL;
+	ASSERT_TEST(snapshotReaderCreate(NULL, 0, &reader) ==
+		SNAPSHOT_NULL_PARAMETERS);
+	ASSERT_TEST(snapshotReaderCreate(data, 0, NULL) ==
+		SNAPSHOT_NULL_PARAMETERS);
+	ASSERT_TEST(snapshotReaderCreate(data, SNAPSHOT_HEADER_SIZE - 1,
+		&reader) == SNAPSHOT_BAD_FORMAT);
+	ASSERT_TEST(snapshotReaderCreate(data, SNAPSHOT_HEADER_SIZE,
+		&reader) == SNAPSHOT_UNSUPPORTED_VERSION);
+	data[SNAPSHOT_MAGIC_SIZE] = SNAPSHOT_VERSION;
+	ASSERT_TEST(snapshotReaderCreate(data, SNAPSHOT_HEADER_SIZE,
+		&reader) == SNAPSHOT_SUCCESS);
+	ASSERT_TEST(snapshotReaderIsDone(reader));
+	ASSERT_TEST(snapshotReaderGetSequence(reader) == 0);
+	int value = 0;
+	ASSERT_TEST(!snapshotReadInt(reader, &value));
+	snapshotReaderDestroy(reader);
+	data[SNAPSHOT_HEADER_SIZE - 1] = (char)0x80;
+	ASSERT_TEST(snapshotReaderCreate(data, SNAPSHOT_HEADER_SIZE,
+		&reader) == SNAPSHOT_BAD_FORMAT);
+	ASSERT_TEST(snapshotReaderGetSequence(NULL) == 0);
+	data[0] = 'X';
+	ASSERT_TEST(snapshotReaderCreate(data, SNAPSHOT_HEADER_SIZE,
+		&reader) == SNAPSHOT_BAD_FORMAT);
+	snapshotReaderDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test fields are read as they were written
+ */
+static bool testSnapshotRoundTrip() {
+	char data[128];
+	size_t size = writeSnapshot(data, sizeof(data));
+	ASSERT_TEST(size == SNAPSHOT_HEADER_SIZE + 4 + 16 + 5 + 3 + 4);
+	SnapshotReader reader = NULL;
+	ASSERT_TEST(snapshotReaderCreate(data, size, &reader) ==
+		SNAPSHOT_SUCCESS);
+	ASSERT_TEST(snapshotReaderGetSequence(reader) == SEQUENCE);
+	int value = 0;
+	const char* string = NULL;
+	const unsigned char* bytes = NULL;
+	ASSERT_TEST(snapshotReadInt(reader, &value) && (value == -7));
+	ASSERT_TEST(snapshotReadString(reader, &string));
+	ASSERT_TEST(strcmp(string, "baba@ganosh") == 0);
+	ASSERT_TEST(snapshotReadString(reader, &string) && (string[0] == '\0'));
+	ASSERT_TEST(snapshotReadBytes(reader, &bytes, 3));
+	ASSERT_TEST((bytes[0] == 0x00) && (bytes[1] == 0xA5) &&
+		(bytes[2] == 0xFF));
+	ASSERT_TEST(!snapshotReaderIsDone(reader));
+	ASSERT_TEST(snapshotReadInt(reader, &value) && (value == 123456789));
+	ASSERT_TEST(snapshotReaderIsDone(reader));
+	snapshotReaderDestroy(reader);
+	return true;
+}
+
+/**
+ * Test truncated and unterminated fields are not read
+ */
+static bool testSnapshotTruncated() {
+	char data[128];
+	size_t size = writeSnapshot(data, sizeof(data));
+	SnapshotReader reader = NULL;
+	int value = 0;
+	const char* string = NULL;
+	const unsigned char* bytes = NULL;
+	ASSERT_TEST(snapshotReaderCreate(data, SNAPSHOT_HEADER_SIZE + 10,
+		&reader) == SNAPSHOT_SUCCESS);
+	ASSERT_TEST(snapshotReadInt(reader, &value));
+	ASSERT_TEST(!snapshotReadString(reader, &string));
+	ASSERT_TEST(!snapshotReadBytes(reader, &bytes, 7));
+	ASSERT_TEST(snapshotReadBytes(reader, &bytes, 6));
+	snapshotReaderDestroy(reader);
+	data[SNAPSHOT_HEADER_SIZE + 4 + 4 + 11] = 'x';
+	ASSERT_TEST(snapshotReaderCreate(data, size, &reader) ==
+		SNAPSHOT_SUCCESS);
+	ASSERT_TEST(snapshotReadInt(reader, &value));
+	ASSERT_TEST(!snapshotReadString(reader, &string));
+	snapshotReaderDestroy(reader);
+	return true;
+}
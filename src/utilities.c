@@ -2,8 +2,12 @@
 #include <string.h>
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "utilities.h"
 
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+
 static int getDigitsCount(int number);
 //static char* getSubString(char* str, int start_index, int end_index);
 
@@ -124,3 +128,19 @@ int stringToInt(const char* string)
     if (string[0] == '-') return -1 * number;
     return number;
 }
+
+/*
+* hashString: hashes a string with the 32 bit FNV-1a hash.
+*
+* @param string the string.
+*
+* @return
+* 	the hash
+ */
+unsigned int hashString(const char* string) {
+	uint32_t hash = FNV_OFFSET_BASIS;
+	for (const char* c = string; *c != END_OF_STRING; c++) {
+		hash = (hash ^ (unsigned char)*c) * FNV_PRIME;
+	}
+	return hash;
+}
@@ -60,4 +60,14 @@ int countChar(char* string, char value);
  */
 int stringToInt(const char* string);
 
+/*
+* hashString: hashes a string with the 32 bit FNV-1a hash.
+*
+* @param string the string.
+*
+* @return
+* 	the hash
+ */
+unsigned int hashString(const char* string);
+
 #endif /* SRC_UTILITIES_H_ */
@@ -0,0 +1,421 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "workloadGenerator.h"
+
+#define MAX_TAX_PERCENTAGE 100
+#define MAX_PRICE_HUNDREDS 1000
+#define PRICE_UNIT 100
+#define MAX_REPORT_COUNT 10
+#define COMPANIES_COUNT 97
+#define WALL_CHAR 'w'
+#define EMPTY_CHAR 'e'
+#define WALLS_IN_TEN 3
+
+struct workloadGenerator_t {
+	WorkloadConfig config;
+	uint64_t state;
+	double* realtors_popularity;
+	double* customers_popularity;
+	char* matrix;
+	int weights_sum;
+};
+
+static const char* COMMAND_NAMES[WORKLOAD_COMMAND_KINDS] = {
+	"realtor add",
+	"realtor remove",
+	"realtor add_apartment_service",
+	"realtor remove_apartment_service",
+	"realtor add_apartment",
+	"realtor remove_apartment",
+	"customer add",
+	"customer remove",
+	"customer make_offer",
+	"realtor respond_to_offer",
+	"customer purchase",
+	"report relevant_realtors",
+	"report significant_realtors",
+	"report most_paying_customers"
+};
+
+static bool isConfigValid(const WorkloadConfig* config);
+static double* createPopularity(int count, double exponent);
+static uint64_t nextRandom(WorkloadGenerator generator);
+static int randomInRange(WorkloadGenerator generator, int min, int max);
+static int drawPopular(WorkloadGenerator generator, const double* popularity,
+	int count);
+static int drawKind(WorkloadGenerator generator);
+static void writeCommand(WorkloadGenerator generator, FILE* output,
+	WorkloadCommandKind kind);
+static void writeApartment(WorkloadGenerator generator, FILE* output,
+	int realtor, int service, int id);
+static void writeCustomer(WorkloadGenerator generator, FILE* output,
+	int customer);
+
+/**
+* workloadConfigSetDefault: fills a config with a mix of all the commands
+* over a few hundred users.
+*
+* @param config the config to fill.
+*/
+void workloadConfigSetDefault(WorkloadConfig* config) {
+	if (config == NULL) return;
+	config->seed = 1;
+	config->realtors = 200;
+	config->customers = 400;
+	config->services_per_realtor = 3;
+	config->apartments_per_service = 10;
+	config->service_capacity = 20;
+	config->zipf_exponent = 1.0;
+	config->min_matrix_side = 1;
+	config->max_matrix_side = 8;
+	static const int weights[WORKLOAD_COMMAND_KINDS] = {
+		2, 1, 3, 1, 20, 4, 4, 1, 15, 10, 8, 4, 3, 3
+	};
+	for (int i = 0; i < WORKLOAD_COMMAND_KINDS; i++) {
+		config->weights[i] = weights[i];
+	}
+}
+
+/**
+* workloadCommandName: returns the user and action words of a command kind.
+*
+* @param kind the command kind.
+*
+* @return
+* 	NULL if kind is out of range; else returns the command name
+*/
+const char* workloadCommandName(WorkloadCommandKind kind) {
+	if ((kind < 0) || (kind >= WORKLOAD_COMMAND_KINDS)) return NULL;
+	return COMMAND_NAMES[kind];
+}
+
+/**
+* Allocates a new WorkloadGenerator, which writes command files in the
+* program input grammar. The same config always gives the same commands.
+*
+* @param config the workload shape, copied.
+*
+* @return
+* 	NULL - if config is NULL, has a non positive amount, a negative weight
+* 		or exponent, matrix sides out of order or allocations failed.
+* 	A new WorkloadGenerator in case of success.
+*/
+WorkloadGenerator workloadGeneratorCreate(const WorkloadConfig* config) {
+	if ((config == NULL) || (!isConfigValid(config))) return NULL;
+	WorkloadGenerator generator = malloc(sizeof(*generator));
+	if (generator == NULL) return NULL;
+	generator->config = *config;
+	generator->state = config->seed * 0x9E3779B97F4A7C15ULL + 1;
+	generator->realtors_popularity = createPopularity(config->realtors,
+		config->zipf_exponent);
+	generator->customers_popularity = createPopularity(config->customers,
+		config->zipf_exponent);
+	int side = config->max_matrix_side;
+	generator->matrix = malloc(sizeof(char) * (side * side + 1));
+	if ((generator->realtors_popularity == NULL) ||
+		(generator->customers_popularity == NULL) ||
+		(generator->matrix == NULL)) {
+		workloadGeneratorDestroy(generator);
+		return NULL;
+	}
+	generator->weights_sum = 0;
+	for (int i = 0; i < WORKLOAD_COMMAND_KINDS; i++) {
+		generator->weights_sum += config->weights[i];
+	}
+	return generator;
+}
+
+/**
+* workloadGeneratorWritePopulation: writes the commands adding every
+* realtor, service, apartment and customer of the workload.
+*
+* @param generator the generator.
+* @param output the file to write to.
+* @param count pointer to save the amount of written commands in, or NULL.
+*
+* @return
+*
+* 	WORKLOAD_GENERATOR_NULL_PARAMETERS - if generator or output are NULL.
+*
+* 	WORKLOAD_GENERATOR_WRITE_FAILED - if writing failed.
+*
+* 	WORKLOAD_GENERATOR_SUCCESS - in case of success.
+*/
+WorkloadGeneratorResult workloadGeneratorWritePopulation(
+	WorkloadGenerator generator, FILE* output, int* count) {
+	if ((generator == NULL) || (output == NULL)) {
+		return WORKLOAD_GENERATOR_NULL_PARAMETERS;
+	}
+	const WorkloadConfig* config = &generator->config;
+	int written = 0;
+	for (int realtor = 0; realtor < config->realtors; realtor++) {
+		fprintf(output, "realtor add realtor%d@yad3.com company%d %d\n",
+			realtor, realtor % COMPANIES_COUNT,
+			randomInRange(generator, 1, MAX_TAX_PERCENTAGE));
+		written++;
+		for (int service = 0; service < config->services_per_realtor;
+			service++) {
+			fprintf(output, "realtor add_apartment_service "
+				"realtor%d@yad3.com service%d %d\n", realtor, service,
+				config->service_capacity);
+			written++;
+			for (int id = 0; id < config->apartments_per_service; id++) {
+				writeApartment(generator, output, realtor, service, id);
+				written++;
+			}
+		}
+	}
+	for (int customer = 0; customer < config->customers; customer++) {
+		writeCustomer(generator, output, customer);
+		written++;
+	}
+	if (count != NULL) *count = written;
+	return ferror(output) ? WORKLOAD_GENERATOR_WRITE_FAILED :
+		WORKLOAD_GENERATOR_SUCCESS;
+}
+
+/**
+* workloadGeneratorWriteCommands: writes random commands over the workload
+* users.
+*
+* @param generator the generator.
+* @param output the file to write to.
+* @param count the amount of commands to write.
+* @param kind the kind of all the commands, or WORKLOAD_MIXED to draw each
+* 	kind by the config weights.
+*
+* @return
+*
+* 	WORKLOAD_GENERATOR_NULL_PARAMETERS - if generator or output are NULL.
+*
+* 	WORKLOAD_GENERATOR_INVALID_PARAMETERS - if count is negative, kind is
+* 		out of range, or all the weights of a mixed workload are 0.
+*
+* 	WORKLOAD_GENERATOR_WRITE_FAILED - if writing failed.
+*
+* 	WORKLOAD_GENERATOR_SUCCESS - in case of success.
+*/
+WorkloadGeneratorResult workloadGeneratorWriteCommands(
+	WorkloadGenerator generator, FILE* output, int count, int kind) {
+	if ((generator == NULL) || (output == NULL)) {
+		return WORKLOAD_GENERATOR_NULL_PARAMETERS;
+	}
+	if ((count < 0) || (kind < WORKLOAD_MIXED) ||
+		(kind >= WORKLOAD_COMMAND_KINDS) ||
+		((kind == WORKLOAD_MIXED) && (generator->weights_sum == 0))) {
+		return WORKLOAD_GENERATOR_INVALID_PARAMETERS;
+	}
+	for (int i = 0; i < count; i++) {
+		writeCommand(generator, output,
+			(kind == WORKLOAD_MIXED) ? drawKind(generator) : kind);
+	}
+	return ferror(output) ? WORKLOAD_GENERATOR_WRITE_FAILED :
+		WORKLOAD_GENERATOR_SUCCESS;
+}
+
+/**
+* workloadGeneratorDestroy: Deallocates an existing generator.
+*
+* @param generator Target generator to be deallocated.
+* If generator is NULL nothing will be done
+*/
+void workloadGeneratorDestroy(WorkloadGenerator generator) {
+	if (generator == NULL) return;
+	free(generator->realtors_popularity);
+	free(generator->customers_popularity);
+	free(generator->matrix);
+	free(generator);
+}
+
+/*
+* isConfigValid: checks the amounts of a config are positive, and its
+* weights, exponent and matrix sides make sense.
+*/
+static bool isConfigValid(const WorkloadConfig* config) {
+	if ((config->realtors <= 0) || (config->customers <= 0) ||
+		(config->services_per_realtor <= 0) ||
+		(config->apartments_per_service <= 0) ||
+		(config->service_capacity <= 0) || (config->zipf_exponent < 0) ||
+		(config->min_matrix_side <= 0) ||
+		(config->max_matrix_side < config->min_matrix_side)) return false;
+	for (int i = 0; i < WORKLOAD_COMMAND_KINDS; i++) {
+		if (config->weights[i] < 0) return false;
+	}
+	return true;
+}
+
+/*
+* createPopularity: builds the cumulative Zipf distribution over count
+* ranks, where rank r is drawn in proportion to 1 / (r + 1) ^ exponent.
+*
+* @return
+* 	NULL in case of allocation error; else returns the distribution.
+*/
+static double* createPopularity(int count, double exponent) {
+	double* popularity = malloc(sizeof(*popularity) * count);
+	if (popularity == NULL) return NULL;
+	double sum = 0;
+	for (int rank = 0; rank < count; rank++) {
+		sum += 1.0 / pow(rank + 1, exponent);
+		popularity[rank] = sum;
+	}
+	for (int rank = 0; rank < count; rank++) {
+		popularity[rank] /= sum;
+	}
+	return popularity;
+}
+
+/*
+* nextRandom: advances the generator xorshift64* state, so the workload
+* does not depend on the platform rand.
+*/
+static uint64_t nextRandom(WorkloadGenerator generator) {
+	generator->state ^= generator->state >> 12;
+	generator->state ^= generator->state << 25;
+	generator->state ^= generator->state >> 27;
+	return generator->state * 0x2545F4914F6CDD1DULL;
+}
+
+/*
+* randomInRange: draws a number between min and max, both included.
+*/
+static int randomInRange(WorkloadGenerator generator, int min, int max) {
+	return min + (int)(nextRandom(generator) % (uint64_t)(max - min + 1));
+}
+
+/*
+* drawPopular: draws a rank from a cumulative distribution, by a binary
+* search for the first rank covering a uniform draw.
+*/
+static int drawPopular(WorkloadGenerator generator, const double* popularity,
+	int count) {
+	double draw = (nextRandom(generator) >> 11) * (1.0 / 9007199254740992.0);
+	int low = 0, high = count - 1;
+	while (low < high) {
+		int middle = low + (high - low) / 2;
+		if (popularity[middle] > draw) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
+	}
+	return low;
+}
+
+/*
+* drawKind: draws a command kind by the config weights.
+*/
+static int drawKind(WorkloadGenerator generator) {
+	int draw = randomInRange(generator, 0, generator->weights_sum - 1);
+	int kind = 0;
+	while (draw >= generator->config.weights[kind]) {
+		draw -= generator->config.weights[kind];
+		kind++;
+	}
+	return kind;
+}
+
+/*
+* writeCommand: writes a single random command of the given kind.
+*/
+static void writeCommand(WorkloadGenerator generator, FILE* output,
+	WorkloadCommandKind kind) {
+	const WorkloadConfig* config = &generator->config;
+	int realtor = drawPopular(generator, generator->realtors_popularity,
+		config->realtors);
+	int customer = drawPopular(generator, generator->customers_popularity,
+		config->customers);
+	int service = randomInRange(generator, 0, config->services_per_realtor - 1);
+	int id = randomInRange(generator, 0, config->apartments_per_service - 1);
+	const char* name = COMMAND_NAMES[kind];
+	switch (kind) {
+		case WORKLOAD_ADD_REALTOR:
+			fprintf(output, "%s realtor%d@yad3.com company%d %d\n", name,
+				realtor, realtor % COMPANIES_COUNT,
+				randomInRange(generator, 1, MAX_TAX_PERCENTAGE));
+			break;
+		case WORKLOAD_ADD_SERVICE:
+			fprintf(output, "%s realtor%d@yad3.com service%d %d\n", name,
+				realtor, service, config->service_capacity);
+			break;
+		case WORKLOAD_REMOVE_SERVICE:
+			fprintf(output, "%s realtor%d@yad3.com service%d\n", name,
+				realtor, service);
+			break;
+		case WORKLOAD_ADD_APARTMENT:
+			writeApartment(generator, output, realtor, service, id);
+			break;
+		case WORKLOAD_REMOVE_APARTMENT:
+			fprintf(output, "%s realtor%d@yad3.com service%d %d\n", name,
+				realtor, service, id);
+			break;
+		case WORKLOAD_ADD_CUSTOMER:
+			writeCustomer(generator, output, customer);
+			break;
+		case WORKLOAD_REMOVE_CUSTOMER:
+		case WORKLOAD_RELEVANT_REALTORS:
+			fprintf(output, "%s customer%d@yad3.com\n", name, customer);
+			break;
+		case WORKLOAD_MAKE_OFFER:
+			fprintf(output, "%s customer%d@yad3.com realtor%d@yad3.com "
+				"service%d %d %d\n", name, customer, realtor, service, id,
+				randomInRange(generator, 1, MAX_PRICE_HUNDREDS) * PRICE_UNIT);
+			break;
+		case WORKLOAD_RESPOND_TO_OFFER:
+			fprintf(output, "%s realtor%d@yad3.com customer%d@yad3.com %s\n",
+				name, realtor, customer,
+				randomInRange(generator, 0, 1) ? "accept" : "decline");
+			break;
+		case WORKLOAD_PURCHASE:
+			fprintf(output, "%s customer%d@yad3.com realtor%d@yad3.com "
+				"service%d %d\n", name, customer, realtor, service, id);
+			break;
+		case WORKLOAD_SIGNIFICANT_REALTORS:
+		case WORKLOAD_MOST_PAYING_CUSTOMERS:
+			fprintf(output, "%s %d\n", name,
+				randomInRange(generator, 1, MAX_REPORT_COUNT));
+			break;
+		case WORKLOAD_REMOVE_REALTOR:
+		default:
+			fprintf(output, "%s realtor%d@yad3.com\n", name, realtor);
+			break;
+	}
+}
+
+/*
+* writeApartment: writes a command adding an apartment with a random price
+* and a random matrix of the configured sides.
+*/
+static void writeApartment(WorkloadGenerator generator, FILE* output,
+	int realtor, int service, int id) {
+	const WorkloadConfig* config = &generator->config;
+	int width = randomInRange(generator, config->min_matrix_side,
+		config->max_matrix_side);
+	int height = randomInRange(generator, config->min_matrix_side,
+		config->max_matrix_side);
+	for (int i = 0; i < width * height; i++) {
+		generator->matrix[i] = (randomInRange(generator, 0, 9) < WALLS_IN_TEN) ?
+			WALL_CHAR : EMPTY_CHAR;
+	}
+	generator->matrix[width * height] = '\0';
+	fprintf(output, "realtor add_apartment realtor%d@yad3.com service%d "
+		"%d %d %d %d %s\n", realtor, service, id,
+		randomInRange(generator, 1, MAX_PRICE_HUNDREDS) * PRICE_UNIT, width,
+		height, generator->matrix);
+}
+
+/*
+* writeCustomer: writes a command adding a customer with random
+* restrictions.
+*/
+static void writeCustomer(WorkloadGenerator generator, FILE* output,
+	int customer) {
+	int side = generator->config.max_matrix_side;
+	fprintf(output, "customer add customer%d@yad3.com %d %d %d\n", customer,
+		randomInRange(generator, 0, side * side / 2),
+		randomInRange(generator, 0, side / 2 + 1),
+		randomInRange(generator, 1, MAX_PRICE_HUNDREDS) * PRICE_UNIT);
+}
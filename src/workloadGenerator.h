@@ -0,0 +1,146 @@
+#ifndef SRC_WORKLOADGENERATOR_H_
+#define SRC_WORKLOADGENERATOR_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+
+typedef struct workloadGenerator_t *WorkloadGenerator;
+
+/**
+* The kinds of commands a workload is made of.
+*/
+typedef enum {
+	WORKLOAD_ADD_REALTOR,
+	WORKLOAD_REMOVE_REALTOR,
+	WORKLOAD_ADD_SERVICE,
+	WORKLOAD_REMOVE_SERVICE,
+	WORKLOAD_ADD_APARTMENT,
+	WORKLOAD_REMOVE_APARTMENT,
+	WORKLOAD_ADD_CUSTOMER,
+	WORKLOAD_REMOVE_CUSTOMER,
+	WORKLOAD_MAKE_OFFER,
+	WORKLOAD_RESPOND_TO_OFFER,
+	WORKLOAD_PURCHASE,
+	WORKLOAD_RELEVANT_REALTORS,
+	WORKLOAD_SIGNIFICANT_REALTORS,
+	WORKLOAD_MOST_PAYING_CUSTOMERS,
+	WORKLOAD_COMMAND_KINDS
+} WorkloadCommandKind;
+
+/** Draw the commands by the configured mix weights */
+#define WORKLOAD_MIXED (-1)
+
+/**
+* The shape of a workload.
+*
+* realtors and customers are the amounts of distinct emails of each type.
+* the email a command uses is drawn from a Zipf distribution with the given
+* exponent, so a few emails are used by most commands; 0 draws uniformly.
+* weights are the relative amounts of each command kind in a mixed workload.
+*/
+typedef struct {
+	unsigned long seed;
+	int realtors;
+	int customers;
+	int services_per_realtor;
+	int apartments_per_service;
+	int service_capacity;
+	double zipf_exponent;
+	int min_matrix_side;
+	int max_matrix_side;
+	int weights[WORKLOAD_COMMAND_KINDS];
+} WorkloadConfig;
+
+/**
+* This type defines end codes for the methods.
+*/
+typedef enum {
+	WORKLOAD_GENERATOR_NULL_PARAMETERS = 0,
+	WORKLOAD_GENERATOR_INVALID_PARAMETERS = 1,
+	WORKLOAD_GENERATOR_WRITE_FAILED = 2,
+	WORKLOAD_GENERATOR_SUCCESS = 3
+} WorkloadGeneratorResult;
+
+/**
+* workloadConfigSetDefault: fills a config with a mix of all the commands
+* over a few hundred users.
+*
+* @param config the config to fill.
+*/
+void workloadConfigSetDefault(WorkloadConfig* config);
+
+/**
+* workloadCommandName: returns the user and action words of a command kind.
+*
+* @param kind the command kind.
+*
+* @return
+* 	NULL if kind is out of range; else returns the command name
+*/
+const char* workloadCommandName(WorkloadCommandKind kind);
+
+/**
+* Allocates a new WorkloadGenerator, which writes command files in the
+* program input grammar. The same config always gives the same commands.
+*
+* @param config the workload shape, copied.
+*
+* @return
+* 	NULL - if config is NULL, has a non positive amount, a negative weight
+* 		or exponent, matrix sides out of order or allocations failed.
+* 	A new WorkloadGenerator in case of success.
+*/
+WorkloadGenerator workloadGeneratorCreate(const WorkloadConfig* config);
+
+/**
+* workloadGeneratorWritePopulation: writes the commands adding every
+* realtor, service, apartment and customer of the workload.
+*
+* @param generator the generator.
+* @param output the file to write to.
+* @param count pointer to save the amount of written commands in, or NULL.
+*
+* @return
+*
+* 	WORKLOAD_GENERATOR_NULL_PARAMETERS - if generator or output are NULL.
+*
+* 	WORKLOAD_GENERATOR_WRITE_FAILED - if writing failed.
+*
+* 	WORKLOAD_GENERATOR_SUCCESS - in case of success.
+*/
+WorkloadGeneratorResult workloadGeneratorWritePopulation(
+	WorkloadGenerator generator, FILE* output, int* count);
+
+/**
+* workloadGeneratorWriteCommands: writes random commands over the workload
+* users.
+*
+* @param generator the generator.
+* @param output the file to write to.
+* @param count the amount of commands to write.
+* @param kind the kind of all the commands, or WORKLOAD_MIXED to draw each
+* 	kind by the config weights.
+*
+* @return
+*
+* 	WORKLOAD_GENERATOR_NULL_PARAMETERS - if generator or output are NULL.
+*
+* 	WORKLOAD_GENERATOR_INVALID_PARAMETERS - if count is negative, kind is
+* 		out of range, or all the weights of a mixed workload are 0.
+*
+* 	WORKLOAD_GENERATOR_WRITE_FAILED - if writing failed.
+*
+* 	WORKLOAD_GENERATOR_SUCCESS - in case of success.
+*/
+WorkloadGeneratorResult workloadGeneratorWriteCommands(
+	WorkloadGenerator generator, FILE* output, int count, int kind);
+
+/**
+* workloadGeneratorDestroy: Deallocates an existing generator.
+*
+* @param generator Target generator to be deallocated.
+* If generator is NULL nothing will be done
+*/
+void workloadGeneratorDestroy(WorkloadGenerator generator);
+
+#endif /* SRC_WORKLOADGENERATOR_H_ */
@@ -0,0 +1,166 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include "workloadGenerator.h"
+#include "test_utilities.h"
+
+#define TEST_TEXT_CAPACITY 4096
+#define TEST_DRAWS 1000
+
+static bool testWorkloadGeneratorCreate();
+static bool testWorkloadGeneratorPopulation();
+static bool testWorkloadGeneratorCommands();
+static bool testWorkloadGeneratorSkew();
+static size_t readBack(FILE* file, char* text);
+int RunWorkloadGeneratorTest();
+
+//int main() {
+int RunWorkloadGeneratorTest() {
+	RUN_TEST(testWorkloadGeneratorCreate);
+	RUN_TEST(testWorkloadGeneratorPopulation);
+	RUN_TEST(testWorkloadGeneratorCommands);
+	RUN_TEST(testWorkloadGeneratorSkew);
+	return 0;
+}
+
+/**
+ * Test create method
+ */
+static bool testWorkloadGeneratorCreate() {
+	WorkloadConfig config;
+	workloadConfigSetDefault(&config);
+	ASSERT_TEST(workloadGeneratorCreate(NULL) == NULL);
+	config.realtors = 0;
+	ASSERT_TEST(workloadGeneratorCreate(&config) == NULL);
+	workloadConfigSetDefault(&config);
+	config.max_matrix_side = config.min_matrix_side - 1;
+	ASSERT_TEST(workloadGeneratorCreate(&config) == NULL);
+	workloadConfigSetDefault(&config);
+	config.weights[WORKLOAD_PURCHASE] = -1;
+	ASSERT_TEST(workloadGeneratorCreate(&config) == NULL);
+	workloadConfigSetDefault(&config);
+	WorkloadGenerator generator = workloadGeneratorCreate(&config);
+	ASSERT_TEST(generator != NULL);
+	ASSERT_TEST(strcmp(workloadCommandName(WORKLOAD_MAKE_OFFER),
+		"customer make_offer") == 0);
+	ASSERT_TEST(workloadCommandName(WORKLOAD_COMMAND_KINDS) == NULL);
+	workloadGeneratorDestroy(generator);
+	workloadGeneratorDestroy(NULL);
+	return true;
+}
+
+/**
+ * Test the population adds every user, service and apartment
+ */
+static bool testWorkloadGeneratorPopulation() {
+	WorkloadConfig config;
+	workloadConfigSetDefault(&config);
+	config.realtors = 2;
+	config.customers = 3;
+	config.services_per_realtor = 2;
+	config.apartments_per_service = 2;
+	WorkloadGenerator generator = workloadGeneratorCreate(&config);
+	FILE* file = tmpfile();
+	int count = 0;
+	ASSERT_TEST(workloadGeneratorWritePopulation(generator, NULL, &count) ==
+		WORKLOAD_GENERATOR_NULL_PARAMETERS);
+	ASSERT_TEST(workloadGeneratorWritePopulation(generator, file, &count) ==
+		WORKLOAD_GENERATOR_SUCCESS);
+	ASSERT_TEST(count == 2 * (1 + 2 * (1 + 2)) + 3);
+	char text[TEST_TEXT_CAPACITY];
+	readBack(file, text);
+	ASSERT_TEST(strncmp(text, "realtor add realtor0@yad3.com company0 ",
+		strlen("realtor add realtor0@yad3.com company0 ")) == 0);
+	ASSERT_TEST(strstr(text, "realtor add_apartment_service "
+		"realtor1@yad3.com service1 20\n") != NULL);
+	ASSERT_TEST(strstr(text, "realtor add_apartment realtor1@yad3.com "
+		"service1 1 ") != NULL);
+	ASSERT_TEST(strstr(text, "customer add customer2@yad3.com ") != NULL);
+	fclose(file);
+	workloadGeneratorDestroy(generator);
+	return true;
+}
+
+/**
+ * Test commands are of the asked kind, and the same for the same seed
+ */
+static bool testWorkloadGeneratorCommands() {
+	WorkloadConfig config;
+	workloadConfigSetDefault(&config);
+	WorkloadGenerator first = workloadGeneratorCreate(&config);
+	WorkloadGenerator second = workloadGeneratorCreate(&config);
+	FILE* first_file = tmpfile();
+	FILE* second_file = tmpfile();
+	ASSERT_TEST(workloadGeneratorWriteCommands(first, first_file, -1,
+		WORKLOAD_MIXED) == WORKLOAD_GENERATOR_INVALID_PARAMETERS);
+	ASSERT_TEST(workloadGeneratorWriteCommands(first, first_file, 1,
+		WORKLOAD_COMMAND_KINDS) == WORKLOAD_GENERATOR_INVALID_PARAMETERS);
+	ASSERT_TEST(workloadGeneratorWriteCommands(first, first_file, 20,
+		WORKLOAD_MIXED) == WORKLOAD_GENERATOR_SUCCESS);
+	ASSERT_TEST(workloadGeneratorWriteCommands(second, second_file, 20,
+		WORKLOAD_MIXED) == WORKLOAD_GENERATOR_SUCCESS);
+	char first_text[TEST_TEXT_CAPACITY];
+	char second_text[TEST_TEXT_CAPACITY];
+	ASSERT_TEST(readBack(first_file, first_text) > 0);
+	readBack(second_file, second_text);
+	ASSERT_TEST(strcmp(first_text, second_text) == 0);
+	fclose(second_file);
+	second_file = tmpfile();
+	ASSERT_TEST(workloadGeneratorWriteCommands(second, second_file, 5,
+		WORKLOAD_MOST_PAYING_CUSTOMERS) == WORKLOAD_GENERATOR_SUCCESS);
+	readBack(second_file, second_text);
+	char* line = second_text;
+	for (int i = 0; i < 5; i++) {
+		ASSERT_TEST(strncmp(line, "report most_paying_customers ",
+			strlen("report most_paying_customers ")) == 0);
+		line = strchr(line, '\n') + 1;
+	}
+	ASSERT_TEST(*line == '\0');
+	fclose(first_file);
+	fclose(second_file);
+	workloadGeneratorDestroy(first);
+	workloadGeneratorDestroy(second);
+	return true;
+}
+
+/**
+ * Test a Zipf workload uses the first emails more than the last ones, and
+ * a uniform one does not
+ */
+static bool testWorkloadGeneratorSkew() {
+	WorkloadConfig config;
+	workloadConfigSetDefault(&config);
+	config.customers = 10;
+	int counts[2][10] = {{0}};
+	for (int skewed = 0; skewed < 2; skewed++) {
+		config.zipf_exponent = skewed ? 1.5 : 0;
+		WorkloadGenerator generator = workloadGeneratorCreate(&config);
+		FILE* file = tmpfile();
+		workloadGeneratorWriteCommands(generator, file, TEST_DRAWS,
+			WORKLOAD_REMOVE_CUSTOMER);
+		rewind(file);
+		int customer = 0;
+		while (fscanf(file, "customer remove customer%d@yad3.com\n",
+				&customer) == 1) {
+			counts[skewed][customer]++;
+		}
+		fclose(file);
+		workloadGeneratorDestroy(generator);
+	}
+	ASSERT_TEST(counts[1][0] > 3 * counts[1][9]);
+	ASSERT_TEST(counts[1][0] > 2 * counts[0][0]);
+	ASSERT_TEST(counts[0][9] > TEST_DRAWS / 20);
+	return true;
+}
+
+/*
+ * Reads a written file back into text, returns the amount read
+ */
+static size_t readBack(FILE* file, char* text) {
+	rewind(file);
+	size_t size = fread(text, sizeof(char), TEST_TEXT_CAPACITY - 1, file);
+	text[size] = '\0';
+	return size;
+}
@@ -0,0 +1,472 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "writeAheadLog.h"
+#include "commandLog.h"
+#include "monotonicClock.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define INT_SIZE 4
+#define SEQUENCE_SIZE 8
+#define CHECKSUM_SIZE INT_SIZE
+#define SEQUENCE_OFFSET CHECKSUM_SIZE
+#define LENGTH_OFFSET (SEQUENCE_OFFSET + SEQUENCE_SIZE)
+#define INITIAL_BUFFER_CAPACITY 4096
+#define BUFFER_GROWTH_FACTOR 2
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+struct writeAheadLogReader_t {
+	const unsigned char* data;
+	size_t size;
+	size_t position;
+	long long sequence;
+	CommandTable table;
+};
+
+struct writeAheadLogWriter_t {
+	FILE* file;
+	CommandTable table;
+	long long sequence;
+	int group_size;
+	long long group_delay;
+	int group_count;
+	long long group_start;
+	unsigned char* buffer;
+	size_t buffer_size;
+	size_t capacity;
+};
+
+static void writeUnsigned(unsigned char* buffer, uint32_t value);
+static uint32_t readUnsigned(const unsigned char* buffer);
+static uint32_t checksum(const unsigned char* data, size_t size);
+static bool ensureBufferCapacity(WriteAheadLogWriter writer, size_t size);
+static bool cutFile(FILE* file, size_t size);
+
+/**
+* Allocates a new WriteAheadLogReader over a log in memory.
+*
+* The log data is not copied and must stay valid while the reader is used.
+* String arguments of the read records point into the data.
+*
+* @param data the log data.
+* @param size the log data size.
+* @param table the command table the log is read with.
+* @param result pointer to save the result reader in.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if data, table or result are NULL.
+*
+* 	WRITE_AHEAD_LOG_BAD_FORMAT - if the data does not start with a log header
+* 		or was written with a different command table.
+*
+* 	WRITE_AHEAD_LOG_UNSUPPORTED_VERSION - if the log version is not
+* 		supported.
+*
+* 	WRITE_AHEAD_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogReaderCreate(const char* data, size_t size,
+	CommandTable table, WriteAheadLogReader* result) {
+	if ((data == NULL) || (table == NULL) || (result == NULL)) {
+		return WRITE_AHEAD_LOG_NULL_PARAMETERS;
+	}
+	const unsigned char* header = (const unsigned char*)data;
+	if ((size < WRITE_AHEAD_LOG_HEADER_SIZE) || (memcmp(header,
+			WRITE_AHEAD_LOG_MAGIC, WRITE_AHEAD_LOG_MAGIC_SIZE) != 0)) {
+		return WRITE_AHEAD_LOG_BAD_FORMAT;
+	}
+	if (readUnsigned(header + WRITE_AHEAD_LOG_MAGIC_SIZE) !=
+		WRITE_AHEAD_LOG_VERSION) {
+		return WRITE_AHEAD_LOG_UNSUPPORTED_VERSION;
+	}
+	if (readUnsigned(header + WRITE_AHEAD_LOG_MAGIC_SIZE + INT_SIZE) !=
+		commandTableGetFingerprint(table)) {
+		return WRITE_AHEAD_LOG_BAD_FORMAT;
+	}
+	WriteAheadLogReader reader = malloc(sizeof(*reader));
+	if (reader == NULL) return WRITE_AHEAD_LOG_OUT_OF_MEMORY;
+	reader->data = header;
+	reader->size = size;
+	reader->position = WRITE_AHEAD_LOG_HEADER_SIZE;
+	reader->sequence = -1;
+	reader->table = table;
+	*result = reader;
+	return WRITE_AHEAD_LOG_SUCCESS;
+}
+
+/**
+* writeAheadLogReaderNext: reads the next record of the log.
+*
+* A record is valid if it is whole, its checksum matches, its sequence
+* follows the one of the previous record and its command can be decoded.
+*
+* @param reader the reader.
+* @param sequence pointer to save the record sequence in.
+* @param record pointer to save the record command in.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if a parameter is NULL.
+*
+* 	WRITE_AHEAD_LOG_BAD_FORMAT - if the record is partly written or not
+* 		valid. the rest of the log is skipped.
+*
+* 	WRITE_AHEAD_LOG_END - if there are no more records.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogReaderNext(WriteAheadLogReader reader,
+	long long* sequence, CommandRecord* record) {
+	if ((reader == NULL) || (sequence == NULL) || (record == NULL)) {
+		return WRITE_AHEAD_LOG_NULL_PARAMETERS;
+	}
+	size_t left = reader->size - reader->position;
+	if (left == 0) return WRITE_AHEAD_LOG_END;
+	const unsigned char* data = reader->data + reader->position;
+	uint32_t length = 0;
+	uint64_t read_sequence = 0;
+	if (left >= WRITE_AHEAD_LOG_RECORD_HEADER_SIZE) {
+		length = readUnsigned(data + LENGTH_OFFSET);
+		read_sequence = ((uint64_t)readUnsigned(data + SEQUENCE_OFFSET +
+			INT_SIZE) << 32) | readUnsigned(data + SEQUENCE_OFFSET);
+	}
+	size_t size = WRITE_AHEAD_LOG_RECORD_HEADER_SIZE + (size_t)length;
+	if ((left < WRITE_AHEAD_LOG_RECORD_HEADER_SIZE) ||
+		(length > left - WRITE_AHEAD_LOG_RECORD_HEADER_SIZE) ||
+		(readUnsigned(data) != checksum(data + CHECKSUM_SIZE,
+			size - CHECKSUM_SIZE)) || (read_sequence > INT64_MAX) ||
+		((reader->sequence >= 0) &&
+			((long long)read_sequence != reader->sequence + 1)) ||
+		(commandLogDecode(data + WRITE_AHEAD_LOG_RECORD_HEADER_SIZE, length,
+			reader->table, record) != length) ||
+		(record->kind != COMMAND_RECORD_COMMAND)) {
+		reader->size = reader->position;
+		return WRITE_AHEAD_LOG_BAD_FORMAT;
+	}
+	reader->position += size;
+	reader->sequence = (long long)read_sequence;
+	*sequence = reader->sequence;
+	return WRITE_AHEAD_LOG_SUCCESS;
+}
+
+/**
+* writeAheadLogReaderGetValidSize: returns the size of the log up to the
+* end of the last valid record read.
+*
+* @param reader the reader.
+*
+* @return
+* 	0 if reader is NULL; else returns the valid size.
+*/
+size_t writeAheadLogReaderGetValidSize(WriteAheadLogReader reader) {
+	return (reader == NULL) ? 0 : reader->position;
+}
+
+/**
+* writeAheadLogReaderDestroy: Deallocates an existing reader.
+*
+* @param reader Target reader to be deallocated.
+* If reader is NULL nothing will be done
+*/
+void writeAheadLogReaderDestroy(WriteAheadLogReader reader) {
+	free(reader);
+}
+
+/**
+* Allocates a new WriteAheadLogWriter, appending to a log file.
+*
+* The file is cut to its valid size, so records continue right after the
+* last valid one. A new log header is written if the valid size is 0.
+*
+* @param file the log file, opened for binary update. must outlive the
+* 	writer.
+* @param size the valid size of the log in the file, as read by a reader,
+* 	or 0 for a new log.
+* @param table the command table the records are written with.
+* @param sequence the sequence of the last command the log follows. the
+* 	first record added gets the next one.
+* @param group_size the amount of records written at once, at least 1.
+* @param group_delay the time in nanoseconds a record may wait for the rest
+* 	of its group.
+* @param result pointer to save the result writer in.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if file, table or result are NULL, or
+* 		sequence, group_size or group_delay are not valid.
+*
+* 	WRITE_AHEAD_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	WRITE_AHEAD_LOG_WRITE_FAILED - if cutting the file or writing the header
+* 		failed.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogWriterCreate(FILE* file, size_t size,
+	CommandTable table, long long sequence, int group_size,
+	long long group_delay, WriteAheadLogWriter* result) {
+	if ((file == NULL) || (table == NULL) || (result == NULL) ||
+		(sequence < 0) || (group_size < 1) || (group_delay < 0) ||
+		((size > 0) && (size < WRITE_AHEAD_LOG_HEADER_SIZE))) {
+		return WRITE_AHEAD_LOG_NULL_PARAMETERS;
+	}
+	WriteAheadLogWriter writer = malloc(sizeof(*writer));
+	if (writer == NULL) return WRITE_AHEAD_LOG_OUT_OF_MEMORY;
+	writer->file = file;
+	writer->table = table;
+	writer->sequence = sequence;
+	writer->group_size = group_size;
+	writer->group_delay = group_delay;
+	writer->group_count = 0;
+	writer->group_start = 0;
+	writer->buffer = NULL;
+	writer->buffer_size = 0;
+	writer->capacity = 0;
+	bool is_written = cutFile(file, size);
+	if ((is_written) && (size == 0)) {
+		unsigned char header[WRITE_AHEAD_LOG_HEADER_SIZE];
+		memcpy(header, WRITE_AHEAD_LOG_MAGIC, WRITE_AHEAD_LOG_MAGIC_SIZE);
+		writeUnsigned(header + WRITE_AHEAD_LOG_MAGIC_SIZE,
+			WRITE_AHEAD_LOG_VERSION);
+		writeUnsigned(header + WRITE_AHEAD_LOG_MAGIC_SIZE + INT_SIZE,
+			commandTableGetFingerprint(table));
+		is_written = (fwrite(header, sizeof(header), 1, file) == 1) &&
+			writeAheadLogSyncFile(file);
+	}
+	if (!is_written) {
+		free(writer);
+		return WRITE_AHEAD_LOG_WRITE_FAILED;
+	}
+	*result = writer;
+	return WRITE_AHEAD_LOG_SUCCESS;
+}
+
+/**
+* writeAheadLogWriterAppend: adds a command to the current group, and
+* commits the group if it is full or waited for the group delay.
+*
+* @param writer the writer.
+* @param record the command, of kind COMMAND_RECORD_COMMAND.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if writer or record are NULL.
+*
+* 	WRITE_AHEAD_LOG_BAD_FORMAT - if the record can not be encoded.
+*
+* 	WRITE_AHEAD_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	WRITE_AHEAD_LOG_WRITE_FAILED - if committing the group failed.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogWriterAppend(WriteAheadLogWriter writer,
+	const CommandRecord* record) {
+	if ((writer == NULL) || (record == NULL)) {
+		return WRITE_AHEAD_LOG_NULL_PARAMETERS;
+	}
+	const CommandSpec* spec = commandTableGetSpec(writer->table,
+		record->index);
+	size_t length = (record->kind == COMMAND_RECORD_COMMAND) ?
+		commandLogEncode(record, spec, NULL) : 0;
+	if ((length == 0) || (length > UINT32_MAX)) {
+		return WRITE_AHEAD_LOG_BAD_FORMAT;
+	}
+	size_t size = WRITE_AHEAD_LOG_RECORD_HEADER_SIZE + length;
+	if (!ensureBufferCapacity(writer, writer->buffer_size + size)) {
+		return WRITE_AHEAD_LOG_OUT_OF_MEMORY;
+	}
+	unsigned char* data = writer->buffer + writer->buffer_size;
+	uint64_t sequence = (uint64_t)(writer->sequence + 1);
+	writeUnsigned(data + SEQUENCE_OFFSET, (uint32_t)sequence);
+	writeUnsigned(data + SEQUENCE_OFFSET + INT_SIZE,
+		(uint32_t)(sequence >> 32));
+	writeUnsigned(data + LENGTH_OFFSET, (uint32_t)length);
+	commandLogEncode(record, spec, data + WRITE_AHEAD_LOG_RECORD_HEADER_SIZE);
+	writeUnsigned(data, checksum(data + CHECKSUM_SIZE, size - CHECKSUM_SIZE));
+	writer->buffer_size += size;
+	writer->sequence++;
+	long long now = monotonicClockNow();
+	if (writer->group_count++ == 0) writer->group_start = now;
+	if ((writer->group_count >= writer->group_size) ||
+		(now - writer->group_start >= writer->group_delay)) {
+		return writeAheadLogWriterCommit(writer);
+	}
+	return WRITE_AHEAD_LOG_SUCCESS;
+}
+
+/**
+* writeAheadLogWriterCommit: writes the current group to the log file, and
+* syncs the file to the disk.
+*
+* @param writer the writer.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if writer is NULL.
+*
+* 	WRITE_AHEAD_LOG_WRITE_FAILED - if writing or syncing failed. the group
+* 		is dropped.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogWriterCommit(WriteAheadLogWriter writer) {
+	if (writer == NULL) return WRITE_AHEAD_LOG_NULL_PARAMETERS;
+	if (writer->group_count == 0) return WRITE_AHEAD_LOG_SUCCESS;
+	bool is_written = (fwrite(writer->buffer, writer->buffer_size, 1,
+		writer->file) == 1) && writeAheadLogSyncFile(writer->file);
+	writer->buffer_size = 0;
+	writer->group_count = 0;
+	return is_written ? WRITE_AHEAD_LOG_SUCCESS :
+		WRITE_AHEAD_LOG_WRITE_FAILED;
+}
+
+/**
+* writeAheadLogWriterReset: empties the log, once a snapshot of the
+* sequence of the writer is stored. the sequences of the records added next
+* go on from it.
+*
+* @param writer the writer.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if writer is NULL.
+*
+* 	WRITE_AHEAD_LOG_WRITE_FAILED - if cutting the log failed.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogWriterReset(WriteAheadLogWriter writer) {
+	if (writer == NULL) return WRITE_AHEAD_LOG_NULL_PARAMETERS;
+	writer->buffer_size = 0;
+	writer->group_count = 0;
+	if ((!cutFile(writer->file, WRITE_AHEAD_LOG_HEADER_SIZE)) ||
+		(!writeAheadLogSyncFile(writer->file))) {
+		return WRITE_AHEAD_LOG_WRITE_FAILED;
+	}
+	return WRITE_AHEAD_LOG_SUCCESS;
+}
+
+/**
+* writeAheadLogWriterGetSequence: returns the sequence of the last record
+* added.
+*
+* @param writer the writer.
+*
+* @return
+* 	0 if writer is NULL; else returns the sequence.
+*/
+long long writeAheadLogWriterGetSequence(WriteAheadLogWriter writer) {
+	return (writer == NULL) ? 0 : writer->sequence;
+}
+
+/**
+* writeAheadLogWriterDestroy: commits the current group, and deallocates
+* an existing writer. the file is not closed.
+*
+* @param writer Target writer to be deallocated.
+* If writer is NULL nothing will be done
+*/
+void writeAheadLogWriterDestroy(WriteAheadLogWriter writer) {
+	if (writer == NULL) return;
+	writeAheadLogWriterCommit(writer);
+	free(writer->buffer);
+	free(writer);
+}
+
+/**
+* writeAheadLogSyncFile: flushes a file and waits for the disk to store it.
+*
+* @param file the file.
+*
+* @return
+* 	false if file is NULL or syncing failed; else returns true.
+*/
+bool writeAheadLogSyncFile(FILE* file) {
+	if ((file == NULL) || (fflush(file) != 0)) return false;
+#ifdef _WIN32
+	return _commit(_fileno(file)) == 0;
+#else
+	return fsync(fileno(file)) == 0;
+#endif
+}
+
+/*
+* writeUnsigned: writes a 32 bit value in little endian order.
+*/
+static void writeUnsigned(unsigned char* buffer, uint32_t value) {
+	for (int i = 0; i < INT_SIZE; i++) {
+		buffer[i] = (unsigned char)(value >> (8 * i));
+	}
+}
+
+/*
+* readUnsigned: reads a 32 bit value in little endian order.
+*/
+static uint32_t readUnsigned(const unsigned char* buffer) {
+	uint32_t value = 0;
+	for (int i = INT_SIZE - 1; i >= 0; i--) {
+		value = (value << 8) | buffer[i];
+	}
+	return value;
+}
+
+/*
+* checksum: the 32 bit FNV-1a hash of the data.
+*/
+static uint32_t checksum(const unsigned char* data, size_t size) {
+	uint32_t hash = FNV_OFFSET_BASIS;
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ data[i]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+/*
+* ensureBufferCapacity: grows the group buffer geometrically until it can
+* hold size bytes.
+*
+* @return
+* 	false in case of allocation error; else returns true.
+*/
+static bool ensureBufferCapacity(WriteAheadLogWriter writer, size_t size) {
+	if (size <= writer->capacity) return true;
+	size_t capacity = (writer->capacity > 0) ? writer->capacity :
+		INITIAL_BUFFER_CAPACITY;
+	while (capacity < size) capacity *= BUFFER_GROWTH_FACTOR;
+	unsigned char* buffer = realloc(writer->buffer, capacity);
+	if (buffer == NULL) return false;
+	writer->buffer = buffer;
+	writer->capacity = capacity;
+	return true;
+}
+
+/*
+* cutFile: cuts a file to size bytes, and moves its position to the end.
+*
+* @return
+* 	false if cutting failed; else returns true.
+*/
+static bool cutFile(FILE* file, size_t size) {
+	if ((fflush(file) != 0) || (size > (size_t)INT32_MAX)) return false;
+#ifdef _WIN32
+	if (_chsize_s(_fileno(file), (long long)size) != 0) return false;
+#else
+	if (ftruncate(fileno(file), (off_t)size) != 0) return false;
+#endif
+	return fseek(file, (long)size, SEEK_SET) == 0;
+}
@@ -0,0 +1,240 @@
+#ifndef SRC_WRITEAHEADLOG_H_
+#define SRC_WRITEAHEADLOG_H_
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "commandTable.h"
+#include "commandRing.h"
+
+/**
+* The write ahead log of the commands which changed the service.
+*
+* A log starts with a header: the 8 bytes of WRITE_AHEAD_LOG_MAGIC, the
+* format version and the fingerprint of the command table (see
+* commandTableGetFingerprint), as 32 bit little endian integers. Every
+* record follows with:
+* 	- a checksum of the rest of the record, 32 bit little endian.
+* 	- the record sequence, 64 bit little endian. sequences of a log go up
+* 		by one from record to record.
+* 	- the size of the command, 32 bit little endian.
+* 	- the command, encoded as in the binary command log (commandLog.h).
+*
+* Records are written in groups: a group is written and synced to the disk
+* at once, when it holds the group size of records, on the first record
+* added after the group delay passed since its first record, and when the
+* writer is destroyed. A crash loses at most the records of the last group,
+* and leaves at most a partly written record at the end of the log, which
+* readers tell by its checksum.
+*/
+#define WRITE_AHEAD_LOG_MAGIC "YAD3WLOG"
+#define WRITE_AHEAD_LOG_MAGIC_SIZE 8
+#define WRITE_AHEAD_LOG_VERSION 1
+#define WRITE_AHEAD_LOG_HEADER_SIZE (WRITE_AHEAD_LOG_MAGIC_SIZE + 4 + 4)
+#define WRITE_AHEAD_LOG_RECORD_HEADER_SIZE (4 + 8 + 4)
+
+typedef struct writeAheadLogReader_t *WriteAheadLogReader;
+typedef struct writeAheadLogWriter_t *WriteAheadLogWriter;
+
+/**
+* This type defines end codes for the methods.
+*/
+typedef enum {
+	WRITE_AHEAD_LOG_NULL_PARAMETERS = 0,
+	WRITE_AHEAD_LOG_OUT_OF_MEMORY = 1,
+	WRITE_AHEAD_LOG_BAD_FORMAT = 2,
+	WRITE_AHEAD_LOG_UNSUPPORTED_VERSION = 3,
+	WRITE_AHEAD_LOG_WRITE_FAILED = 4,
+	WRITE_AHEAD_LOG_END = 5,
+	WRITE_AHEAD_LOG_SUCCESS = 6
+} WriteAheadLogResult;
+
+/**
+* Allocates a new WriteAheadLogReader over a log in memory.
+*
+* The log data is not copied and must stay valid while the reader is used.
+* String arguments of the read records point into the data.
+*
+* @param data the log data.
+* @param size the log data size.
+* @param table the command table the log is read with.
+* @param result pointer to save the result reader in.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if data, table or result are NULL.
+*
+* 	WRITE_AHEAD_LOG_BAD_FORMAT - if the data does not start with a log header
+* 		or was written with a different command table.
+*
+* 	WRITE_AHEAD_LOG_UNSUPPORTED_VERSION - if the log version is not
+* 		supported.
+*
+* 	WRITE_AHEAD_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogReaderCreate(const char* data, size_t size,
+	CommandTable table, WriteAheadLogReader* result);
+
+/**
+* writeAheadLogReaderNext: reads the next record of the log.
+*
+* @param reader the reader.
+* @param sequence pointer to save the record sequence in.
+* @param record pointer to save the record command in.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if a parameter is NULL.
+*
+* 	WRITE_AHEAD_LOG_BAD_FORMAT - if the record is partly written or not
+* 		valid. the rest of the log is skipped.
+*
+* 	WRITE_AHEAD_LOG_END - if there are no more records.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogReaderNext(WriteAheadLogReader reader,
+	long long* sequence, CommandRecord* record);
+
+/**
+* writeAheadLogReaderGetValidSize: returns the size of the log up to the
+* end of the last valid record read.
+*
+* @param reader the reader.
+*
+* @return
+* 	0 if reader is NULL; else returns the valid size.
+*/
+size_t writeAheadLogReaderGetValidSize(WriteAheadLogReader reader);
+
+/**
+* writeAheadLogReaderDestroy: Deallocates an existing reader.
+*
+* @param reader Target reader to be deallocated.
+* If reader is NULL nothing will be done
+*/
+void writeAheadLogReaderDestroy(WriteAheadLogReader reader);
+
+/**
+* Allocates a new WriteAheadLogWriter, appending to a log file.
+*
+* The file is cut to its valid size, so records continue right after the
+* last valid one. A new log header is written if the valid size is 0.
+*
+* @param file the log file, opened for binary update. must outlive the
+* 	writer.
+* @param size the valid size of the log in the file, as read by a reader,
+* 	or 0 for a new log.
+* @param table the command table the records are written with.
+* @param sequence the sequence of the last command the log follows. the
+* 	first record added gets the next one.
+* @param group_size the amount of records written at once, at least 1.
+* @param group_delay the time in nanoseconds a record may wait for the rest
+* 	of its group.
+* @param result pointer to save the result writer in.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if file, table or result are NULL, or
+* 		sequence, group_size or group_delay are not valid.
+*
+* 	WRITE_AHEAD_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	WRITE_AHEAD_LOG_WRITE_FAILED - if cutting the file or writing the header
+* 		failed.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogWriterCreate(FILE* file, size_t size,
+	CommandTable table, long long sequence, int group_size,
+	long long group_delay, WriteAheadLogWriter* result);
+
+/**
+* writeAheadLogWriterAppend: adds a command to the current group, and
+* commits the group if it is full or waited for the group delay.
+*
+* @param writer the writer.
+* @param record the command, of kind COMMAND_RECORD_COMMAND.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if writer or record are NULL.
+*
+* 	WRITE_AHEAD_LOG_BAD_FORMAT - if the record can not be encoded.
+*
+* 	WRITE_AHEAD_LOG_OUT_OF_MEMORY - if allocations failed.
+*
+* 	WRITE_AHEAD_LOG_WRITE_FAILED - if committing the group failed.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogWriterAppend(WriteAheadLogWriter writer,
+	const CommandRecord* record);
+
+/**
+* writeAheadLogWriterCommit: writes the current group to the log file, and
+* syncs the file to the disk.
+*
+* @param writer the writer.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if writer is NULL.
+*
+* 	WRITE_AHEAD_LOG_WRITE_FAILED - if writing or syncing failed. the group
+* 		is dropped.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogWriterCommit(WriteAheadLogWriter writer);
+
+/**
+* writeAheadLogWriterReset: empties the log, once a snapshot of the
+* sequence of the writer is stored. the sequences of the records added next
+* go on from it.
+*
+* @param writer the writer.
+*
+* @return
+*
+* 	WRITE_AHEAD_LOG_NULL_PARAMETERS - if writer is NULL.
+*
+* 	WRITE_AHEAD_LOG_WRITE_FAILED - if cutting the log failed.
+*
+* 	WRITE_AHEAD_LOG_SUCCESS - in case of success.
+*/
+WriteAheadLogResult writeAheadLogWriterReset(WriteAheadLogWriter writer);
+
+/**
+* writeAheadLogWriterGetSequence: returns the sequence of the last record
+* added.
+*
+* @param writer the writer.
+*
+* @return
+* 	0 if writer is NULL; else returns the sequence.
+*/
+long long writeAheadLogWriterGetSequence(WriteAheadLogWriter writer);
+
+/**
+* writeAheadLogWriterDestroy: commits the current group, and deallocates
+* an existing writer. the file is not closed.
+*
+* @param writer Target writer to be deallocated.
+* If writer is NULL nothing will be done
+*/
+void writeAheadLogWriterDestroy(WriteAheadLogWriter writer);
+
+/**
+* writeAheadLogSyncFile: flushes a file and waits for the disk to store it.
+*
+* @param file the file.
+*
+* @return
+* 	false if file is NULL or syncing failed; else returns true.
+*/
+bool writeAheadLogSyncFile(FILE* file);
+
+#endif /* SRC_WRITEAHEADLOG_H_ */
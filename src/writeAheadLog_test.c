@@ -0,0 +1,337 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include "writeAheadLog.h"
+#include "test_utilities.h"
+
+#define S COMMAND_ARGUMENT_STRING
+#define I COMMAND_ARGUMENT_INT
+#define LOG_CAPACITY 512
+#define NO_DELAY 0
+#define LONG_DELAY (1LL << 60)
+
+static Yad3ServiceResult testHandler(Yad3Program program,
+	const CommandArgument* arguments);
+
+static const CommandSpec TEST_COMMANDS[] = {
+	{"realtor", "add", 3, {S, S, I}, testHandler},
+	{"customer", "remove", 1, {S}, testHandler}
+};
+
+#define TEST_COMMANDS_COUNT \
+	((int)(sizeof(TEST_COMMANDS) / sizeof(TEST_COMMANDS[0])))
+
+static bool testWriteAheadLogWriterCreate();
+static bool testWriteAheadLogReaderCreate();
+static bool testWriteAheadLogGroupCommit();
+static bool testWriteAheadLogRoundTrip();
+static bool testWriteAheadLogTornTail();
+static bool testWriteAheadLogReset();
+static bool appendTestRecords(WriteAheadLogWriter writer, int count);
+static size_t readLogFile(FILE* file, char* log);
+int RunWriteAheadLogTest();
+
+//int main() {
+int RunWriteAheadLogTest() {
+	RUN_TEST(testWriteAheadLogWriterCreate);
+	RUN_TEST(testWriteAheadLogReaderCreate);
+	RUN_TEST(testWriteAheadLogGroupCommit);
+	RUN_TEST(testWriteAheadLogRoundTrip);
+	RUN_TEST(testWriteAheadLogTornTail);
+	RUN_TEST(testWriteAheadLogReset);
+	return 0;
+}
+
+/**
+ * Test writer create method
+ */
+static bool testWriteAheadLogWriterCreate() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	FILE* file = tmpfile();
+	WriteAheadLogWriter writer = NULL;
+	ASSERT_TEST(writeAheadLogWriterCreate(NULL, 0, table, 0, 1, NO_DELAY,
+		&writer) == WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 0, NULL, 0, 1, NO_DELAY,
+		&writer) == WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 0, table, -1, 1, NO_DELAY,
+		&writer) == WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 0, table, 0, 0, NO_DELAY,
+		&writer) == WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 3, table, 0, 1, NO_DELAY,
+		&writer) == WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 0, table, 0, 1, NO_DELAY,
+		NULL) == WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 0, table, 7, 1, NO_DELAY,
+		&writer) == WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(writeAheadLogWriterGetSequence(writer) == 7);
+	char log[LOG_CAPACITY];
+	ASSERT_TEST(readLogFile(file, log) == WRITE_AHEAD_LOG_HEADER_SIZE);
+	ASSERT_TEST(memcmp(log, WRITE_AHEAD_LOG_MAGIC,
+		WRITE_AHEAD_LOG_MAGIC_SIZE) == 0);
+	CommandRecord record = {COMMAND_RECORD_UNKNOWN_COMMAND, -1, {{NULL}},
+		NULL, 0};
+	ASSERT_TEST(writeAheadLogWriterAppend(writer, &record) ==
+		WRITE_AHEAD_LOG_BAD_FORMAT);
+	ASSERT_TEST(writeAheadLogWriterAppend(NULL, &record) ==
+		WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogWriterGetSequence(writer) == 7);
+	ASSERT_TEST(writeAheadLogWriterGetSequence(NULL) == 0);
+	writeAheadLogWriterDestroy(writer);
+	writeAheadLogWriterDestroy(NULL);
+	ASSERT_TEST(!writeAheadLogSyncFile(NULL));
+	fclose(file);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test reader create method
+ */
+static bool testWriteAheadLogReaderCreate() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	char log[WRITE_AHEAD_LOG_HEADER_SIZE] = WRITE_AHEAD_LOG_MAGIC;
+	WriteAheadLogReader reader = NULL;
+	ASSERT_TEST(writeAheadLogReaderCreate(NULL, 0, table, &reader) ==
+		WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogReaderCreate(log, sizeof(log), table, NULL) ==
+		WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogReaderCreate(log, sizeof(log) - 1, table,
+		&reader) == WRITE_AHEAD_LOG_BAD_FORMAT);
+	ASSERT_TEST(writeAheadLogReaderCreate(log, sizeof(log), table,
+		&reader) == WRITE_AHEAD_LOG_UNSUPPORTED_VERSION);
+	log[WRITE_AHEAD_LOG_MAGIC_SIZE] = WRITE_AHEAD_LOG_VERSION;
+	ASSERT_TEST(writeAheadLogReaderCreate(log, sizeof(log), table,
+		&reader) == WRITE_AHEAD_LOG_BAD_FORMAT);
+	uint32_t fingerprint = commandTableGetFingerprint(table);
+	for (int i = 0; i < 4; i++) {
+		log[WRITE_AHEAD_LOG_MAGIC_SIZE + 4 + i] =
+			(char)(fingerprint >> (8 * i));
+	}
+	ASSERT_TEST(writeAheadLogReaderCreate(log, sizeof(log), table,
+		&reader) == WRITE_AHEAD_LOG_SUCCESS);
+	long long sequence = 0;
+	CommandRecord record;
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_END);
+	ASSERT_TEST(writeAheadLogReaderNext(reader, NULL, &record) ==
+		WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	ASSERT_TEST(writeAheadLogReaderGetValidSize(reader) == sizeof(log));
+	ASSERT_TEST(writeAheadLogReaderGetValidSize(NULL) == 0);
+	writeAheadLogReaderDestroy(reader);
+	writeAheadLogReaderDestroy(NULL);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test records are written in groups of the group size, or at once with
+ * no group delay
+ */
+static bool testWriteAheadLogGroupCommit() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	FILE* file = tmpfile();
+	char log[LOG_CAPACITY];
+	WriteAheadLogWriter writer = NULL;
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 0, table, 0, 3, LONG_DELAY,
+		&writer) == WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(appendTestRecords(writer, 2));
+	ASSERT_TEST(readLogFile(file, log) == WRITE_AHEAD_LOG_HEADER_SIZE);
+	ASSERT_TEST(appendTestRecords(writer, 1));
+	size_t size = readLogFile(file, log);
+	ASSERT_TEST(size > WRITE_AHEAD_LOG_HEADER_SIZE);
+	ASSERT_TEST(appendTestRecords(writer, 1));
+	ASSERT_TEST(readLogFile(file, log) == size);
+	ASSERT_TEST(writeAheadLogWriterCommit(writer) == WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(readLogFile(file, log) > size);
+	ASSERT_TEST(writeAheadLogWriterGetSequence(writer) == 4);
+	writeAheadLogWriterDestroy(writer);
+	size = readLogFile(file, log);
+
+	ASSERT_TEST(writeAheadLogWriterCreate(file, size, table, 4, 100,
+		NO_DELAY, &writer) == WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(appendTestRecords(writer, 1));
+	ASSERT_TEST(readLogFile(file, log) > size);
+	writeAheadLogWriterDestroy(writer);
+	fclose(file);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test records are read as they were written
+ */
+static bool testWriteAheadLogRoundTrip() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	FILE* file = tmpfile();
+	WriteAheadLogWriter writer = NULL;
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 0, table, 10, 2, LONG_DELAY,
+		&writer) == WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(appendTestRecords(writer, 3));
+	writeAheadLogWriterDestroy(writer);
+	char log[LOG_CAPACITY];
+	size_t size = readLogFile(file, log);
+	WriteAheadLogReader reader = NULL;
+	ASSERT_TEST(writeAheadLogReaderCreate(log, size, table, &reader) ==
+		WRITE_AHEAD_LOG_SUCCESS);
+	long long sequence = 0;
+	CommandRecord record;
+	for (int i = 0; i < 3; i++) {
+		ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+			WRITE_AHEAD_LOG_SUCCESS);
+		ASSERT_TEST(sequence == 11 + i);
+		ASSERT_TEST(record.kind == COMMAND_RECORD_COMMAND);
+		ASSERT_TEST(record.index == i % 2);
+		ASSERT_TEST(strcmp(record.arguments[0].string, "me@a.com") == 0);
+	}
+	ASSERT_TEST(strcmp(record.arguments[1].string, "sella") == 0);
+	ASSERT_TEST(record.arguments[2].number == 2);
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_END);
+	ASSERT_TEST(writeAheadLogReaderGetValidSize(reader) == size);
+	writeAheadLogReaderDestroy(reader);
+	fclose(file);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test a partly written or broken record ends the log, and the writer goes
+ * on from the last valid record
+ */
+static bool testWriteAheadLogTornTail() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	FILE* file = tmpfile();
+	WriteAheadLogWriter writer = NULL;
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 0, table, 0, 1, LONG_DELAY,
+		&writer) == WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(appendTestRecords(writer, 1));
+	char log[LOG_CAPACITY];
+	size_t first = readLogFile(file, log);
+	ASSERT_TEST(appendTestRecords(writer, 1));
+	writeAheadLogWriterDestroy(writer);
+	size_t size = readLogFile(file, log);
+	WriteAheadLogReader reader = NULL;
+	long long sequence = 0;
+	CommandRecord record;
+	ASSERT_TEST(writeAheadLogReaderCreate(log, size - 1, table, &reader) ==
+		WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_BAD_FORMAT);
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_END);
+	ASSERT_TEST(writeAheadLogReaderGetValidSize(reader) == first);
+	writeAheadLogReaderDestroy(reader);
+	log[size - 2] ^= 1;
+	ASSERT_TEST(writeAheadLogReaderCreate(log, size, table, &reader) ==
+		WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_BAD_FORMAT);
+	writeAheadLogReaderDestroy(reader);
+
+	ASSERT_TEST(writeAheadLogWriterCreate(file, first, table, 1, 1,
+		LONG_DELAY, &writer) == WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(appendTestRecords(writer, 1));
+	writeAheadLogWriterDestroy(writer);
+	size = readLogFile(file, log);
+	ASSERT_TEST(writeAheadLogReaderCreate(log, size, table, &reader) ==
+		WRITE_AHEAD_LOG_SUCCESS);
+	for (int i = 1; i <= 2; i++) {
+		ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+			WRITE_AHEAD_LOG_SUCCESS);
+		ASSERT_TEST(sequence == i);
+	}
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_END);
+	writeAheadLogReaderDestroy(reader);
+	fclose(file);
+	commandTableDestroy(table);
+	return true;
+}
+
+/**
+ * Test reset empties the log and keeps the sequences going
+ */
+static bool testWriteAheadLogReset() {
+	CommandTable table = commandTableCreate(TEST_COMMANDS,
+		TEST_COMMANDS_COUNT);
+	FILE* file = tmpfile();
+	WriteAheadLogWriter writer = NULL;
+	ASSERT_TEST(writeAheadLogWriterCreate(file, 0, table, 0, 2, LONG_DELAY,
+		&writer) == WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(appendTestRecords(writer, 3));
+	ASSERT_TEST(writeAheadLogWriterReset(writer) == WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(writeAheadLogWriterReset(NULL) ==
+		WRITE_AHEAD_LOG_NULL_PARAMETERS);
+	char log[LOG_CAPACITY];
+	ASSERT_TEST(readLogFile(file, log) == WRITE_AHEAD_LOG_HEADER_SIZE);
+	ASSERT_TEST(appendTestRecords(writer, 1));
+	writeAheadLogWriterDestroy(writer);
+	size_t size = readLogFile(file, log);
+	WriteAheadLogReader reader = NULL;
+	ASSERT_TEST(writeAheadLogReaderCreate(log, size, table, &reader) ==
+		WRITE_AHEAD_LOG_SUCCESS);
+	long long sequence = 0;
+	CommandRecord record;
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_SUCCESS);
+	ASSERT_TEST(sequence == 4);
+	ASSERT_TEST(writeAheadLogReaderNext(reader, &sequence, &record) ==
+		WRITE_AHEAD_LOG_END);
+	writeAheadLogReaderDestroy(reader);
+	fclose(file);
+	commandTableDestroy(table);
+	return true;
+}
+
+/*
+ * Appends count records to the log, alternating between the two commands
+ * of the test table. returns false if appending failed
+ */
+static bool appendTestRecords(WriteAheadLogWriter writer, int count) {
+	char email[] = "me@a.com";
+	char company[] = "sella";
+	CommandRecord records[] = {
+		{COMMAND_RECORD_COMMAND, 0, {{email}, {company}}, NULL, 0},
+		{COMMAND_RECORD_COMMAND, 1, {{email}}, NULL, 0}
+	};
+	records[0].arguments[2].number = 2;
+	for (int i = 0; i < count; i++) {
+		int index = (int)(writeAheadLogWriterGetSequence(writer) % 2);
+		if (writeAheadLogWriterAppend(writer, &records[index]) !=
+			WRITE_AHEAD_LOG_SUCCESS) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * Reads the whole log file into log, and moves the file position back to
+ * its end. returns the log size
+ */
+static size_t readLogFile(FILE* file, char* log) {
+	fflush(file);
+	rewind(file);
+	size_t size = fread(log, sizeof(char), LOG_CAPACITY, file);
+	fseek(file, 0, SEEK_END);
+	return size;
+}
+
+static Yad3ServiceResult testHandler(Yad3Program program,
+	const CommandArgument* arguments) {
+	(void)program;
+	(void)arguments;
+	return YAD3_SERVICE_SUCCESS;
+}
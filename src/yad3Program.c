@@ -1,16 +1,33 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <pthread.h>
 #include "yad3Program.h"
 #include "utilities.h"
 #include "yad3Service.h"
 #include "mtm_ex2.h"
+#include "inputReader.h"
+#include "commandTokens.h"
+#include "commandTable.h"
+#include "commandRing.h"
+#include "commandLog.h"
+#include "outputSink.h"
+#include "commandStatistics.h"
+#include "monotonicClock.h"
+#include "writeAheadLog.h"
 
 #define COMMENT_SIGN '#'
-#define COMMAND_SAPARATOR_1 '\t'
-#define COMMAND_SAPARATOR_2 ' '
-#define COMMAND_END '\n'
+#define PIPELINE_RING_CAPACITY 1024
+#define WRITE_AHEAD_LOG_GROUP_SIZE 256
+#define WRITE_AHEAD_LOG_GROUP_DELAY (MONOTONIC_CLOCK_TICKS_PER_SECOND / 100)
+#define TEMPORARY_SUFFIX ".tmp"
+#define ARG_STRING COMMAND_ARGUMENT_STRING
+#define ARG_INT COMMAND_ARGUMENT_INT
 #define USER_REALTOR "realtor"
 #define USER_CUSTOMER "customer"
 #define USER_REPORTER "report"
@@ -26,59 +43,144 @@
 #define REPORT_RELEVENT_REALTORS "relevant_realtors"
 #define REPORT_PAYING_CUSTOMERS "most_paying_customers"
 #define REPORT_SIGNIFICANT_REALTORS "significant_realtors"
-#define END_OF_STRING '\0'
 
 typedef enum  {
 	READ = 1,
 	WRITE = 2,
-	APPEND = 3
+	APPEND = 3,
+	WRITE_BINARY = 4,
+	UPDATE_BINARY = 5
 } MTMFileMode;
 
+typedef struct {
+	char* input;
+	char* output;
+	char* converted;
+	char* loaded;
+	char* saved;
+	char* logged;
+	bool is_pipelined;
+	bool is_binary;
+	bool is_timed;
+} ProgramParameters;
+
 struct yad3Program_t {
 	Yad3Service service;
-	FILE* input;
-	FILE* output;
+	InputReader input;
+	OutputSink sink;
+	CommandTokens tokens;
+	CommandTable commands;
+	bool is_pipelined;
+	CommandRing ring;
+	CommandLogReader log;
+	FILE* converted;
+	CommandLogWriter converter;
+	CommandStatistics statistics;
+	char* snapshot;
+	long long sequence;
+	FILE* logged;
+	WriteAheadLogWriter wal;
 };
 
-static bool checkProgramParameters(char *input[], int count);
-static char* GetInputsPaths(char *input[], int count, bool find_input);
-static Yad3Program allocateYad3Program(FILE *input, FILE *output);
+static bool parseProgramParameters(char *input[], int count,
+	ProgramParameters* parameters);
+static bool parsePathParameter(char *input[], int count, int* index,
+	char** path);
+static Yad3Program allocateYad3Program(InputReader input, FILE *output,
+	ProgramParameters* parameters);
+static bool openCommandLogs(Yad3Program program,
+	ProgramParameters* parameters);
+static bool loadSnapshot(Yad3Program program, char* path);
+static void saveSnapshot(Yad3Program program);
+static bool openWriteAheadLog(Yad3Program program, char* path);
+static bool replayWriteAheadLog(Yad3Program program, InputReader reader,
+	size_t* size);
+static bool replaceFile(const char* source, const char* target);
 static bool openFile(char* path, MTMFileMode mode, FILE** output);
 static void closeFile(FILE* output);
-static void writeToErrorOutStream(MtmErrorCode code);
-
-static bool RunCommand(char* command, Yad3Program program);
-
-static bool RunReporterCommand(char** params, Yad3Program program);
-static bool RunPayingCustumersReport(char** params, Yad3Program program);
-static bool RunSignificantRealtorReport(char** params, Yad3Program program);
-static bool RunPrintRealventRealtorReport(char** params, Yad3Program program);
-
-static bool RunRealtorCommand(char** params, Yad3Program program);
-static bool RunAddRealtor(char** params, Yad3Program program);
-static bool RunRemoveRealtor(char** params, Yad3Program program);
-static bool RunRealtorAddApartmentService(char** params, Yad3Program program);
-static bool RunRealtorRemoveApartmentService(char** params,
-	Yad3Program program);
-static bool RunRealtorAddApartmentToRealtor(char** params,
-	Yad3Program program);
-static bool RunRemoveApartmentFromRealtor(char** params, Yad3Program program);
-static bool RunResponeToOffer(char** params, Yad3Program program);
-
-static bool RunCustomerCommand(char** params, Yad3Program program);
-static bool RunAddCustumer(char** params, Yad3Program program);
-static bool RunRemoveCustumer(char** params, Yad3Program program);
-static bool RunCustumerPurchase(char** params, Yad3Program program);
-static bool RunMakeOffer(char** params, Yad3Program program);
-
-static bool HandleResult(Yad3ServiceResult result);
+static void writeToErrorOutStream(Yad3Program program, MtmErrorCode code);
+
+static bool NextRecord(Yad3Program program, CommandRecord* record);
+static void ParseCommand(const char* command, size_t length,
+	Yad3Program program, CommandRecord* record);
+static bool ExecuteCommand(const CommandRecord* record, Yad3Program program);
+static bool LogCommand(Yad3Program program, const CommandRecord* record);
+static void RunPipelined(Yad3Program program);
+static void* RunPipelineReader(void* program_pointer);
+static bool NextRecordCancelable(Yad3Program program, CommandRecord* record);
+static void RunConversion(Yad3Program program);
+
+static Yad3ServiceResult RunAddRealtor(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunRemoveRealtor(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunRealtorAddApartmentService(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunRealtorRemoveApartmentService(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunRealtorAddApartmentToRealtor(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunRemoveApartmentFromRealtor(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunResponeToOffer(Yad3Program program,
+	const CommandArgument* arguments);
+
+static Yad3ServiceResult RunAddCustumer(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunRemoveCustumer(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunCustumerPurchase(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunMakeOffer(Yad3Program program,
+	const CommandArgument* arguments);
+
+static Yad3ServiceResult RunPayingCustumersReport(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunSignificantRealtorReport(Yad3Program program,
+	const CommandArgument* arguments);
+static Yad3ServiceResult RunPrintRealventRealtorReport(Yad3Program program,
+	const CommandArgument* arguments);
+
+static bool HandleResult(Yad3Program program, Yad3ServiceResult result);
 MtmErrorCode ConvertYad3ServiceResult(Yad3ServiceResult value);
-static bool splitString(char* string, int *size, char*** out_matrix);
-//static char** splitString(char* string, int *size);
-static char* getSubString(char* str, int start_index, int end_index);
-static void matrixDestroy(char** matrix, int size);
-static bool addToArray(char*** result, int *logical_size, int *actual_size,
-				char* string, int start_index, int index);
+
+/*
+ * All the program commands: user, action, arguments count, arguments types
+ * and the handler running the command.
+ */
+static const CommandSpec COMMANDS[] = {
+	{USER_REALTOR, ACTION_ADD_USER, 3,
+		{ARG_STRING, ARG_STRING, ARG_INT}, RunAddRealtor},
+	{USER_REALTOR, ACTION_REMOVE_USER, 1,
+		{ARG_STRING}, RunRemoveRealtor},
+	{USER_REALTOR, ACTION_ADD_SERVICE, 3,
+		{ARG_STRING, ARG_STRING, ARG_INT}, RunRealtorAddApartmentService},
+	{USER_REALTOR, ACTION_REMOVE_SERVICE, 2,
+		{ARG_STRING, ARG_STRING}, RunRealtorRemoveApartmentService},
+	{USER_REALTOR, ACTION_ADD_APARTMENT, 7,
+		{ARG_STRING, ARG_STRING, ARG_INT, ARG_INT, ARG_INT, ARG_INT,
+		ARG_STRING}, RunRealtorAddApartmentToRealtor},
+	{USER_REALTOR, ACTION_REMOVE_APARTMENT, 3,
+		{ARG_STRING, ARG_STRING, ARG_INT}, RunRemoveApartmentFromRealtor},
+	{USER_REALTOR, ACTION_RESPOND_OFFER, 3,
+		{ARG_STRING, ARG_STRING, ARG_STRING}, RunResponeToOffer},
+	{USER_CUSTOMER, ACTION_ADD_USER, 4,
+		{ARG_STRING, ARG_INT, ARG_INT, ARG_INT}, RunAddCustumer},
+	{USER_CUSTOMER, ACTION_REMOVE_USER, 1,
+		{ARG_STRING}, RunRemoveCustumer},
+	{USER_CUSTOMER, ACTION_PURCHASE, 4,
+		{ARG_STRING, ARG_STRING, ARG_STRING, ARG_INT}, RunCustumerPurchase},
+	{USER_CUSTOMER, ACTION_MAKE_OFFER, 5,
+		{ARG_STRING, ARG_STRING, ARG_STRING, ARG_INT, ARG_INT}, RunMakeOffer},
+	{USER_REPORTER, REPORT_RELEVENT_REALTORS, 1,
+		{ARG_STRING}, RunPrintRealventRealtorReport},
+	{USER_REPORTER, REPORT_SIGNIFICANT_REALTORS, 1,
+		{ARG_INT}, RunSignificantRealtorReport},
+	{USER_REPORTER, REPORT_PAYING_CUSTOMERS, 1,
+		{ARG_INT}, RunPayingCustumersReport}
+};
+
+#define COMMANDS_COUNT ((int)(sizeof(COMMANDS) / sizeof(COMMANDS[0])))
 
 /**
 * Allocates Yad3Program.
@@ -86,11 +188,16 @@ static bool addToArray(char*** result, int *logical_size, int *actual_size,
 * Creates a new Yad3Program. This function receives the input parameters of the
 * process and retrieves the new program created.
 *
-* 	correct parameters are:
-* 	- only one parameter
-* 	- three parameters, the third must be INPUT_SIGN or OUTPUT_SIGN
-* 	- five parameters, the third and the fifth must be INPUT_SIGN and
-* 		OUTPUT_SIGN (one must be OUTPUT_SIGN and the second must be INPUT_SIGN)
+* 	correct parameters are, in any order and each one at most once:
+* 	- INPUT_SIGN followed by the input file path
+* 	- OUTPUT_SIGN followed by the output file path
+* 	- PIPELINE_SIGN
+* 	- BINARY_SIGN
+* 	- CONVERT_SIGN followed by the converted log path
+* 	- TIMING_SIGN
+* 	- SNAPSHOT_LOAD_SIGN followed by the loaded snapshot path
+* 	- SNAPSHOT_SAVE_SIGN followed by the saved snapshot path
+* 	- WRITE_AHEAD_LOG_SIGN followed by the write ahead log path
 *
 * @param input_parameters input parameters.
 * @param parameter_count input parameters count.
@@ -99,78 +206,142 @@ static bool addToArray(char*** result, int *logical_size, int *actual_size,
 * 	NULL in case of wrong parameters or allocation error; else return true
 */
 Yad3Program yad3ProgramCreate(char *input_parameters[], int parameter_count) {
-	if (!checkProgramParameters(input_parameters, parameter_count)) {
-		writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
+	ProgramParameters parameters;
+	if (!parseProgramParameters(input_parameters, parameter_count,
+			&parameters)) {
+		writeToErrorOutStream(NULL, MTM_INVALID_COMMAND_LINE_PARAMETERS);
 		return NULL;
 	}
-	char* input = GetInputsPaths(input_parameters, parameter_count, true);
-	char* output = GetInputsPaths(input_parameters, parameter_count, false);
-	FILE *out_file = NULL, *in_file = NULL;
-	bool error = false;
-	if (output != NULL) {
-		error = !openFile(output, WRITE, &out_file);
+	char* input = parameters.input;
+	char* output = parameters.output;
+	FILE *out_file = NULL;
+	InputReader reader = NULL;
+	if ((output != NULL) && (!openFile(output, WRITE, &out_file))) {
+		writeToErrorOutStream(NULL, MTM_CANNOT_OPEN_FILE);
+		return NULL;
 	}
+	InputReaderResult result = INPUT_READER_SUCCESS;
 	if (input != NULL) {
-		error &= !openFile(input, READ, &in_file);
+		result = inputReaderCreateFromPath(input, &reader);
+	} else {
+		reader = inputReaderCreateFromStream(stdin);
+		if (reader == NULL) result = INPUT_READER_OUT_OF_MEMORY;
+	}
+	if (result != INPUT_READER_SUCCESS) {
+		closeFile(out_file);
+		writeToErrorOutStream(NULL, result == INPUT_READER_OUT_OF_MEMORY ?
+			MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+		return NULL;
 	}
-	if (error) {
-		writeToErrorOutStream(MTM_CANNOT_OPEN_FILE);
+	Yad3Program program = allocateYad3Program(reader, out_file, &parameters);
+	if ((program != NULL) && ((!openCommandLogs(program, &parameters)) ||
+		((parameters.loaded != NULL) &&
+		(!loadSnapshot(program, parameters.loaded))) ||
+		((parameters.logged != NULL) &&
+		(!openWriteAheadLog(program, parameters.logged))))) {
+		yad3ProgramDestroy(program);
 		return NULL;
 	}
-	return (allocateYad3Program(in_file, out_file));
+	return program;
 }
 
 /*
-* checkProgramParameters:
+* parseProgramParameters:
 *
-* 	method checks if the program input parameters are correct.
+* 	method checks if the program input parameters are correct, and saves
+* 	them.
 *
-* 	correct parameters are:
-* 	- only one parameter
-* 	- three parameters, the third must be INPUT_SIGN or OUTPUT_SIGN
-* 	- five parameters, the third and the fifth must be INPUT_SIGN and
-* 		OUTPUT_SIGN (one must be OUTPUT_SIGN and the second must be INPUT_SIGN)
+* 	correct parameters are, in any order and each one at most once:
+* 	- INPUT_SIGN followed by the input file path
+* 	- OUTPUT_SIGN followed by the output file path
+* 	- PIPELINE_SIGN
+* 	- BINARY_SIGN
+* 	- CONVERT_SIGN followed by the converted log path
+* 	- TIMING_SIGN
+* 	- SNAPSHOT_LOAD_SIGN followed by the loaded snapshot path
+* 	- SNAPSHOT_SAVE_SIGN followed by the saved snapshot path
+* 	- WRITE_AHEAD_LOG_SIGN followed by the write ahead log path
 *
-* @param input_parameters array of input parameters
-* @param parameter_count size of parameters array
+* @param input array of input parameters
+* @param count size of parameters array
+* @param parameters pointer to save the parameters in
 *
 * @return
 *	false if parameters are not good; else returns true.
 */
-static bool checkProgramParameters(char *input[], int count) {
-	if (count == 1) return true;
-	if ((count == 3) &&
-		((areStringsEqual(input[1], INPUT_SIGN)) ||
-		 (areStringsEqual(input[1], OUTPUT_SIGN)))) return true;
-	if ((count == 5) &&
-		(((areStringsEqual(input[1], INPUT_SIGN)) &&
-		  (areStringsEqual(input[3], OUTPUT_SIGN))) ||
-		 ((areStringsEqual(input[1], OUTPUT_SIGN)) &&
-		  (areStringsEqual(input[3], INPUT_SIGN))))) return true;
-	return false;
+static bool parseProgramParameters(char *input[], int count,
+	ProgramParameters* parameters) {
+	parameters->input = NULL;
+	parameters->output = NULL;
+	parameters->converted = NULL;
+	parameters->loaded = NULL;
+	parameters->saved = NULL;
+	parameters->logged = NULL;
+	parameters->is_pipelined = false;
+	parameters->is_binary = false;
+	parameters->is_timed = false;
+	for (int i = 1; i < count; i++) {
+		if (areStringsEqual(input[i], INPUT_SIGN)) {
+			if (!parsePathParameter(input, count, &i, &parameters->input)) {
+				return false;
+			}
+		} else if (areStringsEqual(input[i], OUTPUT_SIGN)) {
+			if (!parsePathParameter(input, count, &i, &parameters->output)) {
+				return false;
+			}
+		} else if ((areStringsEqual(input[i], PIPELINE_SIGN)) &&
+			(!parameters->is_pipelined)) {
+			parameters->is_pipelined = true;
+		} else if ((areStringsEqual(input[i], BINARY_SIGN)) &&
+			(!parameters->is_binary)) {
+			parameters->is_binary = true;
+		} else if ((areStringsEqual(input[i], TIMING_SIGN)) &&
+			(!parameters->is_timed)) {
+			parameters->is_timed = true;
+		} else if (areStringsEqual(input[i], CONVERT_SIGN)) {
+			if (!parsePathParameter(input, count, &i,
+					&parameters->converted)) {
+				return false;
+			}
+		} else if (areStringsEqual(input[i], SNAPSHOT_LOAD_SIGN)) {
+			if (!parsePathParameter(input, count, &i, &parameters->loaded)) {
+				return false;
+			}
+		} else if (areStringsEqual(input[i], SNAPSHOT_SAVE_SIGN)) {
+			if (!parsePathParameter(input, count, &i, &parameters->saved)) {
+				return false;
+			}
+		} else if (areStringsEqual(input[i], WRITE_AHEAD_LOG_SIGN)) {
+			if (!parsePathParameter(input, count, &i, &parameters->logged)) {
+				return false;
+			}
+		} else {
+			return false;
+		}
+	}
+	return true;
 }
 
 /*
-* GetInputFileAdress:
+* parsePathParameter:
 *
-* 	method gets input/output address from program input parameters.
+* 	method reads the path following a sign parameter, and moves the index
+* 	to it.
 *
-* @param input_parameters array of input parameters
-* @param parameter_count size of parameters array
+* @param input array of input parameters
+* @param count size of parameters array
+* @param index the index of the sign parameter
+* @param path pointer to save the path in, must not be set already
 *
 * @return
-*	false if parameters are not good; else returns true.
+*	false if there is no path or it was given already; else returns true.
 */
-static char* GetInputsPaths(char *input[], int count, bool find_input) {
-	if ((count >= 3) &&
-		(areStringsEqual(input[1], (find_input ? INPUT_SIGN : OUTPUT_SIGN)))) {
-		return input[2];
-	}
-	if ((count == 5) &&
-		(areStringsEqual(input[3], (find_input ? INPUT_SIGN : OUTPUT_SIGN)))) {
-		return input[4];
-	}
-	return NULL;
+static bool parsePathParameter(char *input[], int count, int* index,
+	char** path) {
+	if ((*path != NULL) || (*index + 1 >= count)) return false;
+	(*index)++;
+	*path = input[*index];
+	return true;
 }
 
 /*
@@ -178,28 +349,315 @@ static char* GetInputsPaths(char *input[], int count, bool find_input) {
 *
 * allocates a new yad3 programs parameters.
 *
-* @param input_parameters array of input parameters
-* @param parameter_count size of parameters array
+* @param input the input reader
+* @param output the output file, NULL for stdout. the program owns it from
+* 	now on
+* @param parameters the program parameters
 *
 * @return
 *	NULL in case of allocation error; else returns true.
 */
-static Yad3Program allocateYad3Program(FILE *input, FILE *output) {
+static Yad3Program allocateYad3Program(InputReader input, FILE *output,
+	ProgramParameters* parameters) {
 	Yad3Service new_service = yad3ServiceCreate();
-	if (new_service == NULL) return NULL;
+	CommandTokens tokens = commandTokensCreate();
+	CommandTable commands = commandTableCreate(COMMANDS, COMMANDS_COUNT);
+	OutputSink sink = outputSinkCreate(output == NULL ? stdout : output,
+		stderr);
+	CommandStatistics statistics = parameters->is_timed ?
+		commandStatisticsCreate(commands) : NULL;
 	Yad3Program program = malloc(sizeof(*program));
-	if (program == NULL) {
+	if ((new_service == NULL) || (tokens == NULL) || (commands == NULL) ||
+		(sink == NULL) || ((parameters->is_timed) && (statistics == NULL)) ||
+		(program == NULL)) {
 		yad3ServiceDestroy(new_service);
-		closeFile(input);
-		closeFile(output);
+		commandTokensDestroy(tokens);
+		commandStatisticsDestroy(statistics);
+		commandTableDestroy(commands);
+		free(program);
+		inputReaderDestroy(input);
+		if (sink == NULL) {
+			closeFile(output);
+		} else {
+			outputSinkDestroy(sink);
+		}
 		return NULL;
 	}
 	program->service = new_service;
 	program->input = input;
-	program->output = output;
+	program->sink = sink;
+	program->tokens = tokens;
+	program->commands = commands;
+	program->is_pipelined = parameters->is_pipelined;
+	program->ring = NULL;
+	program->log = NULL;
+	program->converted = NULL;
+	program->converter = NULL;
+	program->statistics = statistics;
+	program->snapshot = parameters->saved;
+	program->sequence = 0;
+	program->logged = NULL;
+	program->wal = NULL;
 	return program;
 }
 
+/*
+* openCommandLogs:
+*
+* 	opens the binary command log the program reads, and the one it converts
+* 	the input to, if the parameters ask for them. errors are written to the
+* 	error out stream.
+*
+* @param program the program
+* @param parameters the program parameters
+*
+* @return
+*	false if a log could not be opened; else returns true.
+*/
+static bool openCommandLogs(Yad3Program program,
+	ProgramParameters* parameters) {
+	if (parameters->is_binary) {
+		const char* data = NULL;
+		size_t size = 0;
+		if (!inputReaderReadAll(program->input, &data, &size)) {
+			writeToErrorOutStream(program, MTM_OUT_OF_MEMORY);
+			return false;
+		}
+		CommandLogResult result = commandLogReaderCreate(data, size,
+			program->commands, &program->log);
+		if (result != COMMAND_LOG_SUCCESS) {
+			writeToErrorOutStream(program,
+				result == COMMAND_LOG_OUT_OF_MEMORY ?
+				MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+			return false;
+		}
+	}
+	if (parameters->converted != NULL) {
+		if (!openFile(parameters->converted, WRITE_BINARY,
+				&program->converted)) {
+			writeToErrorOutStream(program, MTM_CANNOT_OPEN_FILE);
+			return false;
+		}
+		CommandLogResult result = commandLogWriterCreate(program->converted,
+			program->commands, &program->converter);
+		if (result != COMMAND_LOG_SUCCESS) {
+			writeToErrorOutStream(program,
+				result == COMMAND_LOG_OUT_OF_MEMORY ?
+				MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+* loadSnapshot:
+*
+* 	replaces the empty service of the program with the one saved in a
+* 	snapshot. errors are written to the error out stream.
+*
+* @param program the program
+* @param path the snapshot path
+*
+* @return
+*	false if the snapshot could not be loaded; else returns true.
+*/
+static bool loadSnapshot(Yad3Program program, char* path) {
+	InputReader reader = NULL;
+	InputReaderResult opened = inputReaderCreateFromPath(path, &reader);
+	if (opened != INPUT_READER_SUCCESS) {
+		writeToErrorOutStream(program, opened == INPUT_READER_OUT_OF_MEMORY ?
+			MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+		return false;
+	}
+	const char* data = NULL;
+	size_t size = 0;
+	Yad3Service service = NULL;
+	SnapshotResult result = SNAPSHOT_OUT_OF_MEMORY;
+	if (inputReaderReadAll(reader, &data, &size)) {
+		result = yad3ServiceLoadSnapshot(data, size, &service,
+			&program->sequence);
+	}
+	inputReaderDestroy(reader);
+	if (result != SNAPSHOT_SUCCESS) {
+		writeToErrorOutStream(program, result == SNAPSHOT_OUT_OF_MEMORY ?
+			MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+		return false;
+	}
+	yad3ServiceDestroy(program->service);
+	program->service = service;
+	return true;
+}
+
+/*
+* saveSnapshot:
+*
+* 	saves the service of the program to a snapshot, if the program was
+* 	asked to, and empties the write ahead log the snapshot includes. the
+* 	snapshot is written to a temporary file and synced first, so a crash
+* 	leaves either the old snapshot or the new one. errors are written to
+* 	the error out stream.
+*
+* @param program the program
+*/
+static void saveSnapshot(Yad3Program program) {
+	if (program->snapshot == NULL) return;
+	char* temporary = malloc(strlen(program->snapshot) +
+		strlen(TEMPORARY_SUFFIX) + 1);
+	if (temporary == NULL) {
+		writeToErrorOutStream(program, MTM_OUT_OF_MEMORY);
+		return;
+	}
+	strcpy(temporary, program->snapshot);
+	strcat(temporary, TEMPORARY_SUFFIX);
+	FILE* file = NULL;
+	if (!openFile(temporary, WRITE_BINARY, &file)) {
+		free(temporary);
+		writeToErrorOutStream(program, MTM_CANNOT_OPEN_FILE);
+		return;
+	}
+	long long sequence = (program->wal != NULL) ?
+		writeAheadLogWriterGetSequence(program->wal) : program->sequence;
+	SnapshotResult result = yad3ServiceSaveSnapshot(program->service,
+		sequence, file);
+	if ((result == SNAPSHOT_SUCCESS) && (!writeAheadLogSyncFile(file))) {
+		result = SNAPSHOT_WRITE_FAILED;
+	}
+	if (fclose(file) != 0) result = SNAPSHOT_WRITE_FAILED;
+	if ((result == SNAPSHOT_SUCCESS) &&
+		(!replaceFile(temporary, program->snapshot))) {
+		result = SNAPSHOT_WRITE_FAILED;
+	}
+	if (result != SNAPSHOT_SUCCESS) remove(temporary);
+	free(temporary);
+	if ((result != SNAPSHOT_SUCCESS) || ((program->wal != NULL) &&
+		(writeAheadLogWriterReset(program->wal) != WRITE_AHEAD_LOG_SUCCESS))) {
+		writeToErrorOutStream(program, result == SNAPSHOT_OUT_OF_MEMORY ?
+			MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+	}
+}
+
+/*
+* openWriteAheadLog:
+*
+* 	runs the commands of the write ahead log at the path which the service
+* 	does not include yet, and opens the log to add the next commands to.
+* 	a new log is created if there is none. errors are written to the error
+* 	out stream.
+*
+* @param program the program
+* @param path the log path
+*
+* @return
+*	false if the log could not be replayed or opened; else returns true.
+*/
+static bool openWriteAheadLog(Yad3Program program, char* path) {
+	InputReader reader = NULL;
+	size_t size = 0;
+	InputReaderResult opened = inputReaderCreateFromPath(path, &reader);
+	if (opened == INPUT_READER_OUT_OF_MEMORY) {
+		writeToErrorOutStream(program, MTM_OUT_OF_MEMORY);
+		return false;
+	}
+	if (opened == INPUT_READER_SUCCESS) {
+		bool is_replayed = replayWriteAheadLog(program, reader, &size);
+		inputReaderDestroy(reader);
+		if (!is_replayed) return false;
+	}
+	if (!openFile(path, size > 0 ? UPDATE_BINARY : WRITE_BINARY,
+			&program->logged)) {
+		writeToErrorOutStream(program, MTM_CANNOT_OPEN_FILE);
+		return false;
+	}
+	WriteAheadLogResult result = writeAheadLogWriterCreate(program->logged,
+		size, program->commands, program->sequence,
+		WRITE_AHEAD_LOG_GROUP_SIZE, WRITE_AHEAD_LOG_GROUP_DELAY,
+		&program->wal);
+	if (result != WRITE_AHEAD_LOG_SUCCESS) {
+		writeToErrorOutStream(program,
+			result == WRITE_AHEAD_LOG_OUT_OF_MEMORY ?
+			MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+		return false;
+	}
+	return true;
+}
+
+/*
+* replayWriteAheadLog:
+*
+* 	runs the commands of a write ahead log which come after the sequence
+* 	of the program, and moves the sequence to the last one. the log ends
+* 	at its first record which is not valid, as a crash while writing it
+* 	leaves. errors are written to the error out stream.
+*
+* @param program the program
+* @param reader the reader of the log file
+* @param size pointer to save the size of the valid log in, 0 if the file
+* 	is empty
+*
+* @return
+*	false if the log is not valid, does not follow the sequence of the
+*	program or a command of it failed; else returns true.
+*/
+static bool replayWriteAheadLog(Yad3Program program, InputReader reader,
+	size_t* size) {
+	const char* data = NULL;
+	size_t data_size = 0;
+	*size = 0;
+	if (!inputReaderReadAll(reader, &data, &data_size)) {
+		writeToErrorOutStream(program, MTM_OUT_OF_MEMORY);
+		return false;
+	}
+	if (data_size == 0) return true;
+	WriteAheadLogReader log = NULL;
+	WriteAheadLogResult result = writeAheadLogReaderCreate(data, data_size,
+		program->commands, &log);
+	if (result != WRITE_AHEAD_LOG_SUCCESS) {
+		writeToErrorOutStream(program,
+			result == WRITE_AHEAD_LOG_OUT_OF_MEMORY ?
+			MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+		return false;
+	}
+	Yad3ServiceResult replayed = YAD3_SERVICE_SUCCESS;
+	long long sequence = 0;
+	CommandRecord record;
+	while ((replayed == YAD3_SERVICE_SUCCESS) && (writeAheadLogReaderNext(log,
+			&sequence, &record) == WRITE_AHEAD_LOG_SUCCESS)) {
+		if (sequence <= program->sequence) continue;
+		if (sequence != program->sequence + 1) {
+			replayed = YAD3_SERVICE_INVALID_PARAMETERS;
+			break;
+		}
+		replayed = commandTableGetSpec(program->commands,
+			record.index)->handler(program, record.arguments);
+		program->sequence = sequence;
+	}
+	*size = writeAheadLogReaderGetValidSize(log);
+	writeAheadLogReaderDestroy(log);
+	if (replayed != YAD3_SERVICE_SUCCESS) {
+		writeToErrorOutStream(program, replayed == YAD3_SERVICE_OUT_OF_MEMORY ?
+			MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+		return false;
+	}
+	return true;
+}
+
+/*
+* replaceFile: renames a file over another one.
+*
+* @param source the file to rename
+* @param target the file to replace
+*
+* @return
+*	false if renaming failed; else returns true.
+*/
+static bool replaceFile(const char* source, const char* target) {
+#ifdef _WIN32
+	remove(target);
+#endif
+	return rename(source, target) == 0;
+}
+
 /*
 * openFile:
 *
@@ -227,6 +685,14 @@ static bool openFile(char* path, MTMFileMode mode, FILE** output) {
 				*output = fopen(path, "a");
 				break;
 			}
+			case WRITE_BINARY : {
+				*output = fopen(path, "wb");
+				break;
+			}
+			case UPDATE_BINARY : {
+				*output = fopen(path, "r+b");
+				break;
+			}
 			default : {
 				*output = NULL;
 				break;
@@ -255,21 +721,45 @@ static void closeFile(FILE *output) {
 */
 void yad3ProgramDestroy(Yad3Program program) {
 	if (program) {
-		closeFile(program->input);
-		closeFile(program->output);
+		inputReaderDestroy(program->input);
+		if (program->statistics != NULL) {
+			commandStatisticsPrint(program->statistics,
+				outputSinkGetStream(program->sink, OUTPUT_SINK_ERROR));
+			slabAllocatorPrint(yad3ServiceGetAllocator(program->service),
+				outputSinkGetStream(program->sink, OUTPUT_SINK_ERROR));
+		}
+		outputSinkDestroy(program->sink);
 		program->input = NULL;
-		program->output = NULL;
+		program->sink = NULL;
 		yad3ServiceDestroy(program->service);
+		commandTokensDestroy(program->tokens);
+		commandLogReaderDestroy(program->log);
+		commandLogWriterDestroy(program->converter);
+		closeFile(program->converted);
+		writeAheadLogWriterDestroy(program->wal);
+		closeFile(program->logged);
+		commandStatisticsDestroy(program->statistics);
+		commandTableDestroy(program->commands);
+		free(program);
 	}
 }
 
 /*
 * writeToErrorOutStream: writes a code to the error out stream.
 *
-* @param program program to destroy
+* @param program the program writing, NULL if it was not created
+* @param code the error code
 */
-static void writeToErrorOutStream(MtmErrorCode code) {
-	mtmPrintErrorMessage(stderr, code);
+static void writeToErrorOutStream(Yad3Program program, MtmErrorCode code) {
+	if (program == NULL) {
+		mtmPrintErrorMessage(stderr, code);
+		return;
+	}
+	if (program->statistics != NULL) {
+		commandStatisticsRecordError(program->statistics, code);
+	}
+	mtmPrintErrorMessage(outputSinkGetStream(program->sink, OUTPUT_SINK_ERROR),
+		code);
 }
 
 /*
@@ -279,309 +769,368 @@ static void writeToErrorOutStream(MtmErrorCode code) {
 */
 void yad3ProgramRun(Yad3Program program) {
 	if (program == NULL) return;
-	char buffer[MAX_LEN] = "";
-	bool should_continue = true;
-	char *charcter =  fgets(buffer, MAX_LEN, //program->input);
-			(program->input != NULL ? program->input : stdin));
-	while ((should_continue) && (charcter != NULL)) {
-		should_continue = RunCommand(buffer, program);
-		if (should_continue) {
-			charcter =  fgets(buffer, MAX_LEN, //program->input);
-					(program->input != NULL ? program->input : stdin));
+	if (program->converter != NULL) {
+		RunConversion(program);
+		return;
+	}
+	if (program->is_pipelined) {
+		RunPipelined(program);
+	} else {
+		CommandRecord record;
+		bool should_continue = true;
+		while ((should_continue) && (NextRecord(program, &record))) {
+			should_continue = ExecuteCommand(&record, program);
 		}
 	}
+	if ((program->wal != NULL) &&
+		(writeAheadLogWriterCommit(program->wal) != WRITE_AHEAD_LOG_SUCCESS)) {
+		writeToErrorOutStream(program, MTM_CANNOT_OPEN_FILE);
+	}
+	saveSnapshot(program);
 }
 
 /*
- * Runs a command recived from the defined input stream
+ * Reads the next command record of the input, from the binary command log
+ * or by parsing the next text line. the string arguments of the record are
+ * valid until the next read. returns false if the input ended.
+ * a broken binary log gives an unknown command record, and then ends
  */
-static bool RunCommand(char* command, Yad3Program program) {
-	if (command[0] == COMMENT_SIGN) return true;
-	int size;
-	char** params = NULL;
-	bool should_continue = true;
-	if (!splitString(command, &size, &params)) {
-		writeToErrorOutStream(MTM_OUT_OF_MEMORY);
-		should_continue = false;
-	} else if (params == NULL) {
-		return true;
-	} else  if (params[0][0] == '\n') {
-		should_continue = true;
-	} else if (areStringsEqual(params[0], USER_CUSTOMER)) {
-		should_continue = RunCustomerCommand(params, program);
-	} else if (areStringsEqual(params[0], USER_REALTOR)) {
-		should_continue = RunRealtorCommand(params, program);
-	} else if (areStringsEqual(params[0], USER_REPORTER)) {
-		should_continue = RunReporterCommand(params, program);
+static bool NextRecord(Yad3Program program, CommandRecord* record) {
+	if (program->log != NULL) {
+		CommandLogResult result = commandLogReaderNext(program->log, record);
+		if (result == COMMAND_LOG_BAD_FORMAT) {
+			record->kind = COMMAND_RECORD_UNKNOWN_COMMAND;
+		}
+		return (result != COMMAND_LOG_END);
+	}
+	const char* line = NULL;
+	size_t length = 0;
+	if (!inputReaderNextLine(program->input, &line, &length)) return false;
+	ParseCommand(line, length, program, record);
+	return true;
+}
+
+/*
+ * Parses a command into a record. the string arguments of the record point
+ * into the program tokens, and are valid until the next parse
+ */
+static void ParseCommand(const char* command, size_t length,
+	Yad3Program program, CommandRecord* record) {
+	record->kind = COMMAND_RECORD_SKIP;
+	record->index = -1;
+	if ((length > 0) && (command[0] == COMMENT_SIGN)) return;
+	CommandTokens params = program->tokens;
+	int size = commandTokensSplit(params, command, length);
+	if (size < 0) {
+		record->kind = COMMAND_RECORD_OUT_OF_MEMORY;
+		return;
+	} else if (size == 0) {
+		return;
+	}
+	CommandTableResult found = commandTableFind(program->commands, params,
+		&record->index);
+	if (found == COMMAND_TABLE_UNKNOWN_COMMAND) {
+		record->kind = COMMAND_RECORD_UNKNOWN_COMMAND;
+	} else if (found == COMMAND_TABLE_WRONG_ARGUMENTS_COUNT) {
+		record->kind = COMMAND_RECORD_WRONG_ARGUMENTS_COUNT;
 	} else {
-		writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-		should_continue = false;
+		record->kind = COMMAND_RECORD_COMMAND;
+		commandTableDecode(commandTableGetSpec(program->commands,
+			record->index), params, record->arguments);
 	}
-	matrixDestroy(params, size);
-	return should_continue;
 }
 
 /*
- * Runs all the realtor commands
-*/
-static bool RunRealtorCommand(char** params, Yad3Program program) {
-	if (areStringsEqual(params[1], ACTION_ADD_USER)) {
-		return RunAddRealtor(params, program);
-	} else if (areStringsEqual(params[1], ACTION_REMOVE_USER)) {
-		return RunRemoveRealtor(params, program);
-	} else if (areStringsEqual(params[1], ACTION_ADD_SERVICE)) {
-		return RunRealtorAddApartmentService(params, program);
-	} else if (areStringsEqual(params[1], ACTION_REMOVE_SERVICE)) {
-		return RunRealtorRemoveApartmentService(params, program);
-	} else if (areStringsEqual(params[1], ACTION_ADD_APARTMENT)) {
-		return RunRealtorAddApartmentToRealtor(params, program);
-	} else if (areStringsEqual(params[1], ACTION_REMOVE_APARTMENT)) {
-		return RunRemoveApartmentFromRealtor(params, program);
-	} else if (areStringsEqual(params[1], ACTION_RESPOND_OFFER)) {
-		return RunResponeToOffer(params, program);
+ * Executes a parsed command record, returns if should continue or not
+ */
+static bool ExecuteCommand(const CommandRecord* record, Yad3Program program) {
+	switch (record->kind) {
+		case COMMAND_RECORD_SKIP: return true;
+		case COMMAND_RECORD_OUT_OF_MEMORY: {
+			writeToErrorOutStream(program, MTM_OUT_OF_MEMORY);
+			return false;
+		}
+		case COMMAND_RECORD_COMMAND:
+		case COMMAND_RECORD_WRONG_ARGUMENTS_COUNT: break;
+		default: {
+			writeToErrorOutStream(program,
+				MTM_INVALID_COMMAND_LINE_PARAMETERS);
+			return false;
+		}
+	}
+	const CommandSpec* spec = commandTableGetSpec(program->commands,
+		record->index);
+	long long start = 0;
+	if (program->statistics != NULL) start = monotonicClockNow();
+	bool should_continue = false;
+	bool is_report = areStringsEqual(spec->user, USER_REPORTER);
+	if (record->kind == COMMAND_RECORD_WRONG_ARGUMENTS_COUNT) {
+		writeToErrorOutStream(program, MTM_INVALID_COMMAND_LINE_PARAMETERS);
 	} else {
-		writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-		return false;
+		Yad3ServiceResult result = spec->handler(program, record->arguments);
+		should_continue = HandleResult(program, result);
+		if ((result == YAD3_SERVICE_SUCCESS) && (!is_report)) {
+			should_continue = LogCommand(program, record);
+		}
+	}
+	// reports never stop the program, and are written out as they end
+	if (is_report) outputSinkFlush(program->sink);
+	if (program->statistics != NULL) {
+		commandStatisticsRecordLatency(program->statistics, record->index,
+			monotonicClockNow() - start);
+	}
+	return should_continue || is_report;
+}
+
+/*
+ * Adds a command which changed the service to the write ahead log, if the
+ * program keeps one. returns if should continue or not
+ */
+static bool LogCommand(Yad3Program program, const CommandRecord* record) {
+	if (program->wal == NULL) return true;
+	WriteAheadLogResult result = writeAheadLogWriterAppend(program->wal,
+		record);
+	if (result == WRITE_AHEAD_LOG_SUCCESS) return true;
+	writeToErrorOutStream(program, result == WRITE_AHEAD_LOG_OUT_OF_MEMORY ?
+		MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+	return false;
+}
+
+/*
+ * Runs the program in two stages: a reader thread parses the input into
+ * records, while this thread executes them in order. all the output is
+ * written by this thread, so it is the same as running serially.
+ * falls back to running serially if the reader thread can not be started.
+ */
+static void RunPipelined(Yad3Program program) {
+	program->ring = commandRingCreate(PIPELINE_RING_CAPACITY);
+	pthread_t reader;
+	if ((program->ring == NULL) ||
+		(pthread_create(&reader, NULL, RunPipelineReader, program) != 0)) {
+		commandRingDestroy(program->ring);
+		program->ring = NULL;
+		program->is_pipelined = false;
+		yad3ProgramRun(program);
+		return;
+	}
+	bool should_continue = true;
+	while (should_continue) {
+		CommandRecord* record = commandRingPeek(program->ring);
+		if (record->kind == COMMAND_RECORD_END) break;
+		should_continue = ExecuteCommand(record, program);
+		commandRingRelease(program->ring);
+	}
+	commandRingStop(program->ring);
+	// the reader may be blocked on an input that has not ended, e.g a pipe
+	if (!should_continue) pthread_cancel(reader);
+	pthread_join(reader, NULL);
+	commandRingDestroy(program->ring);
+	program->ring = NULL;
+}
+
+/*
+ * The reader thread of the pipelined run, parses the input lines into the
+ * program ring until the input ends or the executor stops the ring
+ */
+static void* RunPipelineReader(void* program_pointer) {
+	Yad3Program program = program_pointer;
+	CommandRecord parsed;
+	int state;
+	pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+	while (NextRecordCancelable(program, &parsed)) {
+		if (parsed.kind == COMMAND_RECORD_SKIP) continue;
+		CommandRecord* record = commandRingAcquire(program->ring);
+		if (record == NULL) return NULL;
+		if (!commandRecordCopy(record, &parsed, commandTableGetSpec(
+				program->commands, parsed.index))) {
+			record->kind = COMMAND_RECORD_OUT_OF_MEMORY;
+		}
+		commandRingPublish(program->ring);
+	}
+	CommandRecord* record = commandRingAcquire(program->ring);
+	if (record != NULL) {
+		record->kind = COMMAND_RECORD_END;
+		commandRingPublish(program->ring);
+	}
+	return NULL;
+}
+
+/*
+ * Reads the next record for the reader thread, which may be cancelled only
+ * while it waits here for the input, and never while it holds the ring
+ */
+static bool NextRecordCancelable(Yad3Program program, CommandRecord* record) {
+	int state;
+	pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &state);
+	bool has_record = NextRecord(program, record);
+	pthread_setcancelstate(state, &state);
+	return has_record;
+}
+
+/*
+ * Converts the input into the binary command log instead of running it.
+ * every line is converted, including the ones which would stop a run, so
+ * running the log gives the same output as running the input
+ */
+static void RunConversion(Yad3Program program) {
+	CommandRecord record;
+	while (NextRecord(program, &record)) {
+		CommandLogResult result = COMMAND_LOG_OUT_OF_MEMORY;
+		if (record.kind != COMMAND_RECORD_OUT_OF_MEMORY) {
+			result = commandLogWriterWrite(program->converter, &record);
+		}
+		if (result != COMMAND_LOG_SUCCESS) {
+			writeToErrorOutStream(program,
+				result == COMMAND_LOG_OUT_OF_MEMORY ?
+				MTM_OUT_OF_MEMORY : MTM_CANNOT_OPEN_FILE);
+			return;
+		}
 	}
 }
 
 /*
  * Run AddRealtor command
 */
-static bool RunAddRealtor(char** params, Yad3Program program) {
-	if ((params[2] != NULL) && (params[3] != NULL) && (params[4] != NULL)) {
-		Yad3ServiceResult result = yad3ServiceAddAgent(program->service,
-			params[2], params[3], stringToInt(params[4]));
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
+static Yad3ServiceResult RunAddRealtor(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceAddAgent(program->service, arguments[0].string,
+		arguments[1].string, arguments[2].number);
 }
 
 /*
  * Run RunRemoveRealtor command
 */
-static bool RunRemoveRealtor(char** params, Yad3Program program) {
-	if (params[2] != NULL) {
-		Yad3ServiceResult result = yad3ServiceRemoveAgent(program->service,
-			params[2]);
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
+static Yad3ServiceResult RunRemoveRealtor(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceRemoveAgent(program->service, arguments[0].string);
 }
 
 /*
  * Run RealtorAddApartmentService command
  */
-static bool RunRealtorAddApartmentService(char** params, Yad3Program program) {
-	if ((params[2] != NULL) && (params[3] != NULL) && (params[4] != NULL)) {
-			Yad3ServiceResult result = yad3ServiceAddServiceToAgent(program->
-				service, params[2], params[3], stringToInt(params[4]));
-			return HandleResult(result);
-		}
-		writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-		return false;
+static Yad3ServiceResult RunRealtorAddApartmentService(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceAddServiceToAgent(program->service, arguments[0].string,
+		arguments[1].string, arguments[2].number);
 }
 
 /*
  * Run RealtorAddApartmentService command
  */
-static bool RunRealtorRemoveApartmentService(char** params,
-	Yad3Program program) {
-	if ((params[2] != NULL) && (params[3] != NULL)) {
-			Yad3ServiceResult result = yad3ServiceRemoveServiceFromAgent(
-				program->service, params[2], params[3]);
-			return HandleResult(result);
-		}
-		writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-		return false;
+static Yad3ServiceResult RunRealtorRemoveApartmentService(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceRemoveServiceFromAgent(program->service,
+		arguments[0].string, arguments[1].string);
 }
 
 /*
  * Run AddApartmentToRealtor command
 */
-static bool RunRealtorAddApartmentToRealtor(char** params,
-		Yad3Program program) {
-	if ((params[2] != NULL) && (params[3] != NULL) && (params[4] != NULL)) {
-		Yad3ServiceResult result = yad3ServiceAddApartmentToAgent(
-			program->service, params[2], params[3], stringToInt(params[4]),
-			stringToInt(params[5]), stringToInt(params[6]),
-			stringToInt(params[7]), params[8]);
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
+static Yad3ServiceResult RunRealtorAddApartmentToRealtor(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceAddApartmentToAgent(program->service,
+		arguments[0].string, arguments[1].string, arguments[2].number,
+		arguments[3].number, arguments[4].number, arguments[5].number,
+		arguments[6].string);
 }
 
 /*
  * Run RemoveApartmentFromRealtor command
  */
-static bool RunRemoveApartmentFromRealtor(char** params, Yad3Program program) {
-	if ((params[2] != NULL) && (params[3] != NULL) && (params[4] != NULL)) {
-			Yad3ServiceResult result = yad3ServiceRemoveApartmentFromAgent(
-				program->service, params[2], params[3],
-				stringToInt(params[4]));
-			return HandleResult(result);
-		}
-		writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-		return false;
+static Yad3ServiceResult RunRemoveApartmentFromRealtor(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceRemoveApartmentFromAgent(program->service,
+		arguments[0].string, arguments[1].string, arguments[2].number);
 }
 
 /*
  * Run RemoveApartmentFromRealtor command
  */
-static bool RunResponeToOffer(char** params, Yad3Program program) {
-	if ((params[2] != NULL) && (params[3] != NULL) && (params[4] != NULL)) {
-			Yad3ServiceResult result = yad3ServiceRespondToClientOffer(
-				program->service, params[2], params[3], params[4]);
-			return HandleResult(result);
-		}
-		writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-		return false;
-}
-
-/*
- * Runs one of the possible Customer command
-*/
-static bool RunCustomerCommand(char** params, Yad3Program program) {
-	if (areStringsEqual(params[1], ACTION_ADD_USER)) {
-		return RunAddCustumer(params, program);
-	} else if (areStringsEqual(params[1], ACTION_REMOVE_USER)) {
-		return RunRemoveCustumer(params, program);
-	} else if (areStringsEqual(params[1], ACTION_PURCHASE)) {
-		return RunCustumerPurchase(params, program);
-	} else if (areStringsEqual(params[1], ACTION_MAKE_OFFER)) {
-		return RunMakeOffer(params, program);
-	} else {
-		writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-		return false;
-	}
+static Yad3ServiceResult RunResponeToOffer(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceRespondToClientOffer(program->service,
+		arguments[0].string, arguments[1].string, arguments[2].string);
 }
 
 /*
  * Run AddCustumer command
 */
-static bool RunAddCustumer(char** params, Yad3Program program) {
-	if ((params[2] != NULL) && (params[3] != NULL) && (params[4] != NULL)
-			&& (params[5] != NULL)) {
-		Yad3ServiceResult result = yad3ServiceAddClient(program->service,
-			params[2], stringToInt(params[3]), stringToInt(params[4]),
-			stringToInt(params[5]));
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
+static Yad3ServiceResult RunAddCustumer(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceAddClient(program->service, arguments[0].string,
+		arguments[1].number, arguments[2].number, arguments[3].number);
 }
 
 /*
  * Run RemoveCustumer command
 */
-static bool RunRemoveCustumer(char** params, Yad3Program program) {
-	if (params[2] != NULL) {
-		Yad3ServiceResult result = yad3ServiceRemoveClient(program->service,
-			params[2]);
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
+static Yad3ServiceResult RunRemoveCustumer(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceRemoveClient(program->service, arguments[0].string);
 }
 
 /*
  * Run RunCustumerPurchase command
 */
-static bool RunCustumerPurchase(char** params, Yad3Program program) {
-	if ((params[2] != NULL) && (params[3] != NULL) && (params[4] != NULL)
-			&& (params[5] != NULL)) {
-		Yad3ServiceResult result = yad3ServiceClientPurchaseApartment
-			(program->service,  params[2], params[3], params[4],
-			stringToInt(params[5]));
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
+static Yad3ServiceResult RunCustumerPurchase(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceClientPurchaseApartment(program->service,
+		arguments[0].string, arguments[1].string, arguments[2].string,
+		arguments[3].number);
 }
 
 /*
  * Run RunMakeOffer command
 */
-static bool RunMakeOffer(char** params, Yad3Program program) {
-	if ((params[2] != NULL) && (params[3] != NULL) && (params[4] != NULL)
-			&& (params[5] != NULL) && (params[6] != NULL)) {
-		Yad3ServiceResult result = yad3ServiceMakeClientOffer(program->service,
-			params[2], params[3], params[4], stringToInt(params[5]),
-			stringToInt(params[6]));
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
-}
-
-/*
- * Runs all the possible Reporter commands
-*/
-static bool RunReporterCommand(char** params, Yad3Program program) {
-	if (areStringsEqual(params[1], REPORT_RELEVENT_REALTORS)) {
-		RunPrintRealventRealtorReport(params, program);
-		return true;
-	} else if (areStringsEqual(params[1], REPORT_SIGNIFICANT_REALTORS)) {
-		RunSignificantRealtorReport(params, program);
-		return true;
-	}else if (areStringsEqual(params[1], REPORT_PAYING_CUSTOMERS)) {
-		RunPayingCustumersReport(params, program);
-		return true;
-	} else {
-		writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-		return false;
-	}
+static Yad3ServiceResult RunMakeOffer(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServiceMakeClientOffer(program->service, arguments[0].string,
+		arguments[1].string, arguments[2].string, arguments[3].number,
+		arguments[4].number);
 }
 
 /*
  * Run print most paying costumers report command
 */
-static bool RunPayingCustumersReport(char** params, Yad3Program program) {
-	if ((params[2] != NULL)) {
-		Yad3ServiceResult result = yad3ServicePrintMostPayingClients(
-			program->service, stringToInt(params[2]), program->output);
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
+static Yad3ServiceResult RunPayingCustumersReport(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServicePrintMostPayingClients(program->service,
+		arguments[0].number,
+		outputSinkGetStream(program->sink, OUTPUT_SINK_OUT));
 }
 
 /*
  * Run print most significant realtors report command
 */
-static bool RunSignificantRealtorReport(char** params, Yad3Program program) {
-	if ((params[2] != NULL)) {
-		Yad3ServiceResult result = yad3ServicePrintMostSignificantAgents(
-			program->service, stringToInt(params[2]), program->output);
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
+static Yad3ServiceResult RunSignificantRealtorReport(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServicePrintMostSignificantAgents(program->service,
+		arguments[0].number,
+		outputSinkGetStream(program->sink, OUTPUT_SINK_OUT));
 }
 
 /*
  * Run print most significant realtors report command
 */
-static bool RunPrintRealventRealtorReport(char** params, Yad3Program program) {
-	if ((params[2] != NULL)) {
-		Yad3ServiceResult result = yad3ServicePrintClientsRealventAgents(
-			program->service, params[2], program->output);
-		return HandleResult(result);
-	}
-	writeToErrorOutStream(MTM_INVALID_COMMAND_LINE_PARAMETERS);
-	return false;
+static Yad3ServiceResult RunPrintRealventRealtorReport(Yad3Program program,
+	const CommandArgument* arguments) {
+	return yad3ServicePrintClientsRealventAgents(program->service,
+		arguments[0].string,
+		outputSinkGetStream(program->sink, OUTPUT_SINK_OUT));
 }
 
 /*
  * Handles the code from service, returns if should continue or not
 */
-static bool HandleResult(Yad3ServiceResult result) {
-	if (result == YAD3_SERVICE_SUCCESS) return true;
+static bool HandleResult(Yad3Program program, Yad3ServiceResult result) {
+	if (result == YAD3_SERVICE_SUCCESS) {
+		if (program->statistics != NULL) {
+			commandStatisticsRecordSuccess(program->statistics);
+		}
+		return true;
+	}
 	MtmErrorCode code = ConvertYad3ServiceResult(result);
-	writeToErrorOutStream(code);
+	writeToErrorOutStream(program, code);
 	return (code != MTM_OUT_OF_MEMORY && code != MTM_CANNOT_OPEN_FILE &&
 		code != MTM_INVALID_COMMAND_LINE_PARAMETERS);
 }
@@ -645,129 +1194,3 @@ MtmErrorCode ConvertYad3ServiceResult(Yad3ServiceResult value) {
 	}
 	return result;
 }
-
-/*
-* addToArray: adds a new allocated string from the given range in the string
-* to the result matrix
-*
-* @return
-* 	true in case of success, false in case of allocation error
- */
-bool addToArray(char*** result, int *logical_size, int *actual_size,
-				char* string, int start_index, int index);
-
-/*
-* commandSplit: splits the string to an array of sub string
-* ignores eampty strings.
-*
-* @param string the string.
-* @param size the new array size.
-* @param value the split character.
-*
-* @return
-* 	NULL if string is null or malloc failed; else returns the matrix
- */
-static bool splitString(char* string, int *size, char*** result_ptr) {
-	int actual_size = 8;
-	int logical_size = 0;
-	int start_index = 0;
-	char** result = malloc(sizeof(char*) * actual_size);
-	int index = 0;
-	while ((string[index] != '\0') && (string[index] != '\n')) {
-		if ((string[index] == COMMAND_SAPARATOR_1) ||
-			(string[index] == COMMAND_SAPARATOR_2)) {
-			if (start_index < index) {
-				if (!addToArray(&result, &logical_size, &actual_size,
-						string, start_index, index)) {
-					return false;
-				}
-			}
-			start_index = index + 1;
-		}
-		index++;
-	}
-	if (start_index < index) {
-		if (!addToArray(&result, &logical_size, &actual_size,
-				string, start_index, index)) {
-			return false;
-		}
-	}
-	if (logical_size == 0) {
-		free(result);
-		return true;
-	}
-	if (logical_size != actual_size) {
-		char** new_array =
-			realloc(result, logical_size * sizeof(*new_array));
-		if (new_array == NULL) {
-			matrixDestroy(result, logical_size);
-			return false;
-		}
-		result = new_array;
-	}
-
-	*size = logical_size;
-	*result_ptr = logical_size == 0 ? NULL : result;
-
-    return true;
-}
-
-/*
- * Adds a copy of the given string to the array
- */
-static bool addToArray(char*** result, int *logical_size, int *actual_size,
-				char* string, int start_index, int index) {
-	if (*logical_size == *actual_size) {
-		*actual_size += 4;
-		char** new_array =
-			realloc(*result, (*actual_size) * sizeof(*new_array));
-		if (new_array == NULL) {
-			matrixDestroy(*result, *logical_size);
-			return false;
-		}
-		*result = new_array;
-	}
-	(*result)[*logical_size] = getSubString(string, start_index, index);
-	if (result[*logical_size] == NULL) {
-		matrixDestroy(*result, *logical_size);
-		return false;
-	}
-	(*logical_size)++;
-	return true;
-}
-
-/*
-* getSubString: returns a new sub string in the given range.
-*
-* @param string the string.
-* @param start_index the start_index.
-* @param end_index the end_index.
-*
-* @return
-* 	NULL if string is null or malloc failed or end_index - start_index <= 0;
-* 	else returns the string
- */
-static char* getSubString(char* str, int start_index, int end_index) {
-	if ((str == NULL) || (end_index - start_index <= 0)) return NULL;
-	char* new_string =
-			malloc(sizeof(char) * (end_index - start_index + 1));
-	if (new_string == NULL) return NULL;
-	for (int i = 0; i < (end_index - start_index); i++) {
-		new_string[i] = str[start_index + i];
-	}
-	new_string[end_index - start_index] = END_OF_STRING;
-	return new_string;
-}
-
-/*
-* matrixDestroy: Destroys the given matrixDestroy using free.
-*
-* @param matrix the matrix.
-* @param size the size.
- */
-static void matrixDestroy(char** matrix, int size) {
-	for (int i = 0; i < size; i++) {
-		free(matrix[i]);
-	}
-	free(matrix);
-}
@@ -8,6 +8,13 @@ typedef struct yad3Command_t *Yad3Command;
 
 #define OUTPUT_SIGN "-o"
 #define INPUT_SIGN "-i"
+#define PIPELINE_SIGN "-p"
+#define BINARY_SIGN "-b"
+#define CONVERT_SIGN "-c"
+#define TIMING_SIGN "-t"
+#define SNAPSHOT_LOAD_SIGN "-l"
+#define SNAPSHOT_SAVE_SIGN "-s"
+#define WRITE_AHEAD_LOG_SIGN "-w"
 
 /**
 * Allocates Yad3Program.
@@ -15,11 +22,27 @@ typedef struct yad3Command_t *Yad3Command;
 * Creates a new Yad3Program. This function receives the input parameters of the
 * process and retrieves the new program created.
 *
-* 	correct parameters are:
-* 	- only one parameter
-* 	- three parameters, the third must be INPUT_SIGN or OUTPUT_SIGN
-* 	- five parameters, the third and the fifth must be INPUT_SIGN and
-* 		OUTPUT_SIGN (one must be OUTPUT_SIGN and the second must be INPUT_SIGN)
+* 	correct parameters are, in any order and each one at most once:
+* 	- INPUT_SIGN followed by the input file path
+* 	- OUTPUT_SIGN followed by the output file path
+* 	- PIPELINE_SIGN, to parse the input on a separate thread while the
+* 		commands run. the output is the same as without it.
+* 	- BINARY_SIGN, to read the input as a binary command log instead of
+* 		text commands.
+* 	- CONVERT_SIGN followed by a path, to write the input commands to the
+* 		path as a binary command log instead of running them.
+* 	- TIMING_SIGN, to time every command and print the latency percentiles
+* 		of every command and the amount of every error to the error stream
+* 		when the program is destroyed.
+* 	- SNAPSHOT_LOAD_SIGN followed by a path, to start from the state saved
+* 		in the snapshot at the path instead of an empty one.
+* 	- SNAPSHOT_SAVE_SIGN followed by a path, to save the state to a
+* 		snapshot at the path once the input ends.
+* 	- WRITE_AHEAD_LOG_SIGN followed by a path, to log every command which
+* 		changed the state to a write ahead log at the path. the commands
+* 		already in the log and not in the loaded snapshot run first, so
+* 		the state is recovered after a crash. a saved snapshot empties the
+* 		log.
 *
 * @param input_parameters input parameters.
 * @param parameter_count input parameters count.
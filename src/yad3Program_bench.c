@@ -0,0 +1,150 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "yad3Program.h"
+#include "workloadGenerator.h"
+#include "monotonicClock.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#define NULL_DEVICE "NUL"
+#else
+#include <sys/resource.h>
+#define NULL_DEVICE "/dev/null"
+#endif
+
+#define BENCH_DEFAULT_COMMANDS 20000
+#define BENCH_KIND_COMMANDS_DIVISOR 10
+#define BENCH_REPEATS 3
+#define BENCH_WORKLOAD_FILE "yad3Program_bench.tmp"
+
+static bool writeWorkload(WorkloadConfig* config, int count, int kind,
+	int* total);
+static double runWorkload();
+static double runWorkloadBest();
+static long peakResidentKilobytes();
+int RunYad3ProgramBench(int argc, char *argv[]);
+
+/*
+ * Runs yad3ProgramRun over generated workloads, and prints the commands per
+ * second of a mixed workload, of each command kind and the peak resident
+ * memory of the process.
+ *
+ * arguments are the amount of mixed commands and the workload seed, both
+ * optional. the throughput of a kind is measured by running the population
+ * with and without a tenth of that amount of commands of the kind, so it
+ * excludes the population cost. errors of the runs are discarded.
+ */
+//int main(int argc, char *argv[]) {
+int RunYad3ProgramBench(int argc, char *argv[]) {
+	int commands = (argc > 1) ? atoi(argv[1]) : BENCH_DEFAULT_COMMANDS;
+	WorkloadConfig config;
+	workloadConfigSetDefault(&config);
+	if (argc > 2) config.seed = strtoul(argv[2], NULL, 10);
+	if ((commands <= 0) || (freopen(NULL_DEVICE, "w", stderr) == NULL)) {
+		printf("usage: %s [commands] [seed]\n", argv[0]);
+		return 1;
+	}
+	int total = 0;
+	if (!writeWorkload(&config, commands, WORKLOAD_MIXED, &total)) {
+		printf("could not write %s\n", BENCH_WORKLOAD_FILE);
+		return 1;
+	}
+	double seconds = runWorkloadBest();
+	printf("mixed workload: %d commands, seed %lu\n", total, config.seed);
+	printf("%-34s %12.0f commands/sec (%.3f sec)\n", "all", total / seconds,
+		seconds);
+	int population = 0;
+	writeWorkload(&config, 0, WORKLOAD_MIXED, &population);
+	double base = runWorkloadBest();
+	int kind_commands = commands / BENCH_KIND_COMMANDS_DIVISOR;
+	if (kind_commands == 0) kind_commands = 1;
+	for (int kind = 0; kind < WORKLOAD_COMMAND_KINDS; kind++) {
+		writeWorkload(&config, kind_commands, kind, NULL);
+		double kind_seconds = runWorkloadBest() - base;
+		if (kind_seconds > 0) {
+			printf("%-34s %12.0f commands/sec\n", workloadCommandName(kind),
+				kind_commands / kind_seconds);
+		} else {
+			printf("%-34s %12s commands/sec\n", workloadCommandName(kind),
+				"n/a");
+		}
+	}
+	printf("peak resident memory: %ld KB\n", peakResidentKilobytes());
+	remove(BENCH_WORKLOAD_FILE);
+	return 0;
+}
+
+/*
+ * Writes the workload population followed by count commands of the given
+ * kind into the workload file, and saves the amount of commands in total
+ */
+static bool writeWorkload(WorkloadConfig* config, int count, int kind,
+	int* total) {
+	FILE* file = fopen(BENCH_WORKLOAD_FILE, "w");
+	WorkloadGenerator generator = workloadGeneratorCreate(config);
+	int population = 0;
+	bool is_written = (file != NULL) && (generator != NULL) &&
+		(workloadGeneratorWritePopulation(generator, file, &population) ==
+			WORKLOAD_GENERATOR_SUCCESS) &&
+		(workloadGeneratorWriteCommands(generator, file, count, kind) ==
+			WORKLOAD_GENERATOR_SUCCESS);
+	workloadGeneratorDestroy(generator);
+	if ((file != NULL) && (fclose(file) != 0)) is_written = false;
+	if (total != NULL) *total = population + count;
+	return is_written;
+}
+
+/*
+ * Runs the program over the workload file, returns the run time in seconds
+ */
+static double runWorkload() {
+	char* parameters[] = {"yad3", INPUT_SIGN, BENCH_WORKLOAD_FILE,
+		OUTPUT_SIGN, NULL_DEVICE};
+	long long start = monotonicClockNow();
+	Yad3Program program = yad3ProgramCreate(parameters,
+		sizeof(parameters) / sizeof(parameters[0]));
+	yad3ProgramRun(program);
+	yad3ProgramDestroy(program);
+	return (double)(monotonicClockNow() - start) /
+		MONOTONIC_CLOCK_TICKS_PER_SECOND;
+}
+
+/*
+ * Runs the workload a few times, returns the shortest run time in seconds
+ */
+static double runWorkloadBest() {
+	double best = runWorkload();
+	for (int i = 1; i < BENCH_REPEATS; i++) {
+		double seconds = runWorkload();
+		if (seconds < best) best = seconds;
+	}
+	return best;
+}
+
+/*
+ * Returns the most memory the process had resident so far, in kilobytes
+ */
+#ifdef _WIN32
+static long peakResidentKilobytes() {
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+			sizeof(counters))) return -1;
+	return (long)(counters.PeakWorkingSetSize / 1024);
+}
+#else
+static long peakResidentKilobytes() {
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+}
+#endif
@@ -8,6 +8,8 @@
 #include "agentsManager.h"
 #include "offersManager.h"
 #include "clientPurchaseBill.h"
+#include "accountDirectory.h"
+#include "slabAllocator.h"
 
 #define WALL_CHAR 'w'
 #define EMPTY_CHAR 'e'
@@ -16,6 +18,8 @@ struct yad3Service_t {
 	ClientsManager clients;
 	AgentsManager agents;
 	OffersManager offers;
+	AccountDirectory accounts;
+	SlabAllocator allocator;
 };
 
 static Yad3ServiceResult RemoveApartmentFromAgent(Yad3Service service,
@@ -41,6 +45,8 @@ static Yad3ServiceResult CheckOffer(Yad3Service service, Email client,
 static Yad3ServiceResult PrintClientsDetails(List list, FILE* output);
 static Yad3ServiceResult RemoveOffer(Yad3Service service, Email client,
 		Email agent, int price, int id, char* service_name, char* choice);
+static SnapshotResult LoadSnapshot(Yad3Service service,
+		SnapshotReader reader);
 
 /**
 * Allocates a new Yad3Service.
@@ -50,17 +56,32 @@ static Yad3ServiceResult RemoveOffer(Yad3Service service, Email client,
 * 	A new service in case of success.
 */
 Yad3Service yad3ServiceCreate() {
+	SlabAllocator allocator = slabAllocatorCreate();
+	if (allocator == NULL) return NULL;
+	AccountDirectory accounts = accountDirectoryCreate();
+	if (accounts == NULL) {
+		slabAllocatorDestroy(allocator);
+		return NULL;
+	}
 	ClientsManager client_manager = clientsManagerCreate();
-	if (client_manager == NULL) return NULL;
+	if (client_manager == NULL) {
+		accountDirectoryDestroy(accounts);
+		slabAllocatorDestroy(allocator);
+		return NULL;
+	}
 	AgentsManager agent_manager = agentsManagerCreate();
 	if (agent_manager == NULL) {
 		clientsManagerDestroy(client_manager);
+		accountDirectoryDestroy(accounts);
+		slabAllocatorDestroy(allocator);
 		return NULL;
 	}
 	OffersManager offer_manager = offersManagerCreate();
 	if (offer_manager == NULL) {
 		clientsManagerDestroy(client_manager);
 		agentsManagerDestroy(agent_manager);
+		accountDirectoryDestroy(accounts);
+		slabAllocatorDestroy(allocator);
 		return NULL;
 	}
 	Yad3Service service = malloc(sizeof(*service));
@@ -68,11 +89,20 @@ Yad3Service yad3ServiceCreate() {
 			clientsManagerDestroy(client_manager);
 			agentsManagerDestroy(agent_manager);
 			offersManagerDestroy(offer_manager);
+			accountDirectoryDestroy(accounts);
+			slabAllocatorDestroy(allocator);
 			return NULL;
 		}
+	clientsManagerSetDirectory(client_manager, accounts);
+	agentsManagerSetDirectory(agent_manager, accounts);
+	clientsManagerSetAllocator(client_manager, allocator);
+	agentsManagerSetAllocator(agent_manager, allocator);
+	offersManagerSetAllocator(offer_manager, allocator);
 	service->clients = client_manager;
 	service->agents = agent_manager;
 	service->offers = offer_manager;
+	service->accounts = accounts;
+	service->allocator = allocator;
 	return service;
 }
 
@@ -88,10 +118,25 @@ void yad3ServiceDestroy(Yad3Service service) {
 		clientsManagerDestroy(service->clients);
 		agentsManagerDestroy(service->agents);
 		offersManagerDestroy(service->offers);
+		accountDirectoryDestroy(service->accounts);
+		slabAllocatorDestroy(service->allocator);
 		free(service);
 	}
 }
 
+/**
+* yad3ServiceGetAllocator: gets the allocator the service creates its
+* clients, offers, purchase bills and agent details from.
+*
+* @param service Target service.
+*
+* @return
+* 	NULL if service is NULL; else returns the allocator of the service.
+*/
+SlabAllocator yad3ServiceGetAllocator(Yad3Service service) {
+	return (service == NULL) ? NULL : service->allocator;
+}
+
 /*
  *
  * yad3ServiceAddAgent: Adds new agent with the given parameters.
@@ -123,8 +168,7 @@ Yad3ServiceResult yad3ServiceAddAgent(Yad3Service service, char* email_adress,
 	Email mail = NULL;
 	EmailResult result = emailCreate(email_adress, &mail);
 	if (result != EMAIL_SUCCESS) return convertEmailResult(result);
-	if (clientsManagerClientExists(service->clients, mail) ||
-		agentsManagerAgentExists(service->agents, mail)) {
+	if (accountDirectoryFind(service->accounts, mail, NULL) != ACCOUNT_NONE) {
 		emailDestroy(mail);
 		return YAD3_SERVICE_EMAIL_ALREADY_EXISTS;
 	}
@@ -306,17 +350,9 @@ Yad3ServiceResult yad3ServiceAddApartmentToAgent(Yad3Service service,
 		|| ((countChar(matrix, EMPTY_CHAR) + countChar(matrix, WALL_CHAR))
 				!=  height * width)) return YAD3_SERVICE_INVALID_PARAMETERS;
 	Email mail = NULL;
-	EmailResult email_result = emailCreate(email_adress, &mail);
-	if (email_result != EMAIL_SUCCESS) return convertEmailResult(email_result);
-	bool agent_exists = agentsManagerAgentExists(service->agents, mail);
-	bool client_exists = clientsManagerClientExists(service->clients, mail);
-	if ((!agent_exists) && (!client_exists)) {
-		emailDestroy(mail);
-		return YAD3_SERVICE_EMAIL_DOES_NOT_EXIST;
-	} else if (client_exists) {
-		emailDestroy(mail);
-		return YAD3_SERVICE_EMAIL_WRONG_ACCOUNT_TYPE;
-	}
+	Yad3ServiceResult search_result = CreateEmailAndSearchForAgent(service,
+		email_adress, &mail);
+	if (search_result != YAD3_SERVICE_SUCCESS) return search_result;
 	AgentsManagerResult result = agentsManagerAddApartmentToService(
 		service->agents, mail, service_name, id, price, width, height, matrix);
 	emailDestroy(mail);
@@ -432,8 +468,7 @@ Yad3ServiceResult yad3ServiceAddClient(Yad3Service service, char* email_adress,
 	Email mail = NULL;
 	EmailResult result = emailCreate(email_adress, &mail);
 	if (result != EMAIL_SUCCESS) return convertEmailResult(result);
-	if (clientsManagerClientExists(service->clients, mail) ||
-		agentsManagerAgentExists(service->agents, mail)) {
+	if (accountDirectoryFind(service->accounts, mail, NULL) != ACCOUNT_NONE) {
 		emailDestroy(mail);
 		return YAD3_SERVICE_EMAIL_ALREADY_EXISTS;
 	}
@@ -852,7 +887,8 @@ static Yad3ServiceResult CreateEmailAndSearchForAgent(Yad3Service service,
 
 /**
 * CreateEmailAndSearch: Creates an email and checks if it is a
-* 	registered client or agent.
+* 	registered client or agent, with a single lookup in the account
+* 	directory.
 *
 * @param service service to check.
 * @param email_adress string representing the email.
@@ -866,13 +902,11 @@ static Yad3ServiceResult CreateEmailAndSearch(Yad3Service service,
 	EmailResult result = emailCreate(email_adress, &mail);
 	if (result != EMAIL_SUCCESS) return convertEmailResult(result);
 	*out_email = mail;
-	bool agent_exists = agentsManagerAgentExists(service->agents, mail);
-	bool client_exists = clientsManagerClientExists(service->clients, mail);
-	if ((!agent_exists) && (!client_exists)) {
+	AccountRole role = accountDirectoryFind(service->accounts, mail, NULL);
+	if (role == ACCOUNT_NONE) {
 		emailDestroy(mail);
 		return YAD3_SERVICE_EMAIL_DOES_NOT_EXIST;
-	} else if ((search_for_client && agent_exists) ||
-			   ((!search_for_client) && client_exists)) {
+	} else if (role != (search_for_client ? ACCOUNT_CLIENT : ACCOUNT_AGENT)) {
 		emailDestroy(mail);
 		return YAD3_SERVICE_EMAIL_WRONG_ACCOUNT_TYPE;
 	}
@@ -1101,12 +1135,19 @@ Yad3ServiceResult yad3ServicePrintMostSignificantAgents(Yad3Service service,
 		int count, FILE* output) {
 	if ((service == NULL) || (count <= 0))
 		return YAD3_SERVICE_INVALID_PARAMETERS;
-	List list = NULL;
-	AgentsManagerResult result =
-			agentManagerGetSignificantAgents(service->agents, count, &list);
-	if (!(result == AGENT_MANAGER_SUCCESS))
-		return convertAgentManagerResult(result);
-	return PrintClientsDetails(list, output);
+	if (agentsManagerIsEmpty(service->agents))
+		return convertAgentManagerResult(AGENT_MANAGER_AGENT_NOT_EXISTS);
+	char* company_name = NULL;
+	Email mail = agentsManagerGetFirstSignificant(service->agents,
+			&company_name);
+	while((mail != NULL) && (count > 0)) {
+		mtmPrintRealtor((output == NULL ? stdout : output),
+				emailGetAddress(mail), company_name);
+		count--;
+		mail = agentsManagerGetNextSignificant(service->agents,
+				&company_name);
+	}
+	return YAD3_SERVICE_SUCCESS;
 }
 
 /*
@@ -1160,24 +1201,124 @@ Yad3ServiceResult yad3ServicePrintMostPayingClients(Yad3Service service,
 		int count, FILE* output) {
 	if ((service == NULL) || (count <= 0))
 		return YAD3_SERVICE_INVALID_PARAMETERS;
-	List list = NULL;
-	ClientsManagerResult result =
-			clientsManagerGetSortedPayments(service->clients, &list);
-	if (!(result == CLIENT_MANAGER_SUCCESS))
-		return convertClientManagerResult(result);
-	ClientPurchaseBill currentBill = listGetFirst(list);
-	while((currentBill != NULL) && (count > 0)) {
-		char* mail = clientPurchaseBillGetClientEmailToString(currentBill);
-		if (mail == NULL) {
-			listDestroy(list);
-			return YAD3_SERVICE_OUT_OF_MEMORY;
-		}
-		mtmPrintCustomer((output == NULL ? stdout : output), mail,
-				clientPurchaseBillGetMoneyPaid(currentBill));
-		free(mail);
+	int total_payments = 0;
+	Email mail = clientsManagerGetFirstPaying(service->clients,
+			&total_payments);
+	while((mail != NULL) && (count > 0)) {
+		mtmPrintCustomer((output == NULL ? stdout : output),
+				emailGetAddress(mail), total_payments);
 		count--;
-		currentBill = listGetNext(list);
+		mail = clientsManagerGetNextPaying(service->clients, &total_payments);
 	}
-	listDestroy(list);
 	return YAD3_SERVICE_SUCCESS;
 }
+
+/*
+* yad3ServiceSaveSnapshot: writes the whole state of the service to a
+* binary snapshot: the clients, the agents with their apartment services
+* and apartments, and the offers. see snapshot.h for the format.
+*
+* @param service service to save.
+* @param sequence the snapshot sequence, the last logged command the
+* 	service state includes.
+* @param output file to write the snapshot to.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS if service or output are NULL, or sequence is
+* 	negative.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocation problem.
+*
+* 	SNAPSHOT_WRITE_FAILED if writing failed.
+*
+*	SNAPSHOT_SUCCESS the snapshot was written
+*
+*/
+SnapshotResult yad3ServiceSaveSnapshot(Yad3Service service,
+		long long sequence, FILE* output) {
+	if ((service == NULL) || (output == NULL))
+		return SNAPSHOT_NULL_PARAMETERS;
+	SnapshotWriter writer = NULL;
+	SnapshotResult result = snapshotWriterCreate(output, sequence,
+		&writer);
+	if (result != SNAPSHOT_SUCCESS) return result;
+	result = clientsManagerSaveSnapshot(service->clients, writer);
+	if (result == SNAPSHOT_SUCCESS) {
+		result = agentsManagerSaveSnapshot(service->agents, writer);
+	}
+	if (result == SNAPSHOT_SUCCESS) {
+		result = offersManagerSaveSnapshot(service->offers, writer);
+	}
+	snapshotWriterDestroy(writer);
+	if ((result == SNAPSHOT_SUCCESS) && (fflush(output) != 0))
+		return SNAPSHOT_WRITE_FAILED;
+	return result;
+}
+
+/*
+* yad3ServiceLoadSnapshot: creates a service from a snapshot written by
+* yad3ServiceSaveSnapshot. the entities are built straight from the
+* snapshot, without the checks commands go through, so the snapshot is
+* trusted to hold a state the service reached.
+*
+* @param data the snapshot data.
+* @param size the snapshot size.
+* @param result pointer to save the new service in.
+* @param sequence pointer to save the snapshot sequence in.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS if data, result or sequence are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT if data is not a valid snapshot.
+*
+* 	SNAPSHOT_UNSUPPORTED_VERSION if the snapshot version is not supported.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocation problem.
+*
+*	SNAPSHOT_SUCCESS a new service is saved in the result
+*
+*/
+SnapshotResult yad3ServiceLoadSnapshot(const char* data, size_t size,
+		Yad3Service* result, long long* sequence) {
+	if ((data == NULL) || (result == NULL) || (sequence == NULL))
+		return SNAPSHOT_NULL_PARAMETERS;
+	SnapshotReader reader = NULL;
+	SnapshotResult loaded = snapshotReaderCreate(data, size, &reader);
+	if (loaded != SNAPSHOT_SUCCESS) return loaded;
+	Yad3Service service = yad3ServiceCreate();
+	if (service == NULL) {
+		snapshotReaderDestroy(reader);
+		return SNAPSHOT_OUT_OF_MEMORY;
+	}
+	loaded = LoadSnapshot(service, reader);
+	long long loaded_sequence = snapshotReaderGetSequence(reader);
+	snapshotReaderDestroy(reader);
+	if (loaded != SNAPSHOT_SUCCESS) {
+		yad3ServiceDestroy(service);
+		return loaded;
+	}
+	*result = service;
+	*sequence = loaded_sequence;
+	return SNAPSHOT_SUCCESS;
+}
+
+/*
+ * LoadSnapshot: reads the managers of a new service from a snapshot, and
+ * checks nothing is left after them.
+ */
+static SnapshotResult LoadSnapshot(Yad3Service service,
+		SnapshotReader reader) {
+	SnapshotResult result = clientsManagerLoadSnapshot(service->clients,
+		reader);
+	if (result == SNAPSHOT_SUCCESS) {
+		result = agentsManagerLoadSnapshot(service->agents, reader);
+	}
+	if (result == SNAPSHOT_SUCCESS) {
+		result = offersManagerLoadSnapshot(service->offers, reader);
+	}
+	if ((result == SNAPSHOT_SUCCESS) && !snapshotReaderIsDone(reader))
+		return SNAPSHOT_BAD_FORMAT;
+	return result;
+}
@@ -1,7 +1,10 @@
 #ifndef SRC_YAD3SERVICE_H_
 #define SRC_YAD3SERVICE_H_
 
+#include <stddef.h>
 #include "mtm_ex2.h"
+#include "snapshot.h"
+#include "slabAllocator.h"
 
 typedef struct yad3Service_t *Yad3Service;
 
@@ -54,6 +57,17 @@ Yad3Service yad3ServiceCreate();
 */
 void yad3ServiceDestroy(Yad3Service service);
 
+/**
+* yad3ServiceGetAllocator: gets the allocator the service creates its
+* clients, offers, purchase bills and agent details from.
+*
+* @param service Target service.
+*
+* @return
+* 	NULL if service is NULL; else returns the allocator of the service.
+*/
+SlabAllocator yad3ServiceGetAllocator(Yad3Service service);
+
 /*
  * yad3ServiceAddAgent: Adds new agent with the given parameters.
 *
@@ -458,5 +472,57 @@ Yad3ServiceResult yad3ServicePrintMostSignificantAgents(Yad3Service service,
 Yad3ServiceResult yad3ServicePrintClientsRealventAgents(Yad3Service service,
 		char* email, FILE* output);
 
+/*
+* yad3ServiceSaveSnapshot: writes the whole state of the service to a
+* binary snapshot: the clients, the agents with their apartment services
+* and apartments, and the offers. see snapshot.h for the format.
+*
+* @param service service to save.
+* @param sequence the snapshot sequence, the last logged command the
+* 	service state includes.
+* @param output file to write the snapshot to.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS if service or output are NULL, or sequence is
+* 	negative.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocation problem.
+*
+* 	SNAPSHOT_WRITE_FAILED if writing failed.
+*
+*	SNAPSHOT_SUCCESS the snapshot was written
+*
+*/
+SnapshotResult yad3ServiceSaveSnapshot(Yad3Service service,
+		long long sequence, FILE* output);
+
+/*
+* yad3ServiceLoadSnapshot: creates a service from a snapshot written by
+* yad3ServiceSaveSnapshot. the entities are built straight from the
+* snapshot, without the checks commands go through, so the snapshot is
+* trusted to hold a state the service reached.
+*
+* @param data the snapshot data.
+* @param size the snapshot size.
+* @param result pointer to save the new service in.
+* @param sequence pointer to save the snapshot sequence in.
+*
+* @return
+*
+* 	SNAPSHOT_NULL_PARAMETERS if data, result or sequence are NULL.
+*
+* 	SNAPSHOT_BAD_FORMAT if data is not a valid snapshot.
+*
+* 	SNAPSHOT_UNSUPPORTED_VERSION if the snapshot version is not supported.
+*
+* 	SNAPSHOT_OUT_OF_MEMORY in case of memory allocation problem.
+*
+*	SNAPSHOT_SUCCESS a new service is saved in the result
+*
+*/
+SnapshotResult yad3ServiceLoadSnapshot(const char* data, size_t size,
+		Yad3Service* result, long long* sequence);
+
 
 #endif /* SRC_YAD3SERVICE_H_ */
@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "test_utilities.h"
 #include "yad3Service.h"
 
@@ -20,6 +21,7 @@ static bool testYad3ServiceRemoveApartmentFromAgent();
 static bool testYad3ServiceAddClient();
 static bool testYad3ServiceRemoveClient();
 static bool testYad3ServiceClientPurchaseApartment();
+static bool testYad3ServiceSnapshot();
 
 int RunYad3ServiceTest() {
 
@@ -33,6 +35,7 @@ int RunYad3ServiceTest() {
 	RUN_TEST(testYad3ServiceAddClient);
 	RUN_TEST(testYad3ServiceRemoveClient);
 	RUN_TEST(testYad3ServiceClientPurchaseApartment);
+	RUN_TEST(testYad3ServiceSnapshot);
 	return 0;
 }
 
@@ -168,7 +171,7 @@ static bool testYad3ServiceRemoveServiceFromAgent() {
 	yad3ServiceDestroy(service);
 	return true;
 }
-
+
 static bool testYad3ServiceAddApartmentToAgent(){
 
 	Yad3Service service = yad3ServiceCreate();
@@ -349,3 +352,89 @@ static bool testYad3ServiceClientPurchaseApartment() {
 	yad3ServiceDestroy(service);
 	return true;
 }
+
+/* Saves a service snapshot to memory, returns its size or 0 on failure */
+static size_t saveSnapshotToMemory(Yad3Service service, char* data,
+		size_t capacity) {
+	FILE* file = tmpfile();
+	if (file == NULL) return 0;
+	size_t size = 0;
+	if (yad3ServiceSaveSnapshot(service, 42, file) == SNAPSHOT_SUCCESS) {
+		rewind(file);
+		size = fread(data, 1, capacity, file);
+	}
+	fclose(file);
+	return size;
+}
+
+/* Prints the reports of a service to memory, returns their size */
+static size_t printReportsToMemory(Yad3Service service, char* data,
+		size_t capacity) {
+	FILE* file = tmpfile();
+	if (file == NULL) return 0;
+	yad3ServicePrintMostPayingClients(service, 10, file);
+	yad3ServicePrintMostSignificantAgents(service, 10, file);
+	yad3ServicePrintClientsRealventAgents(service, "ba@ganosh", file);
+	rewind(file);
+	size_t size = fread(data, 1, capacity, file);
+	fclose(file);
+	return size;
+}
+
+static bool testYad3ServiceSnapshot() {
+	Yad3Service service = yad3ServiceCreate();
+	yad3ServiceAddAgent(service, "baba@ganosh", "tania", 5);
+	yad3ServiceAddAgent(service, "nba@ganosh", "nadav", 10);
+	yad3ServiceAddServiceToAgent(service, "baba@ganosh", "serveMe", 5);
+	yad3ServiceAddServiceToAgent(service, "nba@ganosh", "other", 2);
+	yad3ServiceAddApartmentToAgent(service, "baba@ganosh",
+			"serveMe", 3, 100, 3, 3, "ewwwewwwe");
+	yad3ServiceAddApartmentToAgent(service, "baba@ganosh",
+			"serveMe", 1, 500, 1, 9, "eeeeweeee");
+	yad3ServiceAddApartmentToAgent(service, "nba@ganosh",
+			"other", 2, 200, 2, 2, "eeee");
+	yad3ServiceAddClient(service, "ba@ganosh", 1, 1, 1000);
+	yad3ServiceAddClient(service, "c@ganosh", 2, 1, 5000);
+	yad3ServiceClientPurchaseApartment(service, "c@ganosh", "nba@ganosh",
+			"other", 2);
+	char data[1024], copy_data[1024], reports[1024], copy_reports[1024];
+	size_t size = saveSnapshotToMemory(service, data, sizeof(data));
+	ASSERT_TEST(size > 0);
+
+	Yad3Service copy = NULL;
+	long long sequence = 0;
+	ASSERT_TEST(yad3ServiceLoadSnapshot(NULL, size, &copy, &sequence) ==
+			SNAPSHOT_NULL_PARAMETERS);
+	ASSERT_TEST(yad3ServiceLoadSnapshot(data, size - 1, &copy, &sequence) ==
+			SNAPSHOT_BAD_FORMAT);
+	ASSERT_TEST(yad3ServiceLoadSnapshot("not a snapshot", 14, &copy,
+			&sequence) ==
+			SNAPSHOT_BAD_FORMAT);
+	ASSERT_TEST(yad3ServiceLoadSnapshot(data, size, &copy, &sequence) ==
+			SNAPSHOT_SUCCESS);
+	ASSERT_TEST(sequence == 42);
+	ASSERT_TEST(saveSnapshotToMemory(copy, copy_data, sizeof(copy_data)) ==
+			size);
+	ASSERT_TEST(memcmp(data, copy_data, size) == 0);
+	size_t reports_size = printReportsToMemory(service, reports,
+			sizeof(reports));
+	ASSERT_TEST(reports_size > 0);
+	ASSERT_TEST(printReportsToMemory(copy, copy_reports,
+			sizeof(copy_reports)) == reports_size);
+	ASSERT_TEST(memcmp(reports, copy_reports, reports_size) == 0);
+
+	ASSERT_TEST(yad3ServiceAddClient(copy, "baba@ganosh", 1, 1, 1) ==
+			YAD3_SERVICE_EMAIL_ALREADY_EXISTS);
+	ASSERT_TEST(yad3ServiceAddApartmentToAgent(copy, "nba@ganosh",
+			"other", 5, 200, 2, 2, "eeee") == YAD3_SERVICE_SUCCESS);
+	ASSERT_TEST(yad3ServiceAddApartmentToAgent(copy, "nba@ganosh",
+			"other", 6, 200, 2, 2, "eeee") == YAD3_SERVICE_SUCCESS);
+	ASSERT_TEST(yad3ServiceAddApartmentToAgent(copy, "nba@ganosh",
+			"other", 7, 200, 2, 2, "eeee") ==
+					YAD3_SERVICE_APARTMENT_SERVICE_FULL);
+	ASSERT_TEST(yad3ServiceClientPurchaseApartment(copy, "ba@ganosh",
+			"baba@ganosh", "serveMe", 3) == YAD3_SERVICE_SUCCESS);
+	yad3ServiceDestroy(copy);
+	yad3ServiceDestroy(service);
+	return true;
+}